@@ -4,4 +4,10 @@ elseif(CMAKE_BUILD_TYPE STREQUAL "Release")
     add_definitions(-DAE_RELEASE)
 endif()
 
-option(BUILD_TESTS "Build unit tests." ON)
\ No newline at end of file
+option(BUILD_TESTS "Build unit tests." ON)
+option(BUILD_BENCHMARKS "Build benchmarks." ON)
+option(USE_BINNED_ALLOCATOR "Route MemoryUtils allocations through the engine's binned allocator." ON)
+
+if(USE_BINNED_ALLOCATOR)
+    add_definitions(-DAE_USE_BINNED_ALLOCATOR)
+endif()
\ No newline at end of file
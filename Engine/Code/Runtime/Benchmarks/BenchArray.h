@@ -0,0 +1,241 @@
+#pragma once
+
+#include "Benchmark.h"
+#include "Containers/Array.h"
+#include "Memory/Allocators/MemoryArena.h"
+#include <vector>
+
+AE_BENCHMARK("[TArray] Inline allocator")
+{
+    constexpr uint64 iterations = 1000000;
+
+    Benchmark::Measure("THeapAllocator, 8 items", iterations, [] {
+        TArray<int32> u;
+        for (int32 i = 0; i < 8; i++) {
+            u.Add(i);
+        }
+        Benchmark::DoNotOptimize(u);
+    });
+
+    Benchmark::Measure("TInlineAllocator<8>, 8 items", iterations, [] {
+        TArray<int32, TInlineAllocator<8>> u;
+        for (int32 i = 0; i < 8; i++) {
+            u.Add(i);
+        }
+        Benchmark::DoNotOptimize(u);
+    });
+
+    Benchmark::Measure("TInlineAllocator<8>, 32 items", iterations, [] {
+        TArray<int32, TInlineAllocator<8>> u;
+        for (int32 i = 0; i < 32; i++) {
+            u.Add(i);
+        }
+        Benchmark::DoNotOptimize(u);
+    });
+}
+
+AE_BENCHMARK("[TArray] Fixed allocator")
+{
+    constexpr uint64 iterations = 1000000;
+
+    Benchmark::Measure("THeapAllocator, 16 items", iterations, [] {
+        TArray<int32> u;
+        for (int32 i = 0; i < 16; i++) {
+            u.Add(i);
+        }
+        Benchmark::DoNotOptimize(u);
+    });
+
+    Benchmark::Measure("TFixedAllocator<16>, 16 items", iterations, [] {
+        TArray<int32, TFixedAllocator<16>> u;
+        for (int32 i = 0; i < 16; i++) {
+            u.Add(i);
+        }
+        Benchmark::DoNotOptimize(u);
+    });
+}
+
+AE_BENCHMARK("[TArray] Arena allocator")
+{
+    constexpr uint64 iterations = 100000;
+
+    Benchmark::Measure("THeapAllocator, 16 arrays of 64 items", iterations, [] {
+        for (int32 j = 0; j < 16; j++) {
+            TArray<int32> u;
+            for (int32 i = 0; i < 64; i++) {
+                u.Add(i);
+            }
+            Benchmark::DoNotOptimize(u);
+        }
+    });
+
+    Benchmark::Measure("TArenaAllocator, 16 arrays of 64 items", iterations, [] {
+        for (int32 j = 0; j < 16; j++) {
+            TArray<int32, DefaultArenaAllocator> u;
+            for (int32 i = 0; i < 64; i++) {
+                u.Add(i);
+            }
+            Benchmark::DoNotOptimize(u);
+        }
+        MemoryArena::GetFrameArena().Reset();
+    });
+}
+
+
+namespace BenchArray {
+
+/** Same layout as TArray<int32> but not declared trivially relocatable.*/
+struct MovedArray
+{
+    TArray<int32> Items;
+};
+
+template<class ItemType>
+void
+GrowArrayOfArrays()
+{
+    TArray<ItemType> u;
+    for (int32 i = 0; i < 4096; i++) {
+        u.Emplace();
+    }
+    Benchmark::DoNotOptimize(u);
+}
+
+} // namespace BenchArray
+
+AE_BENCHMARK("[TArray] Relocation")
+{
+    constexpr uint64 iterations = 2000;
+
+    Benchmark::Measure("Trivially relocatable, 4096 arrays", iterations, BenchArray::GrowArrayOfArrays<TArray<int32>>);
+    Benchmark::Measure("Move constructed, 4096 arrays", iterations, BenchArray::GrowArrayOfArrays<BenchArray::MovedArray>);
+}
+
+AE_BENCHMARK("[TArray<bool>] Visibility masks")
+{
+    constexpr uint64 iterations  = 1000;
+    constexpr uint32 objectCount = 256 * 1024;
+
+    TArray<bool>      visible(objectCount);
+    TArray<bool>      dirty(objectCount);
+    std::vector<bool> stdVisible(objectCount);
+    std::vector<bool> stdDirty(objectCount);
+    for (uint32 i = 0; i < objectCount; i++) {
+        visible[i] = stdVisible[i] = (i * 7) % 3 == 0;
+        dirty[i] = stdDirty[i] = (i * 13) % 5 == 0;
+    }
+
+    Benchmark::Measure("TArray<bool>, and + count 262144", iterations, [&] {
+        TArray<bool> mask = visible & dirty;
+        Benchmark::DoNotOptimize(mask.CountSetBits());
+    });
+
+    Benchmark::Measure("std::vector<bool>, and + count 262144", iterations, [&] {
+        std::vector<bool> mask(objectCount);
+        uint64            count = 0;
+        for (uint32 i = 0; i < objectCount; i++) {
+            mask[i] = stdVisible[i] && stdDirty[i];
+            count += mask[i];
+        }
+        Benchmark::DoNotOptimize(count);
+    });
+
+    Benchmark::Measure("TArray<bool>, find every set bit 262144", iterations, [&] {
+        uint64 sum = 0;
+        visible.ForEachSetBit([&](uint32 index) { sum += index; });
+        Benchmark::DoNotOptimize(sum);
+    });
+
+    Benchmark::Measure("std::vector<bool>, find every set bit 262144", iterations, [&] {
+        uint64 sum = 0;
+        for (uint32 i = 0; i < objectCount; i++) {
+            sum += stdVisible[i] ? i : 0;
+        }
+        Benchmark::DoNotOptimize(sum);
+    });
+}
+
+namespace BenchArray {
+
+/** Draw call sorted by its 64 bit key, the layer, material and depth packed from high to low bits.*/
+struct DrawCall
+{
+    uint64 SortKey;
+    uint32 Mesh;
+    uint32 Instance;
+};
+
+/**
+ * Sorts copies of the same random keys with each algorithm, every run includes copying the unsorted keys back.
+ */
+void
+MeasureSorts(uint64 count, const char* sizeLabel)
+{
+    // About the same number of sorted keys per measure, at least one run.
+    const uint64 iterations = count < 10000000 ? 10000000 / count : 1;
+
+    TArray<uint64> source;
+    source.Reserve(count);
+    uint64 state = 1;
+    for (uint64 i = 0; i < count; i++) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        source.Add(state);
+    }
+
+    TArray<uint64> keys(source);
+    char           label[128];
+    const auto     measure = [&](const char* name, auto&& sort) {
+        snprintf(label, sizeof(label), "%s, %s keys", name, sizeLabel);
+        Benchmark::Measure(label, iterations, [&] {
+            memcpy(keys.GetData(), source.GetData(), count * sizeof(uint64));
+            sort();
+            Benchmark::DoNotOptimize(keys[0]);
+        });
+    };
+
+    measure("std::sort", [&] { std::sort(keys.begin(), keys.end()); });
+    measure("TArray::Sort", [&] { keys.Sort(); });
+    measure("std::stable_sort", [&] { std::stable_sort(keys.begin(), keys.end()); });
+    measure("TArray::StableSort", [&] { keys.StableSort(); });
+    measure("TArray::RadixSort", [&] { keys.RadixSort(); });
+}
+
+} // namespace BenchArray
+
+AE_BENCHMARK("[TArray] Sort")
+{
+    BenchArray::MeasureSorts(1000, "1K");
+    BenchArray::MeasureSorts(100000, "100K");
+    BenchArray::MeasureSorts(10000000, "10M");
+    BenchArray::MeasureSorts(100000000, "100M");
+
+    // Draw calls with few distinct layers and materials, the radix sort skips the bytes they all share.
+    constexpr uint64             drawCount = 100000;
+    TArray<BenchArray::DrawCall> source;
+    uint64                       state = 1;
+    for (uint32 i = 0; i < drawCount; i++) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        source.Add(BenchArray::DrawCall{ (state >> 60) << 56 | ((state >> 40) & 0xFF) << 32 | (state & 0xFFFFFF), i, i });
+    }
+
+    TArray<BenchArray::DrawCall> draws(source);
+    const auto                   byKey = [](const BenchArray::DrawCall& a, const BenchArray::DrawCall& b) { return a.SortKey < b.SortKey; };
+
+    Benchmark::Measure("std::sort, 100K draw calls", 100, [&] {
+        memcpy(draws.GetData(), source.GetData(), drawCount * sizeof(BenchArray::DrawCall));
+        std::sort(draws.begin(), draws.end(), byKey);
+        Benchmark::DoNotOptimize(draws[0]);
+    });
+
+    Benchmark::Measure("TArray::Sort, 100K draw calls", 100, [&] {
+        memcpy(draws.GetData(), source.GetData(), drawCount * sizeof(BenchArray::DrawCall));
+        draws.Sort(byKey);
+        Benchmark::DoNotOptimize(draws[0]);
+    });
+
+    Benchmark::Measure("TArray::RadixSort with a key, 100K draw calls", 100, [&] {
+        memcpy(draws.GetData(), source.GetData(), drawCount * sizeof(BenchArray::DrawCall));
+        draws.RadixSort([](const BenchArray::DrawCall& draw) { return draw.SortKey; });
+        Benchmark::DoNotOptimize(draws[0]);
+    });
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Benchmark.h"
+#include "Containers/ChunkedArray.h"
+
+namespace BenchChunkedArray {
+
+/**
+ * Component sized item, referred to by pointer once added.
+ */
+struct Component
+{
+    float  Position[3];
+    float  Velocity[3];
+    uint64 Owner;
+};
+
+} // namespace BenchChunkedArray
+
+AE_BENCHMARK("[TChunkedArray] Append and iterate")
+{
+    using BenchChunkedArray::Component;
+
+    constexpr uint32 ItemCount = 100000;
+
+    Benchmark::Measure("TArray, Add 100000", 100, [&] {
+        TArray<Component> array;
+        for (uint32 i = 0; i < ItemCount; i++) {
+            array.Add(Component{ { 0, 0, 0 }, { 1, 1, 1 }, i });
+        }
+        Benchmark::DoNotOptimize(array[ItemCount - 1]);
+    });
+
+    Benchmark::Measure("TChunkedArray<256>, Add 100000", 100, [&] {
+        TChunkedArray<Component, 256> array;
+        for (uint32 i = 0; i < ItemCount; i++) {
+            array.Add(Component{ { 0, 0, 0 }, { 1, 1, 1 }, i });
+        }
+        Benchmark::DoNotOptimize(array[ItemCount - 1]);
+    });
+
+    TArray<Component>             array;
+    TChunkedArray<Component, 256> chunked;
+    for (uint32 i = 0; i < ItemCount; i++) {
+        array.Add(Component{ { 0, 0, 0 }, { 1, 1, 1 }, i });
+        chunked.Add(Component{ { 0, 0, 0 }, { 1, 1, 1 }, i });
+    }
+
+    Benchmark::Measure("TArray, iterate 100000", 1000, [&] {
+        uint64 sum = 0;
+        for (const Component& item : array) {
+            sum += item.Owner;
+        }
+        Benchmark::DoNotOptimize(sum);
+    });
+
+    Benchmark::Measure("TChunkedArray<256>, iterate 100000", 1000, [&] {
+        uint64 sum = 0;
+        for (const Component& item : chunked) {
+            sum += item.Owner;
+        }
+        Benchmark::DoNotOptimize(sum);
+    });
+
+    Benchmark::Measure("TChunkedArray<256>, ForEachChunk 100000", 1000, [&] {
+        uint64 sum = 0;
+        chunked.ForEachChunk([&](const Component* items, uint64 count) {
+            for (uint64 i = 0; i < count; i++) {
+                sum += items[i].Owner;
+            }
+        });
+        Benchmark::DoNotOptimize(sum);
+    });
+
+    Benchmark::Measure("TChunkedArray<256>, operator[] 100000", 1000, [&] {
+        uint64 sum = 0;
+        for (uint32 i = 0; i < ItemCount; i++) {
+            sum += chunked[(i * 7919) % ItemCount].Owner;
+        }
+        Benchmark::DoNotOptimize(sum);
+    });
+}
@@ -0,0 +1,174 @@
+#pragma once
+
+#include "Benchmark.h"
+#include "Containers/MpmcQueue.h"
+#include "Containers/RingBuffer.h"
+#include "Containers/SpscQueue.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace BenchConcurrentQueues {
+
+constexpr uint64 ItemCount = 1 << 20;
+constexpr uint64 BatchSize = 32;
+
+/**
+ * Queue guarded by a mutex, the way threads exchanged work before the lock-free queues.
+ */
+class LockedQueue
+{
+  public:
+    explicit LockedQueue(uint64 capacity) { m_items.Reserve(capacity); }
+
+    void Push(uint64 item) { PushBatch(&item, 1); }
+
+    void PushBatch(const uint64* items, uint64 count)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (uint64 i = 0; i < count; i++) {
+                m_items.PushBack(items[i]);
+            }
+        }
+        m_notEmpty.notify_all();
+    }
+
+    void Pop(uint64& item) { PopBatch(&item, 1); }
+
+    uint64 PopBatch(uint64* items, uint64 maxCount)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notEmpty.wait(lock, [this] { return !m_items.IsEmpty(); });
+
+        uint64 count = 0;
+        for (; count < maxCount && !m_items.IsEmpty(); count++) {
+            items[count] = m_items.PopFront();
+        }
+        return count;
+    }
+
+  private:
+    std::mutex              m_mutex;
+    std::condition_variable m_notEmpty;
+    TRingBuffer<uint64>     m_items;
+};
+
+/**
+ * Moves ItemCount items from producers to consumers, every thread handles an equal share.
+ */
+template<class QueueType>
+void
+MeasureThroughput(const char* label, uint32 threadCount, bool batched)
+{
+    char threadLabel[128];
+    snprintf(threadLabel, sizeof(threadLabel), "%s, %ux%u threads", label, threadCount, threadCount);
+
+    Benchmark::Measure(threadLabel, 1, [&] {
+        QueueType    queue(1024);
+        const uint64 share = ItemCount / threadCount;
+
+        std::thread threads[128];
+        for (uint32 i = 0; i < threadCount; i++) {
+            threads[i] = std::thread([&, i] {
+                uint64 items[BatchSize];
+                for (uint64 j = 0; j < share;) {
+                    const uint64 count = batched ? (share - j < BatchSize ? share - j : BatchSize) : 1;
+                    for (uint64 k = 0; k < count; k++) {
+                        items[k] = (static_cast<uint64>(i) << 32) | (j + k);
+                    }
+                    if (batched) {
+                        queue.PushBatch(items, count);
+                    } else {
+                        queue.Push(items[0]);
+                    }
+                    j += count;
+                }
+            });
+            threads[threadCount + i] = std::thread([&] {
+                uint64 items[BatchSize];
+                uint64 sum = 0;
+                for (uint64 j = 0; j < share;) {
+                    uint64 count = 1;
+                    if (batched) {
+                        count = queue.PopBatch(items, share - j < BatchSize ? share - j : BatchSize);
+                    } else {
+                        queue.Pop(items[0]);
+                    }
+                    for (uint64 k = 0; k < count; k++) {
+                        sum += items[k];
+                    }
+                    j += count;
+                }
+                Benchmark::DoNotOptimize(sum);
+            });
+        }
+
+        for (uint32 i = 0; i < threadCount * 2; i++) {
+            threads[i].join();
+        }
+    });
+}
+
+/**
+ * Sends an item to another thread and waits for it to come back, one round trip per run.
+ */
+template<class QueueType>
+void
+MeasureLatency(const char* label)
+{
+    QueueType   requests(64);
+    QueueType   responses(64);
+    std::thread responder([&] {
+        for (;;) {
+            uint64 item;
+            requests.Pop(item);
+            responses.Push(item);
+            if (item == ~0ull) {
+                return;
+            }
+        }
+    });
+
+    uint64 item = 0;
+    Benchmark::Measure(label, 100000, [&] {
+        requests.Push(item);
+        responses.Pop(item);
+        item++;
+    });
+
+    requests.Push(~0ull);
+    responses.Pop(item);
+    responder.join();
+}
+
+} // namespace BenchConcurrentQueues
+
+AE_BENCHMARK("[TSpscQueue] Throughput and latency")
+{
+    using namespace BenchConcurrentQueues;
+
+    MeasureThroughput<LockedQueue>("Mutex queue, Push/Pop", 1, false);
+    MeasureThroughput<TSpscQueue<uint64>>("TSpscQueue, Push/Pop", 1, false);
+    MeasureThroughput<LockedQueue>("Mutex queue, batches of 32", 1, true);
+    MeasureThroughput<TSpscQueue<uint64>>("TSpscQueue, batches of 32", 1, true);
+
+    MeasureLatency<LockedQueue>("Mutex queue, round trip");
+    MeasureLatency<TSpscQueue<uint64>>("TSpscQueue, round trip");
+}
+
+AE_BENCHMARK("[TMpmcQueue] Throughput and latency")
+{
+    using namespace BenchConcurrentQueues;
+
+    // Up to 64 producers and 64 consumers, whatever the number of cores, to measure oversubscription too.
+    for (uint32 threads = 1; threads <= 64; threads *= 2) {
+        MeasureThroughput<LockedQueue>("Mutex queue, Push/Pop", threads, false);
+        MeasureThroughput<TMpmcQueue<uint64>>("TMpmcQueue, Push/Pop", threads, false);
+        MeasureThroughput<LockedQueue>("Mutex queue, batches of 32", threads, true);
+        MeasureThroughput<TMpmcQueue<uint64>>("TMpmcQueue, batches of 32", threads, true);
+    }
+
+    MeasureLatency<TMpmcQueue<uint64>>("TMpmcQueue, round trip");
+}
@@ -0,0 +1,118 @@
+#include "Benchmark.h"
+#include "Containers/ContainersFwd.h"
+
+#include "BenchArray.h"
+#include "BenchChunkedArray.h"
+#include "BenchConcurrentQueues.h"
+#include "BenchMemory.h"
+#include "BenchSet.h"
+#include "BenchMap.h"
+#include "BenchName.h"
+#include "BenchRingBuffer.h"
+#include "BenchSlotMap.h"
+#include "BenchSoAArray.h"
+#include "BenchString.h"
+
+#ifdef AE_USE_BINNED_ALLOCATOR
+    #include "Memory/Allocators/BinnedAllocator.h"
+#endif
+
+#include <atomic>
+#include <cstring>
+#include <new>
+
+static std::atomic<uint64> gAllocationCount {0};
+
+static Benchmark::Registrar* gFirstBenchmark = nullptr;
+static Benchmark::Registrar* gLastBenchmark  = nullptr;
+
+static void*
+CountedAllocate(size_t size)
+{
+    gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+
+    void* memory = malloc(size ? size : 1);
+    if (!memory) {
+        abort();
+    }
+    return memory;
+}
+
+void*
+operator new(size_t size)
+{
+    return CountedAllocate(size);
+}
+
+void*
+operator new[](size_t size)
+{
+    return CountedAllocate(size);
+}
+
+void
+operator delete(void* memory) noexcept
+{
+    free(memory);
+}
+
+void
+operator delete[](void* memory) noexcept
+{
+    free(memory);
+}
+
+void
+operator delete(void* memory, size_t) noexcept
+{
+    free(memory);
+}
+
+void
+operator delete[](void* memory, size_t) noexcept
+{
+    free(memory);
+}
+
+Benchmark::Registrar::Registrar(const char* name, FunctionType function)
+  : Name(name)
+  , Function(function)
+  , Next(nullptr)
+{
+    if (gLastBenchmark) {
+        gLastBenchmark->Next = this;
+    } else {
+        gFirstBenchmark = this;
+    }
+    gLastBenchmark = this;
+}
+
+uint64
+Benchmark::GetAllocationCount()
+{
+#ifdef AE_USE_BINNED_ALLOCATOR
+    return gAllocationCount.load(std::memory_order_relaxed) + BinnedAllocator::GetThreadAllocationCount();
+#else
+    return gAllocationCount.load(std::memory_order_relaxed);
+#endif
+}
+
+/**
+ * Runs every registered benchmark, or only the ones whose name contains argv[1].
+ */
+int32
+main(int32 argc, char** argv)
+{
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+
+    for (Benchmark::Registrar* benchmark = gFirstBenchmark; benchmark; benchmark = benchmark->Next) {
+        if (filter && !strstr(benchmark->Name, filter)) {
+            continue;
+        }
+
+        printf("%s\n", benchmark->Name);
+        benchmark->Function();
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "Benchmark.h"
+#include "Containers/Map.h"
+#include <unordered_map>
+
+namespace BenchMap {
+
+/**
+ * Pseudo-random keys, so neither container benefits from sequential hashes.
+ */
+inline uint64
+GetKey(uint64 index)
+{
+    return (index + 1) * 0xD6E8FEB86659FD93ull;
+}
+
+/**
+ * Gameplay sized value, large enough for node based maps to spread their entries over the heap.
+ */
+struct Value
+{
+    uint64 Data[4];
+};
+
+template<class MapType, class FindFunctionType, class IterateFunctionType>
+void
+MeasureMap(const char* label, uint64 count, FindFunctionType&& find, IterateFunctionType&& iterate)
+{
+    const uint64 iterations = count < 2000000 ? 2000000 / count : 1;
+
+    char measureLabel[128];
+
+    snprintf(measureLabel, sizeof(measureLabel), "%s, insert %llu", label, count);
+    Benchmark::Measure(measureLabel, iterations, [&] {
+        MapType map;
+        for (uint64 i = 0; i < count; i++) {
+            map[GetKey(i)].Data[0] = i;
+        }
+        Benchmark::DoNotOptimize(map);
+    });
+
+    MapType map;
+    for (uint64 i = 0; i < count; i++) {
+        map[GetKey(i)].Data[0] = i;
+    }
+
+    // Half of the lookups miss.
+    snprintf(measureLabel, sizeof(measureLabel), "%s, find %llu", label, count);
+    Benchmark::Measure(measureLabel, iterations, [&] {
+        uint64 sum = 0;
+        for (uint64 i = 0; i < count; i++) {
+            const Value* value = find(map, GetKey(i * 2));
+            sum += value ? value->Data[0] : 0;
+        }
+        Benchmark::DoNotOptimize(sum);
+    });
+
+    snprintf(measureLabel, sizeof(measureLabel), "%s, iterate %llu", label, count);
+    Benchmark::Measure(measureLabel, iterations, [&] { Benchmark::DoNotOptimize(iterate(map)); });
+}
+
+/**
+ * std::unordered_map::operator[] shaped wrapper, so both containers share MeasureMap.
+ */
+struct EngineMap : TMap<uint64, Value>
+{
+    Value& operator[](uint64 key) { return FindOrAdd(key); }
+};
+
+} // namespace BenchMap
+
+AE_BENCHMARK("[TMap] Insert, find and iterate")
+{
+    for (uint64 count = 1000; count <= 10000000; count *= 10) {
+        BenchMap::MeasureMap<BenchMap::EngineMap>(
+          "TMap", count, [](BenchMap::EngineMap& map, uint64 key) { return map.Find(key); },
+          [](BenchMap::EngineMap& map) {
+              uint64 sum = 0;
+              for (const TMapEntry<uint64, BenchMap::Value>& entry : map) {
+                  sum += entry.Value.Data[0];
+              }
+              return sum;
+          });
+
+        BenchMap::MeasureMap<std::unordered_map<uint64, BenchMap::Value>>(
+          "std::unordered_map", count,
+          [](std::unordered_map<uint64, BenchMap::Value>& map, uint64 key) {
+              auto it = map.find(key);
+              return it != map.end() ? &it->second : nullptr;
+          },
+          [](std::unordered_map<uint64, BenchMap::Value>& map) {
+              uint64 sum = 0;
+              for (const auto& entry : map) {
+                  sum += entry.second.Data[0];
+              }
+              return sum;
+          });
+    }
+}
@@ -0,0 +1,409 @@
+#pragma once
+
+#include "Benchmark.h"
+#include "Containers/Array.h"
+#include "Memory/Allocators/ConcurrentLinearAllocator.h"
+#include "Memory/Allocators/DynamicAllocator.h"
+#include "Memory/Allocators/ObjectPool.h"
+#include "Memory/MemoryUtils.h"
+#include "Serialization/MemoryWriter.h"
+#include <thread>
+
+#if defined(__linux__)
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+namespace BenchMemory {
+
+constexpr uint32 BlockCount = 1024;
+
+/**
+ * Allocates and frees BlockCount blocks with sizes spread over the small size classes.
+ */
+template<class AllocateFunctionType, class FreeFunctionType>
+void
+AllocateAndFree(AllocateFunctionType&& allocate, FreeFunctionType&& free)
+{
+    void* blocks[BlockCount];
+    for (uint32 i = 0; i < BlockCount; i++) {
+        blocks[i] = allocate(16 + (i * 37) % 1024);
+    }
+    for (uint32 i = 0; i < BlockCount; i += 2) {
+        free(blocks[i]);
+    }
+    for (uint32 i = 0; i < BlockCount; i += 2) {
+        blocks[i] = allocate(16 + (i * 91) % 512);
+    }
+    for (uint32 i = 0; i < BlockCount; i++) {
+        free(blocks[i]);
+    }
+}
+
+void
+AllocateAndFreeAligned()
+{
+    AllocateAndFree([](uint64 size) { return MemoryUtils::AllocateAligned(size); }, [](void* memory) { MemoryUtils::FreeAligned(memory); });
+}
+
+void
+AllocateAndFreeDefault()
+{
+    AllocateAndFree([](uint64 size) { return static_cast<void*>(new uint8[size]); },
+                    [](void* memory) { delete[] reinterpret_cast<uint8*>(memory); });
+}
+
+template<class FunctionType>
+void
+MeasureThreads(const char* label, uint32 threadCount, uint64 iterations, FunctionType function)
+{
+    char threadLabel[128];
+    snprintf(threadLabel, sizeof(threadLabel), "%s, %u threads", label, threadCount);
+
+    Benchmark::Measure(threadLabel, 1, [&] {
+        std::thread threads[64];
+        for (uint32 i = 0; i < threadCount; i++) {
+            threads[i] = std::thread([&] {
+                for (uint64 j = 0; j < iterations; j++) {
+                    function();
+                }
+            });
+        }
+        for (uint32 i = 0; i < threadCount; i++) {
+            threads[i].join();
+        }
+    });
+}
+
+/**
+ * Counts the data TLB read misses of the calling thread, when the platform allows it.
+ */
+class TlbMissCounter
+{
+  public:
+    TlbMissCounter()
+    {
+#if defined(__linux__)
+        perf_event_attr attributes {};
+        attributes.type           = PERF_TYPE_HW_CACHE;
+        attributes.size           = sizeof(attributes);
+        attributes.config         = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        attributes.disabled       = 1;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv     = 1;
+
+        m_descriptor = static_cast<int32>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+        if (m_descriptor >= 0) {
+            ioctl(m_descriptor, PERF_EVENT_IOC_RESET, 0);
+            ioctl(m_descriptor, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    ~TlbMissCounter()
+    {
+#if defined(__linux__)
+        if (m_descriptor >= 0) {
+            close(m_descriptor);
+        }
+#endif
+    }
+
+    void Print(const char* label) const
+    {
+        uint64 misses = 0;
+#if defined(__linux__)
+        if (m_descriptor >= 0) {
+            ioctl(m_descriptor, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(m_descriptor, &misses, sizeof(misses)) == sizeof(misses)) {
+                printf("    %-48s %14llu dTLB misses\n", label, misses);
+                return;
+            }
+        }
+#endif
+        printf("    %-48s %14s dTLB misses\n", label, "n/a");
+    }
+
+  private:
+    int32 m_descriptor = -1;
+};
+
+template<class ArrayType>
+void
+MeasureRandomAccess(const char* label, ArrayType& items)
+{
+    constexpr uint64 reads = 16 * 1024 * 1024;
+
+    const uint64 mask = items.GetSize() - 1;
+
+    TlbMissCounter counter;
+    Benchmark::Measure(label, 1, [&] {
+        uint64 index = 0;
+        uint64 sum   = 0;
+        for (uint64 i = 0; i < reads; i++) {
+            index = (index * 6364136223846793005ull + 1442695040888963407ull);
+            sum += items[(index >> 17) & mask];
+        }
+        Benchmark::DoNotOptimize(sum);
+    });
+    counter.Print(label);
+}
+
+struct Particle
+{
+    float Position[3];
+    float Velocity[3];
+    float Color[4];
+    float Age;
+
+    Particle(float age)
+      : Position {}
+      , Velocity {}
+      , Color {}
+      , Age(age)
+    {}
+};
+
+/**
+ * Allocates and frees BlockCount particles in an interleaved order.
+ */
+template<class AllocateFunctionType, class FreeFunctionType>
+void
+AllocateAndFreeParticles(AllocateFunctionType&& allocate, FreeFunctionType&& free)
+{
+    Particle* particles[BlockCount];
+    for (uint32 i = 0; i < BlockCount; i++) {
+        particles[i] = allocate(float(i));
+    }
+    for (uint32 i = 0; i < BlockCount; i += 2) {
+        free(particles[i]);
+    }
+    for (uint32 i = 0; i < BlockCount; i += 2) {
+        particles[i] = allocate(float(i));
+    }
+    for (uint32 i = 0; i < BlockCount; i++) {
+        free(particles[i]);
+    }
+}
+
+/**
+ * Recursive call chain needing a scratch buffer of size floats at every level.
+ */
+template<class ScratchFunctionType>
+float
+SumScratch(uint32 depth, uint32 size, ScratchFunctionType&& scratch)
+{
+    return scratch(size, [depth, size, &scratch](float* buffer) {
+        for (uint32 i = 0; i < size; i++) {
+            buffer[i] = float(i * depth);
+        }
+
+        float sum = depth > 1 ? SumScratch(depth - 1, size, scratch) : 0.0f;
+        for (uint32 i = 0; i < size; i += 16) {
+            sum += buffer[i];
+        }
+        return sum;
+    });
+}
+
+constexpr uint32 JobOutputCount = 16 * 1024;
+
+/**
+ * Every thread allocates JobOutputCount blocks of job output, the blocks are freed by the
+ * function once every thread is done, like the end of a frame.
+ */
+template<class AllocateFunctionType, class EndFrameFunctionType>
+void
+MeasureJobOutput(const char* label, uint32 threadCount, AllocateFunctionType&& allocate, EndFrameFunctionType&& endFrame)
+{
+    char threadLabel[128];
+    snprintf(threadLabel, sizeof(threadLabel), "%s, %u threads", label, threadCount);
+
+    static void* blocks[64][JobOutputCount];
+
+    Benchmark::Measure(threadLabel, 20, [&] {
+        std::thread threads[64];
+        for (uint32 i = 0; i < threadCount; i++) {
+            threads[i] = std::thread([&, i] {
+                for (uint32 j = 0; j < JobOutputCount; j++) {
+                    uint8* memory = reinterpret_cast<uint8*>(allocate(16 + (j * 37) % 1024));
+                    memory[0]     = uint8(j);
+                    blocks[i][j]  = memory;
+                }
+            });
+        }
+        for (uint32 i = 0; i < threadCount; i++) {
+            threads[i].join();
+        }
+
+        endFrame(blocks, threadCount);
+    });
+}
+
+} // namespace BenchMemory
+
+AE_BENCHMARK("[MemoryUtils] AllocateAligned")
+{
+    constexpr uint64 iterations = 2000;
+
+    Benchmark::Measure("MemoryUtils::AllocateAligned, 1536 blocks", iterations, BenchMemory::AllocateAndFreeAligned);
+    Benchmark::Measure("new[]/delete[], 1536 blocks", iterations, BenchMemory::AllocateAndFreeDefault);
+
+    const uint32 hardwareThreads = std::thread::hardware_concurrency();
+    const uint32 maxThreads      = hardwareThreads < 2 ? 2 : (hardwareThreads > 64 ? 64 : hardwareThreads);
+    for (uint32 threads = 1; threads <= maxThreads; threads *= 2) {
+        BenchMemory::MeasureThreads("MemoryUtils::AllocateAligned", threads, iterations, BenchMemory::AllocateAndFreeAligned);
+        BenchMemory::MeasureThreads("new[]/delete[]", threads, iterations, BenchMemory::AllocateAndFreeDefault);
+    }
+}
+
+AE_BENCHMARK("[MemoryUtils] ReallocateAligned")
+{
+    constexpr uint64 maxSize = 256ull * 1024 * 1024;
+
+    Benchmark::Measure("MemoryUtils::ReallocateAligned, x2 to 256 MB", 4, [] {
+        void* memory = MemoryUtils::AllocateAligned(64 * 1024);
+        for (uint64 size = 64 * 1024; size < maxSize; size *= 2) {
+            memset(memory, 1, size);
+            memory = MemoryUtils::ReallocateAligned(memory, size, size * 2);
+        }
+        MemoryUtils::FreeAligned(memory);
+    });
+
+    Benchmark::Measure("Allocate + copy + free, x2 to 256 MB", 4, [] {
+        void* memory = MemoryUtils::AllocateAligned(64 * 1024);
+        for (uint64 size = 64 * 1024; size < maxSize; size *= 2) {
+            memset(memory, 1, size);
+            void* grown = MemoryUtils::AllocateAligned(size * 2);
+            MemoryUtils::CopyMemory(grown, memory, size);
+            MemoryUtils::FreeAligned(memory);
+            memory = grown;
+        }
+        MemoryUtils::FreeAligned(memory);
+    });
+
+    Benchmark::Measure("MemoryWriter, 256 MB in 4 KB writes", 4, [] {
+        static uint8 chunk[4096] = {};
+
+        TArray<uint8> buffer;
+        MemoryWriter  writer(buffer);
+        for (uint64 size = 0; size < maxSize; size += sizeof(chunk)) {
+            writer.Serialize(chunk, sizeof(chunk), "", "");
+        }
+        Benchmark::DoNotOptimize(buffer);
+    });
+}
+
+AE_BENCHMARK("[TArray] Huge page allocator")
+{
+    constexpr uint64 count = 64ull * 1024 * 1024;
+
+    {
+        TArray<uint64> items;
+        items.Resize(count);
+        memset(items.GetData(), 1, count * sizeof(uint64));
+
+        BenchMemory::MeasureRandomAccess("THeapAllocator, 16M random reads over 512 MB", items);
+    }
+
+    {
+        TArray<uint64, THugePageAllocator<>> items;
+        items.Resize(count);
+        memset(items.GetData(), 1, count * sizeof(uint64));
+
+        BenchMemory::MeasureRandomAccess("THugePageAllocator, 16M random reads over 512 MB", items);
+    }
+
+    Benchmark::Measure("THeapAllocator, Add 64M items", 1, [] {
+        TArray<uint64> items;
+        for (uint64 i = 0; i < count; i++) {
+            items.Add(i);
+        }
+        Benchmark::DoNotOptimize(items);
+    });
+
+    Benchmark::Measure("THugePageAllocator, Add 64M items", 1, [] {
+        TArray<uint64, THugePageAllocator<>> items;
+        for (uint64 i = 0; i < count; i++) {
+            items.Add(i);
+        }
+        Benchmark::DoNotOptimize(items);
+    });
+}
+
+AE_BENCHMARK("[TObjectPool]")
+{
+    constexpr uint64 iterations = 10000;
+
+    Benchmark::Measure("new/delete, 1536 particles", iterations, [] {
+        BenchMemory::AllocateAndFreeParticles([](float age) { return new BenchMemory::Particle(age); },
+                                              [](BenchMemory::Particle* particle) { delete particle; });
+    });
+
+    TObjectPool<BenchMemory::Particle> pool;
+    Benchmark::Measure("TObjectPool, 1536 particles", iterations, [&pool] {
+        BenchMemory::AllocateAndFreeParticles([&pool](float age) { return pool.Allocate(age); },
+                                              [&pool](BenchMemory::Particle* particle) { pool.Free(particle); });
+    });
+
+    TObjectPool<BenchMemory::Particle, true> sharedPool;
+    Benchmark::Measure("Thread safe TObjectPool, 1536 particles", iterations, [&sharedPool] {
+        BenchMemory::AllocateAndFreeParticles([&sharedPool](float age) { return sharedPool.Allocate(age); },
+                                              [&sharedPool](BenchMemory::Particle* particle) { sharedPool.Free(particle); });
+    });
+
+    TObjectPool<BenchMemory::Particle, true>::ThreadCache cache(sharedPool);
+    Benchmark::Measure("TObjectPool::ThreadCache, 1536 particles", iterations, [&cache] {
+        BenchMemory::AllocateAndFreeParticles([&cache](float age) { return cache.Allocate(age); },
+                                              [&cache](BenchMemory::Particle* particle) { cache.Free(particle); });
+    });
+}
+AE_BENCHMARK("[TDynamicAllocator] Scratch buffers")
+{
+    constexpr uint64 iterations = 100000;
+    constexpr uint32 depth      = 8;
+    constexpr uint32 size       = 256;
+
+    Benchmark::Measure("TArray, 8 nested scratch buffers", iterations, [] {
+        Benchmark::DoNotOptimize(BenchMemory::SumScratch(depth, size, [](uint32 count, auto&& function) {
+            TArray<float> buffer;
+            buffer.Resize(count);
+            return function(buffer.GetData());
+        }));
+    });
+
+    Benchmark::Measure("TDynamicAllocator, 8 nested scratch buffers", iterations, [] {
+        Benchmark::DoNotOptimize(BenchMemory::SumScratch(depth, size, [](uint32 count, auto&& function) {
+            TDynamicAllocator<float, uint32>::ScopedMarker scope;
+            return function(TDynamicAllocator<float, uint32>::GetThreadAllocator().Allocate(count));
+        }));
+    });
+}
+
+AE_BENCHMARK("[ConcurrentLinearAllocator] Job output")
+{
+    ConcurrentLinearAllocator allocator(1024ull * 1024 * 1024);
+
+    const auto resetAllocator = [&allocator](void*[][BenchMemory::JobOutputCount], uint32) { allocator.Reset(); };
+    const auto freeBlocks     = [](void* blocks[][BenchMemory::JobOutputCount], uint32 threadCount) {
+        for (uint32 i = 0; i < threadCount; i++) {
+            for (uint32 j = 0; j < BenchMemory::JobOutputCount; j++) {
+                MemoryUtils::FreeAligned(blocks[i][j]);
+            }
+        }
+    };
+
+    const uint32 hardwareThreads = std::thread::hardware_concurrency();
+    const uint32 maxThreads      = hardwareThreads < 2 ? 2 : (hardwareThreads > 64 ? 64 : hardwareThreads);
+    for (uint32 threads = 1; threads <= maxThreads; threads *= 2) {
+        BenchMemory::MeasureJobOutput(
+          "ConcurrentLinearAllocator", threads, [&allocator](uint64 size) { return allocator.Allocate(size); }, resetAllocator);
+        BenchMemory::MeasureJobOutput(
+          "ConcurrentLinearAllocator shared cursor", threads, [&allocator](uint64 size) { return allocator.AllocateShared(size); },
+          resetAllocator);
+        BenchMemory::MeasureJobOutput(
+          "MemoryUtils::AllocateAligned", threads, [](uint64 size) { return MemoryUtils::AllocateAligned(size); }, freeBlocks);
+    }
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "Benchmark.h"
+#include "Containers/Map.h"
+#include "Misc/Name.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace BenchName {
+
+constexpr uint32 Count = 1000;
+
+/**
+ * Asset path sized identifiers, long enough that comparing their texts is not free.
+ */
+inline std::string
+GetText(uint32 index)
+{
+    return "/Game/Characters/Knight/Animations/Attack_" + std::to_string(index);
+}
+
+} // namespace BenchName
+
+AE_BENCHMARK("[Name] Intern, compare and look up")
+{
+    using namespace BenchName;
+
+    constexpr uint64 iterations = 2000;
+
+    std::vector<std::string> texts;
+    std::vector<Name>        names;
+    for (uint32 i = 0; i < Count; i++) {
+        texts.push_back(GetText(i));
+        names.push_back(Name(reinterpret_cast<const tchar*>(texts[i].c_str())));
+    }
+
+    Benchmark::Measure("Name, intern 1000 existing", iterations, [&] {
+        uint64 sum = 0;
+        for (const std::string& text : texts) {
+            sum += Name(reinterpret_cast<const tchar*>(text.c_str()), static_cast<uint32>(text.size())).GetId();
+        }
+        Benchmark::DoNotOptimize(sum);
+    });
+
+    Benchmark::Measure("Name, compare 1000", iterations, [&] {
+        uint64 equal = 0;
+        for (uint32 i = 0; i < Count; i++) {
+            equal += names[i] == names[(i * 7) % Count];
+        }
+        Benchmark::DoNotOptimize(equal);
+    });
+
+    Benchmark::Measure("std::string, compare 1000", iterations, [&] {
+        uint64 equal = 0;
+        for (uint32 i = 0; i < Count; i++) {
+            equal += texts[i] == texts[(i * 7) % Count];
+        }
+        Benchmark::DoNotOptimize(equal);
+    });
+
+    TMap<Name, uint32>                      nameMap;
+    std::unordered_map<std::string, uint32> textMap;
+    for (uint32 i = 0; i < Count; i++) {
+        nameMap.Add(names[i], i);
+        textMap[texts[i]] = i;
+    }
+
+    Benchmark::Measure("TMap<Name>, find 1000", iterations, [&] {
+        uint64 sum = 0;
+        for (const Name& name : names) {
+            sum += *nameMap.Find(name);
+        }
+        Benchmark::DoNotOptimize(sum);
+    });
+
+    Benchmark::Measure("std::unordered_map<std::string>, find 1000", iterations, [&] {
+        uint64 sum = 0;
+        for (const std::string& text : texts) {
+            sum += textMap.find(text)->second;
+        }
+        Benchmark::DoNotOptimize(sum);
+    });
+}
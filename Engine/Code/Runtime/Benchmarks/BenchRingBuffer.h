@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Benchmark.h"
+#include "Containers/Deque.h"
+
+#include <deque>
+
+namespace BenchRingBuffer {
+
+/**
+ * Event sized item, queued and then processed in order.
+ */
+struct Event
+{
+    uint32 Type;
+    uint32 Target;
+    uint64 Payload;
+};
+
+} // namespace BenchRingBuffer
+
+AE_BENCHMARK("[TRingBuffer] Event queue")
+{
+    using BenchRingBuffer::Event;
+
+    // Each frame queues a batch of events while the previous ones are processed from the front.
+    constexpr uint32 QueuedCount = 10000;
+    constexpr uint32 FrameCount  = 100000;
+
+    TArray<Event>      array;
+    TRingBuffer<Event> ring;
+    TDeque<Event>      deque;
+    std::deque<Event>  stdDeque;
+    for (uint32 i = 0; i < QueuedCount; i++) {
+        array.Add(Event{ i, i, i });
+        ring.PushBack(Event{ i, i, i });
+        deque.PushBack(Event{ i, i, i });
+        stdDeque.push_back(Event{ i, i, i });
+    }
+
+    Benchmark::Measure("TArray, RemoveAt(0) and Add 1000", 10, [&] {
+        uint64 sum = 0;
+        for (uint32 i = 0; i < 1000; i++) {
+            sum += array[0].Payload;
+            array.RemoveAt(0, 1, false);
+            array.Add(Event{ i, i, i });
+        }
+        Benchmark::DoNotOptimize(sum);
+    });
+
+    Benchmark::Measure("TRingBuffer, PopFront and PushBack 100000", 100, [&] {
+        uint64 sum = 0;
+        for (uint32 i = 0; i < FrameCount; i++) {
+            sum += ring.PopFront().Payload;
+            ring.PushBack(Event{ i, i, i });
+        }
+        Benchmark::DoNotOptimize(sum);
+    });
+
+    Benchmark::Measure("TDeque, PopFront and PushBack 100000", 100, [&] {
+        uint64 sum = 0;
+        for (uint32 i = 0; i < FrameCount; i++) {
+            sum += deque.PopFront().Payload;
+            deque.PushBack(Event{ i, i, i });
+        }
+        Benchmark::DoNotOptimize(sum);
+    });
+
+    Benchmark::Measure("std::deque, pop_front and push_back 100000", 100, [&] {
+        uint64 sum = 0;
+        for (uint32 i = 0; i < FrameCount; i++) {
+            sum += stdDeque.front().Payload;
+            stdDeque.pop_front();
+            stdDeque.push_back(Event{ i, i, i });
+        }
+        Benchmark::DoNotOptimize(sum);
+    });
+
+    Benchmark::Measure("TRingBuffer, iterate 10000", 1000, [&] {
+        uint64 sum = 0;
+        for (const Event& event : ring) {
+            sum += event.Payload;
+        }
+        Benchmark::DoNotOptimize(sum);
+    });
+
+    Benchmark::Measure("TDeque, iterate 10000", 1000, [&] {
+        uint64 sum = 0;
+        for (const Event& event : deque) {
+            sum += event.Payload;
+        }
+        Benchmark::DoNotOptimize(sum);
+    });
+}
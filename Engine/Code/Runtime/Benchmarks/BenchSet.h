@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Benchmark.h"
+#include "Containers/Set.h"
+#include <unordered_set>
+
+namespace BenchSet {
+
+/**
+ * Pseudo-random keys, so neither container benefits from sequential hashes.
+ */
+inline uint64
+GetKey(uint64 index)
+{
+    return (index + 1) * 0xD6E8FEB86659FD93ull;
+}
+
+template<class SetType, class AddFunctionType, class RemoveFunctionType>
+void
+MeasureSet(const char* label, uint64 count, AddFunctionType&& add, RemoveFunctionType&& remove)
+{
+    const uint64 iterations = count < 2000000 ? 2000000 / count : 1;
+
+    char measureLabel[128];
+
+    snprintf(measureLabel, sizeof(measureLabel), "%s, insert %llu", label, count);
+    Benchmark::Measure(measureLabel, iterations, [&] {
+        SetType set;
+        for (uint64 i = 0; i < count; i++) {
+            add(set, GetKey(i));
+        }
+        Benchmark::DoNotOptimize(set);
+    });
+
+    SetType set;
+    for (uint64 i = 0; i < count; i++) {
+        add(set, GetKey(i));
+    }
+
+    // Half of the lookups miss.
+    snprintf(measureLabel, sizeof(measureLabel), "%s, find %llu", label, count);
+    Benchmark::Measure(measureLabel, iterations, [&] {
+        uint64 found = 0;
+        for (uint64 i = 0; i < count; i++) {
+            found += set.count(GetKey(i * 2));
+        }
+        Benchmark::DoNotOptimize(found);
+    });
+
+    snprintf(measureLabel, sizeof(measureLabel), "%s, erase and insert %llu", label, count);
+    Benchmark::Measure(measureLabel, iterations, [&] {
+        for (uint64 i = 0; i < count; i++) {
+            remove(set, GetKey(i));
+            add(set, GetKey(i));
+        }
+    });
+}
+
+/**
+ * std::unordered_set::count shaped wrapper, so both containers share MeasureSet.
+ */
+struct EngineSet : TSet<uint64>
+{
+    uint64 count(uint64 key) const { return Contains(key) ? 1 : 0; }
+};
+
+} // namespace BenchSet
+
+AE_BENCHMARK("[TSet] Insert, find and erase")
+{
+    for (uint64 count = 1000; count <= 10000000; count *= 10) {
+        BenchSet::MeasureSet<BenchSet::EngineSet>(
+          "TSet", count, [](BenchSet::EngineSet& set, uint64 key) { set.Add(key); },
+          [](BenchSet::EngineSet& set, uint64 key) { set.Remove(key); });
+
+        BenchSet::MeasureSet<std::unordered_set<uint64>>(
+          "std::unordered_set", count, [](std::unordered_set<uint64>& set, uint64 key) { set.insert(key); },
+          [](std::unordered_set<uint64>& set, uint64 key) { set.erase(key); });
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Benchmark.h"
+#include "Containers/SlotMap.h"
+
+namespace BenchSlotMap {
+
+/**
+ * Entity sized item, iterated by summing one of its fields.
+ */
+struct Entity
+{
+    float  Position[3];
+    float  Velocity[3];
+    uint64 Id;
+};
+
+constexpr uint64 EntityCount = 100000;
+
+} // namespace BenchSlotMap
+
+AE_BENCHMARK("[TSlotMap] Iterate and remove")
+{
+    using BenchSlotMap::Entity;
+    using BenchSlotMap::EntityCount;
+
+    TArray<Entity>                   array;
+    TSlotMap<Entity>                 map;
+    TArray<TSlotMap<Entity>::Handle> handles;
+    for (uint64 i = 0; i < EntityCount; i++) {
+        array.Add(Entity{ {}, {}, i });
+        handles.Add(map.Add(Entity{ {}, {}, i }));
+    }
+
+    Benchmark::Measure("TArray, iterate 100000", 1000, [&] {
+        uint64 sum = 0;
+        for (const Entity& entity : array) {
+            sum += entity.Id;
+        }
+        Benchmark::DoNotOptimize(sum);
+    });
+
+    Benchmark::Measure("TSlotMap, iterate 100000", 1000, [&] {
+        uint64 sum = 0;
+        for (const Entity& entity : map) {
+            sum += entity.Id;
+        }
+        Benchmark::DoNotOptimize(sum);
+    });
+
+    // Removes items from the front half, the worst case for shifting removals.
+    Benchmark::Measure("TArray, RemoveAt and Add 1000", 10, [&] {
+        for (uint64 i = 0; i < 1000; i++) {
+            array.RemoveAt(i * 32, 1, false);
+            array.Add(Entity{ {}, {}, i });
+        }
+    });
+
+    Benchmark::Measure("TSlotMap, Remove and Add 1000", 10, [&] {
+        for (uint64 i = 0; i < 1000; i++) {
+            map.Remove(handles[i * 32]);
+            handles[i * 32] = map.Add(Entity{ {}, {}, i });
+        }
+    });
+
+    Benchmark::Measure("TSlotMap, Get 100000", 1000, [&] {
+        uint64 sum = 0;
+        for (const TSlotMap<Entity>::Handle& handle : handles) {
+            sum += map.Get(handle)->Id;
+        }
+        Benchmark::DoNotOptimize(sum);
+    });
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Benchmark.h"
+#include "Containers/SoAArray.h"
+
+namespace BenchSoAArray {
+
+struct Vector
+{
+    float X, Y, Z;
+};
+
+/**
+ * Particle stored as a structure, every pass loads all of its fields.
+ */
+struct Particle
+{
+    Vector Position;
+    Vector Velocity;
+    Vector Color;
+    float  Lifetime;
+    float  Size;
+    uint32 Flags;
+};
+
+constexpr uint32 ParticleCount = 1000000;
+
+} // namespace BenchSoAArray
+
+AE_BENCHMARK("[TSoAArray] Particle passes")
+{
+    using namespace BenchSoAArray;
+
+    constexpr uint64 iterations = 100;
+
+    TArray<Particle>                                        structures;
+    TSoAArray<Vector, Vector, Vector, float, float, uint32> columns;
+    structures.Reserve(ParticleCount);
+    columns.Reserve(ParticleCount);
+    for (uint32 i = 0; i < ParticleCount; i++) {
+        structures.Add(Particle{ { float(i), 0, 0 }, { 1, 1, 1 }, {}, 10.0f, 1.0f, i });
+        columns.Add(Vector{ float(i), 0, 0 }, Vector{ 1, 1, 1 }, Vector{}, 10.0f, 1.0f, i);
+    }
+
+    Benchmark::Measure("TArray<Particle>, age 1000000", iterations, [&] {
+        for (Particle& particle : structures) {
+            particle.Lifetime -= 0.016f;
+        }
+        Benchmark::DoNotOptimize(structures);
+    });
+
+    Benchmark::Measure("TSoAArray, age 1000000", iterations, [&] {
+        for (float& lifetime : columns.GetColumn<3>()) {
+            lifetime -= 0.016f;
+        }
+        Benchmark::DoNotOptimize(columns);
+    });
+
+    Benchmark::Measure("TArray<Particle>, integrate 1000000", iterations, [&] {
+        for (Particle& particle : structures) {
+            particle.Position.X += particle.Velocity.X * 0.016f;
+            particle.Position.Y += particle.Velocity.Y * 0.016f;
+            particle.Position.Z += particle.Velocity.Z * 0.016f;
+        }
+        Benchmark::DoNotOptimize(structures);
+    });
+
+    Benchmark::Measure("TSoAArray, integrate 1000000", iterations, [&] {
+        TSpan<Vector> positions  = columns.GetColumn<0>();
+        TSpan<Vector> velocities = columns.GetColumn<1>();
+        for (uint32 i = 0; i < ParticleCount; i++) {
+            positions[i].X += velocities[i].X * 0.016f;
+            positions[i].Y += velocities[i].Y * 0.016f;
+            positions[i].Z += velocities[i].Z * 0.016f;
+        }
+        Benchmark::DoNotOptimize(columns);
+    });
+}
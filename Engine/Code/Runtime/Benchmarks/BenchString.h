@@ -0,0 +1,173 @@
+#pragma once
+
+#include "Benchmark.h"
+#include "Containers/AnvilString.h"
+#include "Containers/Array.h"
+#include "Containers/StringUtils.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace BenchString {
+
+/**
+ * Identifier-length names, the typical content of engine strings.
+ */
+inline const tchar* const Names[] = {
+    ATEXT("PlayerController"), ATEXT("MainCamera"), ATEXT("DirectionalLight_0"), ATEXT("Terrain.Chunk_12_7"),
+    ATEXT("Maçã_Verde"),       ATEXT("Weapon_Sword"), ATEXT("UI/HUD/HealthBar"),   ATEXT("SkeletalMesh_Knight"),
+};
+
+constexpr uint32 NameCount = sizeof(Names) / sizeof(Names[0]);
+constexpr uint32 Count     = 1000;
+
+/**
+ * std::string does not know its number of code points, it decodes the text every time.
+ */
+inline uint64
+CountCodePoints(const std::string& text)
+{
+    uint64 count = 0;
+    for (char c : text) {
+        count += (static_cast<uint8>(c) & 0xC0) != 0x80;
+    }
+    return count;
+}
+
+} // namespace BenchString
+
+AE_BENCHMARK("[String] Identifier-length strings")
+{
+    using namespace BenchString;
+
+    constexpr uint64 iterations = 2000;
+
+    Benchmark::Measure("String, construct 1000", iterations, [] {
+        for (uint32 i = 0; i < Count; i++) {
+            String name(Names[i % NameCount]);
+            Benchmark::DoNotOptimize(name);
+        }
+    });
+
+    Benchmark::Measure("std::string, construct 1000", iterations, [] {
+        for (uint32 i = 0; i < Count; i++) {
+            std::string name(reinterpret_cast<const char*>(Names[i % NameCount]));
+            Benchmark::DoNotOptimize(name);
+        }
+    });
+
+    TArray<String>           names;
+    std::vector<std::string> stdNames;
+    for (uint32 i = 0; i < Count; i++) {
+        names.Add(String(Names[i % NameCount]));
+        stdNames.push_back(reinterpret_cast<const char*>(Names[i % NameCount]));
+    }
+
+    Benchmark::Measure("String, copy 1000", iterations, [&] {
+        TArray<String> copy = names;
+        Benchmark::DoNotOptimize(copy);
+    });
+
+    Benchmark::Measure("std::string, copy 1000", iterations, [&] {
+        std::vector<std::string> copy = stdNames;
+        Benchmark::DoNotOptimize(copy);
+    });
+
+    Benchmark::Measure("String, move 1000", iterations, [&] {
+        for (uint32 i = 0; i + 1 < Count; i++) {
+            String moved = std::move(names[i]);
+            names[i]     = std::move(names[i + 1]);
+            names[i + 1] = std::move(moved);
+        }
+    });
+
+    Benchmark::Measure("std::string, move 1000", iterations, [&] {
+        for (uint32 i = 0; i + 1 < Count; i++) {
+            std::string moved = std::move(stdNames[i]);
+            stdNames[i]       = std::move(stdNames[i + 1]);
+            stdNames[i + 1]   = std::move(moved);
+        }
+    });
+
+    Benchmark::Measure("String, compare 1000", iterations, [&] {
+        uint64 equal = 0;
+        for (uint32 i = 0; i + 1 < Count; i++) {
+            equal += names[i] == names[i + 1];
+        }
+        Benchmark::DoNotOptimize(equal);
+    });
+
+    Benchmark::Measure("std::string, compare 1000", iterations, [&] {
+        uint64 equal = 0;
+        for (uint32 i = 0; i + 1 < Count; i++) {
+            equal += stdNames[i] == stdNames[i + 1];
+        }
+        Benchmark::DoNotOptimize(equal);
+    });
+
+    Benchmark::Measure("String, length 1000", iterations, [&] {
+        uint64 length = 0;
+        for (const String& name : names) {
+            length += name.GetLength();
+        }
+        Benchmark::DoNotOptimize(length);
+    });
+
+    Benchmark::Measure("std::string, length 1000", iterations, [&] {
+        uint64 length = 0;
+        for (const std::string& name : stdNames) {
+            length += CountCodePoints(name);
+        }
+        Benchmark::DoNotOptimize(length);
+    });
+}
+
+AE_BENCHMARK("[StringUtils] Format vs snprintf")
+{
+    using namespace BenchString;
+
+    constexpr uint64 iterations = 200;
+
+    tchar buffer[256];
+
+    Benchmark::Measure("StringUtils::FormatTo, 1000 log lines", iterations, [&] {
+        uint64 size = 0;
+        for (uint32 i = 0; i < Count; i++) {
+            size += StringUtils::FormatTo(buffer, sizeof(buffer), ATEXT("[{}] {} moved to ({:.2f}, {:.2f}) in {} ms"), i, Names[i % NameCount],
+                                          i * 0.75, i * -1.25, i * 0.1f);
+        }
+        Benchmark::DoNotOptimize(size);
+    });
+
+    Benchmark::Measure("snprintf, 1000 log lines", iterations, [&] {
+        uint64 size = 0;
+        for (uint32 i = 0; i < Count; i++) {
+            size += snprintf(reinterpret_cast<char*>(buffer), sizeof(buffer), "[%u] %s moved to (%.2f, %.2f) in %g ms", i,
+                             reinterpret_cast<const char*>(Names[i % NameCount]), i * 0.75, i * -1.25, double(i * 0.1f));
+        }
+        Benchmark::DoNotOptimize(size);
+    });
+
+    Benchmark::Measure("StringUtils::FloatToChars, 1000 doubles", iterations, [&] {
+        uint64 size = 0;
+        for (uint32 i = 0; i < Count; i++) {
+            size += StringUtils::FloatToChars(buffer, i * 1.1 + 0.001);
+        }
+        Benchmark::DoNotOptimize(size);
+    });
+
+    Benchmark::Measure("snprintf %.17g, 1000 doubles", iterations, [&] {
+        uint64 size = 0;
+        for (uint32 i = 0; i < Count; i++) {
+            size += snprintf(reinterpret_cast<char*>(buffer), sizeof(buffer), "%.17g", i * 1.1 + 0.001);
+        }
+        Benchmark::DoNotOptimize(size);
+    });
+
+    Benchmark::Measure("StringUtils::Format, 1000 strings", iterations, [&] {
+        for (uint32 i = 0; i < Count; i++) {
+            String text = StringUtils::Format(ATEXT("{}_{}"), Names[i % NameCount], i);
+            Benchmark::DoNotOptimize(text);
+        }
+    });
+}
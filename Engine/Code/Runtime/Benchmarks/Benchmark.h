@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Types.h"
+#include <chrono>
+#include <cstdio>
+
+namespace Benchmark {
+
+using FunctionType = void (*)();
+
+/**
+ * @brief Registers a benchmark to be run by the benchmark executable.
+*/
+struct Registrar
+{
+    Registrar(const char* name, FunctionType function);
+
+    const char*  Name;
+    FunctionType Function;
+    Registrar*   Next;
+};
+
+/**
+ * @brief Returns the number of allocations made so far.
+ * @return Number of calls to the global operator new, plus the calling thread's
+ * engine allocations when MemoryUtils uses the binned allocator.
+*/
+uint64 GetAllocationCount();
+
+/**
+ * @brief Prevents the compiler from optimizing away a value.
+ * @param value Value to be kept alive.
+*/
+template<class T>
+inline void DoNotOptimize(const T& value)
+{
+#if defined(_MSC_VER)
+    (void)*reinterpret_cast<const volatile char*>(&value);
+#else
+    asm volatile("" : : "g"(&value) : "memory");
+#endif
+}
+
+/**
+ * @brief Runs a function a number of times and prints the elapsed time and allocations per run.
+ * @param label Label printed next to the results.
+ * @param iterations Number of times to run the function.
+ * @param function Function to be measured.
+*/
+template<class MeasuredFunctionType>
+void Measure(const char* label, uint64 iterations, MeasuredFunctionType&& function)
+{
+    const uint64 allocations = GetAllocationCount();
+    const auto   start       = std::chrono::steady_clock::now();
+
+    for (uint64 i = 0; i < iterations; i++) {
+        function();
+    }
+
+    const auto   end     = std::chrono::steady_clock::now();
+    const double elapsed = std::chrono::duration<double, std::nano>(end - start).count();
+    const double allocs  = double(GetAllocationCount() - allocations) / double(iterations);
+
+    printf("    %-48s %14.2f ns/run %10.2f allocs/run\n", label, elapsed / double(iterations), allocs);
+}
+
+} // namespace Benchmark
+
+#define AE_BENCHMARK_CONCAT_IMPL(a, b) a##b
+#define AE_BENCHMARK_CONCAT(a, b)      AE_BENCHMARK_CONCAT_IMPL(a, b)
+
+#define AE_BENCHMARK_IMPL(function, name)                                                    \
+    static void                 function();                                                  \
+    static Benchmark::Registrar AE_BENCHMARK_CONCAT(function, Registrar)(name, function); \
+    static void                 function()
+
+#define AE_BENCHMARK(name) AE_BENCHMARK_IMPL(AE_BENCHMARK_CONCAT(Benchmark_, __COUNTER__), name)
@@ -0,0 +1,345 @@
+#include "Containers/Array.h"
+#include "Containers/ContainersFwd.h"
+#include "Memory/Allocators/BinnedAllocator.h"
+#include "Memory/MemoryTrace.h"
+#include "Memory/PlatformMemory.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+
+#ifndef AE_WINDOWS
+    #include <sys/wait.h>
+    #include <unistd.h>
+#endif
+
+/**
+ * Replays a trace recorded by MemoryTrace against the available allocator backends and
+ * reports their throughput, peak resident size and fragmentation.
+ *
+ * Usage: aeMemoryReplay <trace> [backend name filter]
+ *
+ * Events are replayed on a single thread in the order they were recorded, blocks are
+ * identified by slots resolved when loading the trace so the replay itself does not
+ * need any lookup. Where fork is available every backend is replayed in its own process
+ * so that memory kept by a backend does not hide the resident size of the next one.
+*/
+
+namespace {
+
+struct ReplayOperation
+{
+    EMemoryTraceEvent Type;
+    uint32            Slot;
+    uint64            Size;
+    uint64            Align;
+};
+
+struct ReplayBackend
+{
+    const char* Name;
+    void* (*Allocate)(uint64 size, uint64 align);
+    void* (*Reallocate)(void* memory, uint64 oldSize, uint64 size, uint64 align);
+    void (*Free)(void* memory);
+};
+
+struct ReplayTrace
+{
+    TArray<ReplayOperation> Operations;
+    uint32                  SlotCount {0};
+    uint32                  ThreadCount {0};
+    uint64                  EventCounts[3] {};
+    uint64                  DroppedEvents {0};
+};
+
+struct ReplayResult
+{
+    double NanosecondsPerOperation;
+    uint64 PeakLiveBytes;
+    uint64 PeakResidentBytes;
+    double Fragmentation;
+};
+
+/** Resident size is sampled every SampleInterval operations while measuring memory.*/
+constexpr uint64 SampleInterval = 4096;
+
+void*
+SystemAllocate(uint64 size, uint64 align)
+{
+    size = size ? size : 1;
+#ifdef AE_WINDOWS
+    return _aligned_malloc(size, align);
+#else
+    if (align <= alignof(max_align_t)) {
+        return malloc(size);
+    }
+
+    void* memory = nullptr;
+    return posix_memalign(&memory, align, size) == 0 ? memory : nullptr;
+#endif
+}
+
+void*
+SystemReallocate(void* memory, uint64 oldSize, uint64 size, uint64 align)
+{
+    size = size ? size : 1;
+#ifdef AE_WINDOWS
+    return _aligned_realloc(memory, size, align);
+#else
+    if (align <= alignof(max_align_t)) {
+        return realloc(memory, size);
+    }
+
+    void* result = SystemAllocate(size, align);
+    if (memory) {
+        memcpy(result, memory, oldSize < size ? oldSize : size);
+        free(memory);
+    }
+    return result;
+#endif
+}
+
+void
+SystemFree(void* memory)
+{
+#ifdef AE_WINDOWS
+    _aligned_free(memory);
+#else
+    free(memory);
+#endif
+}
+
+const ReplayBackend gBackends[] = {
+    {"MemoryUtils", &MemoryUtils::AllocateAligned, &MemoryUtils::ReallocateAligned, &MemoryUtils::FreeAligned},
+    {"BinnedAllocator", &BinnedAllocator::Allocate, &BinnedAllocator::Reallocate, &BinnedAllocator::Free},
+    {"System", &SystemAllocate, &SystemReallocate, &SystemFree},
+};
+
+/** Converts the addresses of a trace to slots, events on blocks allocated before the capture began are dropped.*/
+bool
+LoadTrace(const char* path, ReplayTrace& trace)
+{
+    MemoryTraceReader reader;
+    if (!reader.Open(path)) {
+        return false;
+    }
+
+    std::unordered_map<uint64, uint32> slots;
+
+    MemoryTraceEvent event;
+    while (reader.Read(event)) {
+        trace.ThreadCount = event.ThreadId + 1 > trace.ThreadCount ? event.ThreadId + 1 : trace.ThreadCount;
+        trace.EventCounts[static_cast<uint8>(event.Type)]++;
+
+        ReplayOperation operation {event.Type, 0, event.Size, event.Align};
+
+        if (event.Type == EMemoryTraceEvent::Allocate) {
+            operation.Slot        = trace.SlotCount++;
+            slots[event.Address] = operation.Slot;
+        } else {
+            const uint64 address = event.Type == EMemoryTraceEvent::Free ? event.Address : event.OldAddress;
+
+            auto slot = slots.find(address);
+            if (slot == slots.end()) {
+                trace.DroppedEvents++;
+                continue;
+            }
+
+            operation.Slot = slot->second;
+            slots.erase(slot);
+
+            if (event.Type == EMemoryTraceEvent::Reallocate) {
+                slots[event.Address] = operation.Slot;
+            }
+        }
+
+        trace.Operations.Add(operation);
+    }
+
+    return true;
+}
+
+/** Writes a byte to every page of a block, like a program filling it would.*/
+void
+TouchPages(void* memory, uint64 size)
+{
+    uint8* bytes = reinterpret_cast<uint8*>(memory);
+    for (uint64 offset = 0; offset < size; offset += 4096) {
+        bytes[offset] = 1;
+    }
+}
+
+/**
+ * Replays the trace once to measure memory, touching every allocated page, then once
+ * more without touching memory nor sampling to measure the allocator throughput.
+*/
+ReplayResult
+Replay(const ReplayTrace& trace, const ReplayBackend& backend)
+{
+    TArray<void*>  blocks;
+    TArray<uint64> sizes;
+    blocks.Resize(trace.SlotCount);
+    sizes.Resize(trace.SlotCount);
+    memset(blocks.GetData(), 0, trace.SlotCount * sizeof(void*));
+    memset(sizes.GetData(), 0, trace.SlotCount * sizeof(uint64));
+
+    ReplayResult result {};
+
+    const uint64 baseline  = PlatformMemory::GetResidentSize();
+    uint64       liveBytes = 0;
+
+    auto sampleResidentSize = [&]() {
+        const uint64 resident = PlatformMemory::GetResidentSize();
+        const uint64 used     = resident > baseline ? resident - baseline : 0;
+        if (used > result.PeakResidentBytes) {
+            result.PeakResidentBytes = used;
+            result.Fragmentation     = used > liveBytes ? 1.0 - double(liveBytes) / double(used) : 0.0;
+        }
+    };
+
+    for (uint64 i = 0; i < trace.Operations.GetSize(); i++) {
+        const ReplayOperation& operation = trace.Operations[i];
+
+        switch (operation.Type) {
+            case EMemoryTraceEvent::Allocate:
+                blocks[operation.Slot] = backend.Allocate(operation.Size, operation.Align);
+                sizes[operation.Slot]  = operation.Size;
+                liveBytes += operation.Size;
+                TouchPages(blocks[operation.Slot], operation.Size);
+                break;
+            case EMemoryTraceEvent::Reallocate:
+                blocks[operation.Slot] =
+                  backend.Reallocate(blocks[operation.Slot], sizes[operation.Slot], operation.Size, operation.Align);
+                liveBytes += operation.Size - sizes[operation.Slot];
+                sizes[operation.Slot] = operation.Size;
+                TouchPages(blocks[operation.Slot], operation.Size);
+                break;
+            case EMemoryTraceEvent::Free:
+                backend.Free(blocks[operation.Slot]);
+                blocks[operation.Slot] = nullptr;
+                liveBytes -= sizes[operation.Slot];
+                break;
+        }
+
+        result.PeakLiveBytes = liveBytes > result.PeakLiveBytes ? liveBytes : result.PeakLiveBytes;
+        if (i % SampleInterval == 0) {
+            sampleResidentSize();
+        }
+    }
+    sampleResidentSize();
+
+    for (void*& block : blocks) {
+        if (block) {
+            backend.Free(block);
+            block = nullptr;
+        }
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (const ReplayOperation& operation : trace.Operations) {
+        switch (operation.Type) {
+            case EMemoryTraceEvent::Allocate:
+                blocks[operation.Slot] = backend.Allocate(operation.Size, operation.Align);
+                sizes[operation.Slot]  = operation.Size;
+                break;
+            case EMemoryTraceEvent::Reallocate:
+                blocks[operation.Slot] =
+                  backend.Reallocate(blocks[operation.Slot], sizes[operation.Slot], operation.Size, operation.Align);
+                sizes[operation.Slot] = operation.Size;
+                break;
+            case EMemoryTraceEvent::Free:
+                backend.Free(blocks[operation.Slot]);
+                blocks[operation.Slot] = nullptr;
+                break;
+        }
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+
+    for (void* block : blocks) {
+        if (block) {
+            backend.Free(block);
+        }
+    }
+
+    const double elapsed            = std::chrono::duration<double, std::nano>(end - start).count();
+    result.NanosecondsPerOperation = trace.Operations.IsEmpty() ? 0.0 : elapsed / double(trace.Operations.GetSize());
+
+    return result;
+}
+
+/** Replays the trace in a child process when possible.*/
+ReplayResult
+ReplayIsolated(const ReplayTrace& trace, const ReplayBackend& backend)
+{
+#ifndef AE_WINDOWS
+    int32 pipes[2];
+    if (pipe(pipes) == 0) {
+        const pid_t child = fork();
+        if (child == 0) {
+            const ReplayResult result = Replay(trace, backend);
+            _exit(write(pipes[1], &result, sizeof(result)) == sizeof(result) ? EXIT_SUCCESS : EXIT_FAILURE);
+        }
+
+        close(pipes[1]);
+
+        ReplayResult result {};
+        const bool   received = child > 0 && read(pipes[0], &result, sizeof(result)) == sizeof(result);
+        close(pipes[0]);
+
+        if (child > 0) {
+            waitpid(child, nullptr, 0);
+        }
+        if (received) {
+            return result;
+        }
+    }
+#endif
+    return Replay(trace, backend);
+}
+
+} // namespace
+
+int32
+main(int32 argc, char** argv)
+{
+    if (argc < 2) {
+        printf("Usage: %s <trace> [backend name filter]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    ReplayTrace trace;
+    if (!LoadTrace(argv[1], trace)) {
+        printf("Cannot read memory trace %s\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    printf("%s: %llu allocations, %llu reallocations, %llu frees on %u threads, %llu events on unknown blocks dropped\n",
+           argv[1],
+           trace.EventCounts[static_cast<uint8>(EMemoryTraceEvent::Allocate)],
+           trace.EventCounts[static_cast<uint8>(EMemoryTraceEvent::Reallocate)],
+           trace.EventCounts[static_cast<uint8>(EMemoryTraceEvent::Free)],
+           trace.ThreadCount,
+           trace.DroppedEvents);
+
+    printf("    %-24s %12s %16s %16s %14s\n", "Backend", "ns/op", "Peak live MB", "Peak RSS MB", "Fragmentation");
+
+    const char* filter = argc > 2 ? argv[2] : nullptr;
+    for (const ReplayBackend& backend : gBackends) {
+        if (filter && !strstr(backend.Name, filter)) {
+            continue;
+        }
+
+        const ReplayResult result = ReplayIsolated(trace, backend);
+        printf("    %-24s %12.2f %16.2f %16.2f %13.1f%%\n",
+               backend.Name,
+               result.NanosecondsPerOperation,
+               double(result.PeakLiveBytes) / (1024.0 * 1024.0),
+               double(result.PeakResidentBytes) / (1024.0 * 1024.0),
+               result.Fragmentation * 100.0);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,128 @@
+#include "AnvilString.h"
+#include "Math/AnvilMath.h"
+
+#if AE_SSE2
+    #include <emmintrin.h>
+#endif
+
+bool
+Utf8::IsValid(const tchar* text, uint64 size)
+{
+    const uint8* bytes = reinterpret_cast<const uint8*>(text);
+    uint64       i     = 0;
+    while (i < size) {
+#if AE_SSE2
+        // Skips runs of ASCII 16 code units at a time.
+        if (i + 16 <= size && _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i))) == 0) {
+            i += 16;
+            continue;
+        }
+#endif
+        const uint8 lead = bytes[i];
+        if (lead < 0x80) {
+            i++;
+            continue;
+        }
+
+        // The second byte has a narrower range for some leads, rejecting overlong forms, surrogates and values past U+10FFFF.
+        uint64 count;
+        uint8  low  = 0x80;
+        uint8  high = 0xBF;
+        if (lead >= 0xC2 && lead <= 0xDF) {
+            count = 2;
+        } else if (lead >= 0xE0 && lead <= 0xEF) {
+            count = 3;
+            low   = lead == 0xE0 ? 0xA0 : 0x80;
+            high  = lead == 0xED ? 0x9F : 0xBF;
+        } else if (lead >= 0xF0 && lead <= 0xF4) {
+            count = 4;
+            low   = lead == 0xF0 ? 0x90 : 0x80;
+            high  = lead == 0xF4 ? 0x8F : 0xBF;
+        } else {
+            return false;
+        }
+
+        if (i + count > size || bytes[i + 1] < low || bytes[i + 1] > high) {
+            return false;
+        }
+        for (uint64 j = 2; j < count; j++) {
+            if ((bytes[i + j] & 0xC0) != 0x80) {
+                return false;
+            }
+        }
+
+        i += count;
+    }
+
+    return true;
+}
+
+uint64
+Utf8::CountCodePoints(const tchar* text, uint64 size)
+{
+    const uint8* bytes = reinterpret_cast<const uint8*>(text);
+    uint64       count = 0;
+    uint64       i     = 0;
+
+#if AE_SSE2
+    // Every code point has exactly one byte that is not a continuation byte (0x80 to 0xBF).
+    const __m128i continuationLimit = _mm_set1_epi8(static_cast<char>(0xC0));
+    for (; i + 16 <= size; i += 16) {
+        const __m128i block        = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i));
+        const uint32  continuation = static_cast<uint32>(_mm_movemask_epi8(_mm_cmplt_epi8(block, continuationLimit)));
+        count += 16 - Math::PopCount(continuation);
+    }
+#endif
+
+    for (; i < size; i++) {
+        count += (bytes[i] & 0xC0) != 0x80;
+    }
+
+    return count;
+}
+
+String&
+String::Append(const tchar* text, uint32 size)
+{
+    if (size == 0) {
+        return *this;
+    }
+
+    AE_ASSERT(text);
+    AE_ASSERT(Utf8::IsValid(text, size));
+
+    const uint32 newSize = m_size + size;
+    if (newSize > GetCapacity()) {
+        // The text may be part of this string, so it is kept alive until it is copied.
+        const tchar* oldData = GetData();
+        if (text >= oldData && text < oldData + m_size) {
+            String copy(*this);
+            copy.Append(text, size);
+            return *this = std::move(copy);
+        }
+
+        Grow(newSize > GetCapacity() + GetCapacity() / 2 ? newSize : GetCapacity() + GetCapacity() / 2);
+    }
+
+    tchar* data = GetMutableData();
+    memmove(data + m_size, text, size);
+    data[newSize] = 0;
+
+    m_length += static_cast<uint32>(Utf8::CountCodePoints(text, size));
+    m_size = newSize;
+
+    return *this;
+}
+
+void
+String::Grow(uint32 size)
+{
+    tchar* data = reinterpret_cast<tchar*>(MemoryUtils::AllocateAligned(static_cast<uint64>(size) + 1, MemoryUtils::DefaultAlignment));
+    memcpy(data, GetData(), static_cast<uint64>(m_size) + 1);
+
+    Release();
+
+    m_heap.Data     = data;
+    m_heap.Capacity = size;
+    m_onHeap        = 1;
+}
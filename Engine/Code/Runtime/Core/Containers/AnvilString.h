@@ -0,0 +1,319 @@
+#pragma once
+
+#include "Memory/MemoryUtils.h"
+#include "Misc/StdHash.h"
+#include <string_view>
+
+/**
+ * @brief UTF-8 helpers, vectorized with SSE2 when available.
+*/
+class Utf8
+{
+  public:
+    /**
+     * @brief Checks if a range of code units is well formed UTF-8.
+     * Overlong encodings, surrogates and code points above U+10FFFF are rejected.
+     * @param text Code units to check.
+     * @param size Number of code units.
+     * @return True if the range is valid UTF-8.
+    */
+    static bool IsValid(const tchar* text, uint64 size);
+
+    /**
+     * @brief Counts the code points of a range of valid UTF-8 code units.
+     * @param text Code units to count.
+     * @param size Number of code units.
+     * @return The number of code points.
+    */
+    static uint64 CountCodePoints(const tchar* text, uint64 size);
+};
+
+/** Non owning range of UTF-8 code units, which need not be null terminated.*/
+using StringView = std::basic_string_view<tchar>;
+
+/**
+ * @brief Null terminated UTF-8 string.
+ * Strings of up to InlineCapacity code units are stored inside the object, longer
+ * strings on the heap. The number of code points is computed when the text changes,
+ * so GetLength does not decode the text. Moving a string never allocates.
+*/
+class String
+{
+  public:
+    static constexpr uint32 InlineCapacity = 23;
+
+    /**
+     * @brief Default constructor, an empty string allocates no memory.
+    */
+    String()
+      : m_size(0)
+      , m_length(0)
+      , m_onHeap(0)
+    {
+        m_inline[0] = 0;
+    }
+
+    /**
+     * @brief Constructs a string from a null terminated text.
+     * @param text Valid UTF-8 text, can be null.
+    */
+    String(const tchar* text)
+      : String(text, GetTextSize(text))
+    {}
+
+    /**
+     * @brief Constructs a string from a range of code units.
+     * @param text Valid UTF-8 code units.
+     * @param size Number of code units.
+    */
+    String(const tchar* text, uint32 size)
+      : String()
+    {
+        Append(text, size);
+    }
+
+    /**
+     * @brief Copy constructor.
+     * @param other String to be copied.
+    */
+    String(const String& other)
+      : String()
+    {
+        Append(other);
+    }
+
+    /**
+     * @brief Move constructor, steals the heap text or copies the inline text.
+     * @param other String to be moved, left empty.
+    */
+    String(String&& other) noexcept
+    {
+        memcpy(static_cast<void*>(this), &other, sizeof(String));
+        other.Forget();
+    }
+
+    ~String() { Release(); }
+
+    String& operator=(const String& other)
+    {
+        if (this != &other) {
+            Clear();
+            Append(other);
+        }
+        return *this;
+    }
+
+    String& operator=(String&& other) noexcept
+    {
+        if (this != &other) {
+            Release();
+            memcpy(static_cast<void*>(this), &other, sizeof(String));
+            other.Forget();
+        }
+        return *this;
+    }
+
+    String& operator=(const tchar* text)
+    {
+        // The text may be part of this string.
+        *this = String(text);
+        return *this;
+    }
+
+    /**
+     * @brief Returns the number of code units, null terminator included.
+     * @return The number of code units, 0 for an empty string.
+    */
+    uint32 GetSize() const { return m_size ? m_size + 1 : 0; }
+
+    /**
+     * @brief Returns the number of code points, without decoding the text.
+     * @return The number of code points.
+    */
+    uint32 GetLength() const { return m_length; }
+
+    /**
+     * @brief Returns the size in bytes of the text, null terminator included.
+     * @return Size in bytes, 0 for an empty string.
+    */
+    uint64 GetSizeInBytes() const { return static_cast<uint64>(GetSize()) * sizeof(tchar); }
+
+    /**
+     * @brief Returns the number of code units the string can hold without allocating.
+     * @return Capacity in code units, null terminator excluded.
+    */
+    uint32 GetCapacity() const { return m_onHeap ? m_heap.Capacity : InlineCapacity; }
+
+    /**
+     * @brief Checks if the string is empty.
+     * @return True if the string is empty, false otherwise.
+    */
+    bool IsEmpty() const { return m_size == 0; }
+
+    /**
+     * @brief Returns the null terminated text.
+     * @return Pointer to the first code unit.
+    */
+    const tchar* GetData() const { return m_onHeap ? m_heap.Data : m_inline; }
+
+    /**
+     * @brief Returns the null terminated text, usable wherever a C string is expected.
+     * @return Pointer to the first code unit.
+    */
+    const tchar* operator*() const { return GetData(); }
+
+    /**
+     * @brief Returns a view of the text.
+     * @return View of the code units, null terminator excluded.
+    */
+    StringView GetView() const { return StringView(GetData(), m_size); }
+
+    /**
+     * @brief Returns a code unit.
+     * @param index Index of the code unit.
+     * @return The code unit.
+    */
+    tchar operator[](uint32 index) const
+    {
+        AE_ASSERT(index < m_size);
+        return GetData()[index];
+    }
+
+    /**
+     * @brief Appends a range of code units.
+     * @param text Valid UTF-8 code units, may be part of this string.
+     * @param size Number of code units.
+     * @return Reference to the string.
+    */
+    String& Append(const tchar* text, uint32 size);
+
+    String& Append(const String& other) { return Append(other.GetData(), other.m_size); }
+
+    String& operator+=(const String& other) { return Append(other); }
+    String& operator+=(const tchar* text) { return Append(text, GetTextSize(text)); }
+
+    /**
+     * @brief Makes sure the string can hold a number of code units without allocating.
+     * @param size Number of code units, null terminator excluded.
+    */
+    void Reserve(uint32 size)
+    {
+        if (size > GetCapacity()) {
+            Grow(size);
+        }
+    }
+
+    /**
+     * @brief Empties the string, its memory is kept.
+    */
+    void Clear()
+    {
+        m_size              = 0;
+        m_length            = 0;
+        GetMutableData()[0] = 0;
+    }
+
+    friend String operator+(String lhs, const String& rhs)
+    {
+        lhs.Append(rhs);
+        return lhs;
+    }
+
+    friend bool operator==(const String& lhs, const String& rhs)
+    {
+        return lhs.m_size == rhs.m_size && lhs.m_length == rhs.m_length && memcmp(lhs.GetData(), rhs.GetData(), lhs.m_size) == 0;
+    }
+
+    friend bool operator==(const String& lhs, const tchar* rhs)
+    {
+        if (!rhs) {
+            return lhs.IsEmpty();
+        }
+        return strcmp(reinterpret_cast<const char*>(lhs.GetData()), reinterpret_cast<const char*>(rhs)) == 0;
+    }
+
+    friend bool operator==(const String& lhs, StringView rhs)
+    {
+        return lhs.m_size == rhs.size() && (lhs.m_size == 0 || memcmp(lhs.GetData(), rhs.data(), lhs.m_size) == 0);
+    }
+
+    friend bool operator==(const tchar* lhs, const String& rhs) { return rhs == lhs; }
+    friend bool operator==(StringView lhs, const String& rhs) { return rhs == lhs; }
+    friend bool operator!=(const String& lhs, const String& rhs) { return !(lhs == rhs); }
+    friend bool operator!=(const String& lhs, const tchar* rhs) { return !(lhs == rhs); }
+    friend bool operator!=(const tchar* lhs, const String& rhs) { return !(rhs == lhs); }
+    friend bool operator!=(const String& lhs, StringView rhs) { return !(lhs == rhs); }
+    friend bool operator!=(StringView lhs, const String& rhs) { return !(rhs == lhs); }
+
+    /** Orders strings by code units, which is also the code points order.*/
+    friend bool operator<(const String& lhs, const String& rhs)
+    {
+        const uint32 size   = lhs.m_size < rhs.m_size ? lhs.m_size : rhs.m_size;
+        const int    result = memcmp(lhs.GetData(), rhs.GetData(), size);
+        return result < 0 || (result == 0 && lhs.m_size < rhs.m_size);
+    }
+
+  private:
+    struct HeapText
+    {
+        tchar* Data;
+        uint32 Capacity;
+    };
+
+    static uint32 GetTextSize(const tchar* text) { return text ? static_cast<uint32>(strlen(reinterpret_cast<const char*>(text))) : 0; }
+
+    tchar* GetMutableData() { return m_onHeap ? m_heap.Data : m_inline; }
+
+    /** Moves the text to a heap block holding at least size code units.*/
+    void Grow(uint32 size);
+
+    void Release()
+    {
+        if (m_onHeap) {
+            MemoryUtils::FreeAligned(m_heap.Data);
+        }
+    }
+
+    void Forget()
+    {
+        m_size      = 0;
+        m_length    = 0;
+        m_onHeap    = 0;
+        m_inline[0] = 0;
+    }
+
+  private:
+    union
+    {
+        HeapText m_heap;
+        tchar    m_inline[InlineCapacity + 1];
+    };
+
+    uint32 m_size;
+    uint32 m_length : 31;
+    uint32 m_onHeap : 1;
+};
+
+static_assert(sizeof(String) == 32, "String is expected to fit half a cache line");
+
+template<>
+struct TIsTriviallyRelocatable<String>
+{
+    enum
+    {
+        Value = true
+    };
+};
+
+/** Hashes strings, views and null terminated texts alike, so maps and sets of strings are searched without constructing a String.*/
+template<>
+struct TStdHash<String>
+{
+    using ResultType = size_t;
+    ResultType operator()(StringView value) const
+    {
+        return std::hash<std::string_view>()(std::string_view(reinterpret_cast<const char*>(value.data()), value.size()));
+    }
+    ResultType operator()(const String& value) const { return (*this)(value.GetView()); }
+    ResultType operator()(const tchar* value) const { return (*this)(value ? StringView(value) : StringView()); }
+};
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "ContainerAllocators.h"
+#include "Sorting.h"
+#include "Math/AnvilMath.h"
 #include "Serialization/Archive.h"
 
 /**
@@ -12,7 +14,7 @@ class TArray
 {
   public:
     using ItemType      = _ItemType;
-    using AllocatorType = _AllocType;
+    using AllocatorType = typename TAllocatorForElement<_AllocType, _ItemType>::Type;
     using SizeType      = typename _AllocType::SizeType;
 
     /**
@@ -31,10 +33,12 @@ class TArray
     constexpr TArray(const TArray& other)
     {
         m_size     = other.m_size;
-        m_capacity = other.m_capacity;
+        m_capacity = m_size ? m_allocator.CalculateReserve(m_size) : 0;
 
-        m_allocator.Reallocate(other.m_size, 0, sizeof(ItemType));
-        MemoryUtils::CopyElements(GetData(), other.GetData(), other.GetSize());
+        m_allocator.Reallocate(m_capacity, 0, sizeof(ItemType));
+        if (m_size) {
+            MemoryUtils::CopyElements(GetData(), other.GetData(), m_size);
+        }
     }
 
     /**
@@ -48,6 +52,7 @@ class TArray
         m_capacity = other.m_capacity;
 
         m_allocator = std::move(other.m_allocator);
+        RelocateInlineItems(other);
 
         other.m_size     = 0;
         other.m_capacity = 0;
@@ -106,7 +111,7 @@ class TArray
         MemoryUtils::CopyElements(GetData(), begin, m_size);
     }
 
-    ~TArray() {}
+    ~TArray() { MemoryUtils::DestroyItems(GetData(), m_size); }
 
     /**
      * @brief Copy assingment constructor.
@@ -118,14 +123,16 @@ class TArray
         if (this != std::addressof(other)) {
             MemoryUtils::DestroyItems(GetData(), m_size);
 
-            const SizeType oldSize = m_size;
+            const SizeType oldCapacity = m_capacity;
 
             m_size     = other.m_size;
-            m_capacity = other.m_capacity;
+            m_capacity = m_size ? m_allocator.CalculateReserve(m_size) : 0;
 
-            m_allocator.Reallocate(m_size, oldSize, sizeof(ItemType));
+            m_allocator.Reallocate(m_capacity, oldCapacity, sizeof(ItemType));
 
-            MemoryUtils::CopyElements(GetData(), other.GetData(), m_size);
+            if (m_size) {
+                MemoryUtils::CopyElements(GetData(), other.GetData(), m_size);
+            }
         }
 
         return *this;
@@ -145,6 +152,7 @@ class TArray
             m_capacity = other.m_capacity;
 
             m_allocator = std::move(other.m_allocator);
+            RelocateInlineItems(other);
 
             other.m_size     = 0;
             other.m_capacity = 0;
@@ -282,7 +290,7 @@ class TArray
         AE_ASSERT(slots > 0);
         const SizeType oldSize = GetSize();
         if ((m_size += slots) > m_capacity) {
-            ResizeImpl();
+            ResizeImpl(oldSize);
         }
 
         return oldSize;
@@ -348,25 +356,26 @@ class TArray
             newCapacity = m_allocator.CalculateReserve(newCapacity);
         }
         if (newCapacity != m_capacity) {
-            const SizeType oldCapacity = m_capacity;
-            m_capacity                 = newCapacity;
-            m_allocator.Reallocate(newCapacity, oldCapacity, sizeof(ItemType));
+            ReallocateImpl(newCapacity, m_size);
         }
     }
 
     /**
      * @brief Resizes the array to a new size.
+     * Added items are value initialized.
      * @param newSize New size.
     */
     constexpr void Resize(SizeType newSize)
     {
         if (newSize < m_size) {
-            const SizeType index = m_size - newSize;
-            const SizeType count = index;
-            RemoveAt(index, count, false);
+            RemoveAt(newSize, m_size - newSize, false);
         } else if (newSize > m_size) {
-            m_size = newSize;
-            ResizeImpl();
+            const SizeType oldSize = m_size;
+            m_size                 = newSize;
+            if (m_size > m_capacity) {
+                ResizeImpl(oldSize);
+            }
+            MemoryUtils::ConstructElements(GetData() + oldSize, newSize - oldSize);
         }
     }
 
@@ -417,6 +426,39 @@ class TArray
         return INVALID_INDEX;
     }
 
+    /**
+     * @brief Sorts the items with an introsort, items that are equal may be reordered.
+     * @param predicate Function returning true if its first argument goes before its second one.
+    */
+    template<class PredicateType = Sorting::Less>
+    void Sort(const PredicateType& predicate = PredicateType())
+    {
+        Sorting::Sort(GetData(), m_size, predicate);
+    }
+
+    /**
+     * @brief Sorts the items with a merge sort, items that are equal keep their order.
+     * @tparam ScratchAllocType Allocator of the scratch memory, room for half of the items.
+     * @param predicate Function returning true if its first argument goes before its second one.
+    */
+    template<class ScratchAllocType = THeapAllocator<uint64>, class PredicateType = Sorting::Less>
+    void StableSort(const PredicateType& predicate = PredicateType())
+    {
+        Sorting::StableSort<ScratchAllocType>(GetData(), m_size, predicate);
+    }
+
+    /**
+     * @brief Sorts trivially copyable items by an integral or floating point key with a radix sort.
+     * Items with equal keys keep their order.
+     * @tparam ScratchAllocType Allocator of the scratch memory, room for every item.
+     * @param key Function returning the key of an item, by default the item itself.
+    */
+    template<class ScratchAllocType = THeapAllocator<uint64>, class KeyFunctionType = Sorting::Identity>
+    void RadixSort(const KeyFunctionType& key = KeyFunctionType())
+    {
+        Sorting::RadixSort<ScratchAllocType>(GetData(), m_size, key);
+    }
+
     /**
      * @brief Requests the removal of unused capacity.
     */
@@ -440,6 +482,28 @@ class TArray
         }
     }
 
+    /**
+     * @brief Removes an element by moving the last element into its place.
+     * O(1) but does not preserve the order of the elements.
+     * @param index Index of the element to remove.
+     * @param shrink Whether unused capacity is released.
+    */
+    constexpr void RemoveAtSwap(SizeType index, bool shrink = false)
+    {
+        AE_ASSERT(index < m_size);
+
+        ItemType* data = GetData();
+        MemoryUtils::DestroyItems(data + index, 1);
+        if (index != m_size - 1) {
+            MemoryUtils::RelocateItems(data + index, data + m_size - 1, 1);
+        }
+
+        m_size--;
+        if (shrink) {
+            ShrinkToFit();
+        }
+    }
+
     friend void Serialize(Archive& ar, TArray& arr, const char* name, const char* label)
     {
         SizeType arraySize = 0;
@@ -486,11 +550,47 @@ class TArray
     */
     constexpr void CheckAddress(const ItemType* address) const { AE_ASSERT(address < GetData() || address >= (GetData() + GetCapacity())); }
 
-    constexpr void ResizeImpl()
+    /**
+     * @brief Grows the capacity to fit m_size items.
+     * @param itemsCount Number of constructed items to keep.
+    */
+    constexpr void ResizeImpl(SizeType itemsCount) { ReallocateImpl(m_allocator.CalculateGrowth(m_size, m_capacity), itemsCount); }
+
+    /**
+     * @brief Changes the capacity, relocating the constructed items if they are not trivially relocatable.
+     * @param capacity New capacity.
+     * @param itemsCount Number of constructed items to keep.
+    */
+    constexpr void ReallocateImpl(SizeType capacity, SizeType itemsCount)
     {
         const SizeType oldCapacity = m_capacity;
-        m_capacity                 = m_allocator.CalculateGrowth(m_size, m_capacity);
-        m_allocator.Reallocate(m_capacity, oldCapacity, sizeof(ItemType));
+        m_capacity                 = capacity;
+
+        if constexpr (TIsTriviallyRelocatable<ItemType>::Value) {
+            m_allocator.Reallocate(capacity, oldCapacity, sizeof(ItemType));
+        } else {
+            const ItemRelocator relocator {&RelocateItems, itemsCount};
+            m_allocator.Reallocate(capacity, oldCapacity, sizeof(ItemType), itemsCount ? &relocator : nullptr);
+        }
+    }
+
+    static void RelocateItems(void* dst, void* src, uint64 count)
+    {
+        MemoryUtils::RelocateItems(reinterpret_cast<ItemType*>(dst), reinterpret_cast<ItemType*>(src), count);
+    }
+
+    /**
+     * @brief Moves the items that stayed in other's inline storage when its allocator was moved.
+     * Allocators only copy inline items that are trivially relocatable, the others are move constructed here.
+     * @param other Array whose allocator was just moved, m_size is already set.
+    */
+    constexpr void RelocateInlineItems(TArray& other)
+    {
+        if constexpr (!TIsTriviallyRelocatable<ItemType>::Value) {
+            if (m_size && !m_allocator.HasAllocatedData()) {
+                MemoryUtils::RelocateItems(GetData(), other.GetData(), m_size);
+            }
+        }
     }
 
     constexpr void RemoveAtImpl(SizeType index, SizeType count)
@@ -498,14 +598,10 @@ class TArray
         if (count) {
             AE_ASSERT((count >= 0) & (index >= 0) & (index + count <= m_size));
 
-            MemoryUtils::DestroyItems(GetData() + index, count);
+            ItemType* data = GetData() + index;
+            MemoryUtils::DestroyItems(data, count);
+            MemoryUtils::RelocateItems(data, data + count, m_size - index - count);
 
-            SizeType moveCount = m_size - index - count;
-            if (moveCount) {
-                memmove((uint8*)m_allocator.GetData() + (index) * sizeof(ItemType),
-                        (uint8*)m_allocator.GetData() + (index + count) * sizeof(ItemType),
-                        moveCount * sizeof(ItemType));
-            }
             m_size -= count;
         }
     }
@@ -520,10 +616,10 @@ class TArray
 
         const SizeType oldCount = m_size;
         if ((m_size += count) > m_capacity) {
-            ResizeImpl();
+            ResizeImpl(oldCount);
         }
         ItemType* data = GetData() + index;
-        MemoryUtils::MemoryMove<ItemType, ItemType, SizeType>(data + count, data, oldCount - index);
+        MemoryUtils::RelocateItems(data + count, data, oldCount - index);
     }
 
   private:
@@ -583,15 +679,75 @@ operator new(size_t size, TArray<T, AllocatorType>& arr)
     return &arr[index];
 }
 
+template<class ItemType, class SizeType, uint64 Alignment>
+struct TIsTriviallyRelocatable<TArray<ItemType, THeapAllocator<SizeType, Alignment>>>
+{
+    enum
+    {
+        Value = true
+    };
+};
+
+template<class ItemType, class SizeType, uint64 Alignment>
+struct TIsTriviallyRelocatable<TArray<ItemType, TArenaAllocator<SizeType, Alignment>>>
+{
+    enum
+    {
+        Value = true
+    };
+};
+
+template<class ItemType, class SizeType, uint64 Alignment>
+struct TIsTriviallyRelocatable<TArray<ItemType, TConcurrentFrameAllocator<SizeType, Alignment>>>
+{
+    enum
+    {
+        Value = true
+    };
+};
+
+/**
+ * @brief Packed array of bits.
+ * Bits are stored in 64 bits words, so whole words are counted, searched and
+ * combined at once. The bits past the end of the last word are always cleared.
+*/
 template<class _AllocType>
 class TArray<bool, _AllocType>
 {
   public:
-    using ItemType       = uint8;
+    using ItemType       = uint64;
     using TargetItemType = bool;
-    using AllocatorType  = _AllocType;
+    using AllocatorType  = typename TAllocatorForElement<_AllocType, uint64>::Type;
     using SizeType       = typename _AllocType::SizeType;
 
+    static constexpr SizeType BitsPerWord = 64;
+
+    /**
+     * @brief Proxy to a single bit of the array.
+    */
+    class BitReference
+    {
+      public:
+        constexpr BitReference(ItemType& word, ItemType mask)
+          : m_word(word)
+          , m_mask(mask)
+        {}
+
+        constexpr operator bool() const { return (m_word & m_mask) != 0; }
+
+        constexpr BitReference& operator=(bool value)
+        {
+            m_word = value ? (m_word | m_mask) : (m_word & ~m_mask);
+            return *this;
+        }
+
+        constexpr BitReference& operator=(const BitReference& other) { return *this = bool(other); }
+
+      private:
+        ItemType& m_word;
+        ItemType  m_mask;
+    };
+
     /**
      * @brief Default constructor.
     */
@@ -602,21 +758,19 @@ class TArray<bool, _AllocType>
 
     /**
      * @brief Copy constructor.
-     * Constructs an array by coping the elements of other.
+     * Constructs an array by coping the bits of other.
      * @param other The array to be copied.
     */
     constexpr TArray(const TArray& other)
+      : m_size(0)
+      , m_capacity(0)
     {
-        m_size     = other.m_size;
-        m_capacity = other.m_capacity;
-
-        m_allocator.Reallocate(other.m_size, 0, sizeof(ItemType));
-        MemoryUtils::CopyElements(GetData(), other.GetData(), other.GetSize());
+        *this = other;
     }
 
     /**
      * @brief Move constructor.
-     * Constructs an array with the elements of other using move semantics.
+     * Constructs an array with the bits of other using move semantics.
      * @param other The array to be moved.
     */
     constexpr TArray(TArray&& other)
@@ -631,18 +785,16 @@ class TArray<bool, _AllocType>
     }
 
     /**
-     * @brief Constructs a array with an initial slots count.
-     * The slots are default initialized elements.
-     * @param count The initial slots count.
+     * @brief Constructs an array of count bits.
+     * @param count The initial bits count.
+     * @param value Value of the bits.
     */
-    constexpr TArray(SizeType count)
+    constexpr TArray(SizeType count, bool value = false)
+      : m_size(0)
+      , m_capacity(0)
     {
-        m_size     = count;
-        m_capacity = count;
-
-        m_allocator.Reallocate(m_size, 0, sizeof(ItemType));
-
-        MemoryUtils::ConstructElements(GetData(), m_size);
+        Reserve(count);
+        Resize(count, value);
     }
 
     /**
@@ -650,53 +802,79 @@ class TArray<bool, _AllocType>
      * @param list List to be copied to the new created array.
     */
     constexpr TArray(std::initializer_list<TargetItemType> list)
+      : m_size(0)
+      , m_capacity(0)
     {
-        const SizeType size = static_cast<SizeType>(list.size());
-        if (size) {
-            m_size     = size;
-            m_capacity = size;
-
-            m_allocator.Reallocate(m_size, 0, sizeof(ItemType));
-            MemoryUtils::CopyElements(GetData(), list.begin(), m_size);
-        }
+        AddBools(list.begin(), static_cast<SizeType>(list.size()));
     }
 
     /**
-     * @brief Construct an array from a memory range.
-     * @param begin Pointer to the memory's begin.
-     * @param end Pointer to the memory's end.
+     * @brief Construct an array from a range of booleans.
+     * @param begin Pointer to the range's begin.
+     * @param end Pointer to the range's end.
     */
     constexpr TArray(const TargetItemType* begin, const TargetItemType* end)
+      : m_size(0)
+      , m_capacity(0)
     {
         AE_ASSERT(begin && end);
+        AddBools(begin, static_cast<SizeType>(end - begin));
+    }
 
-        const uint64 beginAddr = reinterpret_cast<uint64>(begin);
-        const uint64 endAddr   = reinterpret_cast<uint64>(end);
-        SizeType     size      = static_cast<SizeType>(endAddr - beginAddr) / sizeof(ItemType);
-
-        AE_ASSERT(size);
+    ~TArray() {}
 
-        ConvertBoolToBytes(nullptr, begin, &m_size, size);
+    /**
+     * @brief Copy assingment.
+     * @param other Array to be copied.
+     * @return Reference to the array.
+    */
+    constexpr TArray& operator=(const TArray& other)
+    {
+        if (this != std::addressof(other)) {
+            const SizeType wordCount = GetWordCount(other.m_size);
+            if (wordCount > GetWordCount(m_capacity)) {
+                ReallocateWords(m_allocator.CalculateReserve(wordCount));
+            }
 
-        m_capacity = m_size;
+            m_size = other.m_size;
+            if (wordCount) {
+                MemoryUtils::CopyMemory(GetData(), other.GetData(), wordCount * sizeof(ItemType));
+            }
+        }
 
-        m_allocator.Reallocate(m_size, 0, sizeof(ItemType));
-        ConvertBoolToBytes(GetData(), begin, &m_size, size);
+        return *this;
     }
 
-    ~TArray() {}
+    /**
+     * @brief Move assingment.
+     * @param other Array to be moved.
+     * @return Reference to the array.
+    */
+    constexpr TArray& operator=(TArray&& other) noexcept
+    {
+        if (this != std::addressof(other)) {
+            m_size     = other.m_size;
+            m_capacity = other.m_capacity;
+
+            m_allocator = std::move(other.m_allocator);
+
+            other.m_size     = 0;
+            other.m_capacity = 0;
+        }
+        return *this;
+    }
 
     /**
-     * @brief Returns the number of elements present on the array.
-     * @return Number of elements of the array.
+     * @brief Returns the number of bits present on the array.
+     * @return Number of bits of the array.
     */
     constexpr SizeType GetSize() const { return m_size; }
 
-    constexpr size_t GetSizeInBytes() const { return (size_t)GetCapacity() * sizeof(ItemType); }
+    constexpr size_t GetSizeInBytes() const { return (size_t)GetWordCount(m_capacity) * sizeof(ItemType); }
 
     /**
      * @brief Returns the capacity of the array.
-     * @return The capacity (in bytes) of the array.
+     * @return The capacity (in bits) of the array, a multiple of BitsPerWord.
     */
     constexpr SizeType GetCapacity() const { return m_capacity; }
 
@@ -707,25 +885,376 @@ class TArray<bool, _AllocType>
     constexpr bool IsEmpty() const { return GetSize() == 0; }
 
     /**
-     * @brief Returns a pointer to the array's first element.
-     * @return Pointer to the array's first element.
+     * @brief Returns a pointer to the array's first word.
+     * @return Pointer to the array's first word.
     */
     constexpr ItemType* GetData() { return reinterpret_cast<ItemType*>(m_allocator.GetData()); }
 
     /**
-     * @brief Returns a pointer to the array's first element.
-     * @return Pointer to the array's first element.
+     * @brief Returns a pointer to the array's first word.
+     * @return Pointer to the array's first word.
     */
     constexpr const ItemType* GetData() const { return reinterpret_cast<const ItemType*>(m_allocator.GetData()); }
 
+    /**
+     * @brief Returns the number of words holding the bits.
+     * @return The number of words holding the bits.
+    */
+    constexpr SizeType GetWordCount() const { return GetWordCount(m_size); }
+
+    /**
+     * @brief Returns a bit at a position (index).
+     * @param pos The position (index) of the desired bit.
+     * @return Proxy to the bit at the position pos.
+    */
+    constexpr BitReference operator[](SizeType pos)
+    {
+        AE_ASSERT(pos < GetSize());
+        return BitReference(GetData()[pos / BitsPerWord], GetMask(pos));
+    }
+
+    /**
+     * @brief Returns a bit at a position (index).
+     * @param pos The position (index) of the desired bit.
+     * @return The bit at the position pos.
+    */
+    constexpr bool operator[](SizeType pos) const
+    {
+        AE_ASSERT(pos < GetSize());
+        return (GetData()[pos / BitsPerWord] & GetMask(pos)) != 0;
+    }
+
+    /**
+     * @brief Adds a bit to the end of the array.
+     * The array will be resized if needed.
+     * @param value The bit that will be added.
+     * @return Index to the added bit.
+    */
+    constexpr SizeType Add(bool value)
+    {
+        const SizeType index = m_size;
+        if (index == m_capacity) {
+            ReallocateWords(m_allocator.CalculateGrowth(GetWordCount(index) + 1, GetWordCount(m_capacity)));
+        }
+
+        ItemType& word = GetData()[index / BitsPerWord];
+        if (index % BitsPerWord == 0) {
+            word = 0;
+        }
+        word |= value ? GetMask(index) : 0;
+
+        m_size++;
+        return index;
+    }
+
+    /**
+     * @brief Removes the last bit.
+     * @return The removed bit.
+    */
+    constexpr bool Pop()
+    {
+        AE_ASSERT(!IsEmpty());
+
+        m_size--;
+        ItemType&  word   = GetData()[m_size / BitsPerWord];
+        const bool result = (word & GetMask(m_size)) != 0;
+        word &= ~GetMask(m_size);
+
+        return result;
+    }
+
+    /**
+     * @brief Makes sure the array can hold a number of bits without reallocating.
+     * @param newCapacity Number of bits.
+    */
+    constexpr void Reserve(SizeType newCapacity)
+    {
+        const SizeType wordCount = GetWordCount(newCapacity);
+        if (wordCount > GetWordCount(m_capacity)) {
+            ReallocateWords(m_allocator.CalculateReserve(wordCount));
+        }
+    }
+
+    /**
+     * @brief Resizes the array to a new size.
+     * @param newSize New size.
+     * @param value Value of the added bits.
+    */
+    constexpr void Resize(SizeType newSize, bool value = false)
+    {
+        const SizeType oldSize = m_size;
+        if (newSize < oldSize) {
+            m_size = newSize;
+            ClearTail();
+        } else if (newSize > oldSize) {
+            const SizeType oldWordCount = GetWordCount(oldSize);
+            const SizeType wordCount    = GetWordCount(newSize);
+            if (newSize > m_capacity) {
+                ReallocateWords(m_allocator.CalculateGrowth(wordCount, GetWordCount(m_capacity)));
+            }
+
+            if (wordCount > oldWordCount) {
+                memset(GetData() + oldWordCount, 0, (wordCount - oldWordCount) * sizeof(ItemType));
+            }
+            m_size = newSize;
+            if (value) {
+                SetRange(oldSize, newSize - oldSize);
+            }
+        }
+    }
+
+    /**
+     * @brief Removes every bit.
+     * @param shrink If the memory should be released.
+    */
+    constexpr void Clear(bool shrink = false)
+    {
+        m_size = 0;
+        if (shrink) {
+            ShrinkToFit();
+        }
+    }
+
+    /**
+     * @brief Requests the removal of unused capacity.
+    */
+    constexpr void ShrinkToFit()
+    {
+        const SizeType wordCount = GetWordCount(m_size);
+        if (wordCount != GetWordCount(m_capacity)) {
+            ReallocateWords(wordCount);
+        }
+    }
+
+    /**
+     * @brief Sets or clears a single bit.
+     * @param index Index of the bit.
+     * @param value New value of the bit.
+    */
+    constexpr void Set(SizeType index, bool value = true) { (*this)[index] = value; }
+
+    /**
+     * @brief Sets a range of bits, whole words are written at once.
+     * @param index Index of the first bit.
+     * @param count Number of bits.
+    */
+    void SetRange(SizeType index, SizeType count)
+    {
+        ForEachWordInRange(index, count, [](ItemType& word, ItemType mask) { word |= mask; });
+    }
+
+    /**
+     * @brief Clears a range of bits, whole words are written at once.
+     * @param index Index of the first bit.
+     * @param count Number of bits.
+    */
+    void ClearRange(SizeType index, SizeType count)
+    {
+        ForEachWordInRange(index, count, [](ItemType& word, ItemType mask) { word &= ~mask; });
+    }
+
+    /**
+     * @brief Counts the set bits.
+     * @return The number of set bits.
+    */
+    SizeType CountSetBits() const
+    {
+        const ItemType* words  = GetData();
+        SizeType        result = 0;
+        for (SizeType i = 0, wordCount = GetWordCount(m_size); i < wordCount; i++) {
+            result += Math::PopCount(words[i]);
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Finds the first set bit.
+     * @param start Index of the first bit to look at.
+     * @return Index of the bit, INVALID_INDEX if no bit is set.
+    */
+    SizeType FindFirstSet(SizeType start = 0) const { return FindFirst<false>(start); }
+
+    /**
+     * @brief Finds the first cleared bit.
+     * @param start Index of the first bit to look at.
+     * @return Index of the bit, INVALID_INDEX if every bit is set.
+    */
+    SizeType FindFirstUnset(SizeType start = 0) const { return FindFirst<true>(start); }
+
+    /**
+     * @brief Calls a function with the index of every set bit, in ascending order.
+     * @param function Function taking the bit's index.
+    */
+    template<class FunctionType>
+    void ForEachSetBit(FunctionType&& function) const
+    {
+        const ItemType* words = GetData();
+        for (SizeType i = 0, wordCount = GetWordCount(m_size); i < wordCount; i++) {
+            for (ItemType word = words[i]; word; word &= word - 1) {
+                function(i * BitsPerWord + Math::CountTrailingZeros(word));
+            }
+        }
+    }
+
+    /**
+     * @brief Flips every bit.
+    */
+    void Invert()
+    {
+        ItemType* words = GetData();
+        for (SizeType i = 0, wordCount = GetWordCount(m_size); i < wordCount; i++) {
+            words[i] = ~words[i];
+        }
+        ClearTail();
+    }
+
+    /**
+     * @brief Keeps the bits also set in other.
+     * @param other Array of the same size.
+     * @return Reference to the array.
+    */
+    template<class OtherAllocType>
+    TArray& operator&=(const TArray<bool, OtherAllocType>& other)
+    {
+        return CombineWords(other, [](ItemType lhs, ItemType rhs) { return lhs & rhs; });
+    }
+
+    /**
+     * @brief Sets the bits set in other.
+     * @param other Array of the same size.
+     * @return Reference to the array.
+    */
+    template<class OtherAllocType>
+    TArray& operator|=(const TArray<bool, OtherAllocType>& other)
+    {
+        return CombineWords(other, [](ItemType lhs, ItemType rhs) { return lhs | rhs; });
+    }
+
+    /**
+     * @brief Flips the bits set in other.
+     * @param other Array of the same size.
+     * @return Reference to the array.
+    */
+    template<class OtherAllocType>
+    TArray& operator^=(const TArray<bool, OtherAllocType>& other)
+    {
+        return CombineWords(other, [](ItemType lhs, ItemType rhs) { return lhs ^ rhs; });
+    }
+
+    [[nodiscard]] friend TArray operator&(TArray lhs, const TArray& rhs) { return std::move(lhs &= rhs); }
+    [[nodiscard]] friend TArray operator|(TArray lhs, const TArray& rhs) { return std::move(lhs |= rhs); }
+    [[nodiscard]] friend TArray operator^(TArray lhs, const TArray& rhs) { return std::move(lhs ^= rhs); }
+
+    [[nodiscard]] friend TArray operator~(TArray array)
+    {
+        array.Invert();
+        return array;
+    }
+
+    [[nodiscard]] friend bool operator==(const TArray& lhs, const TArray& rhs)
+    {
+        const SizeType wordCount = GetWordCount(lhs.m_size);
+        return lhs.m_size == rhs.m_size && (wordCount == 0 || memcmp(lhs.GetData(), rhs.GetData(), wordCount * sizeof(ItemType)) == 0);
+    }
+
+    [[nodiscard]] friend bool operator!=(const TArray& lhs, const TArray& rhs) { return !(lhs == rhs); }
+
   private:
-    void ConvertBoolToBytes(uint8* dst, const bool* src, SizeType* dstSize, SizeType srvSize)
+    static constexpr SizeType GetWordCount(SizeType bitCount) { return (bitCount + BitsPerWord - 1) / BitsPerWord; }
+
+    static constexpr ItemType GetMask(SizeType index) { return ItemType(1) << (index % BitsPerWord); }
+
+    /**
+     * @brief Changes the capacity.
+     * @param wordCount New capacity in words.
+    */
+    constexpr void ReallocateWords(SizeType wordCount)
+    {
+        const SizeType oldWordCount = GetWordCount(m_capacity);
+        m_capacity                  = wordCount * BitsPerWord;
+        m_allocator.Reallocate(wordCount, oldWordCount, sizeof(ItemType));
+    }
+
+    /** Restores the invariant of a last word without bits past the end.*/
+    constexpr void ClearTail()
+    {
+        if (m_size % BitsPerWord) {
+            GetData()[m_size / BitsPerWord] &= ~ItemType(0) >> (BitsPerWord - m_size % BitsPerWord);
+        }
+    }
+
+    constexpr void AddBools(const bool* values, SizeType count)
+    {
+        Reserve(m_size + count);
+        for (SizeType i = 0; i < count; i++) {
+            Add(values[i]);
+        }
+    }
+
+    /** Calls function with every word of a range and the mask of the range's bits in the word.*/
+    template<class FunctionType>
+    void ForEachWordInRange(SizeType index, SizeType count, FunctionType&& function)
+    {
+        if (count == 0) {
+            return;
+        }
+
+        AE_ASSERT(index + count <= m_size);
+
+        ItemType*      words     = GetData();
+        const SizeType first     = index / BitsPerWord;
+        const SizeType last      = (index + count - 1) / BitsPerWord;
+        const ItemType firstMask = ~ItemType(0) << (index % BitsPerWord);
+        const ItemType lastMask  = ~ItemType(0) >> (BitsPerWord - 1 - (index + count - 1) % BitsPerWord);
+
+        if (first == last) {
+            function(words[first], firstMask & lastMask);
+            return;
+        }
+
+        function(words[first], firstMask);
+        for (SizeType i = first + 1; i < last; i++) {
+            function(words[i], ~ItemType(0));
+        }
+        function(words[last], lastMask);
+    }
+
+    template<bool Inverted>
+    SizeType FindFirst(SizeType start) const
     {
-        AE_ASSERT(src);
+        if (start >= m_size) {
+            return INVALID_INDEX;
+        }
+
+        const ItemType* words     = GetData();
+        const SizeType  wordCount = GetWordCount(m_size);
+        SizeType        i         = start / BitsPerWord;
+        ItemType        word      = (Inverted ? ~words[i] : words[i]) & (~ItemType(0) << (start % BitsPerWord));
+        while (!word) {
+            if (++i == wordCount) {
+                return INVALID_INDEX;
+            }
+            word = Inverted ? ~words[i] : words[i];
+        }
+
+        // The cleared bits past the end read as unset.
+        const SizeType index = i * BitsPerWord + Math::CountTrailingZeros(word);
+        return index < m_size ? index : SizeType(INVALID_INDEX);
+    }
 
-        *dstSize = (srvSize / 8 + 1) * 8;
+    template<class OtherAllocType, class FunctionType>
+    TArray& CombineWords(const TArray<bool, OtherAllocType>& other, FunctionType&& function)
+    {
+        AE_ASSERT(other.GetSize() == m_size);
 
-        if (dst) {}
+        ItemType*       words      = GetData();
+        const ItemType* otherWords = other.GetData();
+        for (SizeType i = 0, wordCount = GetWordCount(m_size); i < wordCount; i++) {
+            words[i] = function(words[i], otherWords[i]);
+        }
+
+        return *this;
     }
 
   private:
@@ -0,0 +1,319 @@
+#pragma once
+
+#include "Array.h"
+#include "Span.h"
+
+/**
+ * @brief Array of items stored in fixed size chunks that never move.
+ * Adding items only allocates a new chunk when the last one is full, existing items are never copied,
+ * so pointers and references to items stay valid until the item is removed, unlike TArray.
+ * An index is split into a chunk and a position in it with a shift and a mask. The allocator is used
+ * for the table of chunk pointers while the chunks come from the heap.
+*/
+template<class _ItemType, uint32 _ChunkSize = 64, class _AllocType = DefaultHeapAllocator64>
+class TChunkedArray
+{
+  public:
+    using ItemType = _ItemType;
+    using SizeType = typename _AllocType::SizeType;
+
+    /** Number of items in a chunk.*/
+    static constexpr SizeType ChunkSize = _ChunkSize;
+
+    static_assert(ChunkSize != 0 && (ChunkSize & (ChunkSize - 1)) == 0, "The chunk size must be a power of two");
+
+    /**
+     * @brief Iterates the items in order, moving to the next chunk only at the end of a chunk.
+    */
+    template<class ArrayType, class IteratedType>
+    class TIterator
+    {
+      public:
+        TIterator(ArrayType* array, SizeType index)
+          : m_array(array)
+          , m_index(index)
+          , m_item(index < array->GetSize() ? &(*array)[index] : nullptr)
+        {}
+
+        IteratedType& operator*() const { return *m_item; }
+        IteratedType* operator->() const { return m_item; }
+
+        TIterator& operator++()
+        {
+            m_index++;
+            if ((m_index & (ChunkSize - 1)) != 0) {
+                m_item++;
+            } else {
+                m_item = m_index < m_array->GetSize() ? m_array->GetChunk(m_index >> ChunkShift).GetData() : nullptr;
+            }
+            return *this;
+        }
+
+        bool operator==(const TIterator& other) const { return m_index == other.m_index; }
+        bool operator!=(const TIterator& other) const { return m_index != other.m_index; }
+
+      private:
+        ArrayType*    m_array;
+        SizeType      m_index;
+        IteratedType* m_item;
+    };
+
+    using Iterator      = TIterator<TChunkedArray, ItemType>;
+    using ConstIterator = TIterator<const TChunkedArray, const ItemType>;
+
+    /**
+     * @brief Default constructor, no memory is allocated until the first item.
+    */
+    TChunkedArray()
+      : m_size(0)
+    {}
+
+    /**
+     * @brief Copy constructor, the items are copied in order.
+     * @param other Array to be copied.
+    */
+    TChunkedArray(const TChunkedArray& other)
+      : TChunkedArray()
+    {
+        Reserve(other.m_size);
+        other.ForEachChunk([this](const ItemType* items, SizeType count) {
+            MemoryUtils::CopyElements(m_chunks[m_size >> ChunkShift], items, count);
+            m_size += count;
+        });
+    }
+
+    /**
+     * @brief Move constructor, the items keep their addresses.
+     * @param other Array to be moved, left empty.
+    */
+    TChunkedArray(TChunkedArray&& other) noexcept
+      : m_chunks(std::move(other.m_chunks))
+      , m_size(other.m_size)
+    {
+        other.m_size = 0;
+    }
+
+    ~TChunkedArray() { Clear(true); }
+
+    TChunkedArray& operator=(const TChunkedArray& other)
+    {
+        if (this != &other) {
+            *this = TChunkedArray(other);
+        }
+        return *this;
+    }
+
+    TChunkedArray& operator=(TChunkedArray&& other) noexcept
+    {
+        if (this != &other) {
+            Clear(true);
+
+            m_chunks = std::move(other.m_chunks);
+            m_size   = other.m_size;
+
+            other.m_size = 0;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Adds an item constructed in place after the last item.
+     * @param args Arguments passed to the item's constructor.
+     * @return Index of the added item.
+    */
+    template<class... ArgsType>
+    SizeType Emplace(ArgsType&&... args)
+    {
+        if (m_size == m_chunks.GetSize() * ChunkSize) {
+            m_chunks.Add(AllocateChunk());
+        }
+
+        new (m_chunks[m_size >> ChunkShift] + (m_size & (ChunkSize - 1))) ItemType(std::forward<ArgsType>(args)...);
+        return m_size++;
+    }
+
+    /**
+     * @brief Adds an item after the last item.
+     * @param item Item to be moved.
+     * @return Reference to the added item, valid until it is removed.
+    */
+    ItemType& Add(ItemType&& item) { return (*this)[Emplace(std::move(item))]; }
+
+    /**
+     * @brief Adds an item after the last item.
+     * @param item Item to be copied.
+     * @return Reference to the added item, valid until it is removed.
+    */
+    ItemType& Add(const ItemType& item) { return (*this)[Emplace(item)]; }
+
+    /**
+     * @brief Removes the last item.
+     * @return The removed item.
+    */
+    ItemType Pop()
+    {
+        ItemType& item   = GetLast();
+        ItemType  result = std::move(item);
+        MemoryUtils::DestroyItems(&item, 1);
+        m_size--;
+        return result;
+    }
+
+    /**
+     * @brief Returns the last item.
+     * @return Reference to the last item.
+    */
+    ItemType& GetLast()
+    {
+        AE_ASSERT(!IsEmpty());
+        return (*this)[m_size - 1];
+    }
+
+    const ItemType& GetLast() const { return const_cast<TChunkedArray*>(this)->GetLast(); }
+
+    /**
+     * @brief Returns an item at a position (index).
+     * @param pos The position (index) of the desired item.
+     * @return Reference to the item.
+    */
+    ItemType& operator[](SizeType pos)
+    {
+        AE_ASSERT(pos < m_size);
+        return m_chunks[pos >> ChunkShift][pos & (ChunkSize - 1)];
+    }
+
+    const ItemType& operator[](SizeType pos) const { return const_cast<TChunkedArray*>(this)->operator[](pos); }
+
+    /**
+     * @brief Returns the items of a chunk, all chunks but the last one are full.
+     * @param chunk Index of the chunk, lower than GetChunkCount.
+     * @return View of the chunk's items.
+    */
+    TSpan<ItemType, SizeType> GetChunk(SizeType chunk)
+    {
+        AE_ASSERT(chunk < GetChunkCount());
+        const SizeType first = chunk << ChunkShift;
+        return TSpan<ItemType, SizeType>(m_chunks[chunk], m_size - first < ChunkSize ? m_size - first : ChunkSize);
+    }
+
+    TSpan<const ItemType, SizeType> GetChunk(SizeType chunk) const
+    {
+        const TSpan<ItemType, SizeType> items = const_cast<TChunkedArray*>(this)->GetChunk(chunk);
+        return TSpan<const ItemType, SizeType>(items.GetData(), items.GetSize());
+    }
+
+    /**
+     * @brief Calls a function for the items of every chunk in order, faster than iterating items one by one.
+     * @param function Function taking a pointer to the first item of a chunk and the number of items.
+    */
+    template<class FunctionType>
+    void ForEachChunk(FunctionType&& function)
+    {
+        for (SizeType first = 0; first < m_size; first += ChunkSize) {
+            function(m_chunks[first >> ChunkShift], m_size - first < ChunkSize ? m_size - first : ChunkSize);
+        }
+    }
+
+    template<class FunctionType>
+    void ForEachChunk(FunctionType&& function) const
+    {
+        for (SizeType first = 0; first < m_size; first += ChunkSize) {
+            function(static_cast<const ItemType*>(m_chunks[first >> ChunkShift]), m_size - first < ChunkSize ? m_size - first : ChunkSize);
+        }
+    }
+
+    /**
+     * @brief Allocates the chunks needed to hold a number of items.
+     * @param capacity Number of items that can then be added without allocating.
+    */
+    void Reserve(SizeType capacity)
+    {
+        const SizeType chunkCount = (capacity + ChunkSize - 1) >> ChunkShift;
+        if (chunkCount > m_chunks.GetSize()) {
+            m_chunks.Reserve(chunkCount);
+            while (m_chunks.GetSize() < chunkCount) {
+                m_chunks.Add(AllocateChunk());
+            }
+        }
+    }
+
+    /**
+     * @brief Destroys every item.
+     * @param shrink If the chunks should be freed, else they are kept for reuse.
+    */
+    void Clear(bool shrink = false)
+    {
+        if constexpr (!std::is_trivially_destructible_v<ItemType>) {
+            ForEachChunk([](ItemType* items, SizeType count) { MemoryUtils::DestroyItems(items, count); });
+        }
+        m_size = 0;
+
+        if (shrink) {
+            ShrinkToFit();
+            m_chunks.Clear(true);
+        }
+    }
+
+    /**
+     * @brief Frees the chunks past the last item.
+    */
+    void ShrinkToFit()
+    {
+        const SizeType chunkCount = (m_size + ChunkSize - 1) >> ChunkShift;
+        while (m_chunks.GetSize() > chunkCount) {
+            MemoryUtils::FreeAligned(m_chunks.Pop(false));
+        }
+    }
+
+    /**
+     * @brief Returns the number of items.
+     * @return The number of items.
+    */
+    constexpr SizeType GetSize() const { return m_size; }
+
+    /**
+     * @brief Returns the number of items that can be held without allocating a chunk.
+     * @return The capacity, a multiple of ChunkSize.
+    */
+    SizeType GetCapacity() const { return m_chunks.GetSize() * ChunkSize; }
+
+    /**
+     * @brief Returns the number of chunks holding items.
+     * @return The number of chunks.
+    */
+    constexpr SizeType GetChunkCount() const { return (m_size + ChunkSize - 1) >> ChunkShift; }
+
+    /**
+     * @brief Checks if the array is empty.
+     * @return True if the array is empty, false otherwise.
+    */
+    constexpr bool IsEmpty() const { return m_size == 0; }
+
+    Iterator      begin() { return Iterator(this, 0); }
+    Iterator      end() { return Iterator(this, m_size); }
+    ConstIterator begin() const { return ConstIterator(this, 0); }
+    ConstIterator end() const { return ConstIterator(this, m_size); }
+
+  private:
+    static constexpr uint32 CalculateShift()
+    {
+        uint32 shift = 0;
+        while ((SizeType(1) << shift) < ChunkSize) {
+            shift++;
+        }
+        return shift;
+    }
+
+    static constexpr uint32 ChunkShift = CalculateShift();
+    static constexpr uint64 ChunkAlignment
+      = alignof(ItemType) > MemoryUtils::DefaultAlignment ? alignof(ItemType) : MemoryUtils::DefaultAlignment;
+
+    static ItemType* AllocateChunk()
+    {
+        return reinterpret_cast<ItemType*>(MemoryUtils::AllocateAligned(ChunkSize * sizeof(ItemType), ChunkAlignment));
+    }
+
+  private:
+    TArray<ItemType*, _AllocType> m_chunks;
+    SizeType                      m_size;
+};
@@ -1,6 +1,10 @@
 #pragma once
 
+#include "Memory/Allocators/ConcurrentLinearAllocator.h"
+#include "Memory/Allocators/MemoryArena.h"
+#include "Memory/MemoryTracker.h"
 #include "Memory/MemoryUtils.h"
+#include "Memory/PlatformMemory.h"
 
 enum
 {
@@ -10,35 +14,461 @@ enum
 struct AllocatorItem
 {};
 
-template<class _SizeType>
+/**
+ * @brief Moves the items of a container whose items are not trivially relocatable.
+ * Containers pass it on reallocation, allocators must then use it instead of copying
+ * memory whenever the items change address.
+*/
+struct ItemRelocator
+{
+    void (*Relocate)(void* dst, void* src, uint64 count);
+    uint64 Count;
+};
+
+/**
+ * @brief Resolves the allocator a container should instantiate for its item type.
+ * Allocators that need to know the item type (e.g. to keep items inline) expose
+ * a nested ForElementType template, any other allocator is used as is.
+*/
+template<class AllocatorType, class ItemType, class = void>
+struct TAllocatorForElement
+{
+    using Type = AllocatorType;
+};
+
+template<class AllocatorType, class ItemType>
+struct TAllocatorForElement<AllocatorType, ItemType, std::void_t<typename AllocatorType::template ForElementType<ItemType>>>
+{
+    using Type = typename AllocatorType::template ForElementType<ItemType>;
+};
+
+/**
+ * @brief Default growth policy shared by the allocators that can grow.
+ * @param newItemsCount Number of items that must fit.
+ * @param currItemsCount Number of items currently allocated.
+ * @return The new number of items to allocate.
+*/
+template<class SizeType>
+constexpr SizeType
+CalculateDefaultGrowth(SizeType newItemsCount, SizeType currItemsCount)
+{
+    AE_ASSERT(newItemsCount > currItemsCount && newItemsCount > 0);
+
+    size_t result = 4;
+
+    if (currItemsCount) {
+        result = size_t(newItemsCount) + 3 * size_t(newItemsCount) / 8 + 16;
+    } else if (size_t(newItemsCount) > result) {
+        result = size_t(newItemsCount);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Allocates the items from the heap.
+ * Items are aligned to Alignment, or to their natural alignment when Alignment is 0,
+ * and never less than MemoryUtils::DefaultAlignment. Use MemoryUtils::CacheLineAlignment
+ * for arrays written by different threads or MemoryUtils::PageAlignment for page
+ * granular data, their size is then rounded up to the alignment so no other allocation
+ * shares their last cache line or page.
+*/
+template<class _SizeType, uint64 Alignment = 0>
 class THeapAllocator
 {
   public:
     using SizeType = _SizeType;
 
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+
+    template<class ItemType>
+    class ForElementType
+    {
+      public:
+        using SizeType = _SizeType;
+
+        static constexpr uint64 ItemAlignment = Alignment ? Alignment : alignof(ItemType);
+        static constexpr uint64 DataAlignment
+          = ItemAlignment > MemoryUtils::DefaultAlignment ? ItemAlignment : MemoryUtils::DefaultAlignment;
+
+        /**
+         * @brief Default constructor.
+        */
+        constexpr ForElementType()
+          : m_data(nullptr)
+        {}
+
+        /**
+         * @brief Move constructor.
+         * @param other 
+        */
+        constexpr ForElementType(ForElementType&& other)
+        {
+            m_data       = other.m_data;
+            other.m_data = nullptr;
+        }
+
+        /** Destructor.*/
+        ~ForElementType()
+        {
+            if (m_data) {
+                MemoryUtils::FreeAligned(m_data);
+                m_data = nullptr;
+            }
+        }
+
+        /**
+         * @brief Move assignment
+         * Be sure to destroy all items before.
+         * @param other 
+        */
+        constexpr ForElementType& operator=(ForElementType&& other)
+        {
+            AE_ASSERT((void*)this != (void*)&other);
+
+            if (m_data) {
+                MemoryUtils::FreeAligned(m_data);
+            }
+
+            m_data       = other.m_data;
+            other.m_data = nullptr;
+
+            return *this;
+        }
+
+        /**
+         * @brief Reallocate data to fit a count of items.
+         * @param count Number of items.
+         * @param oldCount Number of items currently allocated.
+         * @param itemSizeInBytes Size in bytes of a single item.
+         * @param relocator Moves the items when they cannot be copied, null if they can.
+        */
+        void Reallocate(SizeType count, SizeType oldCount, size_t itemSizeInBytes, const ItemRelocator* relocator = nullptr)
+        {
+            if (m_data && count == 0) {
+                MemoryUtils::FreeAligned(m_data);
+                m_data = nullptr;
+            } else if (m_data && relocator) {
+                AllocatorItem* data
+                  = reinterpret_cast<AllocatorItem*>(MemoryUtils::AllocateAligned(GetSizeInBytes(count, itemSizeInBytes), DataAlignment));
+                relocator->Relocate(data, m_data, relocator->Count);
+                MemoryUtils::FreeAligned(m_data);
+                m_data = data;
+            } else if (m_data || count) {
+                m_data = reinterpret_cast<AllocatorItem*>(MemoryUtils::ReallocateAligned(
+                  m_data, GetSizeInBytes(oldCount, itemSizeInBytes), GetSizeInBytes(count, itemSizeInBytes), DataAlignment));
+            }
+        }
+
+        SizeType CalculateGrowth(SizeType newItemsCount, SizeType currItemsCount) const
+        {
+#if AE_MEMORY_TRACKING
+            MemoryTracker::OnContainerGrowth();
+#endif
+            return CalculateDefaultGrowth(newItemsCount, currItemsCount);
+        }
+
+        constexpr SizeType CalculateReserve(SizeType itemsCount) const { return itemsCount; }
+
+        /**
+         * @brief Get allocated data.
+         * @return Pointer to allocated data.
+        */
+        constexpr AllocatorItem* GetData() const { return m_data; }
+
+        /**
+         * @brief Checks if there is allocated data.
+         * @return True if there is allocated data else otherwise.
+        */
+        constexpr bool HasAllocatedData() const { return !!m_data; }
+
+      private:
+        ForElementType(const ForElementType&);
+        ForElementType& operator=(const ForElementType&);
+
+        static constexpr uint64 GetSizeInBytes(SizeType count, size_t itemSizeInBytes)
+        {
+            const uint64 size = count * itemSizeInBytes;
+            return DataAlignment > MemoryUtils::DefaultAlignment ? MemoryUtils::AlignAddress(size, DataAlignment) : size;
+        }
+
+        AllocatorItem* m_data;
+    };
+};
+
+/**
+ * @brief Keeps the first InlineCount items inside the container itself.
+ * Only when the container grows past InlineCount the items are moved to the
+ * secondary allocator, so small containers never touch the heap.
+*/
+template<uint32 InlineCount, class SecondaryAllocator = THeapAllocator<uint64>>
+class TInlineAllocator
+{
+  public:
+    using SizeType = typename SecondaryAllocator::SizeType;
+
+    template<class ItemType>
+    class ForElementType
+    {
+      public:
+        using SizeType = typename SecondaryAllocator::SizeType;
+
+        /**
+         * @brief Default constructor.
+        */
+        constexpr ForElementType() {}
+
+        /**
+         * @brief Move constructor.
+         * @param other 
+        */
+        constexpr ForElementType(ForElementType&& other)
+          : m_secondary(std::move(other.m_secondary))
+        {
+            if constexpr (TIsTriviallyRelocatable<ItemType>::Value) {
+                MemoryUtils::CopyMemory(m_inlineData, other.m_inlineData, sizeof(m_inlineData));
+            }
+        }
+
+        /**
+         * @brief Move assignment
+         * Be sure to destroy all items before. Inline items that are not trivially relocatable
+         * stay in other, the container must relocate them.
+         * @param other 
+        */
+        constexpr ForElementType& operator=(ForElementType&& other)
+        {
+            AE_ASSERT((void*)this != (void*)&other);
+
+            m_secondary = std::move(other.m_secondary);
+            if constexpr (TIsTriviallyRelocatable<ItemType>::Value) {
+                if (!m_secondary.HasAllocatedData()) {
+                    MemoryUtils::CopyMemory(m_inlineData, other.m_inlineData, sizeof(m_inlineData));
+                }
+            }
+
+            return *this;
+        }
+
+        /**
+         * @brief Reallocate data to fit a count of items.
+         * Items are moved between the inline storage and the secondary allocator when needed.
+         * @param count Number of items.
+         * @param oldCount Number of items currently allocated.
+         * @param itemSizeInBytes Size in bytes of a single item.
+         * @param relocator Moves the items when they cannot be copied, null if they can.
+        */
+        void Reallocate(SizeType count, SizeType oldCount, size_t itemSizeInBytes, const ItemRelocator* relocator = nullptr)
+        {
+            AE_ASSERT(itemSizeInBytes == sizeof(ItemType));
+
+            if (count > InlineCount) {
+                if (m_secondary.HasAllocatedData()) {
+                    m_secondary.Reallocate(count, oldCount, itemSizeInBytes, relocator);
+                } else {
+                    m_secondary.Reallocate(count, 0, itemSizeInBytes);
+                    MoveItems(m_secondary.GetData(), m_inlineData, oldCount < InlineCount ? oldCount : InlineCount, relocator);
+                }
+            } else if (m_secondary.HasAllocatedData()) {
+                MoveItems(m_inlineData, m_secondary.GetData(), oldCount < count ? oldCount : count, relocator);
+                m_secondary.Reallocate(0, oldCount, itemSizeInBytes);
+            }
+        }
+
+        constexpr SizeType CalculateGrowth(SizeType newItemsCount, SizeType currItemsCount) const
+        {
+            if (newItemsCount <= InlineCount) {
+                return InlineCount;
+            }
+
+            return m_secondary.CalculateGrowth(newItemsCount, currItemsCount);
+        }
+
+        constexpr SizeType CalculateReserve(SizeType itemsCount) const
+        {
+            if (itemsCount <= InlineCount) {
+                return InlineCount;
+            }
+
+            return m_secondary.CalculateReserve(itemsCount);
+        }
+
+        /**
+         * @brief Get allocated data.
+         * @return Pointer to the inline storage or to the secondary allocator's data.
+        */
+        constexpr AllocatorItem* GetData() const
+        {
+            if (m_secondary.HasAllocatedData()) {
+                return m_secondary.GetData();
+            }
+
+            return reinterpret_cast<AllocatorItem*>(const_cast<uint8*>(m_inlineData));
+        }
+
+        /**
+         * @brief Checks if the items were moved to the secondary allocator.
+         * @return True if there is allocated data else otherwise.
+        */
+        constexpr bool HasAllocatedData() const { return m_secondary.HasAllocatedData(); }
+
+      private:
+        ForElementType(const ForElementType&);
+        ForElementType& operator=(const ForElementType&);
+
+        static void MoveItems(void* dst, void* src, SizeType count, const ItemRelocator* relocator)
+        {
+            if (relocator) {
+                relocator->Relocate(dst, src, relocator->Count < count ? relocator->Count : count);
+            } else if (count) {
+                MemoryUtils::CopyMemory(dst, src, count * sizeof(ItemType));
+            }
+        }
+
+        alignas(ItemType) uint8 m_inlineData[InlineCount * sizeof(ItemType)];
+
+        typename TAllocatorForElement<SecondaryAllocator, ItemType>::Type m_secondary;
+    };
+};
+
+/**
+ * @brief Keeps up to Capacity items inside the container and never allocates.
+ * Growing past Capacity aborts the program in every build, so growth and reserve
+ * calculations are reduced to bounds checks.
+*/
+template<uint32 Capacity>
+class TFixedAllocator
+{
+  public:
+    using SizeType = uint32;
+
+    template<class ItemType>
+    class ForElementType
+    {
+      public:
+        using SizeType = uint32;
+
+        /**
+         * @brief Default constructor.
+        */
+        constexpr ForElementType() {}
+
+        /**
+         * @brief Move constructor.
+         * @param other 
+        */
+        constexpr ForElementType(ForElementType&& other)
+        {
+            if constexpr (TIsTriviallyRelocatable<ItemType>::Value) {
+                MemoryUtils::CopyMemory(m_inlineData, other.m_inlineData, sizeof(m_inlineData));
+            }
+        }
+
+        /**
+         * @brief Move assignment
+         * Be sure to destroy all items before. Items that are not trivially relocatable stay in
+         * other, the container must relocate them.
+         * @param other 
+        */
+        constexpr ForElementType& operator=(ForElementType&& other)
+        {
+            AE_ASSERT((void*)this != (void*)&other);
+
+            if constexpr (TIsTriviallyRelocatable<ItemType>::Value) {
+                MemoryUtils::CopyMemory(m_inlineData, other.m_inlineData, sizeof(m_inlineData));
+            }
+
+            return *this;
+        }
+
+        /**
+         * @brief Checks that a count of items fits into the inline storage.
+         * @param count Number of items.
+         * @param oldCount Number of items currently allocated.
+         * @param itemSizeInBytes Size in bytes of a single item.
+         * @param relocator Unused, the items never move.
+        */
+        constexpr void Reallocate(SizeType count, SizeType oldCount, size_t itemSizeInBytes, const ItemRelocator* relocator = nullptr)
+        {
+            AE_ASSERT(itemSizeInBytes == sizeof(ItemType));
+            AE_CHECK(count <= Capacity);
+        }
+
+        constexpr SizeType CalculateGrowth(SizeType newItemsCount, SizeType currItemsCount) const
+        {
+            AE_CHECK(newItemsCount <= Capacity);
+            return Capacity;
+        }
+
+        constexpr SizeType CalculateReserve(SizeType itemsCount) const
+        {
+            AE_CHECK(itemsCount <= Capacity);
+            return Capacity;
+        }
+
+        /**
+         * @brief Get allocated data.
+         * @return Pointer to the inline storage.
+        */
+        constexpr AllocatorItem* GetData() const { return reinterpret_cast<AllocatorItem*>(const_cast<uint8*>(m_inlineData)); }
+
+        /**
+         * @brief Checks if there is allocated data.
+         * @return Always false, the items are never allocated.
+        */
+        constexpr bool HasAllocatedData() const { return false; }
+
+      private:
+        ForElementType(const ForElementType&);
+        ForElementType& operator=(const ForElementType&);
+
+        alignas(ItemType) uint8 m_inlineData[Capacity * sizeof(ItemType)];
+    };
+};
+
+/**
+ * @brief Allocates from the calling thread's frame arena.
+ * Growth bumps the arena (in place when the items are the arena's last allocation)
+ * and freeing is O(1). Containers using it must not outlive the frame, nor be
+ * used from another thread. Items are aligned to Alignment, raised to their own
+ * alignment when it is larger.
+*/
+template<class _SizeType, uint64 Alignment = MemoryUtils::DefaultAlignment>
+class TArenaAllocator
+{
+  public:
+    using SizeType = _SizeType;
+
+    template<class ItemType>
+    using ForElementType = TArenaAllocator<_SizeType, (alignof(ItemType) > Alignment ? alignof(ItemType) : Alignment)>;
+
     /**
-     * @brief Default constructor.
+     * @brief Default constructor, binds the allocator to the thread's frame arena.
     */
-    constexpr THeapAllocator()
-      : m_data(nullptr)
+    TArenaAllocator()
+      : m_arena(&MemoryArena::GetFrameArena())
+      , m_data(nullptr)
+      , m_sizeInBytes(0)
     {}
 
     /**
      * @brief Move constructor.
      * @param other 
     */
-    constexpr THeapAllocator(THeapAllocator&& other)
+    constexpr TArenaAllocator(TArenaAllocator&& other)
+      : m_arena(other.m_arena)
+      , m_data(other.m_data)
+      , m_sizeInBytes(other.m_sizeInBytes)
     {
-        m_data       = other.m_data;
-        other.m_data = nullptr;
+        other.m_data        = nullptr;
+        other.m_sizeInBytes = 0;
     }
 
     /** Destructor.*/
-    ~THeapAllocator()
+    ~TArenaAllocator()
     {
         if (m_data) {
-            MemoryUtils::FreeAligned(m_data);
-            m_data = nullptr;
+            m_arena->Free(m_data, m_sizeInBytes);
         }
     }
 
@@ -47,16 +477,20 @@ class THeapAllocator
      * Be sure to destroy all items before.
      * @param other 
     */
-    constexpr THeapAllocator& operator=(THeapAllocator&& other)
+    constexpr TArenaAllocator& operator=(TArenaAllocator&& other)
     {
         AE_ASSERT((void*)this != (void*)&other);
 
         if (m_data) {
-            MemoryUtils::FreeAligned(m_data);
+            m_arena->Free(m_data, m_sizeInBytes);
         }
 
-        m_data       = other.m_data;
-        other.m_data = nullptr;
+        m_arena       = other.m_arena;
+        m_data        = other.m_data;
+        m_sizeInBytes = other.m_sizeInBytes;
+
+        other.m_data        = nullptr;
+        other.m_sizeInBytes = 0;
 
         return *this;
     }
@@ -64,29 +498,158 @@ class THeapAllocator
     /**
      * @brief Reallocate data to fit a count of items.
      * @param count Number of items.
+     * @param oldCount Number of items currently allocated.
      * @param itemSizeInBytes Size in bytes of a single item.
+     * @param relocator Moves the items when they cannot be copied, null if they can.
     */
-    void Reallocate(SizeType count, SizeType oldCount, size_t itemSizeInBytes)
+    void Reallocate(SizeType count, SizeType oldCount, size_t itemSizeInBytes, const ItemRelocator* relocator = nullptr)
     {
-        if (m_data || count) {
-            m_data = reinterpret_cast<AllocatorItem*>(
-              MemoryUtils::ReallocateAligned(m_data, oldCount * itemSizeInBytes, count * itemSizeInBytes));
+        if (m_data && count == 0) {
+            m_arena->Free(m_data, m_sizeInBytes);
+            m_data        = nullptr;
+            m_sizeInBytes = 0;
+        } else if (m_data && relocator) {
+            const uint64   sizeInBytes = count * itemSizeInBytes;
+            AllocatorItem* data        = reinterpret_cast<AllocatorItem*>(m_arena->Allocate(sizeInBytes, Alignment));
+            relocator->Relocate(data, m_data, relocator->Count);
+            m_arena->Free(m_data, m_sizeInBytes);
+            m_data        = data;
+            m_sizeInBytes = sizeInBytes;
+        } else if (count) {
+            const uint64 sizeInBytes = count * itemSizeInBytes;
+            m_data        = reinterpret_cast<AllocatorItem*>(m_arena->Reallocate(m_data, m_sizeInBytes, sizeInBytes, Alignment));
+            m_sizeInBytes = sizeInBytes;
         }
     }
 
     constexpr SizeType CalculateGrowth(SizeType newItemsCount, SizeType currItemsCount) const
     {
-        AE_ASSERT(newItemsCount > currItemsCount && newItemsCount > 0);
+        return CalculateDefaultGrowth(newItemsCount, currItemsCount);
+    }
+
+    constexpr SizeType CalculateReserve(SizeType itemsCount) const { return itemsCount; }
+
+    /**
+     * @brief Get allocated data.
+     * @return Pointer to allocated data.
+    */
+    constexpr AllocatorItem* GetData() const { return m_data; }
+
+    /**
+     * @brief Checks if there is allocated data.
+     * @return True if there is allocated data else otherwise.
+    */
+    constexpr bool HasAllocatedData() const { return !!m_data; }
+
+  private:
+    TArenaAllocator(const TArenaAllocator&);
+    TArenaAllocator& operator=(const TArenaAllocator&);
+
+    MemoryArena*   m_arena;
+    AllocatorItem* m_data;
+    uint64         m_sizeInBytes;
+};
+
+/**
+ * @brief Allocates from the frame allocator shared by every thread.
+ * Any thread can fill its own containers concurrently, growth bumps the thread's
+ * sub-block (in place when the items are the thread's last allocation) and freeing
+ * is O(1). The containers can be handed to other threads but must not outlive the frame.
+*/
+template<class _SizeType, uint64 Alignment = MemoryUtils::DefaultAlignment>
+class TConcurrentFrameAllocator
+{
+  public:
+    using SizeType = _SizeType;
+
+    template<class ItemType>
+    using ForElementType = TConcurrentFrameAllocator<_SizeType, (alignof(ItemType) > Alignment ? alignof(ItemType) : Alignment)>;
+
+    /**
+     * @brief Default constructor, binds the allocator to the frame allocator.
+    */
+    TConcurrentFrameAllocator()
+      : m_allocator(&ConcurrentLinearAllocator::GetFrameAllocator())
+      , m_data(nullptr)
+      , m_sizeInBytes(0)
+    {}
+
+    /**
+     * @brief Move constructor.
+     * @param other 
+    */
+    constexpr TConcurrentFrameAllocator(TConcurrentFrameAllocator&& other)
+      : m_allocator(other.m_allocator)
+      , m_data(other.m_data)
+      , m_sizeInBytes(other.m_sizeInBytes)
+    {
+        other.m_data        = nullptr;
+        other.m_sizeInBytes = 0;
+    }
+
+    /** Destructor.*/
+    ~TConcurrentFrameAllocator()
+    {
+        if (m_data) {
+            m_allocator->Free(m_data, m_sizeInBytes);
+        }
+    }
+
+    /**
+     * @brief Move assignment
+     * Be sure to destroy all items before.
+     * @param other 
+    */
+    constexpr TConcurrentFrameAllocator& operator=(TConcurrentFrameAllocator&& other)
+    {
+        AE_ASSERT((void*)this != (void*)&other);
+
+        if (m_data) {
+            m_allocator->Free(m_data, m_sizeInBytes);
+        }
+
+        m_allocator   = other.m_allocator;
+        m_data        = other.m_data;
+        m_sizeInBytes = other.m_sizeInBytes;
 
-        size_t result = 4;
+        other.m_data        = nullptr;
+        other.m_sizeInBytes = 0;
 
-        if (currItemsCount) {
-            result = size_t(newItemsCount) + 3 * size_t(newItemsCount) / 8 + 16;
-        } else if (size_t(newItemsCount) > result) {
-            result = size_t(newItemsCount);
+        return *this;
+    }
+
+    /**
+     * @brief Reallocate data to fit a count of items.
+     * @param count Number of items.
+     * @param oldCount Number of items currently allocated.
+     * @param itemSizeInBytes Size in bytes of a single item.
+     * @param relocator Moves the items when they cannot be copied, null if they can.
+    */
+    void Reallocate(SizeType count, SizeType oldCount, size_t itemSizeInBytes, const ItemRelocator* relocator = nullptr)
+    {
+        if (m_data && count == 0) {
+            m_allocator->Free(m_data, m_sizeInBytes);
+            m_data        = nullptr;
+            m_sizeInBytes = 0;
+        } else if (m_data && relocator) {
+            const uint64   sizeInBytes = count * itemSizeInBytes;
+            AllocatorItem* data        = reinterpret_cast<AllocatorItem*>(m_allocator->Allocate(sizeInBytes, Alignment));
+            AE_ASSERT(data);
+            relocator->Relocate(data, m_data, relocator->Count);
+            m_allocator->Free(m_data, m_sizeInBytes);
+            m_data        = data;
+            m_sizeInBytes = sizeInBytes;
+        } else if (count) {
+            const uint64 sizeInBytes = count * itemSizeInBytes;
+            m_data        = reinterpret_cast<AllocatorItem*>(m_allocator->Reallocate(m_data, m_sizeInBytes, sizeInBytes, Alignment));
+            m_sizeInBytes = sizeInBytes;
+            AE_ASSERT(m_data);
         }
+    }
 
-        return result;
+    constexpr SizeType CalculateGrowth(SizeType newItemsCount, SizeType currItemsCount) const
+    {
+        return CalculateDefaultGrowth(newItemsCount, currItemsCount);
     }
 
     constexpr SizeType CalculateReserve(SizeType itemsCount) const { return itemsCount; }
@@ -104,8 +667,164 @@ class THeapAllocator
     constexpr bool HasAllocatedData() const { return !!m_data; }
 
   private:
-    THeapAllocator(const THeapAllocator&);
-    THeapAllocator& operator=(const THeapAllocator&);
+    TConcurrentFrameAllocator(const TConcurrentFrameAllocator&);
+    TConcurrentFrameAllocator& operator=(const TConcurrentFrameAllocator&);
 
-    AllocatorItem* m_data;
-};
\ No newline at end of file
+    ConcurrentLinearAllocator* m_allocator;
+    AllocatorItem*             m_data;
+    uint64                     m_sizeInBytes;
+};
+
+/**
+ * @brief Reserves ReservedSizeInBytes of address space and commits it as the container grows.
+ * The items never move, so growth costs no copies, and the memory is committed in
+ * huge page units and advised to be backed by transparent huge pages, which reduces
+ * TLB misses on very large containers. Falls back to normal pages when huge pages
+ * are not available.
+*/
+template<class _SizeType = uint64, uint64 ReservedSizeInBytes = 64ull * 1024 * 1024 * 1024>
+class THugePageAllocator
+{
+  public:
+    using SizeType = _SizeType;
+
+    template<class ItemType>
+    class ForElementType
+    {
+      public:
+        using SizeType = _SizeType;
+
+        /**
+         * @brief Default constructor, no address space is reserved until the first allocation.
+        */
+        constexpr ForElementType()
+          : m_reservation(nullptr)
+          , m_data(nullptr)
+          , m_committedSize(0)
+        {}
+
+        /**
+         * @brief Move constructor.
+         * @param other 
+        */
+        constexpr ForElementType(ForElementType&& other)
+          : m_reservation(other.m_reservation)
+          , m_data(other.m_data)
+          , m_committedSize(other.m_committedSize)
+        {
+            other.m_reservation   = nullptr;
+            other.m_data          = nullptr;
+            other.m_committedSize = 0;
+        }
+
+        /** Destructor.*/
+        ~ForElementType() { Release(); }
+
+        /**
+         * @brief Move assignment
+         * Be sure to destroy all items before.
+         * @param other 
+        */
+        ForElementType& operator=(ForElementType&& other)
+        {
+            AE_ASSERT((void*)this != (void*)&other);
+
+            Release();
+
+            m_reservation   = other.m_reservation;
+            m_data          = other.m_data;
+            m_committedSize = other.m_committedSize;
+
+            other.m_reservation   = nullptr;
+            other.m_data          = nullptr;
+            other.m_committedSize = 0;
+
+            return *this;
+        }
+
+        /**
+         * @brief Commits or decommits memory to fit a count of items, the items never move.
+         * @param count Number of items.
+         * @param oldCount Number of items currently allocated.
+         * @param itemSizeInBytes Size in bytes of a single item.
+         * @param relocator Unused, the items never move.
+        */
+        void Reallocate(SizeType count, SizeType oldCount, size_t itemSizeInBytes, const ItemRelocator* relocator = nullptr)
+        {
+            if (count == 0) {
+                Release();
+                return;
+            }
+
+            const uint64 hugePageSize = PlatformMemory::GetHugePageSize();
+            const uint64 size         = MemoryUtils::AlignAddress(count * itemSizeInBytes, hugePageSize);
+            AE_ASSERT(size <= ReservedSizeInBytes);
+
+            if (!m_data) {
+                m_reservation = reinterpret_cast<uint8*>(PlatformMemory::Reserve(ReservedSizeInBytes + hugePageSize));
+                AE_ASSERT(m_reservation);
+                m_data = MemoryUtils::AlignPointer(m_reservation, hugePageSize);
+            }
+
+            if (size > m_committedSize) {
+                const bool committed = PlatformMemory::Commit(m_data + m_committedSize, size - m_committedSize);
+                AE_ASSERT(committed);
+                (void)committed;
+
+                PlatformMemory::AdviseHugePages(m_data + m_committedSize, size - m_committedSize);
+            } else if (size < m_committedSize) {
+                PlatformMemory::Decommit(m_data + size, m_committedSize - size);
+            }
+
+            m_committedSize = size;
+        }
+
+        SizeType CalculateGrowth(SizeType newItemsCount, SizeType currItemsCount) const
+        {
+            AE_ASSERT(newItemsCount > currItemsCount && newItemsCount > 0);
+            return CalculateReserve(newItemsCount);
+        }
+
+        SizeType CalculateReserve(SizeType itemsCount) const
+        {
+            const uint64 size = MemoryUtils::AlignAddress(itemsCount * sizeof(ItemType), PlatformMemory::GetHugePageSize());
+            return static_cast<SizeType>(size / sizeof(ItemType));
+        }
+
+        /**
+         * @brief Get allocated data.
+         * @return Pointer to allocated data.
+        */
+        constexpr AllocatorItem* GetData() const { return reinterpret_cast<AllocatorItem*>(m_data); }
+
+        /**
+         * @brief Checks if there is allocated data.
+         * @return True if there is allocated data else otherwise.
+        */
+        constexpr bool HasAllocatedData() const { return !!m_data; }
+
+        /**
+         * @brief Returns the number of bytes backed by memory.
+         * @return Committed size in bytes.
+        */
+        constexpr uint64 GetCommittedSize() const { return m_committedSize; }
+
+      private:
+        ForElementType(const ForElementType&);
+        ForElementType& operator=(const ForElementType&);
+
+        void Release()
+        {
+            if (m_reservation) {
+                PlatformMemory::Release(m_reservation, ReservedSizeInBytes + PlatformMemory::GetHugePageSize());
+                m_reservation   = nullptr;
+                m_data          = nullptr;
+                m_committedSize = 0;
+            }
+        }
+
+        uint8* m_reservation;
+        uint8* m_data;
+        uint64 m_committedSize;
+    };
+};
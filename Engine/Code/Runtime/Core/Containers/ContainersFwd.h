@@ -1,10 +1,29 @@
 #pragma once
 
-template<class>
+template<class, unsigned long long>
 class THeapAllocator;
 
-using DefaultHeapAllocator   = THeapAllocator<unsigned int>;       // 32 bits
-using DefaultHeapAllocator64 = THeapAllocator<unsigned long long>; // 64 bits
+using DefaultHeapAllocator   = THeapAllocator<unsigned int, 0>;       // 32 bits
+using DefaultHeapAllocator64 = THeapAllocator<unsigned long long, 0>; // 64 bits
+
+template<unsigned int, class>
+class TInlineAllocator;
+
+template<unsigned int>
+class TFixedAllocator;
+
+template<class, unsigned long long>
+class TArenaAllocator;
+
+using DefaultArenaAllocator = TArenaAllocator<unsigned long long, 16>;
+
+template<class, unsigned long long>
+class TConcurrentFrameAllocator;
+
+using DefaultConcurrentFrameAllocator = TConcurrentFrameAllocator<unsigned long long, 16>;
+
+template<class, unsigned long long>
+class THugePageAllocator;
 
 template<class T, class Allocator = DefaultHeapAllocator64>
 class TArray;
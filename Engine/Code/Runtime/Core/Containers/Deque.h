@@ -0,0 +1,306 @@
+#pragma once
+
+#include "RingBuffer.h"
+
+/**
+ * @brief Double ended queue of items stored in fixed size blocks.
+ * Adding and removing at either end is O(1) and never moves an item, so references to items stay
+ * valid until the item is removed, unlike TRingBuffer and TArray. A ring buffer of block pointers
+ * keeps the blocks in order, the allocator is used for it while the blocks come from the heap.
+ * An emptied block is kept for reuse, so a queue that stays around the same size does not allocate.
+*/
+template<class _ItemType, class _AllocType = DefaultHeapAllocator64>
+class TDeque
+{
+  public:
+    using ItemType = _ItemType;
+    using SizeType = typename _AllocType::SizeType;
+
+    /** Number of items in a block, a power of two filling about 4KB.*/
+    static constexpr SizeType BlockSize
+      = sizeof(ItemType) <= 256 ? static_cast<SizeType>(4096 / Math::RoundUpToPowerOfTwo(static_cast<uint32>(sizeof(ItemType)))) : 16;
+
+    template<class DequeType, class IteratedType>
+    class TIterator
+    {
+      public:
+        TIterator(DequeType* deque, SizeType index)
+          : m_deque(deque)
+          , m_index(index)
+        {}
+
+        IteratedType& operator*() const { return (*m_deque)[m_index]; }
+        IteratedType* operator->() const { return &(*m_deque)[m_index]; }
+
+        TIterator& operator++()
+        {
+            m_index++;
+            return *this;
+        }
+
+        bool operator==(const TIterator& other) const { return m_index == other.m_index; }
+        bool operator!=(const TIterator& other) const { return m_index != other.m_index; }
+
+      private:
+        DequeType* m_deque;
+        SizeType   m_index;
+    };
+
+    using Iterator      = TIterator<TDeque, ItemType>;
+    using ConstIterator = TIterator<const TDeque, const ItemType>;
+
+    /**
+     * @brief Default constructor, no memory is allocated until the first item.
+    */
+    TDeque()
+      : m_spareBlock(nullptr)
+      , m_first(0)
+      , m_size(0)
+    {}
+
+    /**
+     * @brief Copy constructor, the items are copied in order.
+     * @param other Deque to be copied.
+    */
+    TDeque(const TDeque& other)
+      : TDeque()
+    {
+        for (const ItemType& item : other) {
+            EmplaceBack(item);
+        }
+    }
+
+    /**
+     * @brief Move constructor, the items keep their addresses.
+     * @param other Deque to be moved, left empty.
+    */
+    TDeque(TDeque&& other) noexcept
+      : m_blocks(std::move(other.m_blocks))
+      , m_spareBlock(other.m_spareBlock)
+      , m_first(other.m_first)
+      , m_size(other.m_size)
+    {
+        other.m_spareBlock = nullptr;
+        other.m_first      = 0;
+        other.m_size       = 0;
+    }
+
+    ~TDeque() { Clear(true); }
+
+    TDeque& operator=(const TDeque& other)
+    {
+        if (this != &other) {
+            *this = TDeque(other);
+        }
+        return *this;
+    }
+
+    TDeque& operator=(TDeque&& other) noexcept
+    {
+        if (this != &other) {
+            Clear(true);
+
+            m_blocks     = std::move(other.m_blocks);
+            m_spareBlock = other.m_spareBlock;
+            m_first      = other.m_first;
+            m_size       = other.m_size;
+
+            other.m_spareBlock = nullptr;
+            other.m_first      = 0;
+            other.m_size       = 0;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Adds an item constructed in place after the last item.
+     * @param args Arguments passed to the item's constructor.
+     * @return Reference to the added item.
+    */
+    template<class... ArgsType>
+    ItemType& EmplaceBack(ArgsType&&... args)
+    {
+        const SizeType end = m_first + m_size;
+        if (end == m_blocks.GetSize() * BlockSize) {
+            m_blocks.PushBack(AllocateBlock());
+        }
+
+        ItemType* item = new (m_blocks[end / BlockSize] + (end & (BlockSize - 1))) ItemType(std::forward<ArgsType>(args)...);
+        m_size++;
+        return *item;
+    }
+
+    /**
+     * @brief Adds an item constructed in place before the first item.
+     * @param args Arguments passed to the item's constructor.
+     * @return Reference to the added item.
+    */
+    template<class... ArgsType>
+    ItemType& EmplaceFront(ArgsType&&... args)
+    {
+        if (m_first == 0) {
+            m_blocks.PushFront(AllocateBlock());
+            m_first = BlockSize;
+        }
+
+        ItemType* item = new (m_blocks.GetFront() + m_first - 1) ItemType(std::forward<ArgsType>(args)...);
+        m_first--;
+        m_size++;
+        return *item;
+    }
+
+    ItemType& PushBack(const ItemType& item) { return EmplaceBack(item); }
+    ItemType& PushBack(ItemType&& item) { return EmplaceBack(std::move(item)); }
+    ItemType& PushFront(const ItemType& item) { return EmplaceFront(item); }
+    ItemType& PushFront(ItemType&& item) { return EmplaceFront(std::move(item)); }
+
+    /**
+     * @brief Removes the first item.
+     * @return The removed item.
+    */
+    ItemType PopFront()
+    {
+        ItemType& item   = GetFront();
+        ItemType  result = std::move(item);
+        MemoryUtils::DestroyItems(&item, 1);
+
+        m_first++;
+        m_size--;
+        if (m_first == BlockSize) {
+            FreeBlock(m_blocks.PopFront());
+            m_first = 0;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Removes the last item.
+     * @return The removed item.
+    */
+    ItemType PopBack()
+    {
+        ItemType& item   = GetBack();
+        ItemType  result = std::move(item);
+        MemoryUtils::DestroyItems(&item, 1);
+
+        m_size--;
+        if (((m_first + m_size) & (BlockSize - 1)) == 0) {
+            FreeBlock(m_blocks.PopBack());
+            if (m_blocks.IsEmpty()) {
+                m_first = 0;
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Returns the first item.
+     * @return Reference to the first item.
+    */
+    ItemType& GetFront()
+    {
+        AE_ASSERT(!IsEmpty());
+        return m_blocks.GetFront()[m_first];
+    }
+
+    const ItemType& GetFront() const { return const_cast<TDeque*>(this)->GetFront(); }
+
+    /**
+     * @brief Returns the last item.
+     * @return Reference to the last item.
+    */
+    ItemType& GetBack()
+    {
+        AE_ASSERT(!IsEmpty());
+        return m_blocks.GetBack()[(m_first + m_size - 1) & (BlockSize - 1)];
+    }
+
+    const ItemType& GetBack() const { return const_cast<TDeque*>(this)->GetBack(); }
+
+    /**
+     * @brief Returns an item by its position from the front.
+     * @param pos Position of the item, 0 is the first item.
+     * @return Reference to the item.
+    */
+    ItemType& operator[](SizeType pos)
+    {
+        AE_ASSERT(pos < m_size);
+        const SizeType index = m_first + pos;
+        return m_blocks[index / BlockSize][index & (BlockSize - 1)];
+    }
+
+    const ItemType& operator[](SizeType pos) const { return const_cast<TDeque*>(this)->operator[](pos); }
+
+    /**
+     * @brief Destroys every item.
+     * @param shrink If the memory should be released, else one block is kept for reuse.
+    */
+    void Clear(bool shrink = false)
+    {
+        if constexpr (!std::is_trivially_destructible_v<ItemType>) {
+            for (SizeType i = 0; i < m_size; i++) {
+                MemoryUtils::DestroyItems(&(*this)[i], 1);
+            }
+        }
+
+        while (!m_blocks.IsEmpty()) {
+            FreeBlock(m_blocks.PopBack());
+        }
+
+        if (shrink && m_spareBlock) {
+            MemoryUtils::FreeAligned(m_spareBlock);
+            m_spareBlock = nullptr;
+        }
+
+        m_blocks.Clear(shrink);
+        m_first = 0;
+        m_size  = 0;
+    }
+
+    /**
+     * @brief Returns the number of items.
+     * @return The number of items.
+    */
+    constexpr SizeType GetSize() const { return m_size; }
+
+    /**
+     * @brief Checks if the deque is empty.
+     * @return True if the deque is empty, false otherwise.
+    */
+    constexpr bool IsEmpty() const { return m_size == 0; }
+
+    Iterator      begin() { return Iterator(this, 0); }
+    Iterator      end() { return Iterator(this, m_size); }
+    ConstIterator begin() const { return ConstIterator(this, 0); }
+    ConstIterator end() const { return ConstIterator(this, m_size); }
+
+  private:
+    static constexpr uint64 BlockAlignment
+      = alignof(ItemType) > MemoryUtils::DefaultAlignment ? alignof(ItemType) : MemoryUtils::DefaultAlignment;
+
+    ItemType* AllocateBlock()
+    {
+        ItemType* block = m_spareBlock;
+        if (block) {
+            m_spareBlock = nullptr;
+        } else {
+            block = reinterpret_cast<ItemType*>(MemoryUtils::AllocateAligned(BlockSize * sizeof(ItemType), BlockAlignment));
+        }
+        return block;
+    }
+
+    void FreeBlock(ItemType* block)
+    {
+        if (m_spareBlock) {
+            MemoryUtils::FreeAligned(block);
+        } else {
+            m_spareBlock = block;
+        }
+    }
+
+  private:
+    TRingBuffer<ItemType*, _AllocType> m_blocks;
+    ItemType*                          m_spareBlock;
+    SizeType                           m_first;
+    SizeType                           m_size;
+};
@@ -0,0 +1,446 @@
+#pragma once
+
+#include "Array.h"
+#include "Set.h"
+
+/**
+ * @brief Key and value pair stored by TMap.
+*/
+template<class K, class V>
+struct TMapEntry
+{
+    K Key;
+    V Value;
+
+    /**
+     * @brief Constructs the key from a key or view, and the value from any arguments.
+     * @param key Key or view the key is constructed from.
+     * @param args Arguments passed to the value's constructor.
+    */
+    template<class KeyArgType, class... ArgsType>
+    TMapEntry(std::piecewise_construct_t, KeyArgType&& key, ArgsType&&... args)
+      : Key(std::forward<KeyArgType>(key))
+      , Value(std::forward<ArgsType>(args)...)
+    {}
+};
+
+/**
+ * @brief Unordered map of unique keys to values.
+ * Entries are stored inline and densely packed in an array, iterated in insertion
+ * order, and indexed by a flat open addressing table of control bytes and 32 bits
+ * indices probed like TSet's. Removing an entry moves the last entry into its place.
+ * Pointers to entries are invalidated by adding and removing entries.
+ * Find, Contains and Remove accept any key type the Hasher can hash and the keys
+ * can be compared with, FindOrAdd and Emplace only construct a key when one is added.
+*/
+template<class K, class V, class Hasher = TStdHash<K>>
+class TMap
+{
+    using Group = SetControlGroup;
+
+    static constexpr uint32 InvalidIndex = ~0u;
+
+    /** Entries are added until 7/8 of the slots are used.*/
+    static constexpr uint64 GetMaxCount(uint64 capacity) { return capacity - capacity / 8; }
+
+  public:
+    using KeyType   = K;
+    using ValueType = V;
+    using EntryType = TMapEntry<K, V>;
+    using SizeType  = uint64;
+
+    /**
+     * @brief Default constructor, no memory is allocated until the first entry.
+    */
+    TMap() = default;
+
+    /**
+     * @brief Copy constructor.
+     * @param other Map to be copied.
+    */
+    TMap(const TMap& other)
+      : m_hasher(other.m_hasher)
+      , m_entries(other.m_entries)
+    {
+        if (other.m_capacity) {
+            AllocateTable(other.m_capacity);
+            MemoryUtils::CopyMemory(m_controls, other.m_controls, m_capacity * (sizeof(uint8) + sizeof(uint32)));
+            m_growthLeft = other.m_growthLeft;
+        }
+    }
+
+    /**
+     * @brief Move constructor.
+     * @param other Map to be moved, left empty.
+    */
+    TMap(TMap&& other) noexcept
+      : m_hasher(std::move(other.m_hasher))
+      , m_entries(std::move(other.m_entries))
+      , m_controls(other.m_controls)
+      , m_indices(other.m_indices)
+      , m_capacity(other.m_capacity)
+      , m_growthLeft(other.m_growthLeft)
+    {
+        other.ForgetTable();
+    }
+
+    ~TMap() { ReleaseTable(); }
+
+    TMap& operator=(const TMap& other)
+    {
+        if (this != &other) {
+            *this = TMap(other);
+        }
+        return *this;
+    }
+
+    TMap& operator=(TMap&& other) noexcept
+    {
+        if (this != &other) {
+            ReleaseTable();
+
+            m_hasher     = std::move(other.m_hasher);
+            m_entries    = std::move(other.m_entries);
+            m_controls   = other.m_controls;
+            m_indices    = other.m_indices;
+            m_capacity   = other.m_capacity;
+            m_growthLeft = other.m_growthLeft;
+
+            other.ForgetTable();
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Sets the value of a key, adding the key if the map does not contain it yet.
+     * @param key Key or view the key is constructed from.
+     * @param value Value to be copied or moved.
+     * @return Reference to the value.
+    */
+    template<class KeyArgType, class ValueArgType>
+    V& Add(KeyArgType&& key, ValueArgType&& value)
+    {
+        const uint64   hash  = Hash(key);
+        const SizeType index = FindEntryIndex(key, hash);
+        if (index != InvalidIndex) {
+            return m_entries[index].Value = std::forward<ValueArgType>(value);
+        }
+
+        return AddEntry(hash, std::forward<KeyArgType>(key), std::forward<ValueArgType>(value));
+    }
+
+    /**
+     * @brief Returns the value of a key, adding the key with a default constructed value if needed.
+     * @param key Key or view the key is constructed from.
+     * @return Reference to the value.
+    */
+    template<class KeyArgType>
+    V& FindOrAdd(KeyArgType&& key)
+    {
+        return Emplace(std::forward<KeyArgType>(key));
+    }
+
+    /**
+     * @brief Constructs the value of a key in place if the map does not contain the key yet.
+     * @param key Key or view the key is constructed from.
+     * @param args Arguments passed to the value's constructor, unused if the key exists.
+     * @return Reference to the new value, or to the value already in the map.
+    */
+    template<class KeyArgType, class... ArgsType>
+    V& Emplace(KeyArgType&& key, ArgsType&&... args)
+    {
+        const uint64   hash  = Hash(key);
+        const SizeType index = FindEntryIndex(key, hash);
+        if (index != InvalidIndex) {
+            return m_entries[index].Value;
+        }
+
+        return AddEntry(hash, std::forward<KeyArgType>(key), std::forward<ArgsType>(args)...);
+    }
+
+    /**
+     * @brief Finds the value of a key.
+     * @param key Key or view comparable with the keys.
+     * @return Pointer to the value, null if the map does not contain the key.
+    */
+    template<class KeyArgType>
+    V* Find(const KeyArgType& key)
+    {
+        const SizeType index = FindEntryIndex(key, Hash(key));
+        return index != InvalidIndex ? &m_entries[index].Value : nullptr;
+    }
+
+    /**
+     * @brief Finds the value of a key.
+     * @param key Key or view comparable with the keys.
+     * @return Pointer to the value, null if the map does not contain the key.
+    */
+    template<class KeyArgType>
+    const V* Find(const KeyArgType& key) const
+    {
+        return const_cast<TMap*>(this)->Find(key);
+    }
+
+    /**
+     * @brief Checks if the map contains a key.
+     * @param key Key or view comparable with the keys.
+     * @return True if the map contains the key.
+    */
+    template<class KeyArgType>
+    bool Contains(const KeyArgType& key) const
+    {
+        return Find(key) != nullptr;
+    }
+
+    /**
+     * @brief Removes a key and its value.
+     * The last entry is moved into the removed entry's place.
+     * @param key Key or view comparable with the keys.
+     * @return True if the key was removed, false if the map did not contain it.
+    */
+    template<class KeyArgType>
+    bool Remove(const KeyArgType& key)
+    {
+        const SizeType slot = FindSlot(key, Hash(key));
+        if (slot == m_capacity) {
+            return false;
+        }
+
+        const uint32 index = m_indices[slot];
+        ClearSlot(slot);
+
+        const uint32 lastIndex = static_cast<uint32>(m_entries.GetSize() - 1);
+        if (index != lastIndex) {
+            m_indices[FindSlotOfEntry(lastIndex)] = index;
+        }
+        m_entries.RemoveAtSwap(index);
+
+        return true;
+    }
+
+    /**
+     * @brief Makes room for a number of entries without growing again.
+     * @param count Number of entries the map must hold.
+    */
+    void Reserve(SizeType count)
+    {
+        if (count > m_entries.GetCapacity()) {
+            m_entries.Reserve(count);
+        }
+        if (count > m_entries.GetSize() + m_growthLeft) {
+            Rehash(GetCapacityFor(count));
+        }
+    }
+
+    /**
+     * @brief Removes every entry.
+     * @param shrink Whether the memory is released too.
+    */
+    void Clear(bool shrink = false)
+    {
+        m_entries.Clear(shrink);
+        if (shrink) {
+            ReleaseTable();
+            ForgetTable();
+        } else if (m_capacity) {
+            memset(m_controls, Group::Empty, m_capacity);
+            m_growthLeft = GetMaxCount(m_capacity);
+        }
+    }
+
+    /**
+     * @brief Returns the number of entries.
+     * @return The number of entries.
+    */
+    constexpr SizeType GetCount() const { return m_entries.GetSize(); }
+
+    /**
+     * @brief Checks if the map has no entry.
+     * @return True if the map is empty.
+    */
+    constexpr bool IsEmpty() const { return m_entries.IsEmpty(); }
+
+    /**
+     * @brief Returns the entries, densely packed.
+     * @return Pointer to the first entry.
+    */
+    const EntryType* GetEntries() const { return m_entries.GetData(); }
+
+    EntryType*       begin() { return m_entries.begin(); }
+    EntryType*       end() { return m_entries.end(); }
+    const EntryType* begin() const { return m_entries.begin(); }
+    const EntryType* end() const { return m_entries.end(); }
+
+  private:
+    template<class KeyArgType>
+    uint64 Hash(const KeyArgType& key) const { return SetControlGroup::MixHash(static_cast<uint64>(m_hasher(key))); }
+
+    static constexpr uint8 GetControl(uint64 hash) { return static_cast<uint8>(hash & 0x7F); }
+
+    static SizeType GetCapacityFor(SizeType count)
+    {
+        SizeType capacity = Group::Width;
+        while (GetMaxCount(capacity) < count) {
+            capacity *= 2;
+        }
+        return capacity;
+    }
+
+    /** Returns the slot of the key, or the capacity when the map does not contain it.*/
+    template<class KeyArgType>
+    SizeType FindSlot(const KeyArgType& key, uint64 hash) const
+    {
+        if (m_entries.IsEmpty()) {
+            return m_capacity;
+        }
+
+        const EntryType* entries = m_entries.GetData();
+        const uint8      control = GetControl(hash);
+        const SizeType   mask    = m_capacity - 1;
+
+        SizeType groupIndex = (hash >> 7) & mask & ~SizeType(Group::Width - 1);
+        for (SizeType step = Group::Width;; step += Group::Width) {
+            const Group group(m_controls + groupIndex);
+            for (uint32 matches = group.Match(control); matches; matches &= matches - 1) {
+                const SizeType slot = groupIndex + Math::CountTrailingZeros(matches);
+                if (entries[m_indices[slot]].Key == key) {
+                    return slot;
+                }
+            }
+
+            if (group.MatchEmpty()) {
+                return m_capacity;
+            }
+
+            groupIndex = (groupIndex + step) & mask;
+        }
+    }
+
+    template<class KeyArgType>
+    SizeType FindEntryIndex(const KeyArgType& key, uint64 hash) const
+    {
+        const SizeType slot = FindSlot(key, hash);
+        return slot != m_capacity ? m_indices[slot] : InvalidIndex;
+    }
+
+    /** Returns the slot pointing to an entry, comparing indices instead of keys.*/
+    SizeType FindSlotOfEntry(uint32 index) const
+    {
+        const uint64   hash    = Hash(m_entries[index].Key);
+        const uint8    control = GetControl(hash);
+        const SizeType mask    = m_capacity - 1;
+
+        SizeType groupIndex = (hash >> 7) & mask & ~SizeType(Group::Width - 1);
+        for (SizeType step = Group::Width;; step += Group::Width) {
+            for (uint32 matches = Group(m_controls + groupIndex).Match(control); matches; matches &= matches - 1) {
+                const SizeType slot = groupIndex + Math::CountTrailingZeros(matches);
+                if (m_indices[slot] == index) {
+                    return slot;
+                }
+            }
+            groupIndex = (groupIndex + step) & mask;
+        }
+    }
+
+    /** Returns the first free slot of the probe sequence of a hash, the table must have one.*/
+    SizeType FindFreeSlot(uint64 hash) const
+    {
+        const SizeType mask = m_capacity - 1;
+
+        SizeType groupIndex = (hash >> 7) & mask & ~SizeType(Group::Width - 1);
+        for (SizeType step = Group::Width;; step += Group::Width) {
+            if (const uint32 free = Group(m_controls + groupIndex).MatchFree()) {
+                return groupIndex + Math::CountTrailingZeros(free);
+            }
+            groupIndex = (groupIndex + step) & mask;
+        }
+    }
+
+    template<class KeyArgType, class... ArgsType>
+    V& AddEntry(uint64 hash, KeyArgType&& key, ArgsType&&... args)
+    {
+        const SizeType count = m_entries.GetSize();
+        AE_ASSERT(count < InvalidIndex);
+
+        if (!m_capacity) {
+            Rehash(Group::Width);
+        } else if (m_growthLeft == 0 && m_controls[FindFreeSlot(hash)] == Group::Empty) {
+            // Deleted slots are dropped by rehashing at the same capacity, unless the entries alone nearly fill the table.
+            Rehash(count * 32 <= m_capacity * 25 ? m_capacity : m_capacity * 2);
+        }
+
+        const SizeType slot = FindFreeSlot(hash);
+        if (m_controls[slot] == Group::Empty) {
+            m_growthLeft--;
+        }
+
+        m_controls[slot] = GetControl(hash);
+        m_indices[slot]  = static_cast<uint32>(count);
+
+        const SizeType index = m_entries.Emplace(std::piecewise_construct, std::forward<KeyArgType>(key), std::forward<ArgsType>(args)...);
+        return m_entries[index].Value;
+    }
+
+    void ClearSlot(SizeType slot)
+    {
+        // A slot can only become empty again if its group never overflowed,
+        // otherwise a probe sequence may pass through it and must keep going.
+        const SizeType groupIndex = slot & ~SizeType(Group::Width - 1);
+        if (Group(m_controls + groupIndex).MatchEmpty()) {
+            m_controls[slot] = Group::Empty;
+            m_growthLeft++;
+        } else {
+            m_controls[slot] = Group::Deleted;
+        }
+    }
+
+    void AllocateTable(SizeType capacity)
+    {
+        m_controls   = reinterpret_cast<uint8*>(MemoryUtils::AllocateAligned(capacity * (sizeof(uint8) + sizeof(uint32)), Group::Width));
+        m_indices    = reinterpret_cast<uint32*>(m_controls + capacity);
+        m_capacity   = capacity;
+        m_growthLeft = GetMaxCount(capacity);
+
+        memset(m_controls, Group::Empty, capacity);
+    }
+
+    /** Rebuilds the table from the entries, which never move.*/
+    void Rehash(SizeType capacity)
+    {
+        ReleaseTable();
+        AllocateTable(capacity);
+
+        const SizeType count = m_entries.GetSize();
+        for (SizeType i = 0; i < count; i++) {
+            const uint64   hash = Hash(m_entries[i].Key);
+            const SizeType slot = FindFreeSlot(hash);
+
+            m_controls[slot] = GetControl(hash);
+            m_indices[slot]  = static_cast<uint32>(i);
+        }
+
+        m_growthLeft -= count;
+    }
+
+    void ReleaseTable()
+    {
+        if (m_controls) {
+            MemoryUtils::FreeAligned(m_controls);
+        }
+    }
+
+    void ForgetTable()
+    {
+        m_controls   = nullptr;
+        m_indices    = nullptr;
+        m_capacity   = 0;
+        m_growthLeft = 0;
+    }
+
+    Hasher            m_hasher;
+    TArray<EntryType> m_entries;
+    uint8*            m_controls   = nullptr;
+    uint32*           m_indices    = nullptr;
+    SizeType          m_capacity   = 0;
+    SizeType          m_growthLeft = 0;
+};
@@ -0,0 +1,294 @@
+#pragma once
+
+#include "Math/AnvilMath.h"
+#include "Memory/MemoryUtils.h"
+#include "Threading/EventCount.h"
+
+/**
+ * @brief Bounded queue shared by any number of producer and consumer threads.
+ * Every slot carries a sequence number telling which turn of the ring it is ready for, so a thread
+ * claims a position with a single compare and swap and then owns its slot without taking a lock.
+ * Batches claim a whole run of positions with one compare and swap. The positions of the producers
+ * and of the consumers are on their own cache lines.
+ * Items are removed in the order their positions were claimed, so the items of one producer are
+ * removed in the order it added them. The blocking operations spin shortly and then sleep.
+*/
+template<class _ItemType>
+class TMpmcQueue
+{
+  public:
+    using ItemType = _ItemType;
+
+    /**
+     * @brief Constructor, the memory of every item is allocated up front.
+     * @param capacity Maximum number of queued items, rounded up to a power of two of at least 2.
+    */
+    explicit TMpmcQueue(uint64 capacity)
+      : m_mask(Math::RoundUpToPowerOfTwo(capacity > 2 ? capacity : 2) - 1)
+      , m_enqueuePos(0)
+      , m_dequeuePos(0)
+    {
+        m_cells = reinterpret_cast<Cell*>(MemoryUtils::AllocateAligned((m_mask + 1) * sizeof(Cell), MemoryUtils::CacheLineAlignment));
+        for (uint64 i = 0; i <= m_mask; i++) {
+            new (&m_cells[i].Sequence) std::atomic<uint64>(i);
+        }
+    }
+
+    TMpmcQueue(const TMpmcQueue&)            = delete;
+    TMpmcQueue& operator=(const TMpmcQueue&) = delete;
+
+    /**
+     * @brief Destructor, destroys the items left in the queue. No thread may use the queue anymore.
+    */
+    ~TMpmcQueue()
+    {
+        const uint64 end = m_enqueuePos.load(std::memory_order_acquire);
+        for (uint64 pos = m_dequeuePos.load(std::memory_order_acquire); pos != end; pos++) {
+            MemoryUtils::DestroyItems(m_cells[pos & m_mask].GetItem(), 1);
+        }
+        MemoryUtils::FreeAligned(m_cells);
+    }
+
+    /**
+     * @brief Adds an item constructed in place.
+     * @param args Arguments passed to the item's constructor, only used if the item is added.
+     * @return True if the item was added, false if the queue is full.
+    */
+    template<class... ArgsType>
+    bool TryEmplace(ArgsType&&... args)
+    {
+        uint64 pos = m_enqueuePos.load(std::memory_order_relaxed);
+        Cell*  cell;
+        for (;;) {
+            cell             = &m_cells[pos & m_mask];
+            const int64 turn = static_cast<int64>(cell->Sequence.load(std::memory_order_acquire) - pos);
+            if (turn == 0) {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (turn < 0) {
+                // The slot still holds the item of the previous turn.
+                return false;
+            } else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        new (cell->GetItem()) ItemType(std::forward<ArgsType>(args)...);
+        cell->Sequence.store(pos + 1, std::memory_order_release);
+        m_notEmpty.NotifyOne();
+        return true;
+    }
+
+    bool TryPush(const ItemType& item) { return TryEmplace(item); }
+    bool TryPush(ItemType&& item) { return TryEmplace(std::move(item)); }
+
+    /**
+     * @brief Adds copies of as many items as there are free slots in a row.
+     * @param items Items to be copied, in order.
+     * @param count Number of items.
+     * @return Number of items added, the first ones of the range.
+    */
+    uint64 TryPushBatch(const ItemType* items, uint64 count)
+    {
+        uint64       pos;
+        const uint64 added = ClaimRun(m_enqueuePos, 0, count, pos);
+        for (uint64 i = 0; i < added; i++) {
+            Cell& cell = m_cells[(pos + i) & m_mask];
+            new (cell.GetItem()) ItemType(items[i]);
+            cell.Sequence.store(pos + i + 1, std::memory_order_release);
+        }
+
+        if (added) {
+            m_notEmpty.Notify(added);
+        }
+        return added;
+    }
+
+    /**
+     * @brief Removes the oldest item.
+     * @param item Receives the item.
+     * @return True if an item was removed, false if the queue is empty.
+    */
+    bool TryPop(ItemType& item)
+    {
+        uint64 pos = m_dequeuePos.load(std::memory_order_relaxed);
+        Cell*  cell;
+        for (;;) {
+            cell             = &m_cells[pos & m_mask];
+            const int64 turn = static_cast<int64>(cell->Sequence.load(std::memory_order_acquire) - (pos + 1));
+            if (turn == 0) {
+                if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (turn < 0) {
+                // The slot is still waiting for the item of this turn.
+                return false;
+            } else {
+                pos = m_dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        ItemType* queued = cell->GetItem();
+        item             = std::move(*queued);
+        MemoryUtils::DestroyItems(queued, 1);
+        cell->Sequence.store(pos + m_mask + 1, std::memory_order_release);
+        m_notFull.NotifyOne();
+        return true;
+    }
+
+    /**
+     * @brief Removes as many of the oldest items as are ready in a row, up to a maximum.
+     * @param items Receives the items, in order.
+     * @param maxCount Maximum number of items to remove.
+     * @return Number of items removed.
+    */
+    uint64 TryPopBatch(ItemType* items, uint64 maxCount)
+    {
+        uint64       pos;
+        const uint64 removed = ClaimRun(m_dequeuePos, 1, maxCount, pos);
+        for (uint64 i = 0; i < removed; i++) {
+            Cell&     cell   = m_cells[(pos + i) & m_mask];
+            ItemType* queued = cell.GetItem();
+            items[i]         = std::move(*queued);
+            MemoryUtils::DestroyItems(queued, 1);
+            cell.Sequence.store(pos + i + m_mask + 1, std::memory_order_release);
+        }
+
+        if (removed) {
+            m_notFull.Notify(removed);
+        }
+        return removed;
+    }
+
+    /**
+     * @brief Adds an item, waiting while the queue is full.
+     * @param item Item to be added.
+    */
+    void Push(const ItemType& item)
+    {
+        m_notFull.Await([&] { return TryEmplace(item); });
+    }
+
+    void Push(ItemType&& item)
+    {
+        m_notFull.Await([&] { return TryEmplace(std::move(item)); });
+    }
+
+    /**
+     * @brief Adds copies of items, waiting for room until every item is added.
+     * Items of other producers can be interleaved with the batch when it does not fit at once.
+     * @param items Items to be copied, in order.
+     * @param count Number of items.
+    */
+    void PushBatch(const ItemType* items, uint64 count)
+    {
+        uint64 added = 0;
+        m_notFull.Await([&] {
+            added += TryPushBatch(items + added, count - added);
+            return added == count;
+        });
+    }
+
+    /**
+     * @brief Removes the oldest item, waiting while the queue is empty.
+     * @param item Receives the item.
+    */
+    void Pop(ItemType& item)
+    {
+        m_notEmpty.Await([&] { return TryPop(item); });
+    }
+
+    /**
+     * @brief Removes the oldest items, waiting until there is at least one.
+     * @param items Receives the items, in order.
+     * @param maxCount Maximum number of items to remove, not 0.
+     * @return Number of items removed.
+    */
+    uint64 PopBatch(ItemType* items, uint64 maxCount)
+    {
+        uint64 removed = 0;
+        m_notEmpty.Await([&] {
+            removed = TryPopBatch(items, maxCount);
+            return removed != 0;
+        });
+        return removed;
+    }
+
+    /**
+     * @brief Returns the maximum number of queued items.
+     * @return The capacity, a power of two.
+    */
+    constexpr uint64 GetCapacity() const { return m_mask + 1; }
+
+    /**
+     * @brief Returns the number of claimed positions, which may already have changed.
+     * @return The number of items, including the ones still being added or removed.
+    */
+    uint64 GetSize() const
+    {
+        const uint64 dequeuePos = m_dequeuePos.load(std::memory_order_acquire);
+        const uint64 enqueuePos = m_enqueuePos.load(std::memory_order_acquire);
+        return enqueuePos > dequeuePos ? enqueuePos - dequeuePos : 0;
+    }
+
+    /**
+     * @brief Checks if the queue is empty, which may already have changed.
+     * @return True if the queue is empty, false otherwise.
+    */
+    bool IsEmpty() const { return GetSize() == 0; }
+
+  private:
+    struct Cell
+    {
+        std::atomic<uint64> Sequence;
+        alignas(ItemType) uint8 Data[sizeof(ItemType)];
+
+        ItemType* GetItem() { return reinterpret_cast<ItemType*>(Data); }
+    };
+
+    /**
+     * @brief Claims the longest run of ready slots from a position, up to a maximum.
+     * A slot is ready when its sequence is its position plus an offset, 0 for producers and 1 for consumers.
+     * @param position Position of the producers or of the consumers.
+     * @param offset Offset of the sequence of a ready slot.
+     * @param maxCount Maximum number of slots to claim.
+     * @param pos Receives the first claimed position.
+     * @return Number of claimed slots.
+    */
+    uint64 ClaimRun(std::atomic<uint64>& position, uint64 offset, uint64 maxCount, uint64& pos)
+    {
+        pos = position.load(std::memory_order_relaxed);
+        for (;;) {
+            uint64 count = 0;
+            int64  turn  = 0;
+            for (; count < maxCount; count++) {
+                const uint64 sequence = m_cells[(pos + count) & m_mask].Sequence.load(std::memory_order_acquire);
+                turn                  = static_cast<int64>(sequence - (pos + count + offset));
+                if (turn != 0) {
+                    break;
+                }
+            }
+
+            if (count == 0) {
+                if (turn <= 0) {
+                    return 0;
+                }
+                pos = position.load(std::memory_order_relaxed);
+            } else if (position.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)) {
+                return count;
+            }
+        }
+    }
+
+    // Read only after construction.
+    Cell*        m_cells;
+    const uint64 m_mask;
+
+    alignas(MemoryUtils::CacheLineAlignment) std::atomic<uint64> m_enqueuePos;
+    alignas(MemoryUtils::CacheLineAlignment) std::atomic<uint64> m_dequeuePos;
+
+    // Only written when a thread waits.
+    alignas(MemoryUtils::CacheLineAlignment) EventCount m_notEmpty;
+    EventCount m_notFull;
+};
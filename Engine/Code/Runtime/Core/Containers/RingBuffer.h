@@ -0,0 +1,471 @@
+#pragma once
+
+#include "ContainerAllocators.h"
+#include "Math/AnvilMath.h"
+
+/**
+ * @brief Queue of items in a circular buffer, adding and removing at either end is O(1).
+ * The capacity is a power of two, so a position is mapped to its slot with a mask instead of
+ * a division. A full ring buffer grows by moving its items, in order, to a buffer twice as large,
+ * a TFixedAllocator makes its capacity fixed, growing past it is then an error and the fixed
+ * capacity should be a power of two. Growing invalidates pointers to the items, adding and
+ * removing items invalidates iterators.
+*/
+template<class _ItemType, class _AllocType = DefaultHeapAllocator64>
+class TRingBuffer
+{
+  public:
+    using ItemType      = _ItemType;
+    using AllocatorType = typename TAllocatorForElement<_AllocType, _ItemType>::Type;
+    using SizeType      = typename _AllocType::SizeType;
+
+    template<class RingType, class IteratedType>
+    class TIterator
+    {
+      public:
+        TIterator(RingType* ring, SizeType index)
+          : m_ring(ring)
+          , m_index(index)
+        {}
+
+        IteratedType& operator*() const { return (*m_ring)[m_index]; }
+        IteratedType* operator->() const { return &(*m_ring)[m_index]; }
+
+        TIterator& operator++()
+        {
+            m_index++;
+            return *this;
+        }
+
+        bool operator==(const TIterator& other) const { return m_index == other.m_index; }
+        bool operator!=(const TIterator& other) const { return m_index != other.m_index; }
+
+      private:
+        RingType* m_ring;
+        SizeType  m_index;
+    };
+
+    using Iterator      = TIterator<TRingBuffer, ItemType>;
+    using ConstIterator = TIterator<const TRingBuffer, const ItemType>;
+
+    /**
+     * @brief Default constructor, no memory is allocated until the first item.
+    */
+    constexpr TRingBuffer()
+      : m_head(0)
+      , m_size(0)
+      , m_capacity(0)
+    {}
+
+    /**
+     * @brief Copy constructor, the items are copied in order.
+     * @param other Ring buffer to be copied.
+    */
+    TRingBuffer(const TRingBuffer& other)
+      : TRingBuffer()
+    {
+        if (other.m_size) {
+            Reallocate(CalculateCapacity(m_allocator.CalculateReserve(other.m_size), other.m_size));
+            other.ForEachSegment([this](const ItemType* items, SizeType count) {
+                MemoryUtils::CopyElements(GetData() + m_size, items, count);
+                m_size += count;
+            });
+        }
+    }
+
+    /**
+     * @brief Move constructor.
+     * @param other Ring buffer to be moved, left empty.
+    */
+    TRingBuffer(TRingBuffer&& other) noexcept
+      : m_allocator(std::move(other.m_allocator))
+      , m_head(other.m_head)
+      , m_size(other.m_size)
+      , m_capacity(other.m_capacity)
+    {
+        RelocateInlineItems(other);
+
+        other.m_head     = 0;
+        other.m_size     = 0;
+        other.m_capacity = 0;
+    }
+
+    ~TRingBuffer() { DestroyAll(); }
+
+    TRingBuffer& operator=(const TRingBuffer& other)
+    {
+        if (this != &other) {
+            *this = TRingBuffer(other);
+        }
+        return *this;
+    }
+
+    TRingBuffer& operator=(TRingBuffer&& other) noexcept
+    {
+        if (this != &other) {
+            DestroyAll();
+
+            m_allocator = std::move(other.m_allocator);
+            m_head      = other.m_head;
+            m_size      = other.m_size;
+            m_capacity  = other.m_capacity;
+            RelocateInlineItems(other);
+
+            other.m_head     = 0;
+            other.m_size     = 0;
+            other.m_capacity = 0;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Adds an item constructed in place after the last item.
+     * @param args Arguments passed to the item's constructor.
+     * @return Reference to the added item.
+    */
+    template<class... ArgsType>
+    ItemType& EmplaceBack(ArgsType&&... args)
+    {
+        if (m_size == m_capacity) {
+            Grow();
+        }
+
+        ItemType* item = new (GetData() + ((m_head + m_size) & (m_capacity - 1))) ItemType(std::forward<ArgsType>(args)...);
+        m_size++;
+        return *item;
+    }
+
+    /**
+     * @brief Adds an item constructed in place before the first item.
+     * @param args Arguments passed to the item's constructor.
+     * @return Reference to the added item.
+    */
+    template<class... ArgsType>
+    ItemType& EmplaceFront(ArgsType&&... args)
+    {
+        if (m_size == m_capacity) {
+            Grow();
+        }
+
+        const SizeType head = (m_head - 1) & (m_capacity - 1);
+        ItemType*      item = new (GetData() + head) ItemType(std::forward<ArgsType>(args)...);
+        m_head              = head;
+        m_size++;
+        return *item;
+    }
+
+    /**
+     * @brief Adds an item after the last item.
+     * @param item Item to be added, must not be an item of this ring buffer.
+     * @return Reference to the added item.
+    */
+    ItemType& PushBack(const ItemType& item)
+    {
+        CheckAddress(&item);
+        return EmplaceBack(item);
+    }
+
+    ItemType& PushBack(ItemType&& item)
+    {
+        CheckAddress(&item);
+        return EmplaceBack(std::move(item));
+    }
+
+    /**
+     * @brief Adds an item before the first item.
+     * @param item Item to be added, must not be an item of this ring buffer.
+     * @return Reference to the added item.
+    */
+    ItemType& PushFront(const ItemType& item)
+    {
+        CheckAddress(&item);
+        return EmplaceFront(item);
+    }
+
+    ItemType& PushFront(ItemType&& item)
+    {
+        CheckAddress(&item);
+        return EmplaceFront(std::move(item));
+    }
+
+    /**
+     * @brief Removes the first item.
+     * @return The removed item.
+    */
+    ItemType PopFront()
+    {
+        AE_ASSERT(!IsEmpty());
+
+        ItemType* item   = GetData() + m_head;
+        ItemType  result = std::move(*item);
+        MemoryUtils::DestroyItems(item, 1);
+
+        m_head = (m_head + 1) & (m_capacity - 1);
+        m_size--;
+        return result;
+    }
+
+    /**
+     * @brief Removes the last item.
+     * @return The removed item.
+    */
+    ItemType PopBack()
+    {
+        AE_ASSERT(!IsEmpty());
+
+        ItemType* item   = GetData() + ((m_head + m_size - 1) & (m_capacity - 1));
+        ItemType  result = std::move(*item);
+        MemoryUtils::DestroyItems(item, 1);
+
+        m_size--;
+        return result;
+    }
+
+    /**
+     * @brief Destroys a number of items at the front, without moving them out.
+     * @param count Number of items to remove.
+    */
+    void RemoveFront(SizeType count)
+    {
+        AE_ASSERT(count <= m_size);
+
+        const SizeType first = count < m_capacity - m_head ? count : m_capacity - m_head;
+        MemoryUtils::DestroyItems(GetData() + m_head, first);
+        MemoryUtils::DestroyItems(GetData(), count - first);
+
+        m_head = m_capacity ? (m_head + count) & (m_capacity - 1) : 0;
+        m_size -= count;
+    }
+
+    /**
+     * @brief Returns the first item.
+     * @return Reference to the first item.
+    */
+    ItemType& GetFront()
+    {
+        AE_ASSERT(!IsEmpty());
+        return GetData()[m_head];
+    }
+
+    const ItemType& GetFront() const { return const_cast<TRingBuffer*>(this)->GetFront(); }
+
+    /**
+     * @brief Returns the last item.
+     * @return Reference to the last item.
+    */
+    ItemType& GetBack()
+    {
+        AE_ASSERT(!IsEmpty());
+        return GetData()[(m_head + m_size - 1) & (m_capacity - 1)];
+    }
+
+    const ItemType& GetBack() const { return const_cast<TRingBuffer*>(this)->GetBack(); }
+
+    /**
+     * @brief Returns an item by its position from the front.
+     * @param pos Position of the item, 0 is the first item.
+     * @return Reference to the item.
+    */
+    ItemType& operator[](SizeType pos)
+    {
+        AE_ASSERT(pos < m_size);
+        return GetData()[(m_head + pos) & (m_capacity - 1)];
+    }
+
+    const ItemType& operator[](SizeType pos) const { return const_cast<TRingBuffer*>(this)->operator[](pos); }
+
+    /**
+     * @brief Makes sure the ring buffer can hold a number of items without growing.
+     * @param count Number of items.
+    */
+    void Reserve(SizeType count)
+    {
+        if (count > m_capacity) {
+            Reallocate(CalculateCapacity(m_allocator.CalculateReserve(count), count));
+        }
+    }
+
+    /**
+     * @brief Destroys every item.
+     * @param shrink If the memory should be released.
+    */
+    void Clear(bool shrink = false)
+    {
+        RemoveFront(m_size);
+        m_head = 0;
+
+        if (shrink) {
+            ShrinkToFit();
+        }
+    }
+
+    /**
+     * @brief Reduces the capacity to the smallest power of two that fits the items.
+    */
+    void ShrinkToFit()
+    {
+        const SizeType capacity = m_size ? CalculateCapacity(m_allocator.CalculateReserve(m_size), m_size) : 0;
+        if (capacity < m_capacity) {
+            Reallocate(capacity);
+        }
+    }
+
+    /**
+     * @brief Returns the number of items.
+     * @return The number of items.
+    */
+    constexpr SizeType GetSize() const { return m_size; }
+
+    /**
+     * @brief Returns the number of items the ring buffer can hold without growing.
+     * @return The capacity, 0 or a power of two.
+    */
+    constexpr SizeType GetCapacity() const { return m_capacity; }
+
+    /**
+     * @brief Checks if the ring buffer is empty.
+     * @return True if the ring buffer is empty, false otherwise.
+    */
+    constexpr bool IsEmpty() const { return m_size == 0; }
+
+    /**
+     * @brief Checks if the next added item makes the ring buffer grow.
+     * @return True if the ring buffer is full, false otherwise.
+    */
+    constexpr bool IsFull() const { return m_size == m_capacity; }
+
+    Iterator      begin() { return Iterator(this, 0); }
+    Iterator      end() { return Iterator(this, m_size); }
+    ConstIterator begin() const { return ConstIterator(this, 0); }
+    ConstIterator end() const { return ConstIterator(this, m_size); }
+
+  private:
+    ItemType* GetData() const { return reinterpret_cast<ItemType*>(m_allocator.GetData()); }
+
+    void CheckAddress(const ItemType* address) const { AE_ASSERT(address < GetData() || address >= GetData() + m_capacity); }
+
+    /** Calls function with the items as at most two contiguous runs, in order.*/
+    template<class FunctionType>
+    void ForEachSegment(FunctionType&& function) const
+    {
+        const SizeType first = m_size < m_capacity - m_head ? m_size : m_capacity - m_head;
+        if (first) {
+            function(GetData() + m_head, first);
+        }
+        if (m_size > first) {
+            function(GetData(), m_size - first);
+        }
+    }
+
+    static SizeType RoundDownToPowerOfTwo(SizeType value)
+    {
+        return value ? static_cast<SizeType>(uint64(1) << (63 - Math::CountLeadingZeros(value))) : 0;
+    }
+
+    /**
+     * @brief Returns the power of two capacity for an allocator's suggestion.
+     * @param count Number of items suggested by the allocator.
+     * @param minCount Number of items that must fit.
+     * @return The largest power of two within the suggestion, or the smallest one that fits minCount.
+    */
+    static SizeType CalculateCapacity(SizeType count, SizeType minCount)
+    {
+        const SizeType capacity = RoundDownToPowerOfTwo(count);
+        if (capacity >= minCount && capacity) {
+            return capacity;
+        }
+        return static_cast<SizeType>(Math::RoundUpToPowerOfTwo(static_cast<uint64>(minCount > count ? minCount : count)));
+    }
+
+    void Grow() { Reallocate(CalculateCapacity(m_allocator.CalculateGrowth(m_size + 1, m_capacity), m_size + 1)); }
+
+    /**
+     * @brief Moves the items to a new buffer, the first item lands in the first slot.
+     * @param capacity New capacity, a power of two that fits the items, or 0.
+    */
+    void Reallocate(SizeType capacity)
+    {
+        AE_ASSERT(capacity >= m_size && (capacity & (capacity - 1)) == 0);
+
+        if (m_size == 0) {
+            m_allocator.Reallocate(capacity, m_capacity, sizeof(ItemType));
+        } else {
+            AllocatorType allocator;
+            allocator.Reallocate(capacity, 0, sizeof(ItemType));
+
+            if (allocator.HasAllocatedData()) {
+                ItemType* data = reinterpret_cast<ItemType*>(allocator.GetData());
+                SizeType  size = 0;
+                ForEachSegment([&](const ItemType* items, SizeType count) {
+                    MemoryUtils::RelocateItems(data + size, const_cast<ItemType*>(items), count);
+                    size += count;
+                });
+
+                m_allocator = std::move(allocator);
+            } else {
+                // The new buffer is the allocator's own storage, which moving an allocator does not carry the items to.
+                Linearize();
+                if constexpr (TIsTriviallyRelocatable<ItemType>::Value) {
+                    m_allocator.Reallocate(capacity, m_capacity, sizeof(ItemType));
+                } else {
+                    const ItemRelocator relocator { &RelocateItems, m_size };
+                    m_allocator.Reallocate(capacity, m_capacity, sizeof(ItemType), &relocator);
+                }
+            }
+        }
+
+        m_head     = 0;
+        m_capacity = capacity;
+    }
+
+    /** Moves the items in the current buffer so the first item is in the first slot.*/
+    void Linearize()
+    {
+        ItemType* data = GetData();
+        if (m_head + m_size <= m_capacity) {
+            MemoryUtils::RelocateItems(data, data + m_head, m_size);
+        } else {
+            // The front run joins the back run, which starts the buffer, then the two runs swap places.
+            const SizeType front = m_capacity - m_head;
+            const SizeType back  = m_size - front;
+            MemoryUtils::RelocateItems(data + back, data + m_head, front);
+            std::rotate(data, data + back, data + m_size);
+        }
+        m_head = 0;
+    }
+
+    static void RelocateItems(void* dst, void* src, uint64 count)
+    {
+        MemoryUtils::RelocateItems(reinterpret_cast<ItemType*>(dst), reinterpret_cast<ItemType*>(src), count);
+    }
+
+    /**
+     * @brief Moves the items that stayed in other's inline storage when its allocator was moved.
+     * Allocators only copy inline items that are trivially relocatable, the others are move constructed here.
+     * @param other Ring buffer whose allocator was just moved, m_head, m_size and m_capacity are already set.
+    */
+    void RelocateInlineItems(TRingBuffer& other)
+    {
+        if constexpr (!TIsTriviallyRelocatable<ItemType>::Value) {
+            if (m_size && !m_allocator.HasAllocatedData()) {
+                ItemType* data = GetData();
+                ForEachSegment([&](const ItemType* items, SizeType count) {
+                    const SizeType offset = static_cast<SizeType>(items - data);
+                    MemoryUtils::RelocateItems(data + offset, other.GetData() + offset, count);
+                });
+            }
+        }
+    }
+
+    void DestroyAll()
+    {
+        ForEachSegment([](const ItemType* items, SizeType count) { MemoryUtils::DestroyItems(const_cast<ItemType*>(items), count); });
+        m_size = 0;
+    }
+
+  private:
+    AllocatorType m_allocator;
+    SizeType      m_head;
+    SizeType      m_size;
+    SizeType      m_capacity;
+};
@@ -0,0 +1,582 @@
+#pragma once
+
+#include "Math/AnvilMath.h"
+#include "Memory/MemoryUtils.h"
+#include "Misc/StdHash.h"
+#include <initializer_list>
+#include <type_traits>
+
+#if AE_SSE2
+    #include <emmintrin.h>
+#endif
+
+/**
+ * @brief Group of control bytes probed at once, one byte per slot.
+ * A full slot stores the 7 low bits of its hash, empty and deleted slots have the high bit set.
+*/
+struct SetControlGroup
+{
+    static constexpr uint32 Width = 16;
+
+    static constexpr uint8 Empty   = 0x80;
+    static constexpr uint8 Deleted = 0xFE;
+
+    /**
+     * @brief Spreads the bits of a hasher's result, so identity hashes use every group.
+     * @param hash Result of the hasher.
+     * @return Hash whose low bits depend on all of its input bits.
+    */
+    static constexpr uint64 MixHash(uint64 hash)
+    {
+        hash *= 0x9E3779B97F4A7C15ull;
+        return hash ^ (hash >> 32);
+    }
+
+    /**
+     * @brief Loads a group.
+     * @param controls Control bytes, aligned to Width.
+    */
+    explicit SetControlGroup(const uint8* controls)
+    {
+#if AE_SSE2
+        m_controls = _mm_load_si128(reinterpret_cast<const __m128i*>(controls));
+#else
+        memcpy(m_controls, controls, Width);
+#endif
+    }
+
+    /**
+     * @brief Returns the slots whose control byte matches the hash.
+     * @param hash 7 bits of a hash.
+     * @return One bit per matching slot.
+    */
+    uint32 Match(uint8 hash) const
+    {
+#if AE_SSE2
+        return static_cast<uint32>(_mm_movemask_epi8(_mm_cmpeq_epi8(m_controls, _mm_set1_epi8(static_cast<char>(hash)))));
+#else
+        uint32 mask = 0;
+        for (uint32 i = 0; i < Width; i++) {
+            mask |= uint32(m_controls[i] == hash) << i;
+        }
+        return mask;
+#endif
+    }
+
+    /**
+     * @brief Returns the empty slots.
+     * @return One bit per empty slot.
+    */
+    uint32 MatchEmpty() const { return Match(Empty); }
+
+    /**
+     * @brief Returns the slots that are either empty or deleted.
+     * @return One bit per free slot.
+    */
+    uint32 MatchFree() const
+    {
+#if AE_SSE2
+        return static_cast<uint32>(_mm_movemask_epi8(m_controls));
+#else
+        uint32 mask = 0;
+        for (uint32 i = 0; i < Width; i++) {
+            mask |= uint32(m_controls[i] >> 7) << i;
+        }
+        return mask;
+#endif
+    }
+
+  private:
+#if AE_SSE2
+    __m128i m_controls;
+#else
+    uint8 m_controls[Width];
+#endif
+};
+
+/** Checks if a Hasher can hash KeyType and items of type T can be compared with it.*/
+template<class T, class Hasher, class KeyType, class = void>
+struct TIsSetKey
+{
+    enum
+    {
+        Value = false
+    };
+};
+
+template<class T, class Hasher, class KeyType>
+struct TIsSetKey<T,
+                 Hasher,
+                 KeyType,
+                 std::void_t<decltype(std::declval<const Hasher&>()(std::declval<const KeyType&>())), decltype(std::declval<const T&>() == std::declval<const KeyType&>())>>
+{
+    enum
+    {
+        Value = true
+    };
+};
+
+/**
+ * @brief Unordered set of unique items stored in one flat open addressing table.
+ * Every slot has a control byte holding 7 bits of its item's hash, lookups compare
+ * 16 control bytes at once and only touch the items whose bits match, so a lookup
+ * rarely reads more than one item. Items live in one contiguous allocation and move
+ * when the table grows, pointers to them are invalidated by Add, Emplace and Reserve.
+ * Find, Contains and Remove accept any key type the Hasher can hash and the items
+ * can be compared with.
+*/
+template<class T, class Hasher = TStdHash<T>>
+class TSet
+{
+    using Group = SetControlGroup;
+
+    /** Items are added until 7/8 of the slots are used.*/
+    static constexpr uint64 GetMaxCount(uint64 capacity) { return capacity - capacity / 8; }
+
+  public:
+    using ItemType = T;
+    using SizeType = uint64;
+
+    template<class IteratedType>
+    class TIterator
+    {
+      public:
+        TIterator(const uint8* controls, IteratedType* items, SizeType index, SizeType capacity)
+          : m_controls(controls)
+          , m_items(items)
+          , m_index(index)
+          , m_capacity(capacity)
+        {
+            SkipFreeSlots();
+        }
+
+        IteratedType& operator*() const { return m_items[m_index]; }
+        IteratedType* operator->() const { return &m_items[m_index]; }
+
+        TIterator& operator++()
+        {
+            m_index++;
+            SkipFreeSlots();
+            return *this;
+        }
+
+        bool operator==(const TIterator& other) const { return m_index == other.m_index; }
+        bool operator!=(const TIterator& other) const { return m_index != other.m_index; }
+
+      private:
+        void SkipFreeSlots()
+        {
+            while (m_index < m_capacity && (m_controls[m_index] & Group::Empty)) {
+                m_index++;
+            }
+        }
+
+        const uint8*  m_controls;
+        IteratedType* m_items;
+        SizeType      m_index;
+        SizeType      m_capacity;
+    };
+
+    using Iterator      = TIterator<T>;
+    using ConstIterator = TIterator<const T>;
+
+    /**
+     * @brief Default constructor, no memory is allocated until the first item.
+    */
+    constexpr TSet() = default;
+
+    /**
+     * @brief Initializer list constructor.
+     * @param items Items to be added, duplicates are ignored.
+    */
+    TSet(std::initializer_list<T> items)
+    {
+        Reserve(items.size());
+        for (const T& item : items) {
+            Add(item);
+        }
+    }
+
+    /**
+     * @brief Copy constructor.
+     * @param other Set to be copied.
+    */
+    TSet(const TSet& other)
+      : m_hasher(other.m_hasher)
+    {
+        if (other.m_count) {
+            Allocate(other.m_capacity);
+            MemoryUtils::CopyMemory(m_controls, other.m_controls, m_capacity);
+            for (SizeType i = 0; i < m_capacity; i++) {
+                if (!(m_controls[i] & Group::Empty)) {
+                    new (&m_items[i]) T(other.m_items[i]);
+                }
+            }
+
+            m_count      = other.m_count;
+            m_growthLeft = other.m_growthLeft;
+        }
+    }
+
+    /**
+     * @brief Move constructor.
+     * @param other Set to be moved, left empty.
+    */
+    TSet(TSet&& other) noexcept
+      : m_hasher(std::move(other.m_hasher))
+      , m_controls(other.m_controls)
+      , m_items(other.m_items)
+      , m_capacity(other.m_capacity)
+      , m_count(other.m_count)
+      , m_growthLeft(other.m_growthLeft)
+    {
+        other.Forget();
+    }
+
+    ~TSet() { Release(); }
+
+    TSet& operator=(const TSet& other)
+    {
+        if (this != &other) {
+            *this = TSet(other);
+        }
+        return *this;
+    }
+
+    TSet& operator=(TSet&& other) noexcept
+    {
+        if (this != &other) {
+            Release();
+
+            m_hasher     = std::move(other.m_hasher);
+            m_controls   = other.m_controls;
+            m_items      = other.m_items;
+            m_capacity   = other.m_capacity;
+            m_count      = other.m_count;
+            m_growthLeft = other.m_growthLeft;
+
+            other.Forget();
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Adds an item if the set does not contain it yet.
+     * @param item Item to be added.
+     * @return True if the item was added, false if the set already contained it.
+    */
+    bool Add(const T& item) { return Insert(item).second; }
+
+    /**
+     * @brief Adds an item if the set does not contain it yet.
+     * @param item Item to be added.
+     * @return True if the item was added, false if the set already contained it.
+    */
+    bool Add(T&& item) { return Insert(std::move(item)).second; }
+
+    /**
+     * @brief Constructs an item in place if the set does not contain it yet.
+     * A single argument the Hasher can hash and the items can be compared with is looked up
+     * as is, the item is then constructed in its slot and nothing is constructed when the set
+     * already contains it. Other arguments construct a temporary item moved into the set.
+     * @param args Arguments passed to the item's constructor.
+     * @return Reference to the new item, or to the item already in the set.
+    */
+    template<class... ArgsType>
+    T& Emplace(ArgsType&&... args)
+    {
+        if constexpr (IsKey<ArgsType...>()) {
+            return *Insert(std::forward<ArgsType>(args)...).first;
+        } else {
+            return *Insert(T(std::forward<ArgsType>(args)...)).first;
+        }
+    }
+
+    /**
+     * @brief Finds an item.
+     * @param key Item or key comparable with the items.
+     * @return Pointer to the item, null if the set does not contain it.
+    */
+    template<class KeyType>
+    T* Find(const KeyType& key)
+    {
+        const SizeType index = FindIndex(key, Hash(key));
+        return index < m_capacity ? &m_items[index] : nullptr;
+    }
+
+    /**
+     * @brief Finds an item.
+     * @param key Item or key comparable with the items.
+     * @return Pointer to the item, null if the set does not contain it.
+    */
+    template<class KeyType>
+    const T* Find(const KeyType& key) const
+    {
+        return const_cast<TSet*>(this)->Find(key);
+    }
+
+    /**
+     * @brief Checks if the set contains an item.
+     * @param key Item or key comparable with the items.
+     * @return True if the set contains the item.
+    */
+    template<class KeyType>
+    bool Contains(const KeyType& key) const
+    {
+        return Find(key) != nullptr;
+    }
+
+    /**
+     * @brief Removes an item.
+     * @param key Item or key comparable with the items.
+     * @return True if the item was removed, false if the set did not contain it.
+    */
+    template<class KeyType>
+    bool Remove(const KeyType& key)
+    {
+        const SizeType index = FindIndex(key, Hash(key));
+        if (index >= m_capacity) {
+            return false;
+        }
+
+        m_items[index].~T();
+        m_count--;
+
+        // A slot can only become empty again if its group never overflowed,
+        // otherwise a probe sequence may pass through it and must keep going.
+        const SizeType groupIndex = index & ~SizeType(Group::Width - 1);
+        if (Group(m_controls + groupIndex).MatchEmpty()) {
+            m_controls[index] = Group::Empty;
+            m_growthLeft++;
+        } else {
+            m_controls[index] = Group::Deleted;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Makes room for a number of items without growing again.
+     * @param count Number of items the set must hold.
+    */
+    void Reserve(SizeType count)
+    {
+        if (count > m_count + m_growthLeft) {
+            Rehash(GetCapacityFor(count));
+        }
+    }
+
+    /**
+     * @brief Removes every item.
+     * @param shrink Whether the memory is released too.
+    */
+    void Clear(bool shrink = false)
+    {
+        if (shrink) {
+            Release();
+            Forget();
+            return;
+        }
+
+        if (m_count) {
+            DestroyItems();
+            memset(m_controls, Group::Empty, m_capacity);
+            m_count      = 0;
+            m_growthLeft = GetMaxCount(m_capacity);
+        }
+    }
+
+    /**
+     * @brief Returns the number of items.
+     * @return The number of items.
+    */
+    constexpr SizeType GetCount() const { return m_count; }
+
+    /**
+     * @brief Returns the number of slots of the table.
+     * @return The number of slots, a power of two or 0.
+    */
+    constexpr SizeType GetCapacity() const { return m_capacity; }
+
+    /**
+     * @brief Checks if the set has no item.
+     * @return True if the set is empty.
+    */
+    constexpr bool IsEmpty() const { return m_count == 0; }
+
+    Iterator begin() { return Iterator(m_controls, m_items, 0, m_capacity); }
+    Iterator end() { return Iterator(m_controls, m_items, m_capacity, m_capacity); }
+
+    ConstIterator begin() const { return ConstIterator(m_controls, m_items, 0, m_capacity); }
+    ConstIterator end() const { return ConstIterator(m_controls, m_items, m_capacity, m_capacity); }
+
+  private:
+    template<class... ArgsType>
+    static constexpr bool IsKey()
+    {
+        if constexpr (sizeof...(ArgsType) == 1) {
+            return TIsSetKey<T, Hasher, std::decay_t<ArgsType>...>::Value;
+        } else {
+            return false;
+        }
+    }
+
+    template<class KeyType>
+    uint64 Hash(const KeyType& key) const { return SetControlGroup::MixHash(static_cast<uint64>(m_hasher(key))); }
+
+    static constexpr uint8 GetControl(uint64 hash) { return static_cast<uint8>(hash & 0x7F); }
+
+    static SizeType GetCapacityFor(SizeType count)
+    {
+        SizeType capacity = Group::Width;
+        while (GetMaxCount(capacity) < count) {
+            capacity *= 2;
+        }
+        return capacity;
+    }
+
+    /** Returns the index of the item, or the capacity when the set does not contain it.*/
+    template<class KeyType>
+    SizeType FindIndex(const KeyType& key, uint64 hash) const
+    {
+        if (m_count == 0) {
+            return m_capacity;
+        }
+
+        const uint8    control = GetControl(hash);
+        const SizeType mask    = m_capacity - 1;
+
+        SizeType groupIndex = (hash >> 7) & mask & ~SizeType(Group::Width - 1);
+        for (SizeType step = Group::Width;; step += Group::Width) {
+            const Group group(m_controls + groupIndex);
+            for (uint32 matches = group.Match(control); matches; matches &= matches - 1) {
+                const SizeType index = groupIndex + Math::CountTrailingZeros(matches);
+                if (m_items[index] == key) {
+                    return index;
+                }
+            }
+
+            if (group.MatchEmpty()) {
+                return m_capacity;
+            }
+
+            // Triangular probing visits every group of a power of two table.
+            groupIndex = (groupIndex + step) & mask;
+        }
+    }
+
+    /** Returns the first free slot of the probe sequence of a hash, the table must have one.*/
+    SizeType FindFreeSlot(uint64 hash) const
+    {
+        const SizeType mask = m_capacity - 1;
+
+        SizeType groupIndex = (hash >> 7) & mask & ~SizeType(Group::Width - 1);
+        for (SizeType step = Group::Width;; step += Group::Width) {
+            if (const uint32 free = Group(m_controls + groupIndex).MatchFree()) {
+                return groupIndex + Math::CountTrailingZeros(free);
+            }
+            groupIndex = (groupIndex + step) & mask;
+        }
+    }
+
+    template<class ArgType>
+    std::pair<T*, bool> Insert(ArgType&& item)
+    {
+        uint64   hash  = Hash(item);
+        SizeType index = FindIndex(item, hash);
+        if (index < m_capacity) {
+            return {&m_items[index], false};
+        }
+
+        if (!m_capacity) {
+            Rehash(Group::Width);
+        } else if (m_growthLeft == 0 && m_controls[FindFreeSlot(hash)] == Group::Empty) {
+            // Deleted slots are dropped by rehashing at the same capacity, unless the items alone nearly fill the table.
+            Rehash(m_count * 32 <= m_capacity * 25 ? m_capacity : m_capacity * 2);
+        }
+
+        index = FindFreeSlot(hash);
+        if (m_controls[index] == Group::Empty) {
+            m_growthLeft--;
+        }
+
+        m_controls[index] = GetControl(hash);
+        new (&m_items[index]) T(std::forward<ArgType>(item));
+        m_count++;
+
+        return {&m_items[index], true};
+    }
+
+    void Allocate(SizeType capacity)
+    {
+        const uint64 itemsOffset = MemoryUtils::AlignAddress(capacity, alignof(T));
+        const uint64 align       = alignof(T) > Group::Width ? alignof(T) : Group::Width;
+
+        m_controls   = reinterpret_cast<uint8*>(MemoryUtils::AllocateAligned(itemsOffset + capacity * sizeof(T), align));
+        m_items      = reinterpret_cast<T*>(m_controls + itemsOffset);
+        m_capacity   = capacity;
+        m_growthLeft = GetMaxCount(capacity);
+
+        memset(m_controls, Group::Empty, capacity);
+    }
+
+    void Rehash(SizeType capacity)
+    {
+        uint8*         oldControls = m_controls;
+        T*             oldItems    = m_items;
+        const SizeType oldCapacity = m_capacity;
+
+        Allocate(capacity);
+
+        for (SizeType i = 0; i < oldCapacity; i++) {
+            if (!(oldControls[i] & Group::Empty)) {
+                const uint64   hash  = Hash(oldItems[i]);
+                const SizeType index = FindFreeSlot(hash);
+
+                m_controls[index] = GetControl(hash);
+                MemoryUtils::RelocateItems(&m_items[index], &oldItems[i], 1);
+            }
+        }
+
+        m_growthLeft -= m_count;
+
+        if (oldControls) {
+            MemoryUtils::FreeAligned(oldControls);
+        }
+    }
+
+    void DestroyItems()
+    {
+        if constexpr (!std::is_trivially_destructible<T>::value) {
+            for (SizeType i = 0; i < m_capacity; i++) {
+                if (!(m_controls[i] & Group::Empty)) {
+                    m_items[i].~T();
+                }
+            }
+        }
+    }
+
+    void Release()
+    {
+        if (m_controls) {
+            DestroyItems();
+            MemoryUtils::FreeAligned(m_controls);
+        }
+    }
+
+    void Forget()
+    {
+        m_controls   = nullptr;
+        m_items      = nullptr;
+        m_capacity   = 0;
+        m_count      = 0;
+        m_growthLeft = 0;
+    }
+
+    Hasher   m_hasher;
+    uint8*   m_controls   = nullptr;
+    T*       m_items      = nullptr;
+    SizeType m_capacity   = 0;
+    SizeType m_count      = 0;
+    SizeType m_growthLeft = 0;
+};
@@ -0,0 +1,227 @@
+#pragma once
+
+#include "Array.h"
+
+/**
+ * @brief Unordered container of items referred to by generational handles.
+ * Items are densely packed in an array, so iterating them is as fast as iterating a TArray,
+ * and a slot array maps every handle to its item's position. Removing an item moves the last
+ * item into its place, so adding and removing are constant time. A handle to a removed item
+ * is detected as stale, even once its slot was reused by another item.
+ * Pointers to items are invalidated by adding and removing items, handles are not.
+ * Handles are 32 bits, IndexBits of slot index and the rest of generation, so the map holds at
+ * most MaxSlotCount items at once. Generations wrap around, a handle kept while its slot is
+ * reused 2048 times can refer to a newer item again.
+*/
+template<class T, class Allocator = DefaultHeapAllocator64>
+class TSlotMap
+{
+    static constexpr uint32 InvalidIndex = ~0u;
+
+    /** The generation is odd while the slot holds an item, the index is then the item's position, else the next free slot.*/
+    struct Slot
+    {
+        uint32 Index;
+        uint32 Generation;
+    };
+
+  public:
+    using ItemType = T;
+    using SizeType = typename TArray<T, Allocator>::SizeType;
+
+    static constexpr uint32 IndexBits     = 20;
+    static constexpr uint32 MaxSlotCount  = 1u << IndexBits;
+    static constexpr uint32 MaxGeneration = ~0u >> IndexBits;
+
+    /**
+     * @brief Generational reference to an item, a default constructed handle is never valid.
+    */
+    struct Handle
+    {
+        uint32 Value = 0;
+
+        constexpr uint32 GetIndex() const { return Value & (MaxSlotCount - 1); }
+        constexpr uint32 GetGeneration() const { return Value >> IndexBits; }
+
+        constexpr bool operator==(const Handle& other) const { return Value == other.Value; }
+        constexpr bool operator!=(const Handle& other) const { return Value != other.Value; }
+    };
+
+    /**
+     * @brief Adds an item constructed in place.
+     * @param args Arguments passed to the item's constructor.
+     * @return Handle to the item.
+    */
+    template<class... ArgsType>
+    Handle Emplace(ArgsType&&... args)
+    {
+        const SizeType position = m_items.Emplace(std::forward<ArgsType>(args)...);
+        AE_ASSERT(position < InvalidIndex);
+
+        uint32 index = m_freeSlot;
+        if (index != InvalidIndex) {
+            m_freeSlot = m_slots[index].Index;
+        } else {
+            index = static_cast<uint32>(m_slots.GetSize());
+            AE_CHECK(index < MaxSlotCount);
+            m_slots.Add(Slot{ 0, 0 });
+        }
+
+        Slot& slot = m_slots[index];
+        slot.Index      = static_cast<uint32>(position);
+        slot.Generation = (slot.Generation + 1) & MaxGeneration;
+        m_itemSlots.Add(index);
+
+        return MakeHandle(index, slot.Generation);
+    }
+
+    /**
+     * @brief Adds a copy of an item.
+     * @param item Item to be copied.
+     * @return Handle to the item.
+    */
+    Handle Add(const T& item) { return Emplace(item); }
+
+    /**
+     * @brief Adds an item by moving it.
+     * @param item Item to be moved.
+     * @return Handle to the item.
+    */
+    Handle Add(T&& item) { return Emplace(std::move(item)); }
+
+    /**
+     * @brief Removes an item, the last item takes its place.
+     * @param handle Handle to the item, may be stale.
+     * @return True if the item was removed, false if the handle was stale.
+    */
+    bool Remove(Handle handle)
+    {
+        if (!IsValid(handle)) {
+            return false;
+        }
+
+        const uint32   position = m_slots[handle.GetIndex()].Index;
+        const SizeType last     = m_items.GetSize() - 1;
+
+        m_items.RemoveAtSwap(position);
+        m_itemSlots.RemoveAtSwap(position);
+        if (position != last) {
+            m_slots[m_itemSlots[position]].Index = position;
+        }
+
+        FreeSlot(handle.GetIndex());
+
+        return true;
+    }
+
+    /**
+     * @brief Returns the item of a handle.
+     * @param handle Handle to the item, may be stale.
+     * @return Pointer to the item, null if the handle is stale.
+    */
+    T* Get(Handle handle) { return IsValid(handle) ? &m_items[m_slots[handle.GetIndex()].Index] : nullptr; }
+
+    /**
+     * @brief Returns the item of a handle.
+     * @param handle Handle to the item, may be stale.
+     * @return Pointer to the item, null if the handle is stale.
+    */
+    const T* Get(Handle handle) const { return const_cast<TSlotMap*>(this)->Get(handle); }
+
+    /**
+     * @brief Checks if a handle refers to an item of the map.
+     * @param handle Handle to check.
+     * @return True if the item is still in the map.
+    */
+    bool IsValid(Handle handle) const
+    {
+        const uint32 index      = handle.GetIndex();
+        const uint32 generation = handle.GetGeneration();
+        return (generation & 1) && index < m_slots.GetSize() && m_slots[index].Generation == generation;
+    }
+
+    /**
+     * @brief Returns the handle of an item while iterating.
+     * @param position Position of the item in the dense storage.
+     * @return Handle to the item.
+    */
+    Handle GetHandle(SizeType position) const
+    {
+        AE_ASSERT(position < m_items.GetSize());
+        const uint32 index = m_itemSlots[position];
+        return MakeHandle(index, m_slots[index].Generation);
+    }
+
+    /**
+     * @brief Makes sure count items can be added without reallocating.
+     * @param count Number of items.
+    */
+    void Reserve(SizeType count)
+    {
+        if (count > m_items.GetCapacity()) {
+            m_items.Reserve(count);
+            m_itemSlots.Reserve(count);
+        }
+        if (count > m_slots.GetCapacity()) {
+            m_slots.Reserve(count);
+        }
+    }
+
+    /**
+     * @brief Removes every item, every handle becomes stale.
+     * @param shrink If the item storage should be released, the slots are kept so stale handles stay detected.
+    */
+    void Clear(bool shrink = false)
+    {
+        for (SizeType position = 0; position < m_itemSlots.GetSize(); position++) {
+            FreeSlot(m_itemSlots[position]);
+        }
+
+        m_items.Clear(shrink);
+        m_itemSlots.Clear(shrink);
+    }
+
+    /**
+     * @brief Returns the number of items.
+     * @return The number of items.
+    */
+    SizeType GetSize() const { return m_items.GetSize(); }
+
+    /**
+     * @brief Checks if the map has no item.
+     * @return True if the map is empty.
+    */
+    bool IsEmpty() const { return m_items.GetSize() == 0; }
+
+    /**
+     * @brief Returns the densely packed items.
+     * @return Pointer to the first item.
+    */
+    T*       GetData() { return m_items.GetData(); }
+    const T* GetData() const { return m_items.GetData(); }
+
+    T&       operator[](SizeType position) { return m_items[position]; }
+    const T& operator[](SizeType position) const { return m_items[position]; }
+
+    T*       begin() { return m_items.begin(); }
+    T*       end() { return m_items.end(); }
+    const T* begin() const { return m_items.begin(); }
+    const T* end() const { return m_items.end(); }
+
+  private:
+    static constexpr Handle MakeHandle(uint32 index, uint32 generation) { return Handle{ (generation << IndexBits) | index }; }
+
+    /** Makes a slot free, the generation wraps around to 0, which is even like every free slot's.*/
+    void FreeSlot(uint32 index)
+    {
+        Slot& slot      = m_slots[index];
+        slot.Index      = m_freeSlot;
+        slot.Generation = (slot.Generation + 1) & MaxGeneration;
+        m_freeSlot      = index;
+    }
+
+    TArray<T, Allocator>      m_items;
+    TArray<uint32, Allocator> m_itemSlots;
+    TArray<Slot, Allocator>   m_slots;
+    uint32                    m_freeSlot = InvalidIndex;
+};
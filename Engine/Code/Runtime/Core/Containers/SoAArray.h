@@ -0,0 +1,385 @@
+#pragma once
+
+#include "ContainerAllocators.h"
+#include "Span.h"
+#include <tuple>
+
+/**
+ * @brief Array of records stored as a structure of arrays.
+ * Every field of the records has its own contiguous column, so a pass touching a
+ * single field streams only that field through the cache. The columns share a single
+ * allocation and every column starts on a cache line, or on its field's alignment
+ * when larger, so they can be read with aligned vector loads. Removing a record
+ * moves the last record into its place. Pointers and spans to columns are
+ * invalidated when the array reallocates.
+*/
+template<class... Fields>
+class TSoAArray
+{
+    static_assert(sizeof...(Fields) > 0, "TSoAArray needs at least one field");
+
+    static constexpr uint64 ColumnCount = sizeof...(Fields);
+
+    static constexpr uint64 GetColumnAlignment()
+    {
+        uint64 result = MemoryUtils::CacheLineAlignment;
+        for (uint64 align : { uint64(alignof(Fields))... }) {
+            result = align > result ? align : result;
+        }
+        return result;
+    }
+
+  public:
+    using SizeType = uint64;
+
+    template<uint64 Index>
+    using FieldType = std::tuple_element_t<Index, std::tuple<Fields...>>;
+
+    static constexpr uint64 ColumnAlignment = GetColumnAlignment();
+
+    /**
+     * @brief Returns the column index of a field type, the type must be used by a single field.
+     * @return Index of the field's column.
+    */
+    template<class FieldT>
+    static constexpr uint64 GetFieldIndex()
+    {
+        constexpr bool matches[] = { std::is_same_v<FieldT, Fields>... };
+
+        uint64 index = ColumnCount;
+        uint64 count = 0;
+        for (uint64 i = 0; i < ColumnCount; i++) {
+            if (matches[i]) {
+                index = i;
+                count++;
+            }
+        }
+        return count == 1 ? index : ColumnCount;
+    }
+
+    /**
+     * @brief Default constructor, no memory is allocated until the first record.
+    */
+    TSoAArray() = default;
+
+    /**
+     * @brief Copy constructor.
+     * @param other Array to be copied.
+    */
+    TSoAArray(const TSoAArray& other)
+    {
+        if (other.m_size) {
+            Reallocate(other.m_size);
+            ForEachColumnPair(m_columns, other.m_columns, [&](auto* dst, auto* src) { MemoryUtils::CopyElements(dst, src, other.m_size); });
+            m_size = other.m_size;
+        }
+    }
+
+    /**
+     * @brief Move constructor.
+     * @param other Array to be moved, left empty.
+    */
+    TSoAArray(TSoAArray&& other) noexcept
+      : m_size(other.m_size)
+      , m_capacity(other.m_capacity)
+    {
+        for (uint64 i = 0; i < ColumnCount; i++) {
+            m_columns[i] = other.m_columns[i];
+        }
+        other.Forget();
+    }
+
+    ~TSoAArray() { Destroy(); }
+
+    TSoAArray& operator=(const TSoAArray& other)
+    {
+        if (this != &other) {
+            *this = TSoAArray(other);
+        }
+        return *this;
+    }
+
+    TSoAArray& operator=(TSoAArray&& other) noexcept
+    {
+        if (this != &other) {
+            Destroy();
+
+            m_size     = other.m_size;
+            m_capacity = other.m_capacity;
+            for (uint64 i = 0; i < ColumnCount; i++) {
+                m_columns[i] = other.m_columns[i];
+            }
+
+            other.Forget();
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Adds a record to the end of the array.
+     * The array will be resized if needed.
+     * @param values One value per field, each copied or moved into its column.
+     * @return Index to the added record.
+    */
+    template<class... ArgsType>
+    SizeType Add(ArgsType&&... values)
+    {
+        static_assert(sizeof...(ArgsType) == ColumnCount, "Add takes one value per field");
+
+        if (m_size == m_capacity) {
+            Reallocate(CalculateDefaultGrowth(m_size + 1, m_capacity));
+        }
+
+        ConstructRecord(m_size, std::index_sequence_for<Fields...>(), std::forward<ArgsType>(values)...);
+        return m_size++;
+    }
+
+    /**
+     * @brief Removes a record by moving the last record into its place.
+     * O(1) but does not preserve the order of the records.
+     * @param index Index of the record to remove.
+     * @param shrink Whether unused capacity is released.
+    */
+    void RemoveAtSwap(SizeType index, bool shrink = false)
+    {
+        AE_ASSERT(index < m_size);
+
+        const SizeType last = m_size - 1;
+        ForEachColumn([&](auto* column) {
+            MemoryUtils::DestroyItems(column + index, 1);
+            if (index != last) {
+                MemoryUtils::RelocateItems(column + index, column + last, 1);
+            }
+        });
+
+        m_size--;
+        if (shrink) {
+            ShrinkToFit();
+        }
+    }
+
+    /**
+     * @brief Makes sure the array can hold a number of records without reallocating.
+     * @param count Number of records.
+    */
+    void Reserve(SizeType count)
+    {
+        if (count > m_capacity) {
+            Reallocate(count);
+        }
+    }
+
+    /**
+     * @brief Resizes the array to a new size, added records are value initialized.
+     * @param newSize New size.
+    */
+    void Resize(SizeType newSize)
+    {
+        if (newSize < m_size) {
+            ForEachColumn([&](auto* column) { MemoryUtils::DestroyItems(column + newSize, m_size - newSize); });
+        } else if (newSize > m_size) {
+            if (newSize > m_capacity) {
+                Reallocate(CalculateDefaultGrowth(newSize, m_capacity));
+            }
+            ForEachColumn([&](auto* column) { MemoryUtils::ConstructElements(column + m_size, newSize - m_size); });
+        }
+
+        m_size = newSize;
+    }
+
+    /**
+     * @brief Destroys every record.
+     * @param shrink If the memory should be released.
+    */
+    void Clear(bool shrink = false)
+    {
+        ForEachColumn([&](auto* column) { MemoryUtils::DestroyItems(column, m_size); });
+        m_size = 0;
+
+        if (shrink) {
+            ShrinkToFit();
+        }
+    }
+
+    /**
+     * @brief Requests the removal of unused capacity.
+    */
+    void ShrinkToFit()
+    {
+        if (m_size != m_capacity) {
+            Reallocate(m_size);
+        }
+    }
+
+    /**
+     * @brief Returns the number of records.
+     * @return The number of records.
+    */
+    constexpr SizeType GetSize() const { return m_size; }
+
+    /**
+     * @brief Returns the number of records the array can hold without reallocating.
+     * @return The capacity of the array.
+    */
+    constexpr SizeType GetCapacity() const { return m_capacity; }
+
+    /**
+     * @brief Checks if the array is empty.
+     * @return True if the array is empty, false otherwise.
+    */
+    constexpr bool IsEmpty() const { return m_size == 0; }
+
+    /**
+     * @brief Returns the column of a field.
+     * @return Span of the field's values, one per record.
+    */
+    template<uint64 Index>
+    TSpan<FieldType<Index>> GetColumn()
+    {
+        return TSpan<FieldType<Index>>(GetColumnData<Index>(), m_size);
+    }
+
+    template<uint64 Index>
+    TSpan<const FieldType<Index>> GetColumn() const
+    {
+        return TSpan<const FieldType<Index>>(const_cast<TSoAArray*>(this)->GetColumnData<Index>(), m_size);
+    }
+
+    /**
+     * @brief Returns the column of a field, by the field's type.
+     * @return Span of the field's values, one per record.
+    */
+    template<class FieldT>
+    TSpan<FieldT> GetColumn()
+    {
+        static_assert(GetFieldIndex<FieldT>() < ColumnCount, "The type must be used by exactly one field");
+        return GetColumn<GetFieldIndex<FieldT>()>();
+    }
+
+    template<class FieldT>
+    TSpan<const FieldT> GetColumn() const
+    {
+        static_assert(GetFieldIndex<FieldT>() < ColumnCount, "The type must be used by exactly one field");
+        return GetColumn<GetFieldIndex<FieldT>()>();
+    }
+
+    /**
+     * @brief Returns a field of a record.
+     * @param index Index of the record.
+     * @return Reference to the field's value.
+    */
+    template<uint64 Index>
+    FieldType<Index>& Get(SizeType index)
+    {
+        AE_ASSERT(index < m_size);
+        return GetColumnData<Index>()[index];
+    }
+
+    template<uint64 Index>
+    const FieldType<Index>& Get(SizeType index) const
+    {
+        return const_cast<TSoAArray*>(this)->Get<Index>(index);
+    }
+
+  private:
+    template<uint64 Index>
+    FieldType<Index>* GetColumnData()
+    {
+        return static_cast<FieldType<Index>*>(m_columns[Index]);
+    }
+
+    template<class FunctionType>
+    void ForEachColumn(FunctionType&& function)
+    {
+        ForEachColumnImpl(function, std::index_sequence_for<Fields...>());
+    }
+
+    template<class FunctionType, size_t... Indices>
+    void ForEachColumnImpl(FunctionType& function, std::index_sequence<Indices...>)
+    {
+        (function(GetColumnData<Indices>()), ...);
+    }
+
+    /** Calls function with the typed columns of the same field in two column sets.*/
+    template<class FunctionType>
+    static void ForEachColumnPair(void* const (&dst)[ColumnCount], void* const (&src)[ColumnCount], FunctionType&& function)
+    {
+        ForEachColumnPairImpl(dst, src, function, std::index_sequence_for<Fields...>());
+    }
+
+    template<class FunctionType, size_t... Indices>
+    static void ForEachColumnPairImpl(void* const (&dst)[ColumnCount], void* const (&src)[ColumnCount], FunctionType& function,
+                                      std::index_sequence<Indices...>)
+    {
+        (function(static_cast<FieldType<Indices>*>(dst[Indices]), static_cast<FieldType<Indices>*>(src[Indices])), ...);
+    }
+
+    template<size_t... Indices, class... ArgsType>
+    void ConstructRecord(SizeType index, std::index_sequence<Indices...>, ArgsType&&... values)
+    {
+        (new (GetColumnData<Indices>() + index) FieldType<Indices>(std::forward<ArgsType>(values)), ...);
+    }
+
+    /**
+     * @brief Moves the records to a new allocation laid out for a capacity.
+     * @param capacity New capacity, at least the number of records.
+    */
+    void Reallocate(SizeType capacity)
+    {
+        AE_ASSERT(capacity >= m_size);
+
+        void* columns[ColumnCount] = {};
+        if (capacity) {
+            constexpr uint64 sizes[]  = { sizeof(Fields)... };
+            constexpr uint64 aligns[] = { alignof(Fields) > ColumnAlignment ? alignof(Fields) : ColumnAlignment... };
+
+            uint64 offsets[ColumnCount];
+            uint64 size = 0;
+            for (uint64 i = 0; i < ColumnCount; i++) {
+                offsets[i] = MemoryUtils::AlignAddress(size, aligns[i]);
+                size       = offsets[i] + capacity * sizes[i];
+            }
+
+            uint8* data = reinterpret_cast<uint8*>(MemoryUtils::AllocateAligned(size, ColumnAlignment));
+            for (uint64 i = 0; i < ColumnCount; i++) {
+                columns[i] = data + offsets[i];
+            }
+
+            if (m_size) {
+                ForEachColumnPair(columns, m_columns, [&](auto* dst, auto* src) { MemoryUtils::RelocateItems(dst, src, m_size); });
+            }
+        }
+
+        if (m_columns[0]) {
+            MemoryUtils::FreeAligned(m_columns[0]);
+        }
+
+        for (uint64 i = 0; i < ColumnCount; i++) {
+            m_columns[i] = columns[i];
+        }
+        m_capacity = capacity;
+    }
+
+    void Destroy()
+    {
+        Clear();
+        if (m_columns[0]) {
+            MemoryUtils::FreeAligned(m_columns[0]);
+        }
+        Forget();
+    }
+
+    void Forget()
+    {
+        for (uint64 i = 0; i < ColumnCount; i++) {
+            m_columns[i] = nullptr;
+        }
+        m_size     = 0;
+        m_capacity = 0;
+    }
+
+  private:
+    void*    m_columns[ColumnCount] = {};
+    SizeType m_size                 = 0;
+    SizeType m_capacity             = 0;
+};
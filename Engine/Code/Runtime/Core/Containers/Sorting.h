@@ -0,0 +1,314 @@
+#pragma once
+
+#include "ContainerAllocators.h"
+#include "Math/AnvilMath.h"
+
+/**
+ * @brief Sorting algorithms working in place on contiguous items.
+ * Sort is an introsort: quicksort with a median of three pivot, falling back to heapsort when the
+ * recursion gets too deep, so it is O(n log n) in the worst case, and insertion sort for small ranges.
+ * StableSort is a merge sort and RadixSort a least significant digit radix sort, both use scratch
+ * memory from the allocator given as template argument, for example DefaultArenaAllocator to take it
+ * from the frame arena.
+*/
+class Sorting
+{
+  public:
+    /** Orders items with operator<.*/
+    struct Less
+    {
+        template<class ItemType>
+        constexpr bool operator()(const ItemType& a, const ItemType& b) const
+        {
+            return a < b;
+        }
+    };
+
+    /** Uses the item itself as radix sort key.*/
+    struct Identity
+    {
+        template<class ItemType>
+        constexpr const ItemType& operator()(const ItemType& item) const
+        {
+            return item;
+        }
+    };
+
+    /** Ranges up to this number of items are insertion sorted.*/
+    static constexpr uint64 InsertionSortThreshold = 16;
+
+    /**
+     * @brief Sorts items, items that are equal may be reordered.
+     * @param items Items to be sorted.
+     * @param count Number of items.
+     * @param predicate Function returning true if its first argument goes before its second one.
+    */
+    template<class ItemType, class PredicateType>
+    static void Sort(ItemType* items, uint64 count, const PredicateType& predicate)
+    {
+        if (count > 1) {
+            IntroSort(items, count, 2 * (64 - Math::CountLeadingZeros(count)), predicate);
+        }
+    }
+
+    /**
+     * @brief Sorts items, items that are equal keep their order.
+     * @param items Items to be sorted.
+     * @param count Number of items.
+     * @param predicate Function returning true if its first argument goes before its second one.
+    */
+    template<class ScratchAllocType, class ItemType, class PredicateType>
+    static void StableSort(ItemType* items, uint64 count, const PredicateType& predicate)
+    {
+        if (count <= InsertionSortThreshold) {
+            InsertionSort(items, count, predicate);
+            return;
+        }
+
+        using ScratchType = typename TAllocatorForElement<ScratchAllocType, ItemType>::Type;
+        ScratchType scratch;
+        scratch.Reallocate(static_cast<typename ScratchType::SizeType>(count / 2), 0, sizeof(ItemType));
+        MergeSort(items, count, reinterpret_cast<ItemType*>(scratch.GetData()), predicate);
+    }
+
+    /**
+     * @brief Sorts items by an integral or floating point key, items with equal keys keep their order.
+     * One pass is made per byte of the key, passes where every key has the same byte are skipped.
+     * @param items Items to be sorted, trivially copyable.
+     * @param count Number of items.
+     * @param key Function returning the key of an item, for example a 64 bit render sort key.
+    */
+    template<class ScratchAllocType, class ItemType, class KeyFunctionType>
+    static void RadixSort(ItemType* items, uint64 count, const KeyFunctionType& key)
+    {
+        static_assert(std::is_trivially_copyable_v<ItemType>, "Radix sorted items are copied byte wise");
+
+        using RadixKeyType         = decltype(ToRadixKey(key(*items)));
+        constexpr uint32 PassCount = sizeof(RadixKeyType);
+
+        // Below this size the histograms cost more than comparing the keys.
+        if (count <= 64) {
+            InsertionSort(items, count, [&key](const ItemType& a, const ItemType& b) { return ToRadixKey(key(a)) < ToRadixKey(key(b)); });
+            return;
+        }
+
+        const auto getDigit = [](RadixKeyType radixKey, uint32 pass) { return static_cast<uint32>((radixKey >> (pass * 8)) & 0xFF); };
+
+        uint64 histograms[PassCount][256] = {};
+        for (uint64 i = 0; i < count; i++) {
+            const RadixKeyType radixKey = ToRadixKey(key(items[i]));
+            for (uint32 pass = 0; pass < PassCount; pass++) {
+                histograms[pass][getDigit(radixKey, pass)]++;
+            }
+        }
+
+        using ScratchType = typename TAllocatorForElement<ScratchAllocType, ItemType>::Type;
+        ScratchType scratch;
+        scratch.Reallocate(static_cast<typename ScratchType::SizeType>(count), 0, sizeof(ItemType));
+
+        ItemType*          source      = items;
+        ItemType*          destination = reinterpret_cast<ItemType*>(scratch.GetData());
+        const RadixKeyType firstKey    = ToRadixKey(key(items[0]));
+        for (uint32 pass = 0; pass < PassCount; pass++) {
+            uint64* offsets = histograms[pass];
+            if (offsets[getDigit(firstKey, pass)] == count) {
+                continue;
+            }
+
+            uint64 offset = 0;
+            for (uint32 digit = 0; digit < 256; digit++) {
+                const uint64 digitCount = offsets[digit];
+                offsets[digit]          = offset;
+                offset += digitCount;
+            }
+
+            for (uint64 i = 0; i < count; i++) {
+                destination[offsets[getDigit(ToRadixKey(key(source[i])), pass)]++] = source[i];
+            }
+            std::swap(source, destination);
+        }
+
+        if (source != items) {
+            memcpy(items, source, count * sizeof(ItemType));
+        }
+    }
+
+    /**
+     * @brief Maps a key to an unsigned integer of the same size with the same order.
+     * @param key Integral, floating point or enumeration key.
+     * @return The unsigned key.
+    */
+    template<class KeyType>
+    static auto ToRadixKey(KeyType key)
+    {
+        if constexpr (std::is_enum_v<KeyType>) {
+            return ToRadixKey(static_cast<std::underlying_type_t<KeyType>>(key));
+        } else if constexpr (std::is_floating_point_v<KeyType>) {
+            static_assert(sizeof(KeyType) == 4 || sizeof(KeyType) == 8, "Unsupported floating point key");
+            using BitsType = std::conditional_t<sizeof(KeyType) == 4, uint32, uint64>;
+            constexpr BitsType SignBit = BitsType(1) << (sizeof(KeyType) * 8 - 1);
+
+            // Negative values are ordered backwards, all their bits are flipped, positive ones only get the sign bit.
+            BitsType bits;
+            memcpy(&bits, &key, sizeof(key));
+            return (bits & SignBit) ? static_cast<BitsType>(~bits) : static_cast<BitsType>(bits | SignBit);
+        } else {
+            static_assert(std::is_integral_v<KeyType>, "Radix sort keys must be integral, floating point or enumerations");
+            using UnsignedType = std::make_unsigned_t<KeyType>;
+            if constexpr (std::is_signed_v<KeyType>) {
+                return static_cast<UnsignedType>(static_cast<UnsignedType>(key) ^ (UnsignedType(1) << (sizeof(KeyType) * 8 - 1)));
+            } else {
+                return static_cast<UnsignedType>(key);
+            }
+        }
+    }
+
+  private:
+    template<class ItemType, class PredicateType>
+    static void InsertionSort(ItemType* items, uint64 count, const PredicateType& predicate)
+    {
+        for (uint64 i = 1; i < count; i++) {
+            if (predicate(items[i], items[i - 1])) {
+                ItemType item = std::move(items[i]);
+                uint64   j    = i;
+                do {
+                    items[j] = std::move(items[j - 1]);
+                    j--;
+                } while (j > 0 && predicate(item, items[j - 1]));
+                items[j] = std::move(item);
+            }
+        }
+    }
+
+    template<class ItemType, class PredicateType>
+    static void IntroSort(ItemType* items, uint64 count, uint32 depthLimit, const PredicateType& predicate)
+    {
+        while (count > InsertionSortThreshold) {
+            if (depthLimit == 0) {
+                HeapSort(items, count, predicate);
+                return;
+            }
+            depthLimit--;
+
+            // The median of three goes first as pivot, the other two bound both scans.
+            MoveMedianFirst(items, items + 1, items + count / 2, items + count - 1, predicate);
+            ItemType* left  = items + 1;
+            ItemType* right = items + count;
+            for (;;) {
+                while (predicate(*left, *items)) {
+                    left++;
+                }
+                right--;
+                while (predicate(*items, *right)) {
+                    right--;
+                }
+                if (left >= right) {
+                    break;
+                }
+                std::swap(*left, *right);
+                left++;
+            }
+
+            // Recurses into the smaller part, so the stack stays logarithmic.
+            const uint64 leftCount = static_cast<uint64>(left - items);
+            if (leftCount < count - leftCount) {
+                IntroSort(items, leftCount, depthLimit, predicate);
+                items = left;
+                count -= leftCount;
+            } else {
+                IntroSort(left, count - leftCount, depthLimit, predicate);
+                count = leftCount;
+            }
+        }
+        InsertionSort(items, count, predicate);
+    }
+
+    template<class ItemType, class PredicateType>
+    static void MoveMedianFirst(ItemType* result, ItemType* a, ItemType* b, ItemType* c, const PredicateType& predicate)
+    {
+        if (predicate(*a, *b)) {
+            if (predicate(*b, *c)) {
+                std::swap(*result, *b);
+            } else if (predicate(*a, *c)) {
+                std::swap(*result, *c);
+            } else {
+                std::swap(*result, *a);
+            }
+        } else if (predicate(*a, *c)) {
+            std::swap(*result, *a);
+        } else if (predicate(*b, *c)) {
+            std::swap(*result, *c);
+        } else {
+            std::swap(*result, *b);
+        }
+    }
+
+    template<class ItemType, class PredicateType>
+    static void HeapSort(ItemType* items, uint64 count, const PredicateType& predicate)
+    {
+        for (uint64 i = count / 2; i > 0; i--) {
+            SiftDown(items, i - 1, count, predicate);
+        }
+        for (uint64 end = count - 1; end > 0; end--) {
+            std::swap(items[0], items[end]);
+            SiftDown(items, 0, end, predicate);
+        }
+    }
+
+    template<class ItemType, class PredicateType>
+    static void SiftDown(ItemType* items, uint64 index, uint64 count, const PredicateType& predicate)
+    {
+        ItemType item = std::move(items[index]);
+        for (uint64 child = 2 * index + 1; child < count; child = 2 * index + 1) {
+            if (child + 1 < count && predicate(items[child], items[child + 1])) {
+                child++;
+            }
+            if (!predicate(item, items[child])) {
+                break;
+            }
+            items[index] = std::move(items[child]);
+            index        = child;
+        }
+        items[index] = std::move(item);
+    }
+
+    /**
+     * @brief Sorts both halves, then moves the left one into the scratch items and merges it back.
+     * @param scratch Uninitialized memory for count / 2 items.
+    */
+    template<class ItemType, class PredicateType>
+    static void MergeSort(ItemType* items, uint64 count, ItemType* scratch, const PredicateType& predicate)
+    {
+        if (count <= InsertionSortThreshold) {
+            InsertionSort(items, count, predicate);
+            return;
+        }
+
+        const uint64 half = count / 2;
+        MergeSort(items, half, scratch, predicate);
+        MergeSort(items + half, count - half, scratch, predicate);
+        if (!predicate(items[half], items[half - 1])) {
+            return;
+        }
+
+        for (uint64 i = 0; i < half; i++) {
+            new (scratch + i) ItemType(std::move(items[i]));
+        }
+
+        // The merged items are written behind the right half's next item, so none is overwritten before it is read.
+        uint64 left   = 0;
+        uint64 right  = half;
+        uint64 output = 0;
+        while (left < half && right < count) {
+            if (predicate(items[right], scratch[left])) {
+                items[output++] = std::move(items[right++]);
+            } else {
+                items[output++] = std::move(scratch[left++]);
+            }
+        }
+        while (left < half) {
+            items[output++] = std::move(scratch[left++]);
+        }
+        MemoryUtils::DestroyItems(scratch, half);
+    }
+};
@@ -0,0 +1,64 @@
+#pragma once
+
+/**
+ * @brief Non-owning view of contiguous items.
+ * It stays valid as long as the memory it views is neither freed nor moved.
+*/
+template<class T, class _SizeType = uint64>
+class TSpan
+{
+  public:
+    using ItemType = T;
+    using SizeType = _SizeType;
+
+    /**
+     * @brief Default constructor, views no item.
+    */
+    constexpr TSpan() = default;
+
+    /**
+     * @brief Constructs a view of count items.
+     * @param data Pointer to the first item.
+     * @param count Number of items.
+    */
+    constexpr TSpan(T* data, SizeType count)
+      : m_data(data)
+      , m_size(count)
+    {}
+
+    /**
+     * @brief Returns a pointer to the first item.
+     * @return Pointer to the first item.
+    */
+    constexpr T* GetData() const { return m_data; }
+
+    /**
+     * @brief Returns the number of items.
+     * @return The number of items.
+    */
+    constexpr SizeType GetSize() const { return m_size; }
+
+    /**
+     * @brief Checks if the span views no item.
+     * @return True if the span is empty.
+    */
+    constexpr bool IsEmpty() const { return m_size == 0; }
+
+    /**
+     * @brief Returns an item at a position (index).
+     * @param pos The position (index) of the desired item.
+     * @return The item at the position pos.
+    */
+    constexpr T& operator[](SizeType pos) const
+    {
+        AE_ASSERT(pos < m_size);
+        return m_data[pos];
+    }
+
+    constexpr T* begin() const { return m_data; }
+    constexpr T* end() const { return m_data + m_size; }
+
+  private:
+    T*       m_data = nullptr;
+    SizeType m_size = 0;
+};
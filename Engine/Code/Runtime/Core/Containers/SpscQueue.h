@@ -0,0 +1,221 @@
+#pragma once
+
+#include "Math/AnvilMath.h"
+#include "Memory/MemoryUtils.h"
+#include "Threading/EventCount.h"
+
+/**
+ * @brief Bounded queue between exactly one producer thread and one consumer thread.
+ * Every Try operation is wait-free: it completes in a bounded number of steps whatever the other
+ * thread does. The head and the tail are on their own cache lines, next to each side's copy of the
+ * other's position, so the threads only share a line when the copy runs out. Batches publish all
+ * their items with a single store and a single notification.
+ * The blocking operations spin shortly and then sleep until the other side makes room or adds items.
+*/
+template<class _ItemType>
+class TSpscQueue
+{
+  public:
+    using ItemType = _ItemType;
+
+    /**
+     * @brief Constructor, the memory of every item is allocated up front.
+     * @param capacity Maximum number of queued items, rounded up to a power of two.
+    */
+    explicit TSpscQueue(uint64 capacity)
+      : m_capacity(Math::RoundUpToPowerOfTwo(capacity))
+      , m_head(0)
+      , m_cachedTail(0)
+      , m_tail(0)
+      , m_cachedHead(0)
+    {
+        m_items = reinterpret_cast<ItemType*>(MemoryUtils::AllocateAligned(m_capacity * sizeof(ItemType), MemoryUtils::CacheLineAlignment));
+    }
+
+    TSpscQueue(const TSpscQueue&)            = delete;
+    TSpscQueue& operator=(const TSpscQueue&) = delete;
+
+    /**
+     * @brief Destructor, destroys the items left in the queue. No thread may use the queue anymore.
+    */
+    ~TSpscQueue()
+    {
+        const uint64 tail = m_tail.load(std::memory_order_acquire);
+        for (uint64 head = m_head.load(std::memory_order_relaxed); head != tail; head++) {
+            MemoryUtils::DestroyItems(m_items + (head & (m_capacity - 1)), 1);
+        }
+        MemoryUtils::FreeAligned(m_items);
+    }
+
+    /**
+     * @brief Adds an item constructed in place, producer only.
+     * @param args Arguments passed to the item's constructor, only used if the item is added.
+     * @return True if the item was added, false if the queue is full.
+    */
+    template<class... ArgsType>
+    bool TryEmplace(ArgsType&&... args)
+    {
+        const uint64 tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_cachedHead == m_capacity) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead == m_capacity) {
+                return false;
+            }
+        }
+
+        new (m_items + (tail & (m_capacity - 1))) ItemType(std::forward<ArgsType>(args)...);
+        m_tail.store(tail + 1, std::memory_order_release);
+        m_notEmpty.NotifyOne();
+        return true;
+    }
+
+    bool TryPush(const ItemType& item) { return TryEmplace(item); }
+    bool TryPush(ItemType&& item) { return TryEmplace(std::move(item)); }
+
+    /**
+     * @brief Adds copies of as many items as fit, producer only.
+     * @param items Items to be copied, in order.
+     * @param count Number of items.
+     * @return Number of items added, the first ones of the range.
+    */
+    uint64 TryPushBatch(const ItemType* items, uint64 count)
+    {
+        const uint64 tail = m_tail.load(std::memory_order_relaxed);
+        if (m_capacity - (tail - m_cachedHead) < count) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+        }
+
+        const uint64 free  = m_capacity - (tail - m_cachedHead);
+        const uint64 added = count < free ? count : free;
+        if (added) {
+            for (uint64 i = 0; i < added; i++) {
+                new (m_items + ((tail + i) & (m_capacity - 1))) ItemType(items[i]);
+            }
+            m_tail.store(tail + added, std::memory_order_release);
+            m_notEmpty.NotifyOne();
+        }
+        return added;
+    }
+
+    /**
+     * @brief Removes the oldest item, consumer only.
+     * @param item Receives the item.
+     * @return True if an item was removed, false if the queue is empty.
+    */
+    bool TryPop(ItemType& item) { return TryPopBatch(&item, 1) != 0; }
+
+    /**
+     * @brief Removes as many of the oldest items as are queued, up to a maximum, consumer only.
+     * @param items Receives the items, in order.
+     * @param maxCount Maximum number of items to remove.
+     * @return Number of items removed.
+    */
+    uint64 TryPopBatch(ItemType* items, uint64 maxCount)
+    {
+        const uint64 head = m_head.load(std::memory_order_relaxed);
+        if (m_cachedTail - head < maxCount) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+        }
+
+        const uint64 queued  = m_cachedTail - head;
+        const uint64 removed = maxCount < queued ? maxCount : queued;
+        if (removed) {
+            for (uint64 i = 0; i < removed; i++) {
+                ItemType* item = m_items + ((head + i) & (m_capacity - 1));
+                items[i]       = std::move(*item);
+                MemoryUtils::DestroyItems(item, 1);
+            }
+            m_head.store(head + removed, std::memory_order_release);
+            m_notFull.NotifyOne();
+        }
+        return removed;
+    }
+
+    /**
+     * @brief Adds an item, waiting while the queue is full, producer only.
+     * @param item Item to be added.
+    */
+    void Push(const ItemType& item)
+    {
+        m_notFull.Await([&] { return TryEmplace(item); });
+    }
+
+    void Push(ItemType&& item)
+    {
+        m_notFull.Await([&] { return TryEmplace(std::move(item)); });
+    }
+
+    /**
+     * @brief Adds copies of items, waiting for room until every item is added, producer only.
+     * @param items Items to be copied, in order.
+     * @param count Number of items.
+    */
+    void PushBatch(const ItemType* items, uint64 count)
+    {
+        uint64 added = 0;
+        m_notFull.Await([&] {
+            added += TryPushBatch(items + added, count - added);
+            return added == count;
+        });
+    }
+
+    /**
+     * @brief Removes the oldest item, waiting while the queue is empty, consumer only.
+     * @param item Receives the item.
+    */
+    void Pop(ItemType& item)
+    {
+        m_notEmpty.Await([&] { return TryPop(item); });
+    }
+
+    /**
+     * @brief Removes the oldest items, waiting until there is at least one, consumer only.
+     * @param items Receives the items, in order.
+     * @param maxCount Maximum number of items to remove, not 0.
+     * @return Number of items removed.
+    */
+    uint64 PopBatch(ItemType* items, uint64 maxCount)
+    {
+        uint64 removed = 0;
+        m_notEmpty.Await([&] {
+            removed = TryPopBatch(items, maxCount);
+            return removed != 0;
+        });
+        return removed;
+    }
+
+    /**
+     * @brief Returns the maximum number of queued items.
+     * @return The capacity, a power of two.
+    */
+    constexpr uint64 GetCapacity() const { return m_capacity; }
+
+    /**
+     * @brief Returns the number of queued items, which may already have changed.
+     * @return The number of items.
+    */
+    uint64 GetSize() const { return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Checks if the queue is empty, which may already have changed.
+     * @return True if the queue is empty, false otherwise.
+    */
+    bool IsEmpty() const { return GetSize() == 0; }
+
+  private:
+    // Read only after construction.
+    ItemType*    m_items;
+    const uint64 m_capacity;
+
+    // Consumer side.
+    alignas(MemoryUtils::CacheLineAlignment) std::atomic<uint64> m_head;
+    uint64 m_cachedTail;
+
+    // Producer side.
+    alignas(MemoryUtils::CacheLineAlignment) std::atomic<uint64> m_tail;
+    uint64 m_cachedHead;
+
+    // Only written when a thread waits.
+    alignas(MemoryUtils::CacheLineAlignment) EventCount m_notEmpty;
+    EventCount m_notFull;
+};
@@ -0,0 +1,887 @@
+#include "StringUtils.h"
+#include "Math/AnvilMath.h"
+#include "Memory/Allocators/DynamicAllocator.h"
+
+#include <cmath>
+#include <limits>
+
+namespace {
+
+/** Two digit strings of 00 to 99, so integers are written two digits per division.*/
+constexpr char DigitPairs[] = "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+                              "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+                              "8081828384858687888990919293949596979899";
+
+constexpr char HexDigits[] = "0123456789abcdef";
+
+/**
+ * Output of a format call. Text past the capacity is counted but not written,
+ * so a truncated call still reports the size it needs.
+ */
+struct FormatOutput
+{
+    tchar* Data;
+    uint64 Capacity;
+    uint64 Size;
+
+    void Write(const tchar* text, uint64 size)
+    {
+        if (Size < Capacity) {
+            const uint64 room = Capacity - Size;
+            memcpy(Data + Size, text, size < room ? size : room);
+        }
+        Size += size;
+    }
+
+    void Fill(tchar c, uint64 count)
+    {
+        if (Size < Capacity) {
+            const uint64 room = Capacity - Size;
+            memset(Data + Size, c, count < room ? count : room);
+        }
+        Size += count;
+    }
+
+    void Pad(uint64 width, uint64 size)
+    {
+        if (width > size) {
+            Fill(' ', width - size);
+        }
+    }
+};
+
+uint32
+CountDecimalDigits(uint64 value)
+{
+    uint32 count = 1;
+    for (;;) {
+        if (value < 10) {
+            return count;
+        }
+        if (value < 100) {
+            return count + 1;
+        }
+        if (value < 1000) {
+            return count + 2;
+        }
+        if (value < 10000) {
+            return count + 3;
+        }
+        value /= 10000;
+        count += 4;
+    }
+}
+
+/** Writes the digits of value backwards from end, which must have room for them.*/
+void
+WriteDecimalDigits(tchar* end, uint64 value)
+{
+    while (value >= 100) {
+        const uint64 pair = (value % 100) * 2;
+        value /= 100;
+        *--end = static_cast<tchar>(DigitPairs[pair + 1]);
+        *--end = static_cast<tchar>(DigitPairs[pair]);
+    }
+    if (value >= 10) {
+        *--end = static_cast<tchar>(DigitPairs[value * 2 + 1]);
+        *--end = static_cast<tchar>(DigitPairs[value * 2]);
+    } else {
+        *--end = static_cast<tchar>('0' + value);
+    }
+}
+
+uint32
+WriteHexDigits(tchar* buffer, uint64 value)
+{
+    const uint32 count = (64 - Math::CountLeadingZeros(value | 1) + 3) / 4;
+    for (uint32 i = count; i > 0; i--) {
+        buffer[i - 1] = static_cast<tchar>(HexDigits[value & 0xF]);
+        value >>= 4;
+    }
+    return count;
+}
+
+/**
+ * Shortest float to decimal conversion, Grisu2 by Florian Loitsch ("Printing Floating-Point
+ * Numbers Quickly and Accurately with Integers"). The digits always read back to the same
+ * value and are the shortest such digits for all but a tiny fraction of inputs.
+ */
+struct DiyFp
+{
+    uint64 F;
+    int32  E;
+};
+
+struct Boundaries
+{
+    DiyFp W;
+    DiyFp Minus;
+    DiyFp Plus;
+};
+
+struct CachedPower
+{
+    uint64 F;
+    int32  E;
+    int32  K;
+};
+
+/** Products of the cached powers land in this range of binary exponents, so digits come out of 32 bit integers.*/
+constexpr int32 MinTargetExponent = -60;
+
+/** Normalized 10^k for k = -300, -292, ..., 324.*/
+constexpr CachedPower CachedPowers[] = {
+    { 0xAB70FE17C79AC6CA, -1060, -300 },
+    { 0xFF77B1FCBEBCDC4F, -1034, -292 },
+    { 0xBE5691EF416BD60C, -1007, -284 },
+    { 0x8DD01FAD907FFC3C, -980, -276 },
+    { 0xD3515C2831559A83, -954, -268 },
+    { 0x9D71AC8FADA6C9B5, -927, -260 },
+    { 0xEA9C227723EE8BCB, -901, -252 },
+    { 0xAECC49914078536D, -874, -244 },
+    { 0x823C12795DB6CE57, -847, -236 },
+    { 0xC21094364DFB5637, -821, -228 },
+    { 0x9096EA6F3848984F, -794, -220 },
+    { 0xD77485CB25823AC7, -768, -212 },
+    { 0xA086CFCD97BF97F4, -741, -204 },
+    { 0xEF340A98172AACE5, -715, -196 },
+    { 0xB23867FB2A35B28E, -688, -188 },
+    { 0x84C8D4DFD2C63F3B, -661, -180 },
+    { 0xC5DD44271AD3CDBA, -635, -172 },
+    { 0x936B9FCEBB25C996, -608, -164 },
+    { 0xDBAC6C247D62A584, -582, -156 },
+    { 0xA3AB66580D5FDAF6, -555, -148 },
+    { 0xF3E2F893DEC3F126, -529, -140 },
+    { 0xB5B5ADA8AAFF80B8, -502, -132 },
+    { 0x87625F056C7C4A8B, -475, -124 },
+    { 0xC9BCFF6034C13053, -449, -116 },
+    { 0x964E858C91BA2655, -422, -108 },
+    { 0xDFF9772470297EBD, -396, -100 },
+    { 0xA6DFBD9FB8E5B88F, -369, -92 },
+    { 0xF8A95FCF88747D94, -343, -84 },
+    { 0xB94470938FA89BCF, -316, -76 },
+    { 0x8A08F0F8BF0F156B, -289, -68 },
+    { 0xCDB02555653131B6, -263, -60 },
+    { 0x993FE2C6D07B7FAC, -236, -52 },
+    { 0xE45C10C42A2B3B06, -210, -44 },
+    { 0xAA242499697392D3, -183, -36 },
+    { 0xFD87B5F28300CA0E, -157, -28 },
+    { 0xBCE5086492111AEB, -130, -20 },
+    { 0x8CBCCC096F5088CC, -103, -12 },
+    { 0xD1B71758E219652C, -77, -4 },
+    { 0x9C40000000000000, -50, 4 },
+    { 0xE8D4A51000000000, -24, 12 },
+    { 0xAD78EBC5AC620000, 3, 20 },
+    { 0x813F3978F8940984, 30, 28 },
+    { 0xC097CE7BC90715B3, 56, 36 },
+    { 0x8F7E32CE7BEA5C70, 83, 44 },
+    { 0xD5D238A4ABE98068, 109, 52 },
+    { 0x9F4F2726179A2245, 136, 60 },
+    { 0xED63A231D4C4FB27, 162, 68 },
+    { 0xB0DE65388CC8ADA8, 189, 76 },
+    { 0x83C7088E1AAB65DB, 216, 84 },
+    { 0xC45D1DF942711D9A, 242, 92 },
+    { 0x924D692CA61BE758, 269, 100 },
+    { 0xDA01EE641A708DEA, 295, 108 },
+    { 0xA26DA3999AEF774A, 322, 116 },
+    { 0xF209787BB47D6B85, 348, 124 },
+    { 0xB454E4A179DD1877, 375, 132 },
+    { 0x865B86925B9BC5C2, 402, 140 },
+    { 0xC83553C5C8965D3D, 428, 148 },
+    { 0x952AB45CFA97A0B3, 455, 156 },
+    { 0xDE469FBD99A05FE3, 481, 164 },
+    { 0xA59BC234DB398C25, 508, 172 },
+    { 0xF6C69A72A3989F5C, 534, 180 },
+    { 0xB7DCBF5354E9BECE, 561, 188 },
+    { 0x88FCF317F22241E2, 588, 196 },
+    { 0xCC20CE9BD35C78A5, 614, 204 },
+    { 0x98165AF37B2153DF, 641, 212 },
+    { 0xE2A0B5DC971F303A, 667, 220 },
+    { 0xA8D9D1535CE3B396, 694, 228 },
+    { 0xFB9B7CD9A4A7443C, 720, 236 },
+    { 0xBB764C4CA7A44410, 747, 244 },
+    { 0x8BAB8EEFB6409C1A, 774, 252 },
+    { 0xD01FEF10A657842C, 800, 260 },
+    { 0x9B10A4E5E9913129, 827, 268 },
+    { 0xE7109BFBA19C0C9D, 853, 276 },
+    { 0xAC2820D9623BF429, 880, 284 },
+    { 0x80444B5E7AA7CF85, 907, 292 },
+    { 0xBF21E44003ACDD2D, 933, 300 },
+    { 0x8E679C2F5E44FF8F, 960, 308 },
+    { 0xD433179D9C8CB841, 986, 316 },
+    { 0x9E19DB92B4E31BA9, 1013, 324 },
+};
+
+DiyFp
+Subtract(const DiyFp& x, const DiyFp& y)
+{
+    AE_ASSERT(x.E == y.E && x.F >= y.F);
+    return DiyFp{ x.F - y.F, x.E };
+}
+
+/** Upper 64 bits of the 128 bit product, rounded.*/
+DiyFp
+Multiply(const DiyFp& x, const DiyFp& y)
+{
+    const uint64 xLow  = x.F & 0xFFFFFFFFu;
+    const uint64 xHigh = x.F >> 32;
+    const uint64 yLow  = y.F & 0xFFFFFFFFu;
+    const uint64 yHigh = y.F >> 32;
+
+    const uint64 p0 = xLow * yLow;
+    const uint64 p1 = xLow * yHigh;
+    const uint64 p2 = xHigh * yLow;
+    const uint64 p3 = xHigh * yHigh;
+
+    uint64 middle = (p0 >> 32) + (p1 & 0xFFFFFFFFu) + (p2 & 0xFFFFFFFFu);
+    middle += uint64(1) << 31;
+
+    return DiyFp{ p3 + (p2 >> 32) + (p1 >> 32) + (middle >> 32), x.E + y.E + 64 };
+}
+
+DiyFp
+Normalize(const DiyFp& x)
+{
+    const uint32 shift = Math::CountLeadingZeros(x.F);
+    return DiyFp{ x.F << shift, x.E - static_cast<int32>(shift) };
+}
+
+/** Computes the value and the midpoints to its neighbors, value must be positive and finite.*/
+template<class FloatType>
+Boundaries
+ComputeBoundaries(FloatType value)
+{
+    using BitsType = std::conditional_t<sizeof(FloatType) == 4, uint32, uint64>;
+
+    constexpr int32  Precision = std::numeric_limits<FloatType>::digits;
+    constexpr int32  Bias      = std::numeric_limits<FloatType>::max_exponent - 1 + (Precision - 1);
+    constexpr int32  MinExp    = 1 - Bias;
+    constexpr uint64 HiddenBit = uint64(1) << (Precision - 1);
+
+    BitsType bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    const uint64 exponent = static_cast<uint64>(bits) >> (Precision - 1);
+    const uint64 fraction = static_cast<uint64>(bits) & (HiddenBit - 1);
+
+    const DiyFp v = exponent == 0 ? DiyFp{ fraction, MinExp } : DiyFp{ fraction + HiddenBit, static_cast<int32>(exponent) - Bias };
+
+    // The lower neighbor is closer when the value is a power of two, except for the smallest normal.
+    const bool  lowerIsCloser = fraction == 0 && exponent > 1;
+    const DiyFp plus          = Normalize(DiyFp{ 2 * v.F + 1, v.E - 1 });
+    const DiyFp minus         = lowerIsCloser ? DiyFp{ 4 * v.F - 1, v.E - 2 } : DiyFp{ 2 * v.F - 1, v.E - 1 };
+
+    return Boundaries{ Normalize(v), DiyFp{ minus.F << (minus.E - plus.E), plus.E }, plus };
+}
+
+CachedPower
+GetCachedPower(int32 exponent)
+{
+    // k = ceil((MinTargetExponent - exponent - 1) * log10(2)), then rounded up to a table step.
+    const int32 f     = MinTargetExponent - exponent - 1;
+    const int32 k     = (f * 78913) / (1 << 18) + (f > 0);
+    const int32 index = (300 + k + 7) / 8;
+
+    AE_ASSERT(index >= 0 && index < static_cast<int32>(sizeof(CachedPowers) / sizeof(CachedPowers[0])));
+    return CachedPowers[index];
+}
+
+/** Moves the last digit towards the value while it stays inside the boundaries.*/
+void
+Grisu2Round(tchar* digits, int32 length, uint64 distance, uint64 delta, uint64 rest, uint64 tenK)
+{
+    while (rest < distance && delta - rest >= tenK && (rest + tenK < distance || distance - rest > rest + tenK - distance)) {
+        digits[length - 1]--;
+        rest += tenK;
+    }
+}
+
+/** Generates the digits of a value between minus and plus, as close as possible to w.*/
+void
+Grisu2DigitGen(tchar* digits, int32& length, int32& exponent, const DiyFp& minus, const DiyFp& w, const DiyFp& plus)
+{
+    uint64 delta    = Subtract(plus, minus).F;
+    uint64 distance = Subtract(plus, w).F;
+
+    const int32  shift = -plus.E;
+    const uint64 one   = uint64(1) << shift;
+
+    uint32 integral   = static_cast<uint32>(plus.F >> shift);
+    uint64 fractional = plus.F & (one - 1);
+
+    uint32 count = CountDecimalDigits(integral);
+    uint32 pow10 = 1;
+    for (uint32 i = 1; i < count; i++) {
+        pow10 *= 10;
+    }
+
+    while (count > 0) {
+        digits[length++] = static_cast<tchar>('0' + integral / pow10);
+        integral %= pow10;
+        count--;
+
+        const uint64 rest = (static_cast<uint64>(integral) << shift) + fractional;
+        if (rest <= delta) {
+            exponent += static_cast<int32>(count);
+            Grisu2Round(digits, length, distance, delta, rest, static_cast<uint64>(pow10) << shift);
+            return;
+        }
+        pow10 /= 10;
+    }
+
+    int32 fractionalDigits = 0;
+    for (;;) {
+        fractional *= 10;
+        digits[length++] = static_cast<tchar>('0' + (fractional >> shift));
+        fractional &= one - 1;
+        fractionalDigits++;
+
+        delta *= 10;
+        distance *= 10;
+        if (fractional <= delta) {
+            break;
+        }
+    }
+
+    exponent -= fractionalDigits;
+    Grisu2Round(digits, length, distance, delta, fractional, one);
+}
+
+/**
+ * Decimal digits of a float, the value is 0.Digits * 10^Point.
+ * Zero is the single digit 0 with Point 1. The exact value of a double has at most 767 significant digits.
+ */
+struct Decimal
+{
+    tchar Digits[768];
+    int32 Length;
+    int32 Point;
+};
+
+template<class FloatType>
+Decimal
+ToShortestDecimal(FloatType value)
+{
+    Decimal result;
+    if (value == 0) {
+        result.Digits[0] = '0';
+        result.Length    = 1;
+        result.Point     = 1;
+        return result;
+    }
+
+    const Boundaries  boundaries = ComputeBoundaries(value);
+    const CachedPower cached     = GetCachedPower(boundaries.Plus.E);
+    const DiyFp       power      = DiyFp{ cached.F, cached.E };
+
+    const DiyFp w     = Multiply(boundaries.W, power);
+    const DiyFp minus = Multiply(boundaries.Minus, power);
+    const DiyFp plus  = Multiply(boundaries.Plus, power);
+
+    // Shrinks the range by one unit on each side to stay inside it despite the rounded products.
+    int32 exponent = -cached.K;
+    result.Length  = 0;
+    Grisu2DigitGen(result.Digits, result.Length, exponent, DiyFp{ minus.F + 1, minus.E }, w, DiyFp{ plus.F - 1, plus.E });
+
+    result.Point = result.Length + exponent;
+    return result;
+}
+
+/**
+ * Unsigned integer wide enough for any double scaled by the power of ten that brings it between 0.1 and 10,
+ * so digits at a given precision are computed from the exact binary value.
+ */
+struct BigInteger
+{
+    static constexpr int32 MaxWords = 40;
+
+    uint32 Words[MaxWords];
+    int32  Size;
+};
+
+BigInteger
+MakeBigInteger(uint64 value)
+{
+    BigInteger result;
+    result.Words[0] = static_cast<uint32>(value);
+    result.Words[1] = static_cast<uint32>(value >> 32);
+    result.Size     = result.Words[1] ? 2 : result.Words[0] ? 1 : 0;
+    return result;
+}
+
+void
+MultiplySmall(BigInteger& x, uint32 factor)
+{
+    uint64 carry = 0;
+    for (int32 i = 0; i < x.Size; i++) {
+        const uint64 product = static_cast<uint64>(x.Words[i]) * factor + carry;
+        x.Words[i]           = static_cast<uint32>(product);
+        carry                = product >> 32;
+    }
+    if (carry) {
+        AE_ASSERT(x.Size < BigInteger::MaxWords);
+        x.Words[x.Size++] = static_cast<uint32>(carry);
+    }
+}
+
+void
+MultiplyPow10(BigInteger& x, int32 exponent)
+{
+    constexpr uint32 Pow10[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000 };
+    for (; exponent >= 9; exponent -= 9) {
+        MultiplySmall(x, Pow10[9]);
+    }
+    MultiplySmall(x, Pow10[exponent]);
+}
+
+void
+ShiftLeft(BigInteger& x, int32 shift)
+{
+    if (x.Size == 0) {
+        return;
+    }
+
+    const int32 words = shift / 32;
+    const int32 bits  = shift % 32;
+    AE_ASSERT(x.Size + words + 1 <= BigInteger::MaxWords);
+
+    x.Words[x.Size + words] = 0;
+    for (int32 i = x.Size - 1; i >= 0; i--) {
+        if (bits) {
+            x.Words[i + words + 1] |= x.Words[i] >> (32 - bits);
+        }
+        x.Words[i + words] = x.Words[i] << bits;
+    }
+    for (int32 i = 0; i < words; i++) {
+        x.Words[i] = 0;
+    }
+
+    x.Size += words + 1;
+    while (x.Size > 0 && x.Words[x.Size - 1] == 0) {
+        x.Size--;
+    }
+}
+
+int32
+Compare(const BigInteger& x, const BigInteger& y)
+{
+    if (x.Size != y.Size) {
+        return x.Size < y.Size ? -1 : 1;
+    }
+    for (int32 i = x.Size - 1; i >= 0; i--) {
+        if (x.Words[i] != y.Words[i]) {
+            return x.Words[i] < y.Words[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+/** Divides x by y and leaves the remainder in x, the quotient must be a single digit.*/
+uint32
+DivideDigit(BigInteger& x, const BigInteger& y)
+{
+    uint32 quotient = 0;
+    while (Compare(x, y) >= 0) {
+        uint64 borrow = 0;
+        for (int32 i = 0; i < x.Size; i++) {
+            const uint64 difference = static_cast<uint64>(x.Words[i]) - (i < y.Size ? y.Words[i] : 0) - borrow;
+            x.Words[i]              = static_cast<uint32>(difference);
+            borrow                  = difference >> 63;
+        }
+        while (x.Size > 0 && x.Words[x.Size - 1] == 0) {
+            x.Size--;
+        }
+        quotient++;
+    }
+
+    AE_ASSERT(quotient < 10);
+    return quotient;
+}
+
+/**
+ * Correctly rounded digits of a double, ties to even like printf.
+ * @param digits Number of significant digits, or of digits after the point when fixed is true.
+ */
+Decimal
+ToExactDecimal(double value, int32 digits, bool fixed)
+{
+    Decimal result;
+    result.Length = 0;
+
+    if (value != 0) {
+        uint64 bits;
+        memcpy(&bits, &value, sizeof(bits));
+
+        const uint64 exponent = bits >> 52;
+        const uint64 fraction = bits & ((uint64(1) << 52) - 1);
+        const uint64 f        = exponent ? fraction | (uint64(1) << 52) : fraction;
+        const int32  e        = exponent ? static_cast<int32>(exponent) - 1075 : -1074;
+
+        // value = num / den, scaled by a power of ten to be below 1 and at least 0.1.
+        BigInteger num = MakeBigInteger(f);
+        BigInteger den = MakeBigInteger(1);
+        if (e > 0) {
+            ShiftLeft(num, e);
+        } else {
+            ShiftLeft(den, -e);
+        }
+
+        // The estimate is never above the point, a value at the bottom of its binade only needs one more step.
+        const int32 highestBit = e + 63 - static_cast<int32>(Math::CountLeadingZeros(f));
+        result.Point           = static_cast<int32>(std::floor(highestBit * 0.30102999566398120)) + 1;
+        if (result.Point > 0) {
+            MultiplyPow10(den, result.Point);
+        } else {
+            MultiplyPow10(num, -result.Point);
+        }
+        while (Compare(num, den) >= 0) {
+            MultiplySmall(den, 10);
+            result.Point++;
+        }
+
+        const int32 count = fixed ? result.Point + digits : digits;
+        while (result.Length < count && num.Size > 0) {
+            MultiplySmall(num, 10);
+            result.Digits[result.Length++] = static_cast<tchar>('0' + DivideDigit(num, den));
+        }
+
+        if (count >= 0 && num.Size > 0) {
+            ShiftLeft(num, 1);
+            const int32 half = Compare(num, den);
+            const bool  odd  = count > 0 && ((result.Digits[count - 1] - '0') & 1);
+            if (half > 0 || (half == 0 && odd)) {
+                int32 i = result.Length - 1;
+                while (i >= 0 && result.Digits[i] == '9') {
+                    i--;
+                }
+                if (i < 0) {
+                    result.Digits[0] = '1';
+                    result.Length    = 1;
+                    result.Point++;
+                } else {
+                    result.Digits[i]++;
+                    result.Length = i + 1;
+                }
+            }
+        }
+    }
+
+    if (result.Length == 0) {
+        result.Digits[0] = '0';
+        result.Length    = 1;
+        result.Point     = 1;
+    }
+    return result;
+}
+
+/** Writes the decimal with precision digits after the point, the decimal must not have more.*/
+void
+WriteFixed(FormatOutput& out, const Decimal& decimal, bool negative, uint32 precision, uint32 width)
+{
+    const uint64 integralSize = decimal.Point > 0 ? static_cast<uint64>(decimal.Point) : 1;
+    out.Pad(width, negative + integralSize + (precision ? precision + 1 : 0));
+
+    if (negative) {
+        out.Fill('-', 1);
+    }
+
+    if (decimal.Point <= 0) {
+        out.Fill('0', 1);
+    } else if (decimal.Point <= decimal.Length) {
+        out.Write(decimal.Digits, decimal.Point);
+    } else {
+        out.Write(decimal.Digits, decimal.Length);
+        out.Fill('0', decimal.Point - decimal.Length);
+    }
+
+    if (precision) {
+        out.Fill('.', 1);
+
+        const int32  first   = decimal.Point > 0 ? decimal.Point : 0;
+        const uint64 zeros   = decimal.Point < 0 ? static_cast<uint64>(-decimal.Point) : 0;
+        const uint64 leading = zeros < precision ? zeros : precision;
+        const uint64 digits  = decimal.Length > first ? static_cast<uint64>(decimal.Length - first) : 0;
+        out.Fill('0', leading);
+        out.Write(decimal.Digits + first, digits);
+        out.Fill('0', precision - leading - digits);
+    }
+}
+
+/** Writes the decimal with precision digits after the first one, the decimal must not have more.*/
+void
+WriteExponent(FormatOutput& out, const Decimal& decimal, bool negative, uint32 precision, uint32 width)
+{
+    const int32  exponent     = decimal.Point - 1;
+    const uint64 magnitude    = static_cast<uint64>(exponent < 0 ? -exponent : exponent);
+    const uint32 exponentSize = magnitude < 100 ? 2 : 3;
+    const uint64 digits       = static_cast<uint64>(decimal.Length - 1);
+    out.Pad(width, negative + 1 + (precision ? precision + 1 : 0) + 2 + exponentSize);
+
+    if (negative) {
+        out.Fill('-', 1);
+    }
+
+    out.Write(decimal.Digits, 1);
+    if (precision) {
+        out.Fill('.', 1);
+        out.Write(decimal.Digits + 1, digits);
+        out.Fill('0', precision - digits);
+    }
+
+    tchar exponentText[5] = { 'e', exponent < 0 ? '-' : '+' };
+    WriteDecimalDigits(exponentText + 2 + exponentSize, magnitude);
+    if (magnitude < 10) {
+        exponentText[2] = '0';
+    }
+    out.Write(exponentText, 2 + exponentSize);
+}
+
+/** Plain notation for decimal exponents from -4 up to maxExponent, exponent notation otherwise, every digit of the decimal is written.*/
+void
+WriteGeneral(FormatOutput& out, const Decimal& decimal, bool negative, int32 maxExponent, uint32 width)
+{
+    if (decimal.Point - 1 >= -4 && decimal.Point - 1 < maxExponent) {
+        const int32 fraction = decimal.Length - decimal.Point;
+        WriteFixed(out, decimal, negative, fraction > 0 ? static_cast<uint32>(fraction) : 0, width);
+    } else {
+        WriteExponent(out, decimal, negative, static_cast<uint32>(decimal.Length - 1), width);
+    }
+}
+
+template<class FloatType>
+void
+WriteFloat(FormatOutput& out, FloatType value, const StringUtils::FormatSpec& spec)
+{
+    const bool negative = std::signbit(value);
+    if (std::isnan(value) || std::isinf(value)) {
+        const tchar* text = std::isnan(value) ? ATEXT("nan") : negative ? ATEXT("-inf") : ATEXT("inf");
+        const uint64 size = std::isnan(value) || !negative ? 3 : 4;
+        out.Pad(spec.Width, size);
+        out.Write(text, size);
+        return;
+    }
+
+    const FloatType magnitude = negative ? -value : value;
+    if (!spec.HasPrecision) {
+        const Decimal decimal = ToShortestDecimal(magnitude);
+        switch (spec.Type) {
+            case 'f': {
+                const int32 fraction = decimal.Length - decimal.Point;
+                WriteFixed(out, decimal, negative, fraction > 0 ? static_cast<uint32>(fraction) : 0, spec.Width);
+                break;
+            }
+            case 'e':
+                WriteExponent(out, decimal, negative, static_cast<uint32>(decimal.Length - 1), spec.Width);
+                break;
+            default:
+                WriteGeneral(out, decimal, negative, 16, spec.Width);
+                break;
+        }
+        return;
+    }
+
+    // Rounding the shortest digits again would round twice, the digits at the precision come from the exact value.
+    switch (spec.Type) {
+        case 'f':
+            WriteFixed(out, ToExactDecimal(magnitude, static_cast<int32>(spec.Precision), true), negative, spec.Precision, spec.Width);
+            break;
+        case 'e':
+            WriteExponent(out, ToExactDecimal(magnitude, static_cast<int32>(spec.Precision) + 1, false), negative, spec.Precision, spec.Width);
+            break;
+        default: {
+            // Like printf's %g, trailing zeros are dropped and exponents from the precision up use exponent notation.
+            const int32 precision = spec.Precision ? static_cast<int32>(spec.Precision) : 1;
+            Decimal     decimal   = ToExactDecimal(magnitude, precision, false);
+            while (decimal.Length > 1 && decimal.Digits[decimal.Length - 1] == '0') {
+                decimal.Length--;
+            }
+            WriteGeneral(out, decimal, negative, precision, spec.Width);
+            break;
+        }
+    }
+}
+
+void
+WriteInteger(FormatOutput& out, uint64 magnitude, bool negative, const StringUtils::FormatSpec& spec)
+{
+    tchar  digits[StringUtils::MaxIntegerChars];
+    uint32 size;
+    if (spec.Type == 'x') {
+        size = WriteHexDigits(digits, magnitude);
+    } else {
+        size = CountDecimalDigits(magnitude);
+        WriteDecimalDigits(digits + size, magnitude);
+    }
+
+    out.Pad(spec.Width, negative + size);
+    if (negative) {
+        out.Fill('-', 1);
+    }
+    out.Write(digits, size);
+}
+
+void
+WriteText(FormatOutput& out, const StringUtils::FormatText& text, const StringUtils::FormatSpec& spec)
+{
+    uint64 size = text.Size;
+    if (spec.HasPrecision) {
+        // Cuts the text before the first code point past the precision.
+        uint64 count = 0;
+        for (uint64 i = 0; i < size; i++) {
+            if ((text.Data[i] & 0xC0) != 0x80 && count++ == spec.Precision) {
+                size = i;
+            }
+        }
+    }
+
+    out.Write(text.Data, size);
+    if (spec.Width) {
+        out.Pad(spec.Width, Utf8::CountCodePoints(text.Data, size));
+    }
+}
+
+void
+WriteArg(FormatOutput& out, const StringUtils::FormatArg& arg, const StringUtils::FormatSpec& spec)
+{
+    switch (arg.Type) {
+        case StringUtils::FormatArgType::Signed:
+            WriteInteger(out, arg.Signed < 0 ? 0 - static_cast<uint64>(arg.Signed) : static_cast<uint64>(arg.Signed), arg.Signed < 0, spec);
+            break;
+        case StringUtils::FormatArgType::Unsigned:
+            WriteInteger(out, arg.Unsigned, false, spec);
+            break;
+        case StringUtils::FormatArgType::Float:
+            WriteFloat(out, arg.Float, spec);
+            break;
+        case StringUtils::FormatArgType::Double:
+            WriteFloat(out, arg.Double, spec);
+            break;
+        case StringUtils::FormatArgType::Text:
+            WriteText(out, arg.Text, spec);
+            break;
+    }
+}
+
+} // namespace
+
+uint64
+StringUtils::FormatImpl(tchar* buffer, uint64 capacity, const tchar* format, const FormatArg* args, uint32 count)
+{
+    AE_ASSERT(buffer || capacity == 0);
+    AE_ASSERT(format);
+
+    FormatOutput out    = { buffer, capacity ? capacity - 1 : 0, 0 };
+    uint32       next   = 0;
+    const tchar* cursor = format;
+    for (;;) {
+        const tchar* literal = cursor;
+        while (*cursor && *cursor != '{' && *cursor != '}') {
+            cursor++;
+        }
+        out.Write(literal, static_cast<uint64>(cursor - literal));
+
+        if (!*cursor) {
+            break;
+        }
+
+        // Escaped and stray braces are written as they are.
+        const tchar* brace = cursor++;
+        if (*cursor == *brace) {
+            out.Write(cursor++, 1);
+            continue;
+        }
+        if (*brace == '}') {
+            out.Write(brace, 1);
+            continue;
+        }
+
+        FormatSpec spec = {};
+        if (!ParsePlaceholder(cursor, spec)) {
+            out.Write(brace, 1);
+            cursor = brace + 1;
+            continue;
+        }
+
+        const uint32 index = spec.HasIndex ? spec.Index : next++;
+        if (index < count) {
+            WriteArg(out, args[index], spec);
+        }
+    }
+
+    if (capacity) {
+        buffer[out.Size < out.Capacity ? out.Size : out.Capacity] = 0;
+    }
+    return out.Size;
+}
+
+uint32
+StringUtils::IntegerToChars(tchar* buffer, uint64 value)
+{
+    const uint32 size = CountDecimalDigits(value);
+    WriteDecimalDigits(buffer + size, value);
+    return size;
+}
+
+uint32
+StringUtils::IntegerToChars(tchar* buffer, int64 value)
+{
+    if (value < 0) {
+        buffer[0] = '-';
+        return 1 + IntegerToChars(buffer + 1, 0 - static_cast<uint64>(value));
+    }
+    return IntegerToChars(buffer, static_cast<uint64>(value));
+}
+
+uint32
+StringUtils::FloatToChars(tchar* buffer, double value)
+{
+    FormatOutput out = { buffer, MaxFloatChars, 0 };
+    WriteFloat(out, value, FormatSpec{});
+    return static_cast<uint32>(out.Size);
+}
+
+uint32
+StringUtils::FloatToChars(tchar* buffer, float value)
+{
+    FormatOutput out = { buffer, MaxFloatChars, 0 };
+    WriteFloat(out, value, FormatSpec{});
+    return static_cast<uint32>(out.Size);
+}
+
+void
+StringUtils::InvalidFormatString()
+{
+    AE_ASSERT(!"Invalid format string");
+}
+
+String
+StringUtils::FormatToString(const tchar* format, const FormatArg* args, uint32 count)
+{
+    tchar        text[256];
+    const uint64 size = FormatImpl(text, sizeof(text), format, args, count);
+    if (size < sizeof(text)) {
+        return String(text, static_cast<uint32>(size));
+    }
+
+    using ScratchAllocator = TDynamicAllocator<tchar, uint64>;
+    ScratchAllocator::ScopedMarker marker;
+
+    tchar* scratch = ScratchAllocator::GetThreadAllocator().Allocate(size + 1);
+    FormatImpl(scratch, size + 1, format, args, count);
+    return String(scratch, static_cast<uint32>(size));
+}
+
+const tchar*
+StringUtils::FormatToArena(MemoryArena& arena, const tchar* format, const FormatArg* args, uint32 count)
+{
+    tchar        text[256];
+    const uint64 size = FormatImpl(text, sizeof(text), format, args, count);
+
+    tchar* result = reinterpret_cast<tchar*>(arena.Allocate(size + 1, alignof(tchar)));
+    if (size < sizeof(text)) {
+        memcpy(result, text, size + 1);
+    } else {
+        FormatImpl(result, size + 1, format, args, count);
+    }
+    return result;
+}
@@ -0,0 +1,354 @@
+#pragma once
+
+#include "AnvilString.h"
+#include "Memory/Allocators/MemoryArena.h"
+
+/**
+ * @brief String formatting and number to text conversions.
+ * Placeholders have the form {[index][:[type][width][.precision]]}, braces are escaped as {{ and }}.
+ * Every placeholder without an index takes the next argument, placeholders naming one by index
+ * do not move to the next argument. Every argument must be referenced. The types are s (text),
+ * d and x (decimal and hexadecimal integers), f, e and g (fixed, exponent and general floats).
+ * Width is counted in code points, numbers are aligned to the right and text to the left. Precision
+ * is the number of digits after the point of f and e, the number of significant digits of g and
+ * the maximum number of code points of text. Floats are rounded to the precision from their exact
+ * value like printf, without a precision they are written with the shortest digits that read back
+ * to the same value.
+ * Formatting never allocates temporaries, the format string is checked against the arguments
+ * at compile time when the compiler supports consteval and by an assert otherwise.
+*/
+class StringUtils
+{
+  public:
+    /** Buffer size that fits any integer written by IntegerToChars.*/
+    static constexpr uint32 MaxIntegerChars = 20;
+
+    /** Buffer size that fits any float written by FloatToChars.*/
+    static constexpr uint32 MaxFloatChars = 32;
+
+    /** Kinds of values a format argument holds.*/
+    enum class FormatArgType : uint8
+    {
+        Signed,
+        Unsigned,
+        Float,
+        Double,
+        Text
+    };
+
+    struct FormatText
+    {
+        const tchar* Data;
+        uint64       Size;
+    };
+
+    /**
+     * @brief Type erased format argument, it does not own text.
+    */
+    struct FormatArg
+    {
+        FormatArgType Type;
+        union
+        {
+            int64      Signed;
+            uint64     Unsigned;
+            float      Float;
+            double     Double;
+            FormatText Text;
+        };
+    };
+
+    /**
+     * @brief A placeholder of a format string.
+    */
+    struct FormatSpec
+    {
+        uint32 Index;
+        uint32 Width;
+        uint32 Precision;
+        tchar  Type;
+        bool   HasIndex;
+        bool   HasPrecision;
+    };
+
+    /**
+     * @brief Format string checked against the types of the arguments.
+     * The check runs at compile time when consteval is available.
+    */
+    template<class... ArgsType>
+    class TFormatString
+    {
+      public:
+#ifdef __cpp_consteval
+        template<uint64 Size>
+        consteval TFormatString(const tchar (&text)[Size])
+          : m_text(text)
+        {
+            if (!CheckFormat<ArgsType...>(text)) {
+                InvalidFormatString();
+            }
+        }
+#else
+        template<uint64 Size>
+        constexpr TFormatString(const tchar (&text)[Size])
+          : m_text(text)
+        {
+            AE_ASSERT((CheckFormat<ArgsType...>(text)));
+        }
+#endif
+
+        constexpr const tchar* GetText() const { return m_text; }
+
+      private:
+        const tchar* m_text;
+    };
+
+    template<class... ArgsType>
+    using FormatStringType = typename TIdentity<TFormatString<std::decay_t<ArgsType>...>>::Type;
+
+    /**
+     * @brief Formats the arguments into a new string.
+     * Short results are formatted on the stack, longer ones in the thread's scratch allocator.
+     * @param format Format string.
+     * @param args Arguments referenced by the placeholders.
+     * @return The formatted string.
+    */
+    template<class... ArgsType>
+    static String Format(FormatStringType<ArgsType...> format, const ArgsType&... args)
+    {
+        const FormatArg formatArgs[] = { MakeFormatArg(args)..., FormatArg{} };
+        return FormatToString(format.GetText(), formatArgs, sizeof...(ArgsType));
+    }
+
+    /**
+     * @brief Formats the arguments into a caller provided buffer.
+     * The text is truncated to the buffer and is always null terminated when the buffer is not empty.
+     * @param buffer Buffer receiving the text.
+     * @param capacity Size of the buffer in code units, null terminator included.
+     * @param format Format string.
+     * @param args Arguments referenced by the placeholders.
+     * @return Size of the whole formatted text, null terminator excluded. The text was truncated if it is not below capacity.
+    */
+    template<class... ArgsType>
+    static uint64 FormatTo(tchar* buffer, uint64 capacity, FormatStringType<ArgsType...> format, const ArgsType&... args)
+    {
+        const FormatArg formatArgs[] = { MakeFormatArg(args)..., FormatArg{} };
+        return FormatImpl(buffer, capacity, format.GetText(), formatArgs, sizeof...(ArgsType));
+    }
+
+    /**
+     * @brief Formats the arguments into memory of an arena.
+     * @param arena Arena the text is allocated from.
+     * @param format Format string.
+     * @param args Arguments referenced by the placeholders.
+     * @return The null terminated text, valid as long as the arena's memory.
+    */
+    template<class... ArgsType>
+    static const tchar* FormatTo(MemoryArena& arena, FormatStringType<ArgsType...> format, const ArgsType&... args)
+    {
+        const FormatArg formatArgs[] = { MakeFormatArg(args)..., FormatArg{} };
+        return FormatToArena(arena, format.GetText(), formatArgs, sizeof...(ArgsType));
+    }
+
+    /**
+     * @brief Formats type erased arguments into a buffer, the runtime core of every Format call.
+     * @param buffer Buffer receiving the text, can be null when capacity is 0.
+     * @param capacity Size of the buffer in code units, null terminator included.
+     * @param format Format string.
+     * @param args Arguments referenced by the placeholders.
+     * @param count Number of arguments.
+     * @return Size of the whole formatted text, null terminator excluded.
+    */
+    static uint64 FormatImpl(tchar* buffer, uint64 capacity, const tchar* format, const FormatArg* args, uint32 count);
+
+    /**
+     * @brief Writes an integer in decimal, without a null terminator.
+     * @param buffer Buffer of at least MaxIntegerChars code units.
+     * @param value Value to write.
+     * @return Number of code units written.
+    */
+    static uint32 IntegerToChars(tchar* buffer, uint64 value);
+    static uint32 IntegerToChars(tchar* buffer, int64 value);
+
+    /**
+     * @brief Writes a float with the shortest digits that read back to the same value, without a null terminator.
+     * @param buffer Buffer of at least MaxFloatChars code units.
+     * @param value Value to write.
+     * @return Number of code units written.
+    */
+    static uint32 FloatToChars(tchar* buffer, double value);
+    static uint32 FloatToChars(tchar* buffer, float value);
+
+    /**
+     * @brief Returns the kind of format argument a type is passed as.
+    */
+    template<class T>
+    static constexpr FormatArgType GetFormatArgType()
+    {
+        using Type = std::decay_t<T>;
+        if constexpr (std::is_same_v<Type, bool> || std::is_same_v<Type, tchar> || std::is_same_v<Type, const tchar*> ||
+                      std::is_same_v<Type, tchar*> || std::is_same_v<Type, String>) {
+            return FormatArgType::Text;
+        } else if constexpr (std::is_integral_v<Type>) {
+            return std::is_signed_v<Type> ? FormatArgType::Signed : FormatArgType::Unsigned;
+        } else if constexpr (std::is_same_v<Type, float>) {
+            return FormatArgType::Float;
+        } else {
+            static_assert(std::is_same_v<Type, double>, "Type cannot be formatted");
+            return FormatArgType::Double;
+        }
+    }
+
+    /**
+     * @brief Checks a format string against the types of its arguments.
+     * @param format Null terminated format string.
+     * @return True if every placeholder is well formed, references an argument and suits its type, and every argument is referenced.
+    */
+    template<class... ArgsType>
+    static constexpr bool CheckFormat(const tchar* format)
+    {
+        // The last entry only keeps the array from being empty.
+        constexpr FormatArgType types[] = { GetFormatArgType<ArgsType>()..., FormatArgType::Text };
+        constexpr uint32        count   = sizeof...(ArgsType);
+
+        bool   used[count + 1] = {};
+        uint32 next            = 0;
+        while (*format) {
+            const tchar c = *format++;
+            if (c == '{') {
+                if (*format == '{') {
+                    format++;
+                    continue;
+                }
+
+                FormatSpec spec = {};
+                if (!ParsePlaceholder(format, spec)) {
+                    return false;
+                }
+
+                const uint32 index = spec.HasIndex ? spec.Index : next++;
+                if (index >= count || !IsTypeAllowed(types[index], spec.Type)) {
+                    return false;
+                }
+                used[index] = true;
+            } else if (c == '}') {
+                if (*format != '}') {
+                    return false;
+                }
+                format++;
+            }
+        }
+
+        for (uint32 i = 0; i < count; i++) {
+            if (!used[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Parses a placeholder.
+     * @param cursor Position after the opening brace, moved past the closing brace on success.
+     * @param spec Receives the parsed placeholder.
+     * @return True if the placeholder is well formed.
+    */
+    static constexpr bool ParsePlaceholder(const tchar*& cursor, FormatSpec& spec)
+    {
+        if (IsDigit(*cursor)) {
+            spec.HasIndex = true;
+            spec.Index    = ParseNumber(cursor);
+        }
+
+        if (*cursor == ':') {
+            cursor++;
+            if (IsTypeChar(*cursor)) {
+                spec.Type = *cursor++;
+            }
+            spec.Width = ParseNumber(cursor);
+            if (*cursor == '.') {
+                cursor++;
+                if (!IsDigit(*cursor)) {
+                    return false;
+                }
+                spec.HasPrecision = true;
+                spec.Precision    = ParseNumber(cursor);
+            }
+            if (spec.Type == 0 && IsTypeChar(*cursor)) {
+                spec.Type = *cursor++;
+            }
+        }
+
+        if (*cursor != '}') {
+            return false;
+        }
+        cursor++;
+        return true;
+    }
+
+  private:
+    static constexpr bool IsDigit(tchar c) { return c >= '0' && c <= '9'; }
+
+    static constexpr bool IsTypeChar(tchar c) { return c == 's' || c == 'd' || c == 'x' || c == 'f' || c == 'e' || c == 'g'; }
+
+    /** Parses decimal digits, saturating at 65535 so a width can never overflow a buffer computation.*/
+    static constexpr uint32 ParseNumber(const tchar*& cursor)
+    {
+        uint32 value = 0;
+        while (IsDigit(*cursor)) {
+            value = value * 10 + static_cast<uint32>(*cursor++ - '0');
+            value = value > 0xFFFF ? 0xFFFF : value;
+        }
+        return value;
+    }
+
+    static constexpr bool IsTypeAllowed(FormatArgType type, tchar spec)
+    {
+        switch (spec) {
+            case 0:
+                return true;
+            case 's':
+                return type == FormatArgType::Text;
+            case 'd':
+            case 'x':
+                return type == FormatArgType::Signed || type == FormatArgType::Unsigned;
+            default:
+                return type == FormatArgType::Float || type == FormatArgType::Double;
+        }
+    }
+
+    /** Not constexpr, so calling it fails the compile-time check of a format string.*/
+    static void InvalidFormatString();
+
+    template<class T>
+    static FormatArg MakeFormatArg(const T& value)
+    {
+        using Type = std::decay_t<T>;
+
+        FormatArg arg = {};
+        arg.Type      = GetFormatArgType<T>();
+        if constexpr (std::is_same_v<Type, bool>) {
+            arg.Text = value ? FormatText{ ATEXT("true"), 4 } : FormatText{ ATEXT("false"), 5 };
+        } else if constexpr (std::is_same_v<Type, tchar>) {
+            arg.Text = FormatText{ &value, 1 };
+        } else if constexpr (std::is_same_v<Type, String>) {
+            arg.Text = FormatText{ value.GetData(), value.IsEmpty() ? 0 : value.GetSize() - 1 };
+        } else if constexpr (std::is_same_v<Type, const tchar*> || std::is_same_v<Type, tchar*>) {
+            const tchar* text = value;
+            arg.Text          = FormatText{ text, text ? strlen(reinterpret_cast<const char*>(text)) : 0 };
+        } else if constexpr (std::is_integral_v<Type> && std::is_signed_v<Type>) {
+            arg.Signed = value;
+        } else if constexpr (std::is_integral_v<Type>) {
+            arg.Unsigned = value;
+        } else if constexpr (std::is_same_v<Type, float>) {
+            arg.Float = value;
+        } else {
+            arg.Double = value;
+        }
+        return arg;
+    }
+
+    static String FormatToString(const tchar* format, const FormatArg* args, uint32 count);
+
+    static const tchar* FormatToArena(MemoryArena& arena, const tchar* format, const FormatArg* args, uint32 count);
+};
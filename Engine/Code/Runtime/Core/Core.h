@@ -3,6 +3,9 @@
 #include "Types.h"
 
 // Containers
-// #include "Containers/AnvilString.h"
+#include "Containers/AnvilString.h"
 #include "Containers/Array.h"
-// #include "Containers/StringUtils.h"
\ No newline at end of file
+#include "Containers/StringUtils.h"
+
+// Misc
+#include "Misc/Name.h"
@@ -41,3 +41,12 @@ SafeDeleteArray(void* ptr)
 #else
     #define AE_ASSERT(x)
 #endif // AE_DEBUG
+
+// Checked in every build, for errors that would corrupt memory if execution went on.
+#define AE_CHECK(x) ((x) ? (void)0 : std::abort())
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define AE_SSE2 1
+#else
+    #define AE_SSE2 0
+#endif
@@ -2,11 +2,15 @@
 
 #include "Types.h"
 
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
 namespace Math {
-static int32 const gLeadingBitTable[32]
+constexpr int32 gLeadingBitTable[32]
   = {0, 9, 1, 10, 13, 21, 2, 29, 11, 14, 16, 18, 22, 25, 3, 30, 8, 12, 20, 28, 15, 17, 24, 7, 19, 27, 23, 6, 26, 5, 4, 31};
 
-int32
+constexpr int32
 GetLeadingBit(uint32 value)
 {
     value |= value >> 1;
@@ -36,4 +40,64 @@ RoundUpToPowerOfTwo(uint32 value)
         return 1u;
     }
 }
+
+/**
+ * @brief Counts the zero bits below the lowest set bit.
+ * @param value Value, must not be 0.
+ * @return Index of the lowest set bit.
+*/
+inline uint32
+CountTrailingZeros(uint64 value)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return index;
+#else
+    return static_cast<uint32>(__builtin_ctzll(value));
+#endif
+}
+
+/**
+ * @brief Counts the zero bits above the highest set bit.
+ * @param value Value, must not be 0.
+ * @return 63 minus the index of the highest set bit.
+*/
+inline uint32
+CountLeadingZeros(uint64 value)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return 63 - index;
+#else
+    return static_cast<uint32>(__builtin_clzll(value));
+#endif
+}
+
+/**
+ * @brief Rounds up to the next power of two.
+ * @param value Value, at most 2^63.
+ * @return The smallest power of two not below value, 1 for 0.
+*/
+inline uint64
+RoundUpToPowerOfTwo(uint64 value)
+{
+    return value > 1 ? uint64(1) << (64 - CountLeadingZeros(value - 1)) : 1;
+}
+
+/**
+ * @brief Counts the set bits.
+ * @param value Value.
+ * @return Number of set bits.
+*/
+inline uint32
+PopCount(uint64 value)
+{
+#if defined(_MSC_VER)
+    return static_cast<uint32>(__popcnt64(value));
+#else
+    return static_cast<uint32>(__builtin_popcountll(value));
+#endif
+}
 } // namespace Math
\ No newline at end of file
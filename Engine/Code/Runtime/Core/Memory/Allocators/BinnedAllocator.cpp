@@ -0,0 +1,436 @@
+#include "BinnedAllocator.h"
+#include "Memory/MemoryUtils.h"
+#include "Memory/PlatformMemory.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace {
+
+constexpr uint64 SlabSize        = 256 * 1024;
+constexpr uint64 RegionSize      = 64ull * 1024 * 1024 * 1024;
+constexpr uint64 MinRegionSize   = 1024ull * 1024 * 1024;
+constexpr uint32 NumSizeClasses  = 40;
+constexpr uint64 ThreadCacheSize = 32 * 1024;
+constexpr uint64 LargeHeaderSize = 16;
+
+struct SizeClassTable
+{
+    uint32 Sizes[NumSizeClasses];
+    uint8  Lookup[BinnedAllocator::MaxSmallSize / 16 + 1];
+};
+
+/**
+ * Sizes are multiples of 16 up to 128, then four classes per power of two up to MaxSmallSize.
+ */
+constexpr SizeClassTable
+BuildSizeClassTable()
+{
+    SizeClassTable table {};
+
+    uint32 count = 0;
+    for (uint32 size = 16; size <= 128; size += 16) {
+        table.Sizes[count++] = size;
+    }
+    for (uint32 base = 128; base < BinnedAllocator::MaxSmallSize; base *= 2) {
+        for (uint32 size = base + base / 4; size <= base * 2; size += base / 4) {
+            table.Sizes[count++] = size;
+        }
+    }
+
+    uint32 sizeClass = 0;
+    for (uint32 i = 0; i <= BinnedAllocator::MaxSmallSize / 16; i++) {
+        while (table.Sizes[sizeClass] < i * 16) {
+            sizeClass++;
+        }
+        table.Lookup[i] = static_cast<uint8>(sizeClass);
+    }
+
+    return table;
+}
+
+constexpr SizeClassTable gSizeClasses = BuildSizeClassTable();
+
+static_assert(gSizeClasses.Sizes[NumSizeClasses - 1] == BinnedAllocator::MaxSmallSize);
+
+struct FreeBlock
+{
+    FreeBlock* Next;
+};
+
+struct SlabHeader
+{
+    uint32 SizeClass;
+};
+
+struct LargeHeader
+{
+    uint64 MappedSize;
+    uint64 Offset;
+};
+
+static_assert(sizeof(LargeHeader) == LargeHeaderSize);
+
+struct alignas(64) SizeClassPool
+{
+    std::mutex Mutex;
+    FreeBlock* FreeList = nullptr;
+    uint8*     Cursor   = nullptr;
+    uint8*     End      = nullptr;
+};
+
+struct Region
+{
+    Region()
+    {
+        for (uint64 size = RegionSize; size >= MinRegionSize && !Begin; size /= 2) {
+            Begin = reinterpret_cast<uint8*>(PlatformMemory::Reserve(size + SlabSize));
+            End   = Begin ? Begin + size + SlabSize : nullptr;
+        }
+
+        Cursor = Begin ? MemoryUtils::AlignPointer(Begin, SlabSize) : nullptr;
+    }
+
+    uint8*               Begin = nullptr;
+    uint8*               End   = nullptr;
+    std::atomic<uint8*>  Cursor {nullptr};
+};
+
+enum class EThreadCacheState : uint8
+{
+    Uninitialized,
+    Active,
+    Dead
+};
+
+/**
+ * Trivially destructible so it stays usable by other thread_local destructors,
+ * ThreadCacheGuard flushes it when the thread exits.
+ */
+struct ThreadCache
+{
+    FreeBlock*        Lists[NumSizeClasses];
+    uint32            Counts[NumSizeClasses];
+    uint64            AllocationCount;
+    EThreadCacheState State;
+};
+
+struct ThreadCacheGuard
+{
+    ~ThreadCacheGuard();
+};
+
+SizeClassPool gPools[NumSizeClasses];
+
+thread_local ThreadCache      tCache;
+thread_local ThreadCacheGuard tCacheGuard;
+
+Region&
+GetRegion()
+{
+    static Region region;
+    return region;
+}
+
+constexpr uint64
+GetBlockAlignment(uint32 sizeClass)
+{
+    const uint64 size = gSizeClasses.Sizes[sizeClass];
+    return size & (~size + 1);
+}
+
+constexpr uint32
+GetMaxCachedCount(uint32 sizeClass)
+{
+    const uint64 count = ThreadCacheSize / gSizeClasses.Sizes[sizeClass];
+    return count > 4 ? static_cast<uint32>(count) : 4u;
+}
+
+bool
+IsSmallBlock(const void* memory)
+{
+    const Region& region = GetRegion();
+    const uint8*  bytes  = reinterpret_cast<const uint8*>(memory);
+    return bytes >= region.Begin && bytes < region.End;
+}
+
+uint32
+GetSizeClass(const void* memory)
+{
+    const uint64 slab = reinterpret_cast<uint64>(memory) & ~(SlabSize - 1);
+    return reinterpret_cast<const SlabHeader*>(slab)->SizeClass;
+}
+
+/**
+ * Must be called with the pool locked. Returns false when the region is exhausted.
+ */
+bool
+AllocateSlab(SizeClassPool& pool, uint32 sizeClass)
+{
+    Region& region = GetRegion();
+    if (!region.Begin) {
+        return false;
+    }
+
+    uint8* slab = region.Cursor.fetch_add(SlabSize, std::memory_order_relaxed);
+    if (slab + SlabSize > region.End || !PlatformMemory::Commit(slab, SlabSize)) {
+        return false;
+    }
+
+    reinterpret_cast<SlabHeader*>(slab)->SizeClass = sizeClass;
+
+    const uint64 blockSize = gSizeClasses.Sizes[sizeClass];
+    const uint64 offset    = GetBlockAlignment(sizeClass);
+
+    pool.Cursor = slab + offset;
+    pool.End    = slab + offset + ((SlabSize - offset) / blockSize) * blockSize;
+    return true;
+}
+
+/**
+ * Takes up to count blocks from the central pool, returns the number of blocks taken.
+ */
+uint32
+TakeBlocks(uint32 sizeClass, uint32 count, FreeBlock*& list)
+{
+    SizeClassPool&              pool = gPools[sizeClass];
+    std::lock_guard<std::mutex> lock(pool.Mutex);
+
+    const uint64 blockSize = gSizeClasses.Sizes[sizeClass];
+
+    uint32 taken = 0;
+    while (taken < count) {
+        FreeBlock* block = pool.FreeList;
+        if (block) {
+            pool.FreeList = block->Next;
+        } else {
+            if (pool.Cursor == pool.End && !AllocateSlab(pool, sizeClass)) {
+                break;
+            }
+            block = reinterpret_cast<FreeBlock*>(pool.Cursor);
+            pool.Cursor += blockSize;
+        }
+
+        block->Next = list;
+        list        = block;
+        taken++;
+    }
+
+    return taken;
+}
+
+void
+GiveBlocks(uint32 sizeClass, FreeBlock* first, FreeBlock* last)
+{
+    SizeClassPool&              pool = gPools[sizeClass];
+    std::lock_guard<std::mutex> lock(pool.Mutex);
+
+    last->Next    = pool.FreeList;
+    pool.FreeList = first;
+}
+
+/**
+ * Gives half of the cached blocks of a size class back to the central pool.
+ */
+void
+ReleaseBlocks(ThreadCache& cache, uint32 sizeClass, uint32 count)
+{
+    FreeBlock* first = cache.Lists[sizeClass];
+    FreeBlock* last  = first;
+    for (uint32 i = 1; i < count; i++) {
+        last = last->Next;
+    }
+
+    cache.Lists[sizeClass] = last->Next;
+    cache.Counts[sizeClass] -= count;
+
+    GiveBlocks(sizeClass, first, last);
+}
+
+ThreadCacheGuard::~ThreadCacheGuard()
+{
+    for (uint32 sizeClass = 0; sizeClass < NumSizeClasses; sizeClass++) {
+        if (tCache.Counts[sizeClass]) {
+            ReleaseBlocks(tCache, sizeClass, tCache.Counts[sizeClass]);
+        }
+    }
+    tCache.State = EThreadCacheState::Dead;
+}
+
+/**
+ * Slow path taken once per thread, and for every call made after the thread's cache was flushed.
+ */
+bool
+ActivateThreadCache(ThreadCache& cache)
+{
+    if (cache.State == EThreadCacheState::Uninitialized) {
+        (void)&tCacheGuard;
+        cache.State = EThreadCacheState::Active;
+    }
+    return cache.State == EThreadCacheState::Active;
+}
+
+void*
+AllocateLarge(uint64 size, uint64 align)
+{
+    const uint64 pageSize = PlatformMemory::GetPageSize();
+    const uint64 padding  = align <= pageSize ? align : align + LargeHeaderSize;
+    const uint64 mapped   = MemoryUtils::AlignAddress(size + padding, pageSize);
+
+    uint8* base = reinterpret_cast<uint8*>(PlatformMemory::Map(mapped));
+    AE_ASSERT(base);
+    if (!base) {
+        return nullptr;
+    }
+
+    uint8*       memory = MemoryUtils::AlignPointer(base + LargeHeaderSize, align);
+    LargeHeader* header = reinterpret_cast<LargeHeader*>(memory) - 1;
+
+    header->MappedSize = mapped;
+    header->Offset     = static_cast<uint64>(memory - base);
+
+    return memory;
+}
+
+void
+FreeLarge(void* memory)
+{
+    const LargeHeader* header = reinterpret_cast<const LargeHeader*>(memory) - 1;
+    PlatformMemory::Release(reinterpret_cast<uint8*>(memory) - header->Offset, header->MappedSize);
+}
+
+/**
+ * Resizes the mapping of a large block, returns null when the pages cannot be remapped.
+ * The mapping can only move when the block does not need more than page alignment.
+ */
+void*
+ReallocateLarge(void* memory, uint64 size, uint64 align)
+{
+    const LargeHeader* header   = reinterpret_cast<const LargeHeader*>(memory) - 1;
+    const uint64       pageSize = PlatformMemory::GetPageSize();
+    const uint64       offset   = header->Offset;
+    const uint64       mapped   = MemoryUtils::AlignAddress(size + offset, pageSize);
+
+    if (mapped == header->MappedSize) {
+        return memory;
+    }
+
+    uint8* base = reinterpret_cast<uint8*>(memory) - offset;
+    uint8* result
+      = reinterpret_cast<uint8*>(PlatformMemory::Remap(base, header->MappedSize, mapped, align <= pageSize));
+    if (!result) {
+        return nullptr;
+    }
+
+    reinterpret_cast<LargeHeader*>(result + offset)[-1].MappedSize = mapped;
+    return result + offset;
+}
+
+} // namespace
+
+void*
+BinnedAllocator::Allocate(uint64 size, uint64 align)
+{
+    align = align < 16 ? 16 : align;
+
+    if (size > MaxSmallSize || align > MaxSmallSize) {
+        return AllocateLarge(size, align);
+    }
+
+    uint32 sizeClass = gSizeClasses.Lookup[(size + 15) >> 4];
+    while (GetBlockAlignment(sizeClass) < align) {
+        sizeClass++;
+    }
+
+    ThreadCache& cache = tCache;
+    cache.AllocationCount++;
+
+    if (cache.State != EThreadCacheState::Active && !ActivateThreadCache(cache)) {
+        FreeBlock* block = nullptr;
+        return TakeBlocks(sizeClass, 1, block) ? block : AllocateLarge(size, align);
+    }
+
+    FreeBlock* block = cache.Lists[sizeClass];
+    if (!block) {
+        cache.Counts[sizeClass] = TakeBlocks(sizeClass, GetMaxCachedCount(sizeClass) / 2, cache.Lists[sizeClass]);
+        block                   = cache.Lists[sizeClass];
+        if (!block) {
+            return AllocateLarge(size, align);
+        }
+    }
+
+    cache.Lists[sizeClass] = block->Next;
+    cache.Counts[sizeClass]--;
+
+    return block;
+}
+
+void*
+BinnedAllocator::Reallocate(void* memory, uint64 oldSize, uint64 size, uint64 align)
+{
+    if (!memory) {
+        return Allocate(size, align);
+    }
+
+    align = align < 16 ? 16 : align;
+
+    if (IsSmallBlock(memory)) {
+        if (size <= gSizeClasses.Sizes[GetSizeClass(memory)] && (reinterpret_cast<uint64>(memory) & (align - 1)) == 0) {
+            return memory;
+        }
+    } else if (size > MaxSmallSize) {
+        if (void* result = ReallocateLarge(memory, size, align)) {
+            return result;
+        }
+    }
+
+    void* result = Allocate(size, align);
+    if (oldSize) {
+        MemoryUtils::CopyMemory(result, memory, oldSize < size ? oldSize : size);
+    }
+    Free(memory);
+
+    return result;
+}
+
+void
+BinnedAllocator::Free(void* memory)
+{
+    if (!IsSmallBlock(memory)) {
+        FreeLarge(memory);
+        return;
+    }
+
+    const uint32 sizeClass = GetSizeClass(memory);
+    FreeBlock*   block     = reinterpret_cast<FreeBlock*>(memory);
+
+    ThreadCache& cache = tCache;
+    if (cache.State != EThreadCacheState::Active && !ActivateThreadCache(cache)) {
+        GiveBlocks(sizeClass, block, block);
+        return;
+    }
+
+    block->Next            = cache.Lists[sizeClass];
+    cache.Lists[sizeClass] = block;
+
+    if (++cache.Counts[sizeClass] > GetMaxCachedCount(sizeClass)) {
+        ReleaseBlocks(cache, sizeClass, cache.Counts[sizeClass] / 2);
+    }
+}
+
+uint64
+BinnedAllocator::GetAllocationSize(void* memory)
+{
+    if (IsSmallBlock(memory)) {
+        return gSizeClasses.Sizes[GetSizeClass(memory)];
+    }
+
+    const LargeHeader* header = reinterpret_cast<const LargeHeader*>(memory) - 1;
+    return header->MappedSize - header->Offset;
+}
+
+uint64
+BinnedAllocator::GetThreadAllocationCount()
+{
+    return tCache.AllocationCount;
+}
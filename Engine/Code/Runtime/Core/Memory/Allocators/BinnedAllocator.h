@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Types.h"
+
+/**
+ * @brief General purpose allocator with per-thread caches.
+ * Small blocks are served from size class slabs carved out of a single reserved
+ * address range, so they need no header and are naturally aligned. Every thread
+ * keeps a free list per size class and only takes a lock to refill or release a
+ * batch of blocks. Large blocks are mapped directly from the operating system and
+ * grow by remapping their pages instead of copying them.
+*/
+class BinnedAllocator
+{
+  public:
+    /** Largest block size served from the size class slabs.*/
+    static constexpr uint64 MaxSmallSize = 32 * 1024;
+
+    /**
+     * @brief Allocates an aligned memory block.
+     * @param size Size in bytes of the memory block.
+     * @param align Desired alignment, power of two.
+     * @return Pointer to the allocated memory.
+    */
+    static void* Allocate(uint64 size, uint64 align = 16u);
+
+    /**
+     * @brief Resizes a memory block returned by Allocate, keeping its content.
+     * Small blocks stay in place while the new size fits their size class, large
+     * blocks are remapped by the operating system instead of copied when possible.
+     * @param memory Memory block to be resized, can be null.
+     * @param oldSize Current size in bytes of the memory block.
+     * @param size New size in bytes of the memory block.
+     * @param align Desired alignment, power of two.
+     * @return Pointer to the resized memory.
+    */
+    static void* Reallocate(void* memory, uint64 oldSize, uint64 size, uint64 align = 16u);
+
+    /**
+     * @brief Frees a memory block returned by Allocate.
+     * @param memory Pointer to the memory block, can be freed from any thread.
+    */
+    static void Free(void* memory);
+
+    /**
+     * @brief Returns the usable size of a memory block returned by Allocate.
+     * @param memory Pointer to the memory block.
+     * @return Usable size in bytes, at least the requested size.
+    */
+    static uint64 GetAllocationSize(void* memory);
+
+    /**
+     * @brief Returns the number of allocations made by the calling thread.
+     * @return Number of calls to Allocate made by the calling thread.
+    */
+    static uint64 GetThreadAllocationCount();
+};
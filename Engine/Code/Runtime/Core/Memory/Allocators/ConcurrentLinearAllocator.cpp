@@ -0,0 +1,107 @@
+#include "ConcurrentLinearAllocator.h"
+#include "Memory/PlatformMemory.h"
+
+namespace {
+
+/** Generations are unique across allocators, so a sub-block never outlives its allocator or its frame.*/
+std::atomic<uint64> gNextGeneration {1};
+std::atomic<uint32> gNextSlot {0};
+
+} // namespace
+
+ConcurrentLinearAllocator::ConcurrentLinearAllocator(uint64 capacity, uint64 threadBlockSize)
+  : m_capacity(MemoryUtils::AlignAddress(capacity, CommitGranularity))
+  , m_threadBlockSize(threadBlockSize)
+  , m_slot(gNextSlot.fetch_add(1, std::memory_order_relaxed) % ThreadBlockSlots)
+  , m_generation(gNextGeneration.fetch_add(1, std::memory_order_relaxed))
+  , m_committedSize(0)
+  , m_offset(0)
+{
+    m_base = reinterpret_cast<uint8*>(PlatformMemory::Reserve(m_capacity));
+    AE_ASSERT(m_base);
+}
+
+ConcurrentLinearAllocator::~ConcurrentLinearAllocator()
+{
+    PlatformMemory::Release(m_base, m_capacity);
+}
+
+void*
+ConcurrentLinearAllocator::Reallocate(void* memory, uint64 oldSize, uint64 size, uint64 align)
+{
+    uint8* bytes = reinterpret_cast<uint8*>(memory);
+    if (bytes) {
+        ThreadBlock& block = GetThreadBlock();
+        if (bytes + oldSize == block.Cursor && bytes + size <= block.End
+            && block.Generation == m_generation.load(std::memory_order_relaxed)) {
+            block.Cursor = bytes + size;
+            return memory;
+        }
+        if (size <= oldSize) {
+            return memory;
+        }
+    }
+
+    void* result = Allocate(size, align);
+    if (result && bytes && oldSize) {
+        MemoryUtils::CopyMemory(result, memory, oldSize < size ? oldSize : size);
+    }
+
+    return result;
+}
+
+void
+ConcurrentLinearAllocator::Reset()
+{
+    m_offset.store(0, std::memory_order_relaxed);
+    m_generation.store(gNextGeneration.fetch_add(1, std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+ConcurrentLinearAllocator&
+ConcurrentLinearAllocator::GetFrameAllocator()
+{
+    static ConcurrentLinearAllocator frameAllocator;
+    return frameAllocator;
+}
+
+void*
+ConcurrentLinearAllocator::AllocateSlow(uint64 size, uint64 align)
+{
+    // Large blocks would waste most of a sub-block, they go straight to the shared cursor.
+    if (size + align > m_threadBlockSize / 4) {
+        return AllocateShared(size, align);
+    }
+
+    uint8* memory = reinterpret_cast<uint8*>(AllocateShared(m_threadBlockSize, 16u));
+    if (!memory) {
+        return nullptr;
+    }
+
+    ThreadBlock& block = GetThreadBlock();
+    block.Generation   = m_generation.load(std::memory_order_relaxed);
+    block.End          = memory + m_threadBlockSize;
+
+    memory       = MemoryUtils::AlignPointer(memory, align);
+    block.Cursor = memory + size;
+    return memory;
+}
+
+void
+ConcurrentLinearAllocator::Commit(uint64 size)
+{
+    // Threads racing to commit overlapping ranges is harmless, committing is idempotent.
+    uint64 committedSize = m_committedSize.load(std::memory_order_acquire);
+    if (size <= committedSize) {
+        return;
+    }
+
+    const uint64 newCommittedSize = MemoryUtils::AlignAddress(size, CommitGranularity);
+    const bool   committed        = PlatformMemory::Commit(m_base + committedSize, newCommittedSize - committedSize);
+    AE_ASSERT(committed);
+    (void)committed;
+
+    while (committedSize < newCommittedSize
+           && !m_committedSize.compare_exchange_weak(committedSize, newCommittedSize, std::memory_order_release,
+                                                     std::memory_order_acquire)) {
+    }
+}
@@ -0,0 +1,165 @@
+#pragma once
+
+#include "Memory/MemoryUtils.h"
+#include <atomic>
+
+/**
+ * @brief Linear (bump) allocator that any number of threads can allocate from at once.
+ * Memory comes from one reserved address range, committed as it is used. Every thread
+ * carves its small allocations out of its own sub-block with plain pointer bumps, only
+ * taking a new sub-block, and allocating large blocks, costs a single atomic fetch-add
+ * on the shared cursor. Nothing is freed individually, the whole allocator is reset once
+ * per frame, after every thread stopped allocating and every allocation is dead.
+*/
+class ConcurrentLinearAllocator
+{
+  public:
+    static constexpr uint64 DefaultCapacity        = 256 * 1024 * 1024;
+    static constexpr uint64 DefaultThreadBlockSize = 64 * 1024;
+    static constexpr uint64 CommitGranularity      = 1024 * 1024;
+
+    /**
+     * @brief Constructor, reserves the address space but commits no memory.
+     * @param capacity Size in bytes that can be allocated between two resets.
+     * @param threadBlockSize Size in bytes of the sub-blocks taken by every thread.
+    */
+    explicit ConcurrentLinearAllocator(uint64 capacity = DefaultCapacity, uint64 threadBlockSize = DefaultThreadBlockSize);
+
+    ~ConcurrentLinearAllocator();
+
+    ConcurrentLinearAllocator(const ConcurrentLinearAllocator&) = delete;
+    ConcurrentLinearAllocator& operator=(const ConcurrentLinearAllocator&) = delete;
+
+    /**
+     * @brief Allocates an aligned memory block, can be called from any thread.
+     * @param size Size in bytes of the memory block.
+     * @param align Desired alignment.
+     * @return Pointer to the allocated memory, null when the capacity is exhausted.
+    */
+    void* Allocate(uint64 size, uint64 align = 16u)
+    {
+        ThreadBlock& block  = GetThreadBlock();
+        uint8*       memory = MemoryUtils::AlignPointer(block.Cursor, align);
+        if (block.Generation != m_generation.load(std::memory_order_relaxed) || memory + size > block.End) {
+            return AllocateSlow(size, align);
+        }
+
+        block.Cursor = memory + size;
+        return memory;
+    }
+
+    /**
+     * @brief Allocates an aligned memory block straight from the shared cursor.
+     * @param size Size in bytes of the memory block.
+     * @param align Desired alignment.
+     * @return Pointer to the allocated memory, null when the capacity is exhausted.
+    */
+    void* AllocateShared(uint64 size, uint64 align = 16u)
+    {
+        const uint64 paddedSize = size + align - 1;
+        const uint64 offset     = m_offset.fetch_add(paddedSize, std::memory_order_relaxed);
+        const uint64 end        = offset + paddedSize;
+        if (end > m_capacity) {
+            return nullptr;
+        }
+
+        if (end > m_committedSize.load(std::memory_order_acquire)) {
+            Commit(end);
+        }
+
+        return MemoryUtils::AlignPointer(m_base + offset, align);
+    }
+
+    /**
+     * @brief Resizes a memory block allocated by the calling thread.
+     * The thread's most recent allocation is resized in place when its sub-block has room,
+     * any other block is only moved when it grows.
+     * @param memory Memory block to be resized, can be null.
+     * @param oldSize Current size in bytes of the memory block.
+     * @param size New size in bytes of the memory block.
+     * @param align Desired alignment.
+     * @return Pointer to the resized memory, null when the capacity is exhausted.
+    */
+    void* Reallocate(void* memory, uint64 oldSize, uint64 size, uint64 align = 16u);
+
+    /**
+     * @brief Gives a memory block back to the allocator.
+     * Only the calling thread's most recent allocation is actually reclaimed, anything else waits for Reset.
+     * @param memory Memory block to be freed.
+     * @param size Size in bytes of the memory block.
+    */
+    void Free(void* memory, uint64 size)
+    {
+        ThreadBlock& block = GetThreadBlock();
+        uint8*       bytes = reinterpret_cast<uint8*>(memory);
+        if (bytes && bytes + size == block.Cursor && block.Generation == m_generation.load(std::memory_order_relaxed)) {
+            block.Cursor = bytes;
+        }
+    }
+
+    /**
+     * @brief Releases every allocation at once, the committed memory is kept for the next frame.
+     * No other thread may use the allocator during the reset.
+    */
+    void Reset();
+
+    /**
+     * @brief Returns the number of bytes taken from the shared cursor since the last reset.
+     * @return Used size in bytes, including the unused tail of the threads' sub-blocks.
+    */
+    uint64 GetUsedSize() const
+    {
+        const uint64 offset = m_offset.load(std::memory_order_relaxed);
+        return offset < m_capacity ? offset : m_capacity;
+    }
+
+    /**
+     * @brief Returns the number of bytes backed by memory.
+     * @return Committed size in bytes.
+    */
+    uint64 GetCommittedSize() const { return m_committedSize.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Returns the number of bytes that can be allocated between two resets.
+     * @return Capacity in bytes.
+    */
+    constexpr uint64 GetCapacity() const { return m_capacity; }
+
+    /**
+     * @brief Returns the allocator shared by every thread for the frame's output.
+     * It must be reset once per frame, after every job of the frame completed.
+     * @return The frame allocator.
+    */
+    static ConcurrentLinearAllocator& GetFrameAllocator();
+
+  private:
+    /** Sub-block of a thread, only valid while its generation is the allocator's.*/
+    struct ThreadBlock
+    {
+        uint64 Generation;
+        uint8* Cursor;
+        uint8* End;
+    };
+
+    static constexpr uint32 ThreadBlockSlots = 4;
+
+    ThreadBlock& GetThreadBlock()
+    {
+        static thread_local ThreadBlock threadBlocks[ThreadBlockSlots] = {};
+        return threadBlocks[m_slot];
+    }
+
+    void* AllocateSlow(uint64 size, uint64 align);
+
+    void Commit(uint64 size);
+
+    uint8*              m_base;
+    uint64              m_capacity;
+    uint64              m_threadBlockSize;
+    uint32              m_slot;
+    std::atomic<uint64> m_generation;
+    std::atomic<uint64> m_committedSize;
+
+    /** Written by every thread, kept away from the fields read on every allocation.*/
+    alignas(MemoryUtils::CacheLineAlignment) std::atomic<uint64> m_offset;
+};
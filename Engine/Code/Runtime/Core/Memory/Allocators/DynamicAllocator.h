@@ -3,166 +3,280 @@
 #include "Memory/MemoryUtils.h"
 
 /**
- * @brief Allocates contiguous resizable memory.
+ * @brief Stack allocator handing out contiguous runs of items from a list of chunks.
+ * Allocations are a pointer bump inside the current chunk and are released in LIFO order,
+ * either one by one with Pop or all at once by rolling back to a marker. Chunks are never
+ * moved, so pointers stay valid until their allocation is rolled back, and rolled back chunks
+ * are kept for the next allocations. The allocator hands out uninitialized storage, items
+ * constructed in it must be destroyed by the caller before their memory is rolled back.
+ * An allocator is not thread safe, every thread has its own instance through GetThreadAllocator.
 */
 template<class _ItemType, class _SizeType>
 class TDynamicAllocator
 {
+    struct ChunkHeader
+    {
+        ChunkHeader* Next;
+        _SizeType    Capacity;
+    };
+
+    static constexpr uint64 ChunkAlign      = alignof(_ItemType) > alignof(ChunkHeader) ? alignof(_ItemType) : alignof(ChunkHeader);
+    static constexpr uint64 ChunkHeaderSize = MemoryUtils::AlignAddress(sizeof(ChunkHeader), ChunkAlign);
+
   public:
     using ItemType = _ItemType;
     using SizeType = _SizeType;
 
+    static constexpr uint64 DefaultChunkSize = 64 * 1024;
+
+    /**
+     * @brief Position of the allocator, a default constructed marker is the empty allocator.
+    */
+    struct Marker
+    {
+        ChunkHeader* Chunk  = nullptr;
+        ItemType*    Cursor = nullptr;
+        SizeType     Size   = 0;
+    };
+
+    class ScopedMarker;
+
     /**
-     * @brief Default contructor.
+     * @brief Constructor, no memory is reserved until the first allocation.
+     * @param chunkSize Minimum size in bytes of each chunk.
     */
-    constexpr TDynamicAllocator() noexcept {}
+    explicit TDynamicAllocator(uint64 chunkSize = DefaultChunkSize) noexcept
+      : m_chunkCapacity(static_cast<SizeType>(chunkSize > sizeof(ItemType) ? chunkSize / sizeof(ItemType) : 1))
+    {}
 
-    constexpr TDynamicAllocator(const TDynamicAllocator& other) noexcept = default;
+    /** Releases every chunk.*/
+    ~TDynamicAllocator() { Destroy(); }
 
-    constexpr TDynamicAllocator(TDynamicAllocator&& other) noexcept
+    TDynamicAllocator(const TDynamicAllocator&) = delete;
+    TDynamicAllocator& operator=(const TDynamicAllocator&) = delete;
+
+    TDynamicAllocator(TDynamicAllocator&& other) noexcept
       : m_first(other.m_first)
-      , m_last(other.m_last)
+      , m_chunk(other.m_chunk)
+      , m_cursor(other.m_cursor)
       , m_end(other.m_end)
+      , m_size(other.m_size)
+      , m_capacity(other.m_capacity)
+      , m_chunkCapacity(other.m_chunkCapacity)
     {
-        other.m_first = nullptr;
-        other.m_last  = nullptr;
-        other.m_end   = nullptr;
+        other.Forget();
     }
 
-    constexpr TDynamicAllocator& operator=(const TDynamicAllocator& other) noexcept = default;
-
-    constexpr TDynamicAllocator& operator=(TDynamicAllocator&& other) noexcept
+    TDynamicAllocator& operator=(TDynamicAllocator&& other) noexcept
     {
-        m_first = other.m_first;
-        m_last  = other.m_last;
-        m_end   = other.m_end;
+        if (this != &other) {
+            Destroy();
 
-        other.m_first = nullptr;
-        other.m_last  = nullptr;
-        other.m_end   = nullptr;
+            m_first         = other.m_first;
+            m_chunk         = other.m_chunk;
+            m_cursor        = other.m_cursor;
+            m_end           = other.m_end;
+            m_size          = other.m_size;
+            m_capacity      = other.m_capacity;
+            m_chunkCapacity = other.m_chunkCapacity;
+
+            other.Forget();
+        }
 
         return *this;
     }
 
     /**
-     * @brief Reserves a count of elements in the memory.
+     * @brief Makes sure the next allocation of count elements does not allocate a chunk.
      * @param count The number of elements to reserve in memory.
     */
     void Reserve(SizeType count)
     {
         AE_ASSERT(count > 0);
 
-        if (count > GetCapacity()) {
-            AllocateMemoryBlock(count);
+        if (static_cast<SizeType>(m_end - m_cursor) < count) {
+            NextChunk(count);
         }
     }
 
     /**
-     * @brief Allocates a number of elements on the allocator.
+     * @brief Allocates a number of contiguous elements on the allocator.
      * @param count The number of elements.
-     * @return Pointer to the allocated elements.
+     * @return Pointer to the uninitialized elements, valid until they are rolled back.
     */
     ItemType* Allocate(SizeType count)
     {
-        if (GetSize() + count > GetCapacity()) {
-            Reserve(GetSize() + count);
+        if (static_cast<SizeType>(m_end - m_cursor) < count) {
+            NextChunk(count);
         }
 
-        const SizeType offset = GetSize();
-        m_last += count;
+        ItemType* items = m_cursor;
+        m_cursor += count;
+        m_size += count;
 
-        return m_first + offset;
+        return items;
     }
 
-    constexpr void Deallocate(ItemType* ptr, SizeType count)
+    /**
+     * @brief Gives elements back to the allocator.
+     * Only the most recent allocation is actually reclaimed, anything else waits for a rollback.
+     * @param items Elements returned by Allocate.
+     * @param count The number of elements.
+    */
+    void Deallocate(ItemType* items, SizeType count)
     {
-        m_first = nullptr;
-        m_last  = nullptr;
-        m_end   = nullptr;
-        if (m_first != m_end) {
-            MemoryUtils::FreeAligned(ptr);
+        if (items && items + count == m_cursor) {
+            m_cursor = items;
+            m_size -= count;
         }
     }
 
-    constexpr void Reset(SizeType cursor = 0) { m_last = m_first + cursor; }
-
     /**
-     * @brief Returns the number of elements allocated on the allocator.
-     * @return The number of elements allocated on the allocator.
+     * @brief Releases the most recent elements.
+     * @param count The number of elements, they must belong to the most recent allocation.
     */
-    constexpr SizeType GetSize() const { return static_cast<SizeType>(m_last - m_first); }
+    void Pop(SizeType count = 1)
+    {
+        AE_ASSERT(m_chunk && static_cast<SizeType>(m_cursor - GetChunkData(m_chunk)) >= count);
+
+        m_cursor -= count;
+        m_size -= count;
+    }
 
     /**
-     * @brief Returns the max number of elements the allocator can allocate.
-     * @return The max number of elements the allocator can allocate.
+     * @brief Returns the current position of the allocator.
+     * @return A marker to roll back to.
     */
-    constexpr SizeType GetCapacity() const { return static_cast<SizeType>(m_end - m_first); }
-
-    constexpr ItemType* GetData() { return m_first; }
-
-    constexpr const ItemType* GetData() const { return m_first; }
+    Marker GetMarker() const { return Marker{ m_chunk, m_cursor, m_size }; }
 
     /**
-     * @brief C++ iterator begin.
-     * @return A pointer to the begin.
+     * @brief Releases every allocation made after a marker was taken.
+     * @param marker Marker of this allocator, the default marker releases every allocation.
     */
-    constexpr ItemType* begin() noexcept { return m_first; }
+    void Reset(const Marker& marker = {})
+    {
+        if (marker.Chunk) {
+            m_chunk  = marker.Chunk;
+            m_cursor = marker.Cursor;
+            m_end    = GetChunkData(marker.Chunk) + marker.Chunk->Capacity;
+        } else {
+            m_chunk  = m_first;
+            m_cursor = m_first ? GetChunkData(m_first) : nullptr;
+            m_end    = m_first ? m_cursor + m_first->Capacity : nullptr;
+        }
+
+        m_size = marker.Size;
+    }
 
     /**
-     * @brief C++ iterator begin.
-     * @return A pointer to the begin.
+     * @brief Returns the number of elements allocated on the allocator.
+     * @return The number of elements allocated on the allocator.
     */
-    constexpr const ItemType* begin() const noexcept { return m_first; }
+    constexpr SizeType GetSize() const { return m_size; }
 
     /**
-     * @brief C++ iterator end.
-     * @return A pointer to the end.
+     * @brief Returns the number of elements the allocator's chunks can hold.
+     * @return The number of elements the allocator's chunks can hold.
     */
-    constexpr ItemType* end() noexcept { return m_last; }
+    constexpr SizeType GetCapacity() const { return m_capacity; }
 
     /**
-     * @brief C++ iterator end.
-     * @return A pointer to the end.
+     * @brief Releases every chunk, every allocation must be dead.
     */
-    constexpr const ItemType* end() const noexcept { return m_last; }
-
-    constexpr void Destroy()
+    void Destroy()
     {
-        MemoryUtils::DestroyItems(m_first, GetSize());
-        if (GetCapacity()) {
-            m_end  = nullptr;
-            m_last = nullptr;
+        while (m_first) {
+            ChunkHeader* next = m_first->Next;
             MemoryUtils::FreeAligned(m_first);
-            m_first = nullptr;
+            m_first = next;
         }
+
+        Forget();
     }
 
-    constexpr void Pop(SizeType count = 1)
+    /**
+     * @brief Returns the calling thread's allocator.
+     * Scratch memory of deep call chains comes from here, rolled back with a ScopedMarker.
+     * @return The thread's allocator.
+    */
+    static TDynamicAllocator& GetThreadAllocator()
     {
-        AE_ASSERT(m_last);
-        m_last -= count;
+        static thread_local TDynamicAllocator threadAllocator;
+        return threadAllocator;
     }
 
   private:
-    constexpr void AllocateMemoryBlock(SizeType newSize)
+    static ItemType* GetChunkData(ChunkHeader* chunk) { return reinterpret_cast<ItemType*>(reinterpret_cast<uint8*>(chunk) + ChunkHeaderSize); }
+
+    /** Moves to the first following chunk with room for count elements, allocating it when needed.*/
+    void NextChunk(SizeType count)
     {
-        const SizeType oldSize     = GetSize();
-        const SizeType currentSize = newSize;
-        const uint64   actualSize  = static_cast<uint64>(currentSize * sizeof(ItemType));
-        ItemType*      temp        = reinterpret_cast<ItemType*>(MemoryUtils::AllocateAligned(actualSize));
-        if (oldSize > 0) {
-            MemoryUtils::CopyElements(temp, m_first, GetSize());
-            MemoryUtils::FreeAligned(m_first);
+        ChunkHeader* chunk = m_chunk ? m_chunk->Next : m_first;
+        if (!chunk || chunk->Capacity < count) {
+            const SizeType capacity = count > m_chunkCapacity ? count : m_chunkCapacity;
+            const uint64   size     = ChunkHeaderSize + static_cast<uint64>(capacity) * sizeof(ItemType);
+
+            ChunkHeader* newChunk = reinterpret_cast<ChunkHeader*>(MemoryUtils::AllocateAligned(size, ChunkAlign));
+            newChunk->Next        = chunk;
+            newChunk->Capacity    = capacity;
+
+            if (m_chunk) {
+                m_chunk->Next = newChunk;
+            } else {
+                m_first = newChunk;
+            }
+
+            m_capacity += capacity;
+            chunk = newChunk;
         }
-        m_first = temp;
-        temp    = nullptr;
 
-        m_last = m_first + oldSize;
-        m_end  = m_first + currentSize;
+        m_chunk  = chunk;
+        m_cursor = GetChunkData(chunk);
+        m_end    = m_cursor + chunk->Capacity;
     }
 
+    void Forget()
+    {
+        m_first    = nullptr;
+        m_chunk    = nullptr;
+        m_cursor   = nullptr;
+        m_end      = nullptr;
+        m_size     = 0;
+        m_capacity = 0;
+    }
+
+  private:
+    ChunkHeader* m_first         = nullptr;
+    ChunkHeader* m_chunk         = nullptr;
+    ItemType*    m_cursor        = nullptr;
+    ItemType*    m_end           = nullptr;
+    SizeType     m_size          = 0;
+    SizeType     m_capacity      = 0;
+    SizeType     m_chunkCapacity = 1;
+};
+
+/**
+ * @brief Rolls an allocator back to where it was when the scope was entered.
+*/
+template<class _ItemType, class _SizeType>
+class TDynamicAllocator<_ItemType, _SizeType>::ScopedMarker
+{
+  public:
+    /**
+     * @brief Constructor.
+     * @param allocator Allocator to roll back, the calling thread's allocator by default.
+    */
+    explicit ScopedMarker(TDynamicAllocator& allocator = TDynamicAllocator::GetThreadAllocator())
+      : m_allocator(allocator)
+      , m_marker(allocator.GetMarker())
+    {}
+
+    ~ScopedMarker() { m_allocator.Reset(m_marker); }
+
+    ScopedMarker(const ScopedMarker&) = delete;
+    ScopedMarker& operator=(const ScopedMarker&) = delete;
+
   private:
-    ItemType* m_first = nullptr;
-    ItemType* m_last  = nullptr;
-    ItemType* m_end   = nullptr;
-};
\ No newline at end of file
+    TDynamicAllocator& m_allocator;
+    Marker             m_marker;
+};
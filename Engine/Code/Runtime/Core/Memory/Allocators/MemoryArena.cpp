@@ -0,0 +1,70 @@
+#include "MemoryArena.h"
+
+MemoryArena::MemoryArena(uint64 blockSize)
+  : m_blockSize(blockSize)
+{}
+
+MemoryArena::~MemoryArena()
+{
+    FreeBlocks();
+}
+
+void
+MemoryArena::Reset()
+{
+    if (m_block && m_block->Previous) {
+        const uint64 blockSize = m_reservedSize;
+        FreeBlocks();
+        AllocateBlock(blockSize);
+    }
+
+    m_usedSize = 0;
+    m_cursor   = m_block ? GetBlockData(m_block) : nullptr;
+}
+
+uint64
+MemoryArena::GetUsedSize() const
+{
+    return m_block ? m_usedSize + static_cast<uint64>(m_cursor - GetBlockData(m_block)) : 0;
+}
+
+MemoryArena&
+MemoryArena::GetFrameArena()
+{
+    static thread_local MemoryArena frameArena;
+    return frameArena;
+}
+
+void
+MemoryArena::AllocateBlock(uint64 minSize)
+{
+    const uint64 size = minSize > m_blockSize ? minSize : m_blockSize;
+
+    Block* block    = reinterpret_cast<Block*>(MemoryUtils::AllocateAligned(sizeof(Block) + size));
+    block->Previous = m_block;
+    block->Size     = size;
+
+    if (m_block) {
+        m_usedSize += static_cast<uint64>(m_cursor - GetBlockData(m_block));
+    }
+
+    m_block  = block;
+    m_cursor = GetBlockData(block);
+    m_end    = m_cursor + size;
+    m_reservedSize += size;
+}
+
+void
+MemoryArena::FreeBlocks()
+{
+    while (m_block) {
+        Block* previous = m_block->Previous;
+        MemoryUtils::FreeAligned(m_block);
+        m_block = previous;
+    }
+
+    m_cursor       = nullptr;
+    m_end          = nullptr;
+    m_usedSize     = 0;
+    m_reservedSize = 0;
+}
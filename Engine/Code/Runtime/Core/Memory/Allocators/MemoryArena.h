@@ -0,0 +1,135 @@
+#pragma once
+
+#include "Memory/MemoryUtils.h"
+
+/**
+ * @brief Linear (bump) allocator that releases all of its memory at once.
+ * Allocations are a pointer bump inside the current block, frees are no-ops
+ * except for the most recent allocation, and Reset rewinds the whole arena.
+ * An arena is not thread safe, every thread has its own frame arena.
+*/
+class MemoryArena
+{
+  public:
+    static constexpr uint64 DefaultBlockSize = 256 * 1024;
+
+    /**
+     * @brief Constructor, no memory is reserved until the first allocation.
+     * @param blockSize Minimum size in bytes of each memory block.
+    */
+    explicit MemoryArena(uint64 blockSize = DefaultBlockSize);
+
+    ~MemoryArena();
+
+    MemoryArena(const MemoryArena&) = delete;
+    MemoryArena& operator=(const MemoryArena&) = delete;
+
+    /**
+     * @brief Allocates an aligned memory block from the arena.
+     * @param size Size in bytes of the memory block.
+     * @param align Desired alignment.
+     * @return Pointer to the allocated memory.
+    */
+    void* Allocate(uint64 size, uint64 align = 16u)
+    {
+        uint8* memory = MemoryUtils::AlignPointer(m_cursor, align);
+        if (!m_cursor || memory + size > m_end) {
+            AllocateBlock(size + align);
+            memory = MemoryUtils::AlignPointer(m_cursor, align);
+        }
+
+        m_cursor = memory + size;
+        return memory;
+    }
+
+    /**
+     * @brief Resizes a memory block allocated from the arena.
+     * The most recent allocation is resized in place when the current block has room,
+     * any other block is only moved when it grows.
+     * @param memory Memory block to be resized, can be null.
+     * @param oldSize Current size in bytes of the memory block.
+     * @param size New size in bytes of the memory block.
+     * @param align Desired alignment.
+     * @return Pointer to the resized memory.
+    */
+    void* Reallocate(void* memory, uint64 oldSize, uint64 size, uint64 align = 16u)
+    {
+        uint8* bytes = reinterpret_cast<uint8*>(memory);
+        if (bytes) {
+            if (bytes + oldSize == m_cursor && bytes + size <= m_end) {
+                m_cursor = bytes + size;
+                return memory;
+            }
+            if (size <= oldSize) {
+                return memory;
+            }
+        }
+
+        void* result = Allocate(size, align);
+        if (bytes && oldSize) {
+            MemoryUtils::CopyMemory(result, memory, oldSize < size ? oldSize : size);
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Gives a memory block back to the arena.
+     * Only the most recent allocation is actually reclaimed, anything else waits for Reset.
+     * @param memory Memory block to be freed.
+     * @param size Size in bytes of the memory block.
+    */
+    void Free(void* memory, uint64 size)
+    {
+        uint8* bytes = reinterpret_cast<uint8*>(memory);
+        if (bytes && bytes + size == m_cursor) {
+            m_cursor = bytes;
+        }
+    }
+
+    /**
+     * @brief Releases every allocation at once.
+     * When the last cycle needed more than one block they are merged into a single
+     * block, so a steady workload ends up bumping inside one block.
+    */
+    void Reset();
+
+    /**
+     * @brief Returns the number of bytes handed out since the last reset.
+     * @return Used size in bytes, including alignment padding.
+    */
+    uint64 GetUsedSize() const;
+
+    /**
+     * @brief Returns the number of bytes reserved by the arena's blocks.
+     * @return Reserved size in bytes.
+    */
+    constexpr uint64 GetReservedSize() const { return m_reservedSize; }
+
+    /**
+     * @brief Returns the calling thread's frame arena.
+     * It must be reset by its thread once per frame, after every frame allocation is dead.
+     * @return The thread's frame arena.
+    */
+    static MemoryArena& GetFrameArena();
+
+  private:
+    struct Block
+    {
+        Block* Previous;
+        uint64 Size;
+    };
+
+    void AllocateBlock(uint64 minSize);
+
+    void FreeBlocks();
+
+    static uint8* GetBlockData(Block* block) { return reinterpret_cast<uint8*>(block + 1); }
+
+    Block* m_block        = nullptr;
+    uint8* m_cursor       = nullptr;
+    uint8* m_end          = nullptr;
+    uint64 m_blockSize    = 0;
+    uint64 m_usedSize     = 0;
+    uint64 m_reservedSize = 0;
+};
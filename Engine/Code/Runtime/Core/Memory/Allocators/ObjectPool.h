@@ -0,0 +1,433 @@
+#pragma once
+
+#include "Memory/MemoryUtils.h"
+#include <atomic>
+#include <mutex>
+
+/**
+ * @brief Pool of same-sized objects carved out of large chunks.
+ * Freed objects are recycled through an intrusive free list threaded through their
+ * storage, so allocating and freeing is a pointer pop/push plus the object's constructor
+ * and destructor. Objects are referred to by pointer or by generational handle, a handle
+ * to a freed object is detected as stale. Chunks are only released with the pool, the
+ * table of chunks never moves since Get reads it without the lock, so a pool holds at
+ * most MaxChunks chunks and aborts when it needs more.
+ * A pool is single threaded unless ThreadSafe is set, thread safe pools take a lock on
+ * every call unless they are used through a ThreadCache.
+*/
+template<class T, bool ThreadSafe = false>
+class TObjectPool
+{
+    struct FreeNode
+    {
+        FreeNode* Next;
+    };
+
+    /** Placed after the storage of every object.*/
+    struct SlotTrailer
+    {
+        std::atomic<uint32> Generation;
+        uint32              Index;
+    };
+
+    static constexpr uint64 SlotAlign     = alignof(T) > alignof(SlotTrailer) ? alignof(T) : alignof(SlotTrailer);
+    static constexpr uint64 ObjectSize    = sizeof(T) > sizeof(FreeNode) ? sizeof(T) : sizeof(FreeNode);
+    static constexpr uint64 TrailerOffset = MemoryUtils::AlignAddress(ObjectSize, alignof(SlotTrailer));
+    static constexpr uint64 SlotSize      = MemoryUtils::AlignAddress(TrailerOffset + sizeof(SlotTrailer), SlotAlign);
+
+  public:
+    static constexpr uint64 DefaultChunkSize     = 64 * 1024;
+    static constexpr uint32 MaxChunks            = 64 * 1024;
+    static constexpr uint32 DefaultCacheCapacity = 256;
+    static constexpr uint32 MinObjectsPerChunk   = 8;
+
+    /**
+     * @brief Generational reference to a pooled object, a default constructed handle is never valid.
+    */
+    struct Handle
+    {
+        uint32 Index      = 0;
+        uint32 Generation = 0;
+
+        constexpr bool operator==(const Handle& other) const { return Index == other.Index && Generation == other.Generation; }
+        constexpr bool operator!=(const Handle& other) const { return !(*this == other); }
+    };
+
+    class ThreadCache;
+
+    /**
+     * @brief Constructor, no memory is allocated until the first object.
+     * @param chunkSize Approximate size in bytes of each chunk.
+    */
+    explicit TObjectPool(uint64 chunkSize = DefaultChunkSize)
+      : m_chunks(nullptr)
+      , m_chunkCount(0)
+      , m_freeList(nullptr)
+    {
+        uint64 objectsPerChunk = MinObjectsPerChunk;
+        while (objectsPerChunk * 2 * SlotSize <= chunkSize) {
+            objectsPerChunk *= 2;
+        }
+
+        m_chunkShift = 0;
+        while ((uint64(1) << m_chunkShift) < objectsPerChunk) {
+            m_chunkShift++;
+        }
+    }
+
+    /**
+     * @brief Destroys the objects still alive and releases every chunk.
+     * Thread caches of the pool must be destroyed before.
+    */
+    ~TObjectPool()
+    {
+        const uint32 objectsPerChunk = GetObjectsPerChunk();
+        const uint32 chunkCount      = m_chunkCount.load(std::memory_order_relaxed);
+        for (uint32 chunk = 0; chunk < chunkCount; chunk++) {
+            for (uint32 i = 0; i < objectsPerChunk; i++) {
+                uint8* slot = m_chunks[chunk] + i * SlotSize;
+                if (GetTrailer(slot)->Generation.load(std::memory_order_relaxed) & 1) {
+                    MemoryUtils::DestroyItems(reinterpret_cast<T*>(slot), 1);
+                }
+            }
+            MemoryUtils::FreeAligned(m_chunks[chunk]);
+        }
+
+        if (m_chunks) {
+            MemoryUtils::FreeAligned(m_chunks);
+        }
+    }
+
+    TObjectPool(const TObjectPool&) = delete;
+    TObjectPool& operator=(const TObjectPool&) = delete;
+
+    /**
+     * @brief Constructs an object in the pool.
+     * @param args Arguments passed to the object's constructor.
+     * @return Pointer to the object.
+    */
+    template<class... ArgsType>
+    T* Allocate(ArgsType&&... args)
+    {
+        FreeNode* node = Locked([this]() { return PopSlot(); });
+        return Construct(node, std::forward<ArgsType>(args)...);
+    }
+
+    /**
+     * @brief Constructs an object in the pool.
+     * @param args Arguments passed to the object's constructor.
+     * @return Handle to the object.
+    */
+    template<class... ArgsType>
+    Handle AllocateHandle(ArgsType&&... args)
+    {
+        return GetHandle(Allocate(std::forward<ArgsType>(args)...));
+    }
+
+    /**
+     * @brief Destroys an object and gives its memory back to the pool.
+     * @param object Object allocated from this pool.
+    */
+    void Free(T* object)
+    {
+        FreeNode* node = Destroy(object);
+        Locked([this, node]() { PushSlots(node, node); });
+    }
+
+    /**
+     * @brief Destroys an object and gives its memory back to the pool.
+     * @param handle Valid handle to an object of this pool.
+    */
+    void Free(Handle handle)
+    {
+        T* object = Get(handle);
+        AE_ASSERT(object);
+        if (object) {
+            Free(object);
+        }
+    }
+
+    /**
+     * @brief Returns the object referred by a handle.
+     * @param handle Handle to an object of this pool.
+     * @return Pointer to the object, null if it was freed.
+    */
+    T* Get(Handle handle) const
+    {
+        if (!(handle.Generation & 1) || (handle.Index >> m_chunkShift) >= m_chunkCount.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+
+        uint8* slot = m_chunks[handle.Index >> m_chunkShift] + (handle.Index & (GetObjectsPerChunk() - 1)) * SlotSize;
+        if (GetTrailer(slot)->Generation.load(std::memory_order_acquire) != handle.Generation) {
+            return nullptr;
+        }
+
+        return reinterpret_cast<T*>(slot);
+    }
+
+    /**
+     * @brief Returns a handle to an object of the pool.
+     * @param object Live object allocated from this pool.
+     * @return Handle to the object.
+    */
+    Handle GetHandle(const T* object) const
+    {
+        const SlotTrailer* trailer = GetTrailer(reinterpret_cast<const uint8*>(object));
+
+        Handle handle;
+        handle.Index      = trailer->Index;
+        handle.Generation = trailer->Generation.load(std::memory_order_relaxed);
+        AE_ASSERT(handle.Generation & 1);
+
+        return handle;
+    }
+
+    /**
+     * @brief Returns the number of objects the allocated chunks can hold.
+     * @return Capacity of the pool.
+    */
+    uint64 GetCapacity() const { return uint64(m_chunkCount.load(std::memory_order_relaxed)) << m_chunkShift; }
+
+    /**
+     * @brief Returns the number of objects of each chunk.
+     * @return Objects per chunk, a power of two.
+    */
+    uint32 GetObjectsPerChunk() const { return uint32(1) << m_chunkShift; }
+
+  private:
+    static SlotTrailer* GetTrailer(const uint8* slot) { return reinterpret_cast<SlotTrailer*>(const_cast<uint8*>(slot) + TrailerOffset); }
+
+    template<class FunctionType>
+    auto Locked(FunctionType&& function)
+    {
+        if constexpr (ThreadSafe) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return function();
+        } else {
+            return function();
+        }
+    }
+
+    /** Only the thread owning the slot writes its generation, so no atomic read-modify-write is needed.*/
+    static void BumpGeneration(uint8* slot)
+    {
+        std::atomic<uint32>& generation = GetTrailer(slot)->Generation;
+        generation.store(generation.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    template<class... ArgsType>
+    static T* Construct(FreeNode* node, ArgsType&&... args)
+    {
+        static_assert(std::is_constructible<T, ArgsType...>::value, "T is not constructible from these arguments");
+
+        uint8* slot = reinterpret_cast<uint8*>(node);
+        T*     item = reinterpret_cast<T*>(slot);
+
+        MemoryUtils::ConstructElement(item, std::forward<ArgsType>(args)...);
+        BumpGeneration(slot);
+
+        return item;
+    }
+
+    static FreeNode* Destroy(T* object)
+    {
+        AE_ASSERT(object);
+
+        uint8* slot = reinterpret_cast<uint8*>(object);
+        AE_ASSERT(GetTrailer(slot)->Generation.load(std::memory_order_relaxed) & 1);
+
+        BumpGeneration(slot);
+        MemoryUtils::DestroyItems(object, 1);
+
+        return reinterpret_cast<FreeNode*>(slot);
+    }
+
+    /** Must be called with the lock held.*/
+    FreeNode* PopSlot()
+    {
+        if (!m_freeList) {
+            AllocateChunk();
+        }
+
+        FreeNode* node = m_freeList;
+        m_freeList     = node->Next;
+        return node;
+    }
+
+    /** Pops up to count slots, must be called with the lock held.*/
+    FreeNode* PopSlots(uint32 count, uint32& popped)
+    {
+        if (!m_freeList) {
+            AllocateChunk();
+        }
+
+        FreeNode* first = m_freeList;
+        FreeNode* last  = first;
+        for (popped = 1; popped < count && last->Next; popped++) {
+            last = last->Next;
+        }
+
+        m_freeList = last->Next;
+        last->Next = nullptr;
+        return first;
+    }
+
+    /** Must be called with the lock held.*/
+    void PushSlots(FreeNode* first, FreeNode* last)
+    {
+        last->Next = m_freeList;
+        m_freeList = first;
+    }
+
+    void AllocateChunk()
+    {
+        if (!m_chunks) {
+            m_chunks = reinterpret_cast<uint8**>(MemoryUtils::AllocateAligned(MaxChunks * sizeof(uint8*)));
+        }
+        const uint32 chunkIndex = m_chunkCount.load(std::memory_order_relaxed);
+        AE_CHECK(chunkIndex < MaxChunks);
+
+        const uint32 objectsPerChunk = GetObjectsPerChunk();
+        const uint64 align           = SlotAlign > 16 ? SlotAlign : 16;
+        uint8*       chunk           = reinterpret_cast<uint8*>(MemoryUtils::AllocateAligned(objectsPerChunk * SlotSize, align));
+
+        FreeNode* next = m_freeList;
+        for (uint32 i = objectsPerChunk; i > 0; i--) {
+            uint8* slot = chunk + (i - 1) * SlotSize;
+
+            SlotTrailer* trailer = new (slot + TrailerOffset) SlotTrailer;
+            trailer->Generation.store(0, std::memory_order_relaxed);
+            trailer->Index = (chunkIndex << m_chunkShift) + i - 1;
+
+            FreeNode* node = reinterpret_cast<FreeNode*>(slot);
+            node->Next     = next;
+            next           = node;
+        }
+
+        m_freeList = next;
+
+        m_chunks[chunkIndex] = chunk;
+        m_chunkCount.store(chunkIndex + 1, std::memory_order_release);
+    }
+
+    std::mutex          m_mutex;
+    uint8**             m_chunks;
+    std::atomic<uint32> m_chunkCount;
+    uint32              m_chunkShift;
+    FreeNode*           m_freeList;
+};
+
+/**
+ * @brief Per-thread front end of a thread safe pool.
+ * Keeps a local free list that is refilled from, and flushed to, the pool in batches
+ * so most allocations and frees do not take the pool's lock. A cache must only be
+ * used by the thread that created it and destroyed before its pool.
+*/
+template<class T, bool ThreadSafe>
+class TObjectPool<T, ThreadSafe>::ThreadCache
+{
+  public:
+    /**
+     * @brief Constructor.
+     * @param pool Pool the objects are allocated from.
+     * @param capacity Maximum number of free objects kept by the cache.
+    */
+    explicit ThreadCache(TObjectPool& pool, uint32 capacity = DefaultCacheCapacity)
+      : m_pool(&pool)
+      , m_freeList(nullptr)
+      , m_count(0)
+      , m_capacity(capacity > 2 ? capacity : 2)
+    {
+        static_assert(ThreadSafe, "Thread caches need a thread safe pool");
+    }
+
+    /** Gives the cached objects back to the pool.*/
+    ~ThreadCache()
+    {
+        if (m_freeList) {
+            Flush(m_count);
+        }
+    }
+
+    ThreadCache(const ThreadCache&) = delete;
+    ThreadCache& operator=(const ThreadCache&) = delete;
+
+    /**
+     * @brief Constructs an object in the pool.
+     * @param args Arguments passed to the object's constructor.
+     * @return Pointer to the object.
+    */
+    template<class... ArgsType>
+    T* Allocate(ArgsType&&... args)
+    {
+        if (!m_freeList) {
+            m_freeList = m_pool->Locked([this]() { return m_pool->PopSlots(m_capacity / 2, m_count); });
+        }
+
+        FreeNode* node = m_freeList;
+        m_freeList     = node->Next;
+        m_count--;
+
+        return Construct(node, std::forward<ArgsType>(args)...);
+    }
+
+    /**
+     * @brief Constructs an object in the pool.
+     * @param args Arguments passed to the object's constructor.
+     * @return Handle to the object.
+    */
+    template<class... ArgsType>
+    Handle AllocateHandle(ArgsType&&... args)
+    {
+        return m_pool->GetHandle(Allocate(std::forward<ArgsType>(args)...));
+    }
+
+    /**
+     * @brief Destroys an object and keeps its memory in the cache.
+     * @param object Object allocated from the cache's pool, by any thread.
+    */
+    void Free(T* object)
+    {
+        FreeNode* node = Destroy(object);
+        node->Next     = m_freeList;
+        m_freeList     = node;
+
+        if (++m_count >= m_capacity) {
+            Flush(m_capacity / 2);
+        }
+    }
+
+    /**
+     * @brief Destroys an object and keeps its memory in the cache.
+     * @param handle Valid handle to an object of the cache's pool.
+    */
+    void Free(Handle handle)
+    {
+        T* object = m_pool->Get(handle);
+        AE_ASSERT(object);
+        if (object) {
+            Free(object);
+        }
+    }
+
+  private:
+    void Flush(uint32 count)
+    {
+        FreeNode* first = m_freeList;
+        FreeNode* last  = first;
+        for (uint32 i = 1; i < count; i++) {
+            last = last->Next;
+        }
+
+        m_freeList = last->Next;
+        m_count -= count;
+
+        m_pool->Locked([this, first, last]() { m_pool->PushSlots(first, last); });
+    }
+
+    TObjectPool* m_pool;
+    FreeNode*    m_freeList;
+    uint32       m_count;
+    uint32       m_capacity;
+};
@@ -0,0 +1,299 @@
+#include "MemoryTrace.h"
+
+#include <atomic>
+#include <mutex>
+
+/**
+ * Trace layout: a header made of Magic and Version, followed by the events.
+ * Every event starts with a byte holding the event type in its 2 low bits and the log2
+ * of the alignment in the others, followed by the thread id as a varint, then:
+ *  - Allocate: size as a varint, address.
+ *  - Reallocate: old address, size as a varint, address.
+ *  - Free: address.
+ * Addresses are written as zigzag varint deltas to the previously written address.
+*/
+
+namespace {
+
+constexpr uint32 Magic   = 0x544D4541; // "AEMT"
+constexpr uint32 Version = 1;
+
+constexpr uint64
+ZigZagEncode(int64 value)
+{
+    return (static_cast<uint64>(value) << 1) ^ static_cast<uint64>(value >> 63);
+}
+
+constexpr int64
+ZigZagDecode(uint64 value)
+{
+    return static_cast<int64>(value >> 1) ^ -static_cast<int64>(value & 1);
+}
+
+} // namespace
+
+#if AE_MEMORY_TRACKING
+
+namespace {
+
+constexpr uint64 BufferSize   = 64 * 1024;
+constexpr uint64 MaxEventSize = 1 + 5 + 3 * 10;
+
+std::atomic<bool>   gCapturing {false};
+std::atomic<uint32> gThreadCount {0};
+std::mutex          gMutex;
+FILE*               gFile;
+uint8               gBuffer[BufferSize];
+uint64              gBufferSize;
+uint64              gLastAddress;
+
+thread_local uint32 tThreadId = ~0u;
+
+uint32
+GetThreadId()
+{
+    if (tThreadId == ~0u) {
+        tThreadId = gThreadCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    return tThreadId;
+}
+
+void
+Flush()
+{
+    fwrite(gBuffer, 1, gBufferSize, gFile);
+    gBufferSize = 0;
+}
+
+void
+WriteVarint(uint64 value)
+{
+    while (value >= 0x80) {
+        gBuffer[gBufferSize++] = static_cast<uint8>(value | 0x80);
+        value >>= 7;
+    }
+    gBuffer[gBufferSize++] = static_cast<uint8>(value);
+}
+
+void
+WriteAddress(void* memory)
+{
+    const uint64 address = reinterpret_cast<uint64>(memory);
+    WriteVarint(ZigZagEncode(static_cast<int64>(address - gLastAddress)));
+    gLastAddress = address;
+}
+
+/** Starts an event, returns false when not capturing. The caller must hold gMutex.*/
+bool
+WriteEventHeader(EMemoryTraceEvent type, uint64 align, uint32 threadId)
+{
+    if (!gFile) {
+        return false;
+    }
+
+    if (gBufferSize + MaxEventSize > BufferSize) {
+        Flush();
+    }
+
+    uint8 alignShift = 0;
+    while ((uint64(1) << alignShift) < align) {
+        alignShift++;
+    }
+
+    gBuffer[gBufferSize++] = static_cast<uint8>(static_cast<uint8>(type) | (alignShift << 2));
+    WriteVarint(threadId);
+
+    return true;
+}
+
+} // namespace
+
+bool
+MemoryTrace::BeginCapture(const char* path)
+{
+    EndCapture();
+
+    std::lock_guard<std::mutex> lock(gMutex);
+
+    gFile = fopen(path, "wb");
+    if (!gFile) {
+        return false;
+    }
+
+    const uint32 header[] = {Magic, Version};
+    fwrite(header, sizeof(header), 1, gFile);
+
+    gBufferSize  = 0;
+    gLastAddress = 0;
+    gCapturing.store(true, std::memory_order_release);
+
+    return true;
+}
+
+void
+MemoryTrace::EndCapture()
+{
+    std::lock_guard<std::mutex> lock(gMutex);
+
+    gCapturing.store(false, std::memory_order_relaxed);
+    if (gFile) {
+        Flush();
+        fclose(gFile);
+        gFile = nullptr;
+    }
+}
+
+bool
+MemoryTrace::IsCapturing()
+{
+    return gCapturing.load(std::memory_order_relaxed);
+}
+
+void
+MemoryTrace::OnAllocate(void* memory, uint64 size, uint64 align)
+{
+    if (!IsCapturing()) {
+        return;
+    }
+
+    const uint32 threadId = GetThreadId();
+
+    std::lock_guard<std::mutex> lock(gMutex);
+    if (WriteEventHeader(EMemoryTraceEvent::Allocate, align, threadId)) {
+        WriteVarint(size);
+        WriteAddress(memory);
+    }
+}
+
+bool
+MemoryTrace::BeginReallocate()
+{
+    if (!IsCapturing()) {
+        return false;
+    }
+
+    GetThreadId();
+    gMutex.lock();
+    return true;
+}
+
+void
+MemoryTrace::EndReallocate(void* oldMemory, void* memory, uint64 size, uint64 align)
+{
+    std::lock_guard<std::mutex> lock(gMutex, std::adopt_lock);
+    if (WriteEventHeader(EMemoryTraceEvent::Reallocate, align, tThreadId)) {
+        WriteAddress(oldMemory);
+        WriteVarint(size);
+        WriteAddress(memory);
+    }
+}
+
+void
+MemoryTrace::OnFree(void* memory)
+{
+    if (!IsCapturing()) {
+        return;
+    }
+
+    const uint32 threadId = GetThreadId();
+
+    std::lock_guard<std::mutex> lock(gMutex);
+    if (WriteEventHeader(EMemoryTraceEvent::Free, 1, threadId)) {
+        WriteAddress(memory);
+    }
+}
+
+#endif // AE_MEMORY_TRACKING
+
+MemoryTraceReader::~MemoryTraceReader()
+{
+    if (m_file) {
+        fclose(m_file);
+    }
+}
+
+bool
+MemoryTraceReader::Open(const char* path)
+{
+    if (m_file) {
+        fclose(m_file);
+    }
+
+    m_file        = fopen(path, "rb");
+    m_lastAddress = 0;
+    if (!m_file) {
+        return false;
+    }
+
+    uint32 header[2];
+    if (fread(header, sizeof(header), 1, m_file) != 1 || header[0] != Magic || header[1] != Version) {
+        fclose(m_file);
+        m_file = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+bool
+MemoryTraceReader::Read(MemoryTraceEvent& event)
+{
+    if (!m_file) {
+        return false;
+    }
+
+    const int32 first = fgetc(m_file);
+    if (first == EOF) {
+        return false;
+    }
+
+    event.Type  = static_cast<EMemoryTraceEvent>(first & 3);
+    event.Align = uint64(1) << (first >> 2);
+    event.Size  = 0;
+
+    uint64 threadId = 0;
+    if (!ReadVarint(threadId)) {
+        return false;
+    }
+    event.ThreadId = static_cast<uint32>(threadId);
+
+    auto readAddress = [this](uint64& address) {
+        uint64 delta = 0;
+        if (!ReadVarint(delta)) {
+            return false;
+        }
+        address       = m_lastAddress + static_cast<uint64>(ZigZagDecode(delta));
+        m_lastAddress = address;
+        return true;
+    };
+
+    event.OldAddress = 0;
+    switch (event.Type) {
+        case EMemoryTraceEvent::Allocate:
+            return ReadVarint(event.Size) && readAddress(event.Address);
+        case EMemoryTraceEvent::Reallocate:
+            return readAddress(event.OldAddress) && ReadVarint(event.Size) && readAddress(event.Address);
+        case EMemoryTraceEvent::Free:
+            return readAddress(event.Address);
+        default:
+            return false;
+    }
+}
+
+bool
+MemoryTraceReader::ReadVarint(uint64& value)
+{
+    value = 0;
+    for (uint32 shift = 0; shift < 64; shift += 7) {
+        const int32 byte = fgetc(m_file);
+        if (byte == EOF) {
+            return false;
+        }
+
+        value |= static_cast<uint64>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
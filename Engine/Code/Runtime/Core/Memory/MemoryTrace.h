@@ -0,0 +1,106 @@
+#pragma once
+
+#include "MemoryTracker.h"
+#include <cstdio>
+
+enum class EMemoryTraceEvent : uint8
+{
+    Allocate,
+    Reallocate,
+    Free
+};
+
+/**
+ * @brief An allocation, reallocation or free recorded in a memory trace.
+*/
+struct MemoryTraceEvent
+{
+    EMemoryTraceEvent Type;
+    uint32            ThreadId;
+    uint64            Size;
+    uint64            Align;
+    uint64            OldAddress;
+    uint64            Address;
+};
+
+#if AE_MEMORY_TRACKING
+
+/**
+ * @brief Records the allocations made through MemoryUtils to a binary trace file.
+ * Events of every thread are written in the order they happened, tagged with a small
+ * per-thread id. Use MemoryTraceReader to read them back.
+*/
+class MemoryTrace
+{
+  public:
+    /**
+     * @brief Starts recording to a file, any previous capture is ended.
+     * @param path Path of the trace file.
+     * @return True if the file could be created.
+    */
+    static bool BeginCapture(const char* path);
+
+    /**
+     * @brief Stops recording and closes the trace file.
+    */
+    static void EndCapture();
+
+    /**
+     * @brief Returns whether allocations are being recorded.
+     * @return True while capturing.
+    */
+    static bool IsCapturing();
+
+    static void OnAllocate(void* memory, uint64 size, uint64 align);
+
+    /**
+     * @brief Locks the trace for a reallocation while capturing.
+     * The old block is released by the reallocation, so the trace stays locked until its event
+     * is written, another thread could otherwise get the same block and record it first.
+     * @return True if the reallocation must be recorded with EndReallocate.
+    */
+    static bool BeginReallocate();
+
+    /**
+     * @brief Records a reallocation started with BeginReallocate and unlocks the trace.
+    */
+    static void EndReallocate(void* oldMemory, void* memory, uint64 size, uint64 align);
+
+    static void OnFree(void* memory);
+};
+
+#endif // AE_MEMORY_TRACKING
+
+/**
+ * @brief Reads the events of a trace written by MemoryTrace.
+*/
+class MemoryTraceReader
+{
+  public:
+    MemoryTraceReader() = default;
+
+    ~MemoryTraceReader();
+
+    MemoryTraceReader(const MemoryTraceReader&) = delete;
+    MemoryTraceReader& operator=(const MemoryTraceReader&) = delete;
+
+    /**
+     * @brief Opens a trace file.
+     * @param path Path of the trace file.
+     * @return True if the file exists and is a trace of a supported version.
+    */
+    bool Open(const char* path);
+
+    /**
+     * @brief Reads the next event.
+     * @param event Read event.
+     * @return False at the end of the trace.
+    */
+    bool Read(MemoryTraceEvent& event);
+
+  private:
+    bool ReadVarint(uint64& value);
+
+    FILE*  m_file {nullptr};
+    uint64 m_lastAddress {0};
+};
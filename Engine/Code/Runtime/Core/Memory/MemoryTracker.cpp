@@ -0,0 +1,385 @@
+#include "MemoryTracker.h"
+
+#if AE_MEMORY_TRACKING
+
+    #include <atomic>
+    #include <cstdio>
+    #include <mutex>
+
+namespace {
+
+/**
+ * Counters of a tag as seen by a single thread, only the owning thread writes them.
+ * Live values can get negative when memory is freed by another thread than the one
+ * that allocated it, only their sum over every thread is meaningful.
+*/
+struct TagCounters
+{
+    std::atomic<int64>  LiveBytes;
+    std::atomic<int64>  LiveAllocations;
+    std::atomic<uint64> TotalAllocations;
+    std::atomic<uint64> Reallocations;
+    std::atomic<uint64> ContainerGrowths;
+    int64               SampledBytes;
+};
+
+enum class EThreadStatsState : uint8
+{
+    Uninitialized,
+    Active,
+    Dead
+};
+
+/**
+ * Trivially constructible and destructible so that it is usable by every allocation
+ * of the thread, ThreadStatsGuard folds it into gRetiredStats when the thread exits.
+*/
+struct ThreadStats
+{
+    TagCounters         Tags[MemoryTracker::MaxTags];
+    std::atomic<uint64> Histogram[MemoryTracker::HistogramBuckets];
+    ThreadStats*        Previous;
+    ThreadStats*        Next;
+    EThreadStatsState   State;
+};
+
+struct ThreadStatsGuard
+{
+    ~ThreadStatsGuard();
+};
+
+/** A thread samples the peak of a tag every time its live bytes grow by this much.*/
+constexpr int64 PeakSampleBytes = 64 * 1024;
+
+constexpr uint32 MaxTagNameLength = 32;
+
+std::mutex          gMutex;
+ThreadStats*        gThreads;
+ThreadStats         gRetiredStats;
+std::atomic<uint64> gPeakBytes[MemoryTracker::MaxTags];
+std::atomic<uint64> gTotalPeakBytes;
+char                gTagNames[MemoryTracker::MaxTags][MaxTagNameLength];
+std::atomic<uint16> gTagCount {1};
+
+thread_local ThreadStats      tStats;
+thread_local ThreadStatsGuard tStatsGuard;
+thread_local uint16           tCurrentTag = MemoryTracker::UntaggedTag;
+
+template<class T, class U>
+void
+Add(std::atomic<T>& counter, U value)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + static_cast<T>(value), std::memory_order_relaxed);
+}
+
+void
+Fold(TagCounters& dst, const TagCounters& src)
+{
+    Add(dst.LiveBytes, src.LiveBytes.load(std::memory_order_relaxed));
+    Add(dst.LiveAllocations, src.LiveAllocations.load(std::memory_order_relaxed));
+    Add(dst.TotalAllocations, src.TotalAllocations.load(std::memory_order_relaxed));
+    Add(dst.Reallocations, src.Reallocations.load(std::memory_order_relaxed));
+    Add(dst.ContainerGrowths, src.ContainerGrowths.load(std::memory_order_relaxed));
+}
+
+ThreadStatsGuard::~ThreadStatsGuard()
+{
+    std::lock_guard<std::mutex> lock(gMutex);
+
+    for (uint16 tag = 0; tag < MemoryTracker::MaxTags; tag++) {
+        Fold(gRetiredStats.Tags[tag], tStats.Tags[tag]);
+    }
+    for (uint32 bucket = 0; bucket < MemoryTracker::HistogramBuckets; bucket++) {
+        Add(gRetiredStats.Histogram[bucket], tStats.Histogram[bucket].load(std::memory_order_relaxed));
+    }
+
+    if (tStats.Previous) {
+        tStats.Previous->Next = tStats.Next;
+    } else {
+        gThreads = tStats.Next;
+    }
+    if (tStats.Next) {
+        tStats.Next->Previous = tStats.Previous;
+    }
+
+    tStats.State = EThreadStatsState::Dead;
+}
+
+/** Sums the counters of every thread, the caller must hold gMutex.*/
+void
+SumTagCounters(TagCounters& sum, uint16 tag)
+{
+    Fold(sum, gRetiredStats.Tags[tag]);
+    for (ThreadStats* stats = gThreads; stats; stats = stats->Next) {
+        Fold(sum, stats->Tags[tag]);
+    }
+}
+
+void
+UpdatePeak(std::atomic<uint64>& peak, int64 live)
+{
+    const uint64 value   = live > 0 ? static_cast<uint64>(live) : 0;
+    uint64       current = peak.load(std::memory_order_relaxed);
+    while (value > current && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+}
+
+/** Samples the live bytes of a tag and of every allocation, the caller must hold gMutex.*/
+void
+SamplePeak(uint16 tag)
+{
+    int64 total = 0;
+
+    const uint16 count = gTagCount.load(std::memory_order_relaxed);
+    for (uint16 i = 0; i < count; i++) {
+        TagCounters counters {};
+        SumTagCounters(counters, i);
+
+        const int64 live = counters.LiveBytes.load(std::memory_order_relaxed);
+        if (i == tag) {
+            UpdatePeak(gPeakBytes[tag], live);
+        }
+        total += live;
+    }
+
+    UpdatePeak(gTotalPeakBytes, total);
+}
+
+void
+UpdateLiveBytes(ThreadStats& stats, uint16 tag, int64 delta)
+{
+    TagCounters& counters = stats.Tags[tag];
+
+    const int64 live = counters.LiveBytes.load(std::memory_order_relaxed) + delta;
+    counters.LiveBytes.store(live, std::memory_order_relaxed);
+
+    if (live < counters.SampledBytes) {
+        counters.SampledBytes = live;
+    } else if (live - counters.SampledBytes >= PeakSampleBytes && stats.State == EThreadStatsState::Active) {
+        counters.SampledBytes = live;
+        std::lock_guard<std::mutex> lock(gMutex);
+        SamplePeak(tag);
+    }
+}
+
+/**
+ * Calls function with the stats the calling thread must update, a thread whose stats
+ * have been retired updates gRetiredStats under the lock.
+*/
+template<class Function>
+void
+UpdateThreadStats(Function&& function)
+{
+    if (tStats.State == EThreadStatsState::Uninitialized) {
+        std::lock_guard<std::mutex> lock(gMutex);
+
+        (void)&tStatsGuard;
+        tStats.Next = gThreads;
+        if (gThreads) {
+            gThreads->Previous = &tStats;
+        }
+        gThreads     = &tStats;
+        tStats.State = EThreadStatsState::Active;
+    }
+
+    if (tStats.State == EThreadStatsState::Active) {
+        function(tStats);
+    } else {
+        // Retired stats never sample the peak, it is updated when queried instead.
+        std::lock_guard<std::mutex> lock(gMutex);
+        function(gRetiredStats);
+    }
+}
+
+uint32
+GetHistogramBucket(uint64 size)
+{
+    uint32 bucket = 0;
+    while (size >>= 1) {
+        bucket++;
+    }
+    return bucket;
+}
+
+void
+PrintStats(FILE* file, const char* name, const MemoryTagStats& stats)
+{
+    fprintf(file,
+            "%-32s %16llu %16llu %12llu %12llu %12llu %12llu\n",
+            name,
+            stats.LiveBytes,
+            stats.PeakBytes,
+            stats.LiveAllocations,
+            stats.TotalAllocations,
+            stats.Reallocations,
+            stats.ContainerGrowths);
+}
+
+} // namespace
+
+uint16
+MemoryTracker::RegisterTag(const char* name)
+{
+    std::lock_guard<std::mutex> lock(gMutex);
+
+    const uint16 count = gTagCount.load(std::memory_order_relaxed);
+    for (uint16 tag = 1; tag < count; tag++) {
+        if (strncmp(gTagNames[tag], name, MaxTagNameLength - 1) == 0) {
+            return tag;
+        }
+    }
+
+    if (count == MaxTags) {
+        return UntaggedTag;
+    }
+
+    strncpy(gTagNames[count], name, MaxTagNameLength - 1);
+    gTagCount.store(count + 1, std::memory_order_release);
+
+    return count;
+}
+
+const char*
+MemoryTracker::GetTagName(uint16 tag)
+{
+    AE_ASSERT(tag < GetTagCount());
+    return tag == UntaggedTag ? "Untagged" : gTagNames[tag];
+}
+
+uint16
+MemoryTracker::GetTagCount()
+{
+    return gTagCount.load(std::memory_order_acquire);
+}
+
+uint16
+MemoryTracker::GetCurrentTag()
+{
+    return tCurrentTag;
+}
+
+void
+MemoryTracker::SetCurrentTag(uint16 tag)
+{
+    AE_ASSERT(tag < GetTagCount());
+    tCurrentTag = tag;
+}
+
+MemoryTagStats
+MemoryTracker::GetTagStats(uint16 tag)
+{
+    AE_ASSERT(tag < GetTagCount());
+
+    std::lock_guard<std::mutex> lock(gMutex);
+    SamplePeak(tag);
+
+    TagCounters counters {};
+    SumTagCounters(counters, tag);
+
+    MemoryTagStats stats;
+    stats.LiveBytes        = static_cast<uint64>(counters.LiveBytes.load(std::memory_order_relaxed));
+    stats.PeakBytes        = gPeakBytes[tag].load(std::memory_order_relaxed);
+    stats.LiveAllocations  = static_cast<uint64>(counters.LiveAllocations.load(std::memory_order_relaxed));
+    stats.TotalAllocations = counters.TotalAllocations.load(std::memory_order_relaxed);
+    stats.Reallocations    = counters.Reallocations.load(std::memory_order_relaxed);
+    stats.ContainerGrowths = counters.ContainerGrowths.load(std::memory_order_relaxed);
+    return stats;
+}
+
+MemoryTagStats
+MemoryTracker::GetTotalStats()
+{
+    MemoryTagStats total {};
+
+    const uint16 count = GetTagCount();
+    for (uint16 tag = 0; tag < count; tag++) {
+        const MemoryTagStats stats = GetTagStats(tag);
+        total.LiveBytes += stats.LiveBytes;
+        total.LiveAllocations += stats.LiveAllocations;
+        total.TotalAllocations += stats.TotalAllocations;
+        total.Reallocations += stats.Reallocations;
+        total.ContainerGrowths += stats.ContainerGrowths;
+    }
+    total.PeakBytes = gTotalPeakBytes.load(std::memory_order_relaxed);
+
+    return total;
+}
+
+uint64
+MemoryTracker::GetSizeHistogram(uint32 bucket)
+{
+    AE_ASSERT(bucket < HistogramBuckets);
+
+    std::lock_guard<std::mutex> lock(gMutex);
+
+    uint64 allocations = gRetiredStats.Histogram[bucket].load(std::memory_order_relaxed);
+    for (ThreadStats* stats = gThreads; stats; stats = stats->Next) {
+        allocations += stats->Histogram[bucket].load(std::memory_order_relaxed);
+    }
+    return allocations;
+}
+
+bool
+MemoryTracker::Dump(const char* path)
+{
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        return false;
+    }
+
+    fprintf(file, "%-32s %16s %16s %12s %12s %12s %12s\n", "Tag", "Live bytes", "Peak bytes", "Live", "Allocations", "Reallocs", "Growths");
+
+    const uint16 count = GetTagCount();
+    for (uint16 tag = 0; tag < count; tag++) {
+        PrintStats(file, GetTagName(tag), GetTagStats(tag));
+    }
+    PrintStats(file, "Total", GetTotalStats());
+
+    fprintf(file, "\n%-32s %16s\n", "Allocation size", "Allocations");
+    for (uint32 bucket = 0; bucket < HistogramBuckets; bucket++) {
+        const uint64 allocations = GetSizeHistogram(bucket);
+        if (allocations) {
+            fprintf(file, "[2^%-2u, 2^%-2u) %19s %16llu\n", bucket, bucket + 1, "", allocations);
+        }
+    }
+
+    return fclose(file) == 0;
+}
+
+void
+MemoryTracker::OnAllocate(uint16 tag, uint64 size)
+{
+    UpdateThreadStats([=](ThreadStats& stats) {
+        TagCounters& counters = stats.Tags[tag];
+        Add(counters.LiveAllocations, 1);
+        Add(counters.TotalAllocations, 1);
+        Add(stats.Histogram[GetHistogramBucket(size)], 1);
+        UpdateLiveBytes(stats, tag, static_cast<int64>(size));
+    });
+}
+
+void
+MemoryTracker::OnReallocate(uint16 tag, uint64 oldSize, uint64 size)
+{
+    UpdateThreadStats([=](ThreadStats& stats) {
+        Add(stats.Tags[tag].Reallocations, 1);
+        UpdateLiveBytes(stats, tag, static_cast<int64>(size) - static_cast<int64>(oldSize));
+    });
+}
+
+void
+MemoryTracker::OnFree(uint16 tag, uint64 size)
+{
+    UpdateThreadStats([=](ThreadStats& stats) {
+        TagCounters& counters = stats.Tags[tag];
+        Add(counters.LiveAllocations, -1);
+        Add(counters.LiveBytes, -static_cast<int64>(size));
+    });
+}
+
+void
+MemoryTracker::OnContainerGrowth()
+{
+    UpdateThreadStats([](ThreadStats& stats) { Add(stats.Tags[tCurrentTag].ContainerGrowths, 1); });
+}
+
+#endif // AE_MEMORY_TRACKING
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "Types.h"
+
+#ifndef AE_MEMORY_TRACKING
+    #if defined(AE_RELEASE) || defined(_RELEASE)
+        #define AE_MEMORY_TRACKING 0
+    #else
+        #define AE_MEMORY_TRACKING 1
+    #endif
+#endif
+
+#if AE_MEMORY_TRACKING
+
+/**
+ * @brief Statistics of the allocations made under a memory tag.
+*/
+struct MemoryTagStats
+{
+    uint64 LiveBytes;
+    uint64 PeakBytes;
+    uint64 LiveAllocations;
+    uint64 TotalAllocations;
+    uint64 Reallocations;
+    uint64 ContainerGrowths;
+};
+
+/**
+ * @brief Accounts every allocation made through MemoryUtils.
+ * Allocations are attributed to the memory tag active on the allocating thread,
+ * see AE_MEMORY_TAG_SCOPE. Only compiled when AE_MEMORY_TRACKING is enabled,
+ * which is the default for every configuration but Release.
+*/
+class MemoryTracker
+{
+  public:
+    static constexpr uint16 MaxTags          = 64;
+    static constexpr uint16 UntaggedTag      = 0;
+    static constexpr uint32 HistogramBuckets = 64;
+
+    /**
+     * @brief Registers a memory tag, registering the same name twice returns the same tag.
+     * @param name Name of the tag.
+     * @return The tag, or UntaggedTag when there is no room for more tags.
+    */
+    static uint16 RegisterTag(const char* name);
+
+    /**
+     * @brief Returns the name of a memory tag.
+     * @param tag The tag.
+     * @return Name of the tag.
+    */
+    static const char* GetTagName(uint16 tag);
+
+    /**
+     * @brief Returns the number of registered memory tags, including UntaggedTag.
+     * @return Number of registered tags.
+    */
+    static uint16 GetTagCount();
+
+    /**
+     * @brief Returns the memory tag active on the calling thread.
+     * @return The active tag.
+    */
+    static uint16 GetCurrentTag();
+
+    /**
+     * @brief Sets the memory tag active on the calling thread.
+     * @param tag The tag.
+    */
+    static void SetCurrentTag(uint16 tag);
+
+    /**
+     * @brief Returns the statistics of a memory tag.
+     * @param tag The tag.
+     * @return The tag statistics.
+    */
+    static MemoryTagStats GetTagStats(uint16 tag);
+
+    /**
+     * @brief Returns the statistics of every allocation, whatever their tag.
+     * @return The total statistics.
+    */
+    static MemoryTagStats GetTotalStats();
+
+    /**
+     * @brief Returns the number of allocations whose size is in [2^bucket, 2^(bucket + 1)).
+     * Bucket 0 also counts empty allocations.
+     * @param bucket Histogram bucket.
+     * @return Number of allocations.
+    */
+    static uint64 GetSizeHistogram(uint32 bucket);
+
+    /**
+     * @brief Writes every statistic to a text file.
+     * @param path Path of the file.
+     * @return True if the file was written.
+    */
+    static bool Dump(const char* path);
+
+    static void OnAllocate(uint16 tag, uint64 size);
+
+    static void OnReallocate(uint16 tag, uint64 oldSize, uint64 size);
+
+    static void OnFree(uint16 tag, uint64 size);
+
+    /**
+     * @brief Counts a reallocation requested by a container's growth policy.
+    */
+    static void OnContainerGrowth();
+};
+
+/**
+ * @brief Sets the calling thread's memory tag for the lifetime of the scope.
+*/
+class MemoryTagScope
+{
+  public:
+    explicit MemoryTagScope(uint16 tag)
+      : m_previousTag(MemoryTracker::GetCurrentTag())
+    {
+        MemoryTracker::SetCurrentTag(tag);
+    }
+
+    ~MemoryTagScope() { MemoryTracker::SetCurrentTag(m_previousTag); }
+
+    MemoryTagScope(const MemoryTagScope&) = delete;
+    MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+
+  private:
+    uint16 m_previousTag;
+};
+
+    #define AE_MEMORY_CONCAT_IMPL(a, b) a##b
+    #define AE_MEMORY_CONCAT(a, b)      AE_MEMORY_CONCAT_IMPL(a, b)
+
+    /** Attributes the allocations made until the end of the scope to the tag called name.*/
+    #define AE_MEMORY_TAG_SCOPE(name)                                                                   \
+        static const uint16 AE_MEMORY_CONCAT(memoryTag, __LINE__) = MemoryTracker::RegisterTag(name); \
+        MemoryTagScope      AE_MEMORY_CONCAT(memoryTagScope, __LINE__)(AE_MEMORY_CONCAT(memoryTag, __LINE__))
+
+#else
+
+    #define AE_MEMORY_TAG_SCOPE(name)
+
+#endif // AE_MEMORY_TRACKING
@@ -1,36 +1,180 @@
 #include "MemoryUtils.h"
+#include "MemoryTrace.h"
+#include "MemoryTracker.h"
+
+#ifdef AE_USE_BINNED_ALLOCATOR
+    #include "Allocators/BinnedAllocator.h"
+#endif
+
+namespace {
+
+#ifdef AE_USE_BINNED_ALLOCATOR
+
+void*
+AllocateBlock(uint64 size, uint64 align)
+{
+    return BinnedAllocator::Allocate(size, align);
+}
+
+void*
+ReallocateBlock(void* memory, uint64 oldSize, uint64 size, uint64 align)
+{
+    return BinnedAllocator::Reallocate(memory, oldSize, size, align);
+}
+
+void
+FreeBlock(void* memory)
+{
+    BinnedAllocator::Free(memory);
+}
+
+#else
+
+/**
+ * The distance to the start of the raw memory is stored right before the aligned block,
+ * so any alignment can be honored.
+ */
+void*
+AllocateBlock(uint64 size, uint64 align)
+{
+    uint8* rawMemory     = new uint8[size + align + sizeof(uint32)];
+    uint8* alignedMemory = MemoryUtils::AlignPointer(rawMemory + sizeof(uint32), align);
+
+    const uint32 shift = static_cast<uint32>(alignedMemory - rawMemory);
+    memcpy(alignedMemory - sizeof(uint32), &shift, sizeof(uint32));
+
+    return alignedMemory;
+}
+
+void
+FreeBlock(void* memory)
+{
+    uint8* alignedMemory = reinterpret_cast<uint8*>(memory);
+
+    uint32 shift;
+    memcpy(&shift, alignedMemory - sizeof(uint32), sizeof(uint32));
+
+    delete[] (alignedMemory - shift);
+}
+
+void*
+ReallocateBlock(void* memory, uint64 oldSize, uint64 size, uint64 align)
+{
+    void* ptr = AllocateBlock(size, align);
+
+    if (memory && oldSize) {
+        oldSize = oldSize > size ? size : oldSize;
+        memcpy(ptr, memory, oldSize);
+        FreeBlock(memory);
+    }
+
+    return ptr;
+}
+
+#endif // AE_USE_BINNED_ALLOCATOR
+
+#if AE_MEMORY_TRACKING
+
+/** Placed right before every tracked allocation.*/
+struct AllocationHeader
+{
+    uint64 Size;
+    uint32 Offset;
+    uint16 Tag;
+    uint16 Padding;
+};
+
+static_assert(sizeof(AllocationHeader) == 16, "AllocationHeader must keep 16 bytes alignment");
+
+AllocationHeader*
+GetHeader(void* memory)
+{
+    return reinterpret_cast<AllocationHeader*>(memory) - 1;
+}
+
+#endif // AE_MEMORY_TRACKING
+
+} // namespace
+
+#if AE_MEMORY_TRACKING
 
 void*
 MemoryUtils::AllocateAligned(uint64 size, uint64 align)
 {
-    uint64 actualSize = size + align;
+    const uint32 offset = static_cast<uint32>(align > sizeof(AllocationHeader) ? align : sizeof(AllocationHeader));
+
+    uint8* memory = reinterpret_cast<uint8*>(AllocateBlock(size + offset, align)) + offset;
 
-    uint8* rawMemory = new uint8[actualSize];
+    AllocationHeader* header = GetHeader(memory);
+    header->Size             = size;
+    header->Offset           = offset;
+    header->Tag              = MemoryTracker::GetCurrentTag();
 
-    uint8* alignedMemory = AlignPointer(rawMemory, align);
-    if (alignedMemory == rawMemory) {
-        alignedMemory += align;
+    MemoryTracker::OnAllocate(header->Tag, size);
+    MemoryTrace::OnAllocate(memory, size, align);
+
+    return memory;
+}
+
+void*
+MemoryUtils::ReallocateAligned(void* dst, uint64 oldSize, uint64 size, uint64 align)
+{
+    if (!dst) {
+        return AllocateAligned(size, align);
     }
 
-    int64 shift = alignedMemory - rawMemory;
-    AE_ASSERT(shift > 0 && shift <= 256);
+    AllocationHeader* header = GetHeader(dst);
+    const uint32      offset = header->Offset;
+    AE_ASSERT(offset >= align || offset == sizeof(AllocationHeader));
 
-    alignedMemory[-1] = static_cast<uint8>(shift & 0xFF);
+    oldSize = header->Size;
 
-    return alignedMemory;
+    const bool traced    = MemoryTrace::BeginReallocate();
+    uint8*     rawMemory = reinterpret_cast<uint8*>(dst) - offset;
+    uint8*     memory    = reinterpret_cast<uint8*>(ReallocateBlock(rawMemory, oldSize + offset, size + offset, align)) + offset;
+    if (traced) {
+        MemoryTrace::EndReallocate(dst, memory, size, align);
+    }
+
+    header       = GetHeader(memory);
+    header->Size = size;
+
+    MemoryTracker::OnReallocate(header->Tag, oldSize, size);
+
+    return memory;
 }
 
 void
 MemoryUtils::FreeAligned(void* memoryBlock)
 {
     AE_ASSERT(memoryBlock);
-    uint8* alignedMemory = reinterpret_cast<uint8*>(memoryBlock);
 
-    int64 shift = alignedMemory[-1];
-    if (shift == 0) {
-        shift = 256;
-    }
+    AllocationHeader* header = GetHeader(memoryBlock);
+    MemoryTracker::OnFree(header->Tag, header->Size);
+    MemoryTrace::OnFree(memoryBlock);
+
+    FreeBlock(reinterpret_cast<uint8*>(memoryBlock) - header->Offset);
+}
+
+#else
 
-    uint8* rawMemory = alignedMemory - shift;
-    delete[] rawMemory;
+void*
+MemoryUtils::AllocateAligned(uint64 size, uint64 align)
+{
+    return AllocateBlock(size, align);
 }
+
+void*
+MemoryUtils::ReallocateAligned(void* dst, uint64 oldSize, uint64 size, uint64 align)
+{
+    return ReallocateBlock(dst, oldSize, size, align);
+}
+
+void
+MemoryUtils::FreeAligned(void* memoryBlock)
+{
+    AE_ASSERT(memoryBlock);
+    FreeBlock(memoryBlock);
+}
+
+#endif // AE_MEMORY_TRACKING
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "TypeTraits.h"
 #include "Types.h"
 
 /**
@@ -8,6 +9,15 @@
 class MemoryUtils
 {
   public:
+    /** Alignment of allocations that do not ask for one.*/
+    static constexpr uint64 DefaultAlignment = 16;
+
+    /** Alignment keeping data used by different threads in different cache lines.*/
+    static constexpr uint64 CacheLineAlignment = 64;
+
+    /** Alignment of the smallest virtual memory page on every supported platform.*/
+    static constexpr uint64 PageAlignment = 4096;
+
     /**
      * @brief Aligns the given address to the given align size.
      * @param address Memory address to be aligned.
@@ -44,18 +54,16 @@ class MemoryUtils
     */
     static void* AllocateAligned(uint64 size, uint64 align = 16u);
 
-    static void* ReallocateAligned(void* dst, uint64 oldSize, uint64 size, uint64 align = 16u)
-    {
-        void* ptr = AllocateAligned(size, align);
-
-        if (dst && oldSize) {
-            oldSize = oldSize > size ? size : oldSize;
-            memcpy(ptr, dst, oldSize);
-            FreeAligned(dst);
-        }
-
-        return ptr;
-    }
+    /**
+     * @brief Resizes an aligned memory block, keeping its content.
+     * The block is grown in place when the allocator can, otherwise it is moved.
+     * @param dst Memory block to be resized, can be null.
+     * @param oldSize Current size in bytes of the memory block.
+     * @param size New size in bytes of the memory block.
+     * @param align Desired alignment.
+     * @return Pointer to the resized memory.
+    */
+    static void* ReallocateAligned(void* dst, uint64 oldSize, uint64 size, uint64 align = 16u);
 
     /**
      * @brief Free an aligned memory block.
@@ -63,6 +71,12 @@ class MemoryUtils
     */
     static void FreeAligned(void* memoryBlock);
 
+    /**
+     * @brief Copy constructs items into uninitialized memory.
+     * @param dst Uninitialized memory receiving the copies.
+     * @param src Items to be copied.
+     * @param size Number of items.
+    */
     template<class ItemType, class SizeType>
     static constexpr void CopyElements(ItemType* dst, const ItemType* src, SizeType size)
     {
@@ -70,24 +84,44 @@ class MemoryUtils
         AE_ASSERT(src);
         AE_ASSERT(size);
 
-        if constexpr (std::is_trivially_constructible<ItemType>::value) {
+        if constexpr (std::is_trivially_copyable<ItemType>::value) {
             memcpy(dst, src, size * sizeof(ItemType));
         } else {
             for (uint64 i = 0; i < size; i++) {
-                dst[i] = src[i];
+                new (dst + i) ItemType(src[i]);
             }
         }
     }
 
+    /**
+     * @brief Constructs one item into uninitialized memory.
+     * @param dst Uninitialized memory receiving the item.
+     * @param args Arguments forwarded to the item's constructor.
+    */
+    template<class T, class... Args>
+    static constexpr void ConstructElement(T* dst, Args&&... args)
+    {
+        static_assert(std::is_constructible<T, Args...>::value, "T is not constructible from these arguments");
+        AE_ASSERT(dst);
+
+        new (dst) T(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Constructs items into uninitialized memory.
+     * @param dst Uninitialized memory receiving the items.
+     * @param count Number of items.
+     * @param args Arguments of every item's constructor, passed to each item as lvalues.
+    */
     template<class T, class... Args>
     static constexpr void ConstructElements(T* dst, uint64 count, Args&&... args)
     {
+        // Rvalue arguments could only be moved into the first item, ConstructElement moves them into a single one.
+        static_assert(std::is_constructible<T, Args&...>::value, "T is not constructible from lvalues of these arguments, use ConstructElement");
         AE_ASSERT(dst);
 
-        if constexpr (std::is_constructible<T>::value) {
-            for (uint64 i = 0; i < count; i++) {
-                dst[i] = T(std::forward<Args>(args)...);
-            }
+        for (uint64 i = 0; i < count; i++) {
+            new (dst + i) T(args...);
         }
     }
 
@@ -96,7 +130,7 @@ class MemoryUtils
     {
         if constexpr (!std::is_trivially_destructible_v<ItemType>) {
             while (count) {
-                class DestructItemsElementType = ItemType;
+                using DestructItemsElementType = ItemType;
 
                 item->DestructItemsElementType::~DestructItemsElementType();
                 ++item;
@@ -105,21 +139,56 @@ class MemoryUtils
         }
     }
 
+    /**
+     * @brief Moves items to another, possibly overlapping, range leaving the source range uninitialized.
+     * Trivially relocatable items are moved with memmove, the others are move constructed
+     * into their new address and destroyed at the old one.
+     * @param dst Destination of the items.
+     * @param src Items to be moved.
+     * @param count Number of items.
+    */
+    template<class ItemType, class SizeType>
+    static void RelocateItems(ItemType* dst, ItemType* src, SizeType count)
+    {
+        if constexpr (TIsTriviallyRelocatable<ItemType>::Value) {
+            if (count) {
+                memmove(static_cast<void*>(dst), static_cast<const void*>(src), count * sizeof(ItemType));
+            }
+        } else if (dst < src) {
+            for (SizeType i = 0; i < count; i++) {
+                new (dst + i) ItemType(std::move(src[i]));
+                DestroyItems(src + i, 1);
+            }
+        } else if (dst > src) {
+            for (SizeType i = count; i > 0; i--) {
+                new (dst + i - 1) ItemType(std::move(src[i - 1]));
+                DestroyItems(src + i - 1, 1);
+            }
+        }
+    }
+
+    /**
+     * @brief Moves items to another range, converting them to DstItemType, leaving the source range uninitialized.
+     * @param dst Destination of the items.
+     * @param src Items to be moved.
+     * @param count Number of items.
+    */
     template<class DstItemType, class SrcItemType, class SizeType>
     static constexpr void MemoryMove(void* dst, const SrcItemType* src, SizeType count)
     {
-        if constexpr (
-          std::is_same_v<
-            DstItemType,
-            SrcItemType> || (std::is_trivially_copy_constructible_v<DstItemType> && std::is_trivially_copy_constructible_v<SrcItemType> && std::is_trivially_destructible_v<SrcItemType>)) {
+        if constexpr (std::is_same_v<DstItemType, SrcItemType>) {
+            RelocateItems(reinterpret_cast<DstItemType*>(dst), const_cast<SrcItemType*>(src), count);
+        } else if constexpr (std::is_trivially_copy_constructible_v<DstItemType> && std::is_trivially_copy_constructible_v<SrcItemType> &&
+                             std::is_trivially_destructible_v<SrcItemType>) {
             memmove(dst, src, count * sizeof(SrcItemType));
         } else {
+            SrcItemType* item = const_cast<SrcItemType*>(src);
             while (count) {
                 using RealocateConstructItems = SrcItemType;
 
-                new (dst) DstItemType(*src);
+                new (dst) DstItemType(std::move(*item));
                 ++(DstItemType*&)dst;
-                (src++)->RealocateConstructItems::~RealocateConstructItems();
+                (item++)->RealocateConstructItems::~RealocateConstructItems();
                 --count;
             }
         }
@@ -0,0 +1,133 @@
+#include "PlatformMemory.h"
+
+#ifdef AE_WINDOWS
+    #include "OS/Windows/WindowsCommons.h"
+    #include <psapi.h>
+#else
+    #include <cstdio>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+uint64
+PlatformMemory::GetPageSize()
+{
+#ifdef AE_WINDOWS
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return static_cast<uint64>(info.dwPageSize);
+#else
+    return static_cast<uint64>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+uint64
+PlatformMemory::GetHugePageSize()
+{
+#if defined(__linux__) && (defined(__x86_64__) || defined(__aarch64__))
+    return 2 * 1024 * 1024;
+#else
+    return GetPageSize();
+#endif
+}
+
+void*
+PlatformMemory::Reserve(uint64 size)
+{
+#ifdef AE_WINDOWS
+    return VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+#else
+    void* address = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    return address == MAP_FAILED ? nullptr : address;
+#endif
+}
+
+bool
+PlatformMemory::Commit(void* address, uint64 size)
+{
+#ifdef AE_WINDOWS
+    return VirtualAlloc(address, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+#else
+    return mprotect(address, size, PROT_READ | PROT_WRITE) == 0;
+#endif
+}
+
+void
+PlatformMemory::Decommit(void* address, uint64 size)
+{
+#ifdef AE_WINDOWS
+    VirtualFree(address, size, MEM_DECOMMIT);
+#else
+    mmap(address, size, PROT_NONE, MAP_FIXED | MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+#endif
+}
+
+bool
+PlatformMemory::AdviseHugePages(void* address, uint64 size)
+{
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    return madvise(address, size, MADV_HUGEPAGE) == 0;
+#else
+    return false;
+#endif
+}
+
+void*
+PlatformMemory::Map(uint64 size)
+{
+#ifdef AE_WINDOWS
+    return VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+    void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return address == MAP_FAILED ? nullptr : address;
+#endif
+}
+
+void*
+PlatformMemory::Remap(void* address, uint64 oldSize, uint64 size, bool allowMove)
+{
+#if defined(__linux__)
+    void* result = mremap(address, oldSize, size, allowMove ? MREMAP_MAYMOVE : 0);
+    return result == MAP_FAILED ? nullptr : result;
+#else
+    return size <= oldSize ? address : nullptr;
+#endif
+}
+
+void
+PlatformMemory::Release(void* address, uint64 size)
+{
+#ifdef AE_WINDOWS
+    VirtualFree(address, 0, MEM_RELEASE);
+#else
+    munmap(address, size);
+#endif
+}
+
+uint64
+PlatformMemory::GetResidentSize()
+{
+#ifdef AE_WINDOWS
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return 0;
+    }
+    return static_cast<uint64>(counters.WorkingSetSize);
+#elif defined(__linux__)
+    FILE* file = fopen("/proc/self/statm", "r");
+    if (!file) {
+        return 0;
+    }
+
+    unsigned long long pages    = 0;
+    unsigned long long resident = 0;
+    if (fscanf(file, "%llu %llu", &pages, &resident) != 2) {
+        resident = 0;
+    }
+    fclose(file);
+
+    return resident * GetPageSize();
+#else
+    return 0;
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Types.h"
+
+/**
+ * @brief Operating system virtual memory operations.
+*/
+class PlatformMemory
+{
+  public:
+    /**
+     * @brief Returns the size of a virtual memory page.
+     * @return Page size in bytes.
+    */
+    static uint64 GetPageSize();
+
+    /**
+     * @brief Returns the size of a huge page.
+     * @return Huge page size in bytes, the page size when huge pages are not supported.
+    */
+    static uint64 GetHugePageSize();
+
+    /**
+     * @brief Reserves address space without backing it with memory.
+     * @param size Size in bytes, multiple of the page size.
+     * @return Pointer to the reserved range, null on failure.
+    */
+    static void* Reserve(uint64 size);
+
+    /**
+     * @brief Backs a reserved range with read/write memory.
+     * @param address Page aligned address inside a reserved range.
+     * @param size Size in bytes, multiple of the page size.
+     * @return True on success.
+    */
+    static bool Commit(void* address, uint64 size);
+
+    /**
+     * @brief Gives the memory of a committed range back, keeping the range reserved.
+     * @param address Page aligned address inside a reserved range.
+     * @param size Size in bytes, multiple of the page size.
+    */
+    static void Decommit(void* address, uint64 size);
+
+    /**
+     * @brief Asks the operating system to back a range with huge pages.
+     * @param address Huge page aligned address inside a reserved range.
+     * @param size Size in bytes, multiple of the huge page size.
+     * @return True if the hint was accepted, the range keeps normal pages otherwise.
+    */
+    static bool AdviseHugePages(void* address, uint64 size);
+
+    /**
+     * @brief Reserves and commits a read/write range.
+     * @param size Size in bytes, multiple of the page size.
+     * @return Pointer to the mapped range, null on failure.
+    */
+    static void* Map(uint64 size);
+
+    /**
+     * @brief Resizes a range returned by Map without copying its content.
+     * @param address Address returned by Map.
+     * @param oldSize Current size in bytes of the range.
+     * @param size New size in bytes, multiple of the page size.
+     * @param allowMove Whether the range can be moved to another address.
+     * @return Address of the resized range, null when it cannot be resized.
+    */
+    static void* Remap(void* address, uint64 oldSize, uint64 size, bool allowMove);
+
+    /**
+     * @brief Releases a range returned by Reserve or Map.
+     * @param address Address returned by Reserve or Map.
+     * @param size Size in bytes of the whole range.
+    */
+    static void Release(void* address, uint64 size);
+
+    /**
+     * @brief Returns the amount of memory of the process currently resident in physical memory.
+     * @return Resident size in bytes, 0 when it cannot be queried.
+    */
+    static uint64 GetResidentSize();
+};
@@ -0,0 +1,237 @@
+#include "Name.h"
+#include "Memory/Allocators/MemoryArena.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace {
+
+/**
+ * Interned text, allocated once from the table's arena and never moved.
+ */
+struct NameEntry
+{
+    uint64 Hash;
+    uint32 Size;
+    tchar  Text[1];
+};
+
+/**
+ * Open addressing table of ids. A slot holds the high half of its name's hash next to the id,
+ * so a probe rarely reads an entry whose text does not match. Slots are written once, and a
+ * full table is replaced by a larger one, the old one is kept for the readers still probing it.
+ */
+struct NameSlots
+{
+    std::atomic<uint64>* Slots;
+    uint64               Mask;
+};
+
+constexpr uint32 ChunkBits        = 12;
+constexpr uint32 ChunkSize        = 1u << ChunkBits;
+constexpr uint32 MaxChunks        = 4096;
+constexpr uint64 InitialSlotCount = 4096;
+constexpr uint64 HashTagMask      = 0xFFFFFFFF00000000ull;
+
+constexpr NameEntry EmptyEntry = { 0, 0, { 0 } };
+
+uint64
+Mix(uint64 value)
+{
+    value ^= value >> 32;
+    value *= 0xD6E8FEB86659FD93ull;
+    value ^= value >> 32;
+    value *= 0xD6E8FEB86659FD93ull;
+    value ^= value >> 32;
+    return value;
+}
+
+/**
+ * Hashes 8 code units at a time, identifiers are short so most texts are one or two words.
+ */
+uint64
+HashText(const tchar* text, uint32 size)
+{
+    uint64 hash = 0x9E3779B97F4A7C15ull ^ size;
+    uint32 i    = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64 word;
+        memcpy(&word, text + i, 8);
+        hash = ((hash << 5 | hash >> 59) ^ word) * 0x517CC1B727220A95ull;
+    }
+
+    if (i < size) {
+        uint64 word = 0;
+        memcpy(&word, text + i, size - i);
+        hash = ((hash << 5 | hash >> 59) ^ word) * 0x517CC1B727220A95ull;
+    }
+
+    return Mix(hash);
+}
+
+class NameTable
+{
+  public:
+    NameTable()
+      : m_arena(64 * 1024)
+    {
+        m_chunks[0]    = AllocateChunk();
+        m_chunks[0][0] = &EmptyEntry;
+        m_table.store(AllocateSlots(InitialSlotCount), std::memory_order_release);
+    }
+
+    /** Lock free, safe to call while other threads add names.*/
+    uint32 Find(const tchar* text, uint32 size, uint64 hash) const
+    {
+        const NameSlots* table = m_table.load(std::memory_order_acquire);
+        const uint64     tag   = hash & HashTagMask;
+        for (uint64 index = hash & table->Mask;; index = (index + 1) & table->Mask) {
+            const uint64 slot = table->Slots[index].load(std::memory_order_acquire);
+            if (slot == 0) {
+                return 0;
+            }
+
+            if ((slot & HashTagMask) == tag) {
+                const uint32     id    = static_cast<uint32>(slot);
+                const NameEntry* entry = GetEntry(id);
+                if (entry->Size == size && memcmp(entry->Text, text, size) == 0) {
+                    return id;
+                }
+            }
+        }
+    }
+
+    uint32 FindOrAdd(const tchar* text, uint32 size)
+    {
+        const uint64 hash = HashText(text, size);
+        if (const uint32 id = Find(text, size, hash)) {
+            return id;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        // Another thread may have added the text since the lock free lookup.
+        if (const uint32 id = Find(text, size, hash)) {
+            return id;
+        }
+
+        AE_ASSERT(Utf8::IsValid(text, size));
+
+        const uint32 id = m_count.load(std::memory_order_relaxed) + 1;
+        AE_ASSERT(id < ChunkSize * MaxChunks);
+
+        NameEntry* entry = reinterpret_cast<NameEntry*>(m_arena.Allocate(offsetof(NameEntry, Text) + size + 1, alignof(NameEntry)));
+
+        entry->Hash       = hash;
+        entry->Size       = size;
+        entry->Text[size] = 0;
+        memcpy(entry->Text, text, size);
+
+        if (!m_chunks[id >> ChunkBits]) {
+            m_chunks[id >> ChunkBits] = AllocateChunk();
+        }
+        m_chunks[id >> ChunkBits][id & (ChunkSize - 1)] = entry;
+
+        // Tables are at most half full, so probes stay short.
+        NameSlots* table = m_table.load(std::memory_order_relaxed);
+        if (static_cast<uint64>(id) * 2 > table->Mask + 1) {
+            NameSlots* grown = AllocateSlots((table->Mask + 1) * 2);
+            for (uint32 i = 1; i < id; i++) {
+                Insert(grown, GetEntry(i)->Hash, i);
+            }
+            m_table.store(grown, std::memory_order_release);
+            table = grown;
+        }
+
+        // Publishing the slot makes the entry visible to the lock free lookups.
+        m_count.store(id, std::memory_order_release);
+        Insert(table, hash, id);
+        return id;
+    }
+
+    const NameEntry* GetEntry(uint32 id) const
+    {
+        AE_ASSERT(id <= m_count.load(std::memory_order_acquire));
+        return m_chunks[id >> ChunkBits][id & (ChunkSize - 1)];
+    }
+
+    uint32 GetCount() const { return m_count.load(std::memory_order_acquire); }
+
+  private:
+    static void Insert(NameSlots* table, uint64 hash, uint32 id)
+    {
+        uint64 index = hash & table->Mask;
+        while (table->Slots[index].load(std::memory_order_relaxed) != 0) {
+            index = (index + 1) & table->Mask;
+        }
+        table->Slots[index].store((hash & HashTagMask) | id, std::memory_order_release);
+    }
+
+    const NameEntry** AllocateChunk()
+    {
+        void* chunk = m_arena.Allocate(ChunkSize * sizeof(NameEntry*), MemoryUtils::CacheLineAlignment);
+        return reinterpret_cast<const NameEntry**>(chunk);
+    }
+
+    NameSlots* AllocateSlots(uint64 count)
+    {
+        void* slots = m_arena.Allocate(count * sizeof(std::atomic<uint64>), MemoryUtils::CacheLineAlignment);
+        memset(slots, 0, count * sizeof(std::atomic<uint64>));
+
+        NameSlots* table = reinterpret_cast<NameSlots*>(m_arena.Allocate(sizeof(NameSlots), alignof(NameSlots)));
+        table->Slots     = reinterpret_cast<std::atomic<uint64>*>(slots);
+        table->Mask      = count - 1;
+        return table;
+    }
+
+    std::mutex              m_mutex;
+    MemoryArena             m_arena;
+    std::atomic<NameSlots*> m_table { nullptr };
+    std::atomic<uint32>     m_count { 0 };
+    const NameEntry**       m_chunks[MaxChunks] = {};
+};
+
+NameTable&
+GetNameTable()
+{
+    static NameTable table;
+    return table;
+}
+
+} // namespace
+
+Name::Name(const tchar* text)
+  : Name(text, text ? static_cast<uint32>(strlen(reinterpret_cast<const char*>(text))) : 0)
+{}
+
+Name::Name(const tchar* text, uint32 size)
+  : m_id(size ? GetNameTable().FindOrAdd(text, size) : 0)
+{}
+
+Name
+Name::Find(const tchar* text, uint32 size)
+{
+    Name result;
+    if (size) {
+        result.m_id = GetNameTable().Find(text, size, HashText(text, size));
+    }
+    return result;
+}
+
+uint32
+Name::GetCount()
+{
+    return GetNameTable().GetCount();
+}
+
+const tchar*
+Name::GetText() const
+{
+    return GetNameTable().GetEntry(m_id)->Text;
+}
+
+uint32
+Name::GetSize() const
+{
+    return GetNameTable().GetEntry(m_id)->Size;
+}
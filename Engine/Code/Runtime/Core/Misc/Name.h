@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Containers/AnvilString.h"
+#include "Misc/StdHash.h"
+
+/**
+ * @brief Identifier interned in the global name table.
+ * A name is a 32 bit id, so comparing, hashing and copying names are integer operations.
+ * Each distinct text is stored once for the lifetime of the program and names are never
+ * removed from the table. Looking up a name that is already in the table takes no lock,
+ * only adding a new name does. Names compare by text equality, they are case sensitive.
+ * The default name is the empty name, with id 0.
+*/
+class Name
+{
+  public:
+    /**
+     * @brief Default constructor, the empty name.
+    */
+    constexpr Name() = default;
+
+    /**
+     * @brief Interns a null terminated text.
+     * @param text Valid UTF-8 text, can be null.
+    */
+    explicit Name(const tchar* text);
+
+    /**
+     * @brief Interns a range of code units.
+     * @param text Valid UTF-8 code units.
+     * @param size Number of code units.
+    */
+    Name(const tchar* text, uint32 size);
+
+    explicit Name(const String& text)
+      : Name(text.GetData(), text.IsEmpty() ? 0 : text.GetSize() - 1)
+    {}
+
+    /**
+     * @brief Looks a text up without adding it to the table.
+     * @param text Valid UTF-8 code units.
+     * @param size Number of code units.
+     * @return The name of the text, the empty name if the text was never interned.
+    */
+    static Name Find(const tchar* text, uint32 size);
+
+    /**
+     * @brief Returns the number of names in the table, the empty name excluded.
+     * @return The number of interned names.
+    */
+    static uint32 GetCount();
+
+    /**
+     * @brief Returns the id of the name, unique to its text for the lifetime of the program.
+     * @return The id, 0 for the empty name.
+    */
+    constexpr uint32 GetId() const { return m_id; }
+
+    /**
+     * @brief Returns the interned text, which is never moved or freed.
+     * @return The null terminated text.
+    */
+    const tchar* GetText() const;
+
+    /**
+     * @brief Returns the number of code units of the text, null terminator excluded.
+     * @return Size of the text.
+    */
+    uint32 GetSize() const;
+
+    /**
+     * @brief Checks if this is the empty name.
+     * @return True if the name is empty, false otherwise.
+    */
+    constexpr bool IsEmpty() const { return m_id == 0; }
+
+    constexpr bool operator==(const Name& other) const { return m_id == other.m_id; }
+    constexpr bool operator!=(const Name& other) const { return m_id != other.m_id; }
+
+    /** Orders names by id, which is the order they were first interned in, not the order of their texts.*/
+    constexpr bool operator<(const Name& other) const { return m_id < other.m_id; }
+
+  private:
+    uint32 m_id = 0;
+};
+
+template<>
+struct TStdHash<Name>
+{
+    using ResultType = uint32;
+    ResultType operator()(const Name& value) const { return value.GetId(); }
+};
@@ -4,5 +4,5 @@ template<class T>
 struct TStdHash
 {
     using ResultType = size_t;
-    ResultType operator()(const T& value) { return std::hash<T>()(value); }
+    ResultType operator()(const T& value) const { return std::hash<T>()(value); }
 };
\ No newline at end of file
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "Futex.h"
+
+/**
+ * @brief Lets threads sleep until a lock-free condition may have changed.
+ * The condition lives elsewhere, for example a queue that is not empty. A waiter announces itself,
+ * checks the condition again and only then sleeps, and a notifier changes the condition before
+ * notifying, so a wake cannot be lost between the check and the sleep. Notifying costs a fence and
+ * a load when no thread waits, and it only enters the kernel when a waiter was not woken yet,
+ * so a burst of notifications wakes each sleeping thread once.
+*/
+class EventCount
+{
+  public:
+    /** Number of times Await checks the condition before the thread sleeps.*/
+    static constexpr uint32 SpinCount = 64;
+
+    /**
+     * @brief Announces that the calling thread is about to wait.
+     * The condition must be checked after this call, then either Wait or CancelWait must be called.
+     * @return Key passed to Wait.
+    */
+    uint32 PrepareWait()
+    {
+        // The waiter is counted and reads the epoch in one operation, so any later notification changes its key.
+        const uint64 state = m_state.fetch_add(1, std::memory_order_relaxed);
+
+        // Pairs with the fence of the notifiers: either they see this waiter, or the next check sees their change.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return static_cast<uint32>(state >> EpochShift);
+    }
+
+    /**
+     * @brief Withdraws a PrepareWait, the condition was met.
+    */
+    void CancelWait() { RemoveWaiter(); }
+
+    /**
+     * @brief Sleeps until a notification sent after PrepareWait.
+     * @param key Key returned by PrepareWait.
+    */
+    void Wait(uint32 key)
+    {
+        while (static_cast<uint32>(m_state.load(std::memory_order_acquire) >> EpochShift) == key) {
+            Futex::Wait(GetEpoch(), key);
+        }
+        RemoveWaiter();
+    }
+
+    /**
+     * @brief Wakes one waiting thread, to be called after changing the condition.
+    */
+    void NotifyOne() { Notify(1); }
+
+    /**
+     * @brief Wakes every waiting thread, to be called after changing the condition.
+    */
+    void NotifyAll() { Notify(~0ull); }
+
+    /**
+     * @brief Wakes waiting threads, to be called after changing the condition.
+     * @param count Maximum number of threads to wake, for example the number of items made available.
+    */
+    void Notify(uint64 count)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        uint64 state = m_state.load(std::memory_order_relaxed);
+        while (GetWaiters(state) > GetPendingWakes(state)) {
+            const uint64 idle  = GetWaiters(state) - GetPendingWakes(state);
+            const uint64 wakes = count < idle ? count : idle;
+            if (m_state.compare_exchange_weak(state, state + wakes * PendingWake + Epoch, std::memory_order_release)) {
+                Futex::Wake(GetEpoch(), static_cast<uint32>(wakes));
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Blocks until a condition is met, spinning shortly before sleeping.
+     * @param condition Function returning true once the thread can go on, it can consume what it checks.
+    */
+    template<class ConditionType>
+    void Await(ConditionType&& condition)
+    {
+        for (uint32 i = 0; i < SpinCount; i++) {
+            if (condition()) {
+                return;
+            }
+            Futex::Pause();
+        }
+
+        for (;;) {
+            const uint32 key = PrepareWait();
+            if (condition()) {
+                CancelWait();
+                return;
+            }
+            Wait(key);
+            if (condition()) {
+                return;
+            }
+        }
+    }
+
+  private:
+    // The state holds the number of waiters in its low 16 bits, the number of wakes sent to waiters that
+    // did not leave yet in the next 16 bits, and the epoch, bumped by every notification, in its high half.
+    static constexpr uint64 PendingWake = uint64(1) << 16;
+    static constexpr uint32 EpochShift  = 32;
+    static constexpr uint64 Epoch       = uint64(1) << EpochShift;
+
+    static constexpr uint64 GetWaiters(uint64 state) { return state & (PendingWake - 1); }
+    static constexpr uint64 GetPendingWakes(uint64 state) { return (state >> 16) & (PendingWake - 1); }
+
+    /** The high half of the state, the word the waiters sleep on.*/
+    std::atomic<uint32>& GetEpoch()
+    {
+        static_assert(sizeof(std::atomic<uint64>) == 2 * sizeof(std::atomic<uint32>), "The epoch must be addressable as a 32 bit word");
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        return reinterpret_cast<std::atomic<uint32>*>(&m_state)[0];
+#else
+        return reinterpret_cast<std::atomic<uint32>*>(&m_state)[1];
+#endif
+    }
+
+    /**
+     * Every leaving waiter counts as one of the pending wakes, whether it was woken or not. A pending wake
+     * always belongs to a waiter that will leave without another notification, so the count can only be
+     * underestimated, which costs a wake, never a lost one.
+     */
+    void RemoveWaiter()
+    {
+        uint64 state = m_state.load(std::memory_order_relaxed);
+        for (;;) {
+            const uint64 waiters = GetWaiters(state) - 1;
+            uint64       pending = GetPendingWakes(state);
+            pending              = pending ? pending - 1 : 0;
+            pending              = pending < waiters ? pending : waiters;
+
+            const uint64 removed = (state & ~(Epoch - 1)) | pending * PendingWake | waiters;
+            if (m_state.compare_exchange_weak(state, removed, std::memory_order_relaxed)) {
+                return;
+            }
+        }
+    }
+
+    std::atomic<uint64> m_state { 0 };
+};
@@ -0,0 +1,55 @@
+#include "Futex.h"
+
+#ifdef AE_WINDOWS
+    #include "OS/Windows/WindowsCommons.h"
+#elif defined(__linux__)
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#else
+    #include <thread>
+#endif
+
+static_assert(sizeof(std::atomic<uint32>) == sizeof(uint32), "Futex words must be plain 32 bit words");
+
+void
+Futex::Wait(const std::atomic<uint32>& word, uint32 expected)
+{
+#ifdef AE_WINDOWS
+    WaitOnAddress(const_cast<std::atomic<uint32>*>(&word), &expected, sizeof(expected), INFINITE);
+#elif defined(__linux__)
+    syscall(SYS_futex, &word, FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+    // No address wait on this platform, the thread gives its time slice away until the word changes.
+    while (word.load(std::memory_order_acquire) == expected) {
+        std::this_thread::yield();
+    }
+#endif
+}
+
+void
+Futex::Wake(std::atomic<uint32>& word, uint32 count)
+{
+#ifdef AE_WINDOWS
+    for (uint32 i = 0; i < count; i++) {
+        WakeByAddressSingle(&word);
+    }
+#elif defined(__linux__)
+    syscall(SYS_futex, &word, FUTEX_WAKE_PRIVATE, count < 0x7FFFFFFF ? count : 0x7FFFFFFF, nullptr, nullptr, 0);
+#else
+    (void)word;
+    (void)count;
+#endif
+}
+
+void
+Futex::WakeAll(std::atomic<uint32>& word)
+{
+#ifdef AE_WINDOWS
+    WakeByAddressAll(&word);
+#elif defined(__linux__)
+    syscall(SYS_futex, &word, FUTEX_WAKE_PRIVATE, 0x7FFFFFFF, nullptr, nullptr, 0);
+#else
+    (void)word;
+#endif
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Types.h"
+
+#include <atomic>
+
+#if AE_SSE2
+    #include <emmintrin.h>
+#endif
+
+/**
+ * @brief Operating system wait on the value of a 32 bit word.
+ * A thread sleeps in the kernel until the word is woken, without a mutex or an event object, so
+ * any atomic can be waited on. Wakes are not counted: a waiter must check its condition again
+ * after Wait returns, which can also happen spuriously.
+*/
+class Futex
+{
+  public:
+    /**
+     * @brief Sleeps while the word holds the expected value.
+     * Returns immediately if the word no longer holds it.
+     * @param word Word to wait on.
+     * @param expected Value the word holds when the caller decided to wait.
+    */
+    static void Wait(const std::atomic<uint32>& word, uint32 expected);
+
+    /**
+     * @brief Wakes threads waiting on the word.
+     * @param word Word the threads wait on.
+     * @param count Maximum number of threads to wake.
+    */
+    static void Wake(std::atomic<uint32>& word, uint32 count = 1);
+
+    /**
+     * @brief Wakes every thread waiting on the word.
+     * @param word Word the threads wait on.
+    */
+    static void WakeAll(std::atomic<uint32>& word);
+
+    /**
+     * @brief Hints the processor that the calling thread is spinning.
+    */
+    static void Pause()
+    {
+#if AE_SSE2
+        _mm_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield");
+#endif
+    }
+};
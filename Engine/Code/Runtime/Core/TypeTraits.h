@@ -41,6 +41,21 @@ template<>          struct TIsFundamental<float>    { enum { Value = true }; };
 template<>          struct TIsFundamental<double>   { enum { Value = true }; };
 // clang-format on
 
+/**
+ * @brief Whether items of type T can be moved to another address by copying their bytes,
+ * without calling their move constructor nor destroying the moved-from items.
+ * True for trivially copyable types, specialize it for types that do not point to
+ * themselves (e.g. types owning a heap allocation) so containers move them with memcpy.
+*/
+template<class T>
+struct TIsTriviallyRelocatable
+{
+    enum
+    {
+        Value = std::is_trivially_copyable<T>::value
+    };
+};
+
 template<class T0, class T1>
 struct TIsSame
 {
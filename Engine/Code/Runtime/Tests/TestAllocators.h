@@ -0,0 +1,1037 @@
+#pragma once
+
+#include "Containers/Array.h"
+#include "Memory/Allocators/BinnedAllocator.h"
+#include "Memory/Allocators/ConcurrentLinearAllocator.h"
+#include "Memory/Allocators/DynamicAllocator.h"
+#include "Memory/Allocators/MemoryArena.h"
+#include "Memory/Allocators/ObjectPool.h"
+#include "Memory/MemoryTrace.h"
+#include "Memory/MemoryTracker.h"
+#include <atomic>
+#include <doctest/doctest.h>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+TEST_SUITE_BEGIN("Memory");
+
+TEST_CASE("[MemoryArena]")
+{
+    SUBCASE("Allocate and Reset")
+    {
+        MemoryArena arena(1024);
+
+        CHECK_EQ(arena.GetUsedSize(), 0);
+        CHECK_EQ(arena.GetReservedSize(), 0);
+
+        uint8* a = reinterpret_cast<uint8*>(arena.Allocate(100));
+        uint8* b = reinterpret_cast<uint8*>(arena.Allocate(100, 64));
+
+        CHECK_EQ(reinterpret_cast<uint64>(a) % 16, 0);
+        CHECK_EQ(reinterpret_cast<uint64>(b) % 64, 0);
+        CHECK_GE(b, a + 100);
+        CHECK_GE(arena.GetUsedSize(), 200);
+        CHECK_EQ(arena.GetReservedSize(), 1024);
+
+        arena.Reset();
+
+        CHECK_EQ(arena.GetUsedSize(), 0);
+        CHECK_EQ(arena.Allocate(100), a);
+    }
+
+    SUBCASE("Multiple blocks are merged on Reset")
+    {
+        MemoryArena arena(1024);
+
+        for (int32 i = 0; i < 10; i++) {
+            memset(arena.Allocate(512), i, 512);
+        }
+
+        CHECK_GE(arena.GetUsedSize(), 10 * 512);
+        CHECK_GT(arena.GetReservedSize(), 1024);
+
+        const uint64 reserved = arena.GetReservedSize();
+        arena.Reset();
+
+        CHECK_EQ(arena.GetReservedSize(), reserved);
+
+        uint8* first = reinterpret_cast<uint8*>(arena.Allocate(512));
+        for (int32 i = 1; i < 10; i++) {
+            CHECK_EQ(reinterpret_cast<uint8*>(arena.Allocate(512)), first + i * 512);
+        }
+    }
+
+    SUBCASE("Reallocate and Free")
+    {
+        MemoryArena arena(1024);
+
+        uint8* a = reinterpret_cast<uint8*>(arena.Allocate(64));
+        memset(a, 7, 64);
+
+        CHECK_EQ(arena.Reallocate(a, 64, 256), a);
+
+        uint8* b = reinterpret_cast<uint8*>(arena.Allocate(64));
+        uint8* c = reinterpret_cast<uint8*>(arena.Reallocate(a, 256, 512));
+
+        CHECK_NE(c, a);
+        CHECK_EQ(c[0], 7);
+        CHECK_EQ(c[63], 7);
+
+        arena.Free(c, 512);
+        CHECK_EQ(arena.Allocate(64), c);
+
+        arena.Free(b, 64);
+        CHECK_NE(arena.Allocate(64), b);
+    }
+}
+
+TEST_CASE("[TArray] Arena allocator")
+{
+    MemoryArena& arena = MemoryArena::GetFrameArena();
+    arena.Reset();
+
+    SUBCASE("Add and Remove")
+    {
+        TArray<int32, DefaultArenaAllocator> u;
+        for (int32 i = 0; i < 100; i++) {
+            u.Add(i);
+        }
+
+        CHECK_EQ(u.GetSize(), 100);
+        CHECK_GE(arena.GetUsedSize(), 100 * sizeof(int32));
+
+        for (int32 i = 0; i < 100; i++) {
+            CHECK_EQ(u[i], i);
+        }
+
+        u.RemoveAt(0, 50);
+
+        CHECK_EQ(u.GetSize(), 50);
+        CHECK_EQ(u[0], 50);
+    }
+
+    SUBCASE("Last allocation grows in place")
+    {
+        TArray<int32, DefaultArenaAllocator> u;
+        u.Reserve(4);
+
+        const int32* data = u.GetData();
+        u.Reserve(1000);
+
+        CHECK_EQ(u.GetData(), data);
+    }
+
+    SUBCASE("Move")
+    {
+        TArray<int32, DefaultArenaAllocator> u = {1, 2, 3};
+        TArray<int32, DefaultArenaAllocator> v(std::move(u));
+
+        CHECK(u.IsEmpty());
+        CHECK_EQ(v.GetSize(), 3);
+        CHECK_EQ(v[2], 3);
+    }
+
+    SUBCASE("Over aligned items")
+    {
+        struct alignas(64) CacheLine
+        {
+            int32 Value;
+        };
+
+        arena.Allocate(4);
+        TArray<CacheLine, DefaultArenaAllocator> u;
+        for (int32 i = 0; i < 100; i++) {
+            u.Add(CacheLine{ i });
+            CHECK_EQ(reinterpret_cast<uintptr_t>(u.GetData()) % 64, 0);
+        }
+        CHECK_EQ(u[99].Value, 99);
+    }
+
+    arena.Reset();
+    CHECK_EQ(arena.GetUsedSize(), 0);
+}
+
+TEST_CASE("[ConcurrentLinearAllocator]")
+{
+    SUBCASE("Allocate and Reset")
+    {
+        ConcurrentLinearAllocator allocator(4 * 1024 * 1024, 4096);
+        CHECK_EQ(allocator.GetUsedSize(), 0);
+        CHECK_EQ(allocator.GetCommittedSize(), 0);
+
+        uint8* a = reinterpret_cast<uint8*>(allocator.Allocate(100));
+        uint8* b = reinterpret_cast<uint8*>(allocator.Allocate(100, 64));
+
+        REQUIRE(a);
+        REQUIRE(b);
+        CHECK_EQ(reinterpret_cast<uint64>(a) % 16, 0);
+        CHECK_EQ(reinterpret_cast<uint64>(b) % 64, 0);
+        CHECK_GE(b, a + 100);
+        CHECK_GE(allocator.GetCommittedSize(), allocator.GetUsedSize());
+
+        // Large blocks are taken from the shared cursor.
+        uint8* large = reinterpret_cast<uint8*>(allocator.Allocate(64 * 1024));
+        REQUIRE(large);
+        memset(large, 1, 64 * 1024);
+
+        allocator.Reset();
+        CHECK_EQ(allocator.GetUsedSize(), 0);
+        CHECK_EQ(allocator.Allocate(100), a);
+    }
+
+    SUBCASE("Reallocate and Free")
+    {
+        ConcurrentLinearAllocator allocator(4 * 1024 * 1024, 4096);
+
+        uint8* a = reinterpret_cast<uint8*>(allocator.Allocate(16));
+        a[0]     = 42;
+
+        // The last allocation grows in place.
+        CHECK_EQ(allocator.Reallocate(a, 16, 256), a);
+
+        uint8* b = reinterpret_cast<uint8*>(allocator.Allocate(16));
+        uint8* c = reinterpret_cast<uint8*>(allocator.Reallocate(a, 256, 512));
+        CHECK_NE(c, a);
+        CHECK_EQ(c[0], 42);
+
+        allocator.Free(c, 512);
+        CHECK_EQ(allocator.Allocate(16), c);
+        allocator.Free(b, 16);
+    }
+
+    SUBCASE("Capacity")
+    {
+        ConcurrentLinearAllocator allocator(1024 * 1024, 4096);
+
+        CHECK(allocator.Allocate(512 * 1024));
+        CHECK_EQ(allocator.Allocate(1024 * 1024), nullptr);
+
+        allocator.Reset();
+        CHECK(allocator.Allocate(1000 * 1024));
+    }
+
+    SUBCASE("Threads")
+    {
+        constexpr uint32 ThreadCount = 8;
+        constexpr uint32 Count       = 5000;
+        constexpr uint32 FrameCount  = 4;
+
+        ConcurrentLinearAllocator allocator(64 * 1024 * 1024, 16 * 1024);
+
+        for (uint32 frame = 0; frame < FrameCount; frame++) {
+            uint32* blocks[ThreadCount][Count];
+
+            std::thread threads[ThreadCount];
+            for (uint32 t = 0; t < ThreadCount; t++) {
+                threads[t] = std::thread([&allocator, &blocks, t]() {
+                    for (uint32 i = 0; i < Count; i++) {
+                        const uint32 size   = 1 + (i * 7 + t) % 64;
+                        uint32*      memory = reinterpret_cast<uint32*>(allocator.Allocate(size * sizeof(uint32), 4));
+                        for (uint32 j = 0; j < size; j++) {
+                            memory[j] = t * Count + i;
+                        }
+                        blocks[t][i] = memory;
+
+                        // A few large blocks go through the shared cursor.
+                        if (i % 1000 == 0) {
+                            memset(allocator.Allocate(32 * 1024), int(t), 32 * 1024);
+                        }
+                    }
+                });
+            }
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+
+            bool intact = true;
+            for (uint32 t = 0; t < ThreadCount; t++) {
+                for (uint32 i = 0; i < Count; i++) {
+                    const uint32 size = 1 + (i * 7 + t) % 64;
+                    intact            = intact && blocks[t][i][0] == t * Count + i && blocks[t][i][size - 1] == t * Count + i;
+                }
+            }
+            CHECK(intact);
+
+            allocator.Reset();
+        }
+    }
+}
+
+TEST_CASE("[TArray] Concurrent frame allocator")
+{
+    constexpr int32 ThreadCount = 4;
+
+    ConcurrentLinearAllocator& allocator = ConcurrentLinearAllocator::GetFrameAllocator();
+    allocator.Reset();
+
+    {
+        TArray<int32, DefaultConcurrentFrameAllocator> results[ThreadCount];
+
+        std::thread threads[ThreadCount];
+        for (int32 t = 0; t < ThreadCount; t++) {
+            threads[t] = std::thread([&results, t]() {
+                for (int32 i = 0; i < 1000; i++) {
+                    results[t].Add(t * 1000 + i);
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        // The arrays outlive the threads that filled them.
+        for (int32 t = 0; t < ThreadCount; t++) {
+            REQUIRE_EQ(results[t].GetSize(), 1000);
+            CHECK_EQ(results[t][0], t * 1000);
+            CHECK_EQ(results[t][999], t * 1000 + 999);
+        }
+
+        CHECK_GE(allocator.GetUsedSize(), ThreadCount * 1000 * sizeof(int32));
+    }
+
+    {
+        struct alignas(64) CacheLine
+        {
+            int32 Value;
+        };
+
+        // Over aligned items.
+        allocator.Allocate(4);
+        TArray<CacheLine, DefaultConcurrentFrameAllocator> u;
+        for (int32 i = 0; i < 100; i++) {
+            u.Add(CacheLine{ i });
+            CHECK_EQ(reinterpret_cast<uintptr_t>(u.GetData()) % 64, 0);
+        }
+        CHECK_EQ(u[99].Value, 99);
+    }
+
+    allocator.Reset();
+}
+
+TEST_CASE("[BinnedAllocator]")
+{
+    SUBCASE("Size classes")
+    {
+        bool aligned = true;
+        bool fits    = true;
+        for (uint64 size = 0; size <= BinnedAllocator::MaxSmallSize; size += 7) {
+            uint8* memory = reinterpret_cast<uint8*>(BinnedAllocator::Allocate(size));
+
+            aligned &= reinterpret_cast<uint64>(memory) % 16 == 0;
+            fits &= BinnedAllocator::GetAllocationSize(memory) >= size;
+
+            memset(memory, 0xAE, size);
+            BinnedAllocator::Free(memory);
+        }
+
+        CHECK(aligned);
+        CHECK(fits);
+    }
+
+    SUBCASE("Alignment")
+    {
+        for (uint64 align = 16; align <= 64 * 1024; align *= 2) {
+            void* small = BinnedAllocator::Allocate(48, align);
+            void* large = BinnedAllocator::Allocate(100 * 1024, align);
+
+            CHECK_EQ(reinterpret_cast<uint64>(small) % align, 0);
+            CHECK_EQ(reinterpret_cast<uint64>(large) % align, 0);
+            CHECK_GE(BinnedAllocator::GetAllocationSize(small), 48);
+            CHECK_GE(BinnedAllocator::GetAllocationSize(large), 100 * 1024);
+
+            BinnedAllocator::Free(small);
+            BinnedAllocator::Free(large);
+        }
+    }
+
+    SUBCASE("Blocks are distinct and recycled")
+    {
+        TArray<uint32*> blocks;
+        for (uint32 i = 0; i < 10000; i++) {
+            uint32* block = reinterpret_cast<uint32*>(BinnedAllocator::Allocate(sizeof(uint32) * (1 + i % 64)));
+            *block        = i;
+            blocks.Add(block);
+        }
+
+        bool intact = true;
+        for (uint32 i = 0; i < 10000; i++) {
+            intact &= *blocks[i] == i;
+            BinnedAllocator::Free(blocks[i]);
+        }
+        CHECK(intact);
+
+        void* first = BinnedAllocator::Allocate(16);
+        BinnedAllocator::Free(first);
+        CHECK_EQ(BinnedAllocator::Allocate(16), first);
+        BinnedAllocator::Free(first);
+    }
+
+    SUBCASE("Cross thread free")
+    {
+        constexpr uint32 count = 4096;
+
+        TArray<void*> blocks;
+        std::thread   producer([&blocks] {
+            for (uint32 i = 0; i < count; i++) {
+                blocks.Add(BinnedAllocator::Allocate(64));
+            }
+        });
+        producer.join();
+
+        std::thread consumer([&blocks] {
+            for (void* block : blocks) {
+                BinnedAllocator::Free(block);
+            }
+        });
+        consumer.join();
+
+        CHECK_EQ(blocks.GetSize(), count);
+    }
+
+    SUBCASE("Reallocate small blocks")
+    {
+        uint8* memory = reinterpret_cast<uint8*>(BinnedAllocator::Allocate(20));
+        memset(memory, 7, 20);
+
+        CHECK_EQ(BinnedAllocator::Reallocate(memory, 20, 30), memory);
+
+        uint8* grown = reinterpret_cast<uint8*>(BinnedAllocator::Reallocate(memory, 30, 1000));
+
+        CHECK_NE(grown, memory);
+        CHECK_EQ(grown[0], 7);
+        CHECK_EQ(grown[19], 7);
+
+        BinnedAllocator::Free(grown);
+    }
+
+    SUBCASE("Reallocate large blocks")
+    {
+        constexpr uint64 size = 1024 * 1024;
+
+        uint8* memory = reinterpret_cast<uint8*>(BinnedAllocator::Allocate(size));
+        for (uint64 i = 0; i < size; i += 4096) {
+            memory[i] = static_cast<uint8>(i >> 12);
+        }
+
+        uint8* grown = reinterpret_cast<uint8*>(BinnedAllocator::Reallocate(memory, size, 64 * size));
+
+        CHECK_GE(BinnedAllocator::GetAllocationSize(grown), 64 * size);
+
+        bool intact = true;
+        for (uint64 i = 0; i < size; i += 4096) {
+            intact &= grown[i] == static_cast<uint8>(i >> 12);
+        }
+        CHECK(intact);
+
+        memset(grown, 9, 64 * size);
+
+        uint8* shrunk = reinterpret_cast<uint8*>(BinnedAllocator::Reallocate(grown, 64 * size, 100));
+
+        CHECK_EQ(shrunk[0], 9);
+        CHECK_EQ(shrunk[99], 9);
+
+        BinnedAllocator::Free(shrunk);
+
+        void* aligned = BinnedAllocator::Allocate(size, 64 * 1024);
+        aligned       = BinnedAllocator::Reallocate(aligned, size, 4 * size, 64 * 1024);
+
+        CHECK_EQ(reinterpret_cast<uint64>(aligned) % (64 * 1024), 0);
+
+        BinnedAllocator::Free(aligned);
+    }
+
+    SUBCASE("Thread allocation count")
+    {
+        const uint64 count = BinnedAllocator::GetThreadAllocationCount();
+        BinnedAllocator::Free(BinnedAllocator::Allocate(32));
+        CHECK_EQ(BinnedAllocator::GetThreadAllocationCount(), count + 1);
+    }
+}
+
+struct PooledObject
+{
+    static inline std::atomic<int32> LiveCount {0};
+
+    int32  Id;
+    double Payload[3];
+
+    explicit PooledObject(int32 id = 0)
+      : Id(id)
+      , Payload {}
+    {
+        LiveCount++;
+    }
+
+    ~PooledObject() { LiveCount--; }
+};
+
+TEST_CASE("[TObjectPool]")
+{
+    PooledObject::LiveCount = 0;
+
+    SUBCASE("Allocate and Free")
+    {
+        TObjectPool<PooledObject> pool;
+        CHECK_EQ(pool.GetCapacity(), 0);
+
+        PooledObject* a = pool.Allocate(1);
+        PooledObject* b = pool.Allocate(2);
+
+        CHECK_EQ(a->Id, 1);
+        CHECK_EQ(b->Id, 2);
+        CHECK_NE(a, b);
+        CHECK_EQ(PooledObject::LiveCount, 2);
+        CHECK_EQ(pool.GetCapacity(), pool.GetObjectsPerChunk());
+        CHECK_EQ(reinterpret_cast<uint64>(a) % alignof(PooledObject), 0);
+
+        pool.Free(a);
+        CHECK_EQ(PooledObject::LiveCount, 1);
+
+        // The last freed object is recycled first.
+        CHECK_EQ(pool.Allocate(3), a);
+        CHECK_EQ(a->Id, 3);
+    }
+
+    SUBCASE("Many chunks")
+    {
+        {
+            TObjectPool<PooledObject> pool(1024);
+
+            PooledObject* objects[1000];
+            for (int32 i = 0; i < 1000; i++) {
+                objects[i] = pool.Allocate(i);
+            }
+
+            CHECK_GE(pool.GetCapacity(), 1000);
+            CHECK_GT(pool.GetCapacity() / pool.GetObjectsPerChunk(), 1);
+
+            for (int32 i = 0; i < 1000; i += 2) {
+                pool.Free(objects[i]);
+            }
+            CHECK_EQ(PooledObject::LiveCount, 500);
+
+            for (int32 i = 1; i < 1000; i += 2) {
+                CHECK_EQ(objects[i]->Id, i);
+            }
+        }
+
+        // Objects still alive are destroyed with the pool.
+        CHECK_EQ(PooledObject::LiveCount, 0);
+    }
+
+    SUBCASE("Handles")
+    {
+        TObjectPool<PooledObject> pool;
+
+        using Handle = TObjectPool<PooledObject>::Handle;
+
+        CHECK_EQ(pool.Get(Handle()), nullptr);
+
+        Handle a = pool.AllocateHandle(10);
+        Handle b = pool.AllocateHandle(20);
+
+        CHECK_NE(a, b);
+        CHECK_EQ(pool.Get(a)->Id, 10);
+        CHECK_EQ(pool.Get(b)->Id, 20);
+        CHECK_EQ(pool.GetHandle(pool.Get(b)), b);
+
+        pool.Free(a);
+        CHECK_EQ(pool.Get(a), nullptr);
+
+        // The slot is reused but the old handle stays stale.
+        Handle c = pool.AllocateHandle(30);
+        CHECK_EQ(c.Index, a.Index);
+        CHECK_NE(c.Generation, a.Generation);
+        CHECK_EQ(pool.Get(a), nullptr);
+        CHECK_EQ(pool.Get(c)->Id, 30);
+
+        Handle outOfRange;
+        outOfRange.Index      = 1 << 30;
+        outOfRange.Generation = 1;
+        CHECK_EQ(pool.Get(outOfRange), nullptr);
+    }
+
+    SUBCASE("Thread caches")
+    {
+        constexpr int32 ThreadCount = 4;
+        constexpr int32 Count       = 10000;
+
+        TObjectPool<PooledObject, true> pool;
+        PooledObject*                   objects[ThreadCount][64];
+
+        std::thread threads[ThreadCount];
+        for (int32 t = 0; t < ThreadCount; t++) {
+            threads[t] = std::thread([&pool, &objects, t]() {
+                TObjectPool<PooledObject, true>::ThreadCache cache(pool, 32);
+
+                for (int32 i = 0; i < Count; i++) {
+                    PooledObject*& object = objects[t][i % 64];
+                    if (i >= 64) {
+                        cache.Free(object);
+                    }
+                    object = cache.Allocate(i);
+                }
+                for (PooledObject* object : objects[t]) {
+                    cache.Free(object);
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        CHECK_EQ(PooledObject::LiveCount, 0);
+        CHECK_LE(pool.GetCapacity(), ThreadCount * (64 + 32) + pool.GetObjectsPerChunk() * ThreadCount);
+
+        TObjectPool<PooledObject, true>::Handle handle = pool.AllocateHandle(7);
+        CHECK_EQ(pool.Get(handle)->Id, 7);
+        pool.Free(handle);
+    }
+}
+
+TEST_CASE("[TDynamicAllocator]")
+{
+    using StackAllocator = TDynamicAllocator<uint64, uint32>;
+
+    SUBCASE("Allocate and Pop")
+    {
+        StackAllocator stack(1024);
+        CHECK_EQ(stack.GetCapacity(), 0);
+
+        uint64* a = stack.Allocate(16);
+        uint64* b = stack.Allocate(16);
+        CHECK_EQ(b, a + 16);
+        CHECK_EQ(stack.GetSize(), 32);
+        CHECK_EQ(stack.GetCapacity(), 128);
+
+        stack.Pop(16);
+        CHECK_EQ(stack.GetSize(), 16);
+        CHECK_EQ(stack.Allocate(8), b);
+
+        // Only the most recent allocation is reclaimed.
+        stack.Deallocate(a, 16);
+        CHECK_EQ(stack.GetSize(), 24);
+        stack.Deallocate(b, 8);
+        CHECK_EQ(stack.GetSize(), 16);
+    }
+
+    SUBCASE("Pointers stay valid")
+    {
+        StackAllocator stack(1024);
+
+        uint64* items[100];
+        for (uint32 i = 0; i < 100; i++) {
+            items[i] = stack.Allocate(i + 1);
+            for (uint32 j = 0; j <= i; j++) {
+                items[i][j] = i;
+            }
+        }
+
+        CHECK_EQ(stack.GetSize(), 5050);
+        CHECK_GE(stack.GetCapacity(), 5050);
+
+        for (uint32 i = 0; i < 100; i++) {
+            CHECK_EQ(items[i][0], i);
+            CHECK_EQ(items[i][i], i);
+        }
+
+        // Allocations larger than a chunk get their own chunk.
+        uint64* large = stack.Allocate(1000);
+        large[999]    = 1;
+        CHECK_EQ(items[99][99], 99);
+    }
+
+    SUBCASE("Markers")
+    {
+        StackAllocator stack(1024);
+
+        stack.Allocate(100);
+        const StackAllocator::Marker marker = stack.GetMarker();
+
+        uint64* first = stack.Allocate(100);
+        stack.Allocate(500);
+        const uint32 capacity = stack.GetCapacity();
+
+        stack.Reset(marker);
+        CHECK_EQ(stack.GetSize(), 100);
+
+        // Rolled back chunks are reused.
+        CHECK_EQ(stack.Allocate(100), first);
+        stack.Allocate(500);
+        CHECK_EQ(stack.GetCapacity(), capacity);
+
+        stack.Reset();
+        CHECK_EQ(stack.GetSize(), 0);
+        CHECK_EQ(stack.GetCapacity(), capacity);
+    }
+
+    SUBCASE("Scoped markers")
+    {
+        StackAllocator& stack = StackAllocator::GetThreadAllocator();
+        const uint32    size  = stack.GetSize();
+
+        {
+            StackAllocator::ScopedMarker scope;
+            stack.Allocate(64);
+
+            {
+                StackAllocator::ScopedMarker innerScope(stack);
+                stack.Allocate(100000);
+                CHECK_EQ(stack.GetSize(), size + 100064);
+            }
+
+            CHECK_EQ(stack.GetSize(), size + 64);
+        }
+
+        CHECK_EQ(stack.GetSize(), size);
+
+        // Every thread has its own allocator.
+        StackAllocator* otherStack = nullptr;
+        std::thread([&otherStack]() { otherStack = &StackAllocator::GetThreadAllocator(); }).join();
+        CHECK_NE(otherStack, &stack);
+    }
+}
+
+TEST_CASE("[TArray] Huge page allocator")
+{
+    using HugePageArray = TArray<int64, THugePageAllocator<uint64, 1024ull * 1024 * 1024>>;
+
+    SUBCASE("Items never move")
+    {
+        HugePageArray u;
+        u.Add(0);
+
+        const int64* data = u.GetData();
+
+        CHECK_EQ(reinterpret_cast<uint64>(data) % PlatformMemory::GetHugePageSize(), 0);
+        CHECK_EQ(u.GetCapacity() * sizeof(int64) % PlatformMemory::GetHugePageSize(), 0);
+
+        for (int64 i = 1; i < 1000000; i++) {
+            u.Add(i);
+        }
+
+        CHECK_EQ(u.GetData(), data);
+        CHECK_EQ(u.GetSize(), 1000000);
+
+        bool intact = true;
+        for (int64 i = 0; i < 1000000; i++) {
+            intact &= u[i] == i;
+        }
+        CHECK(intact);
+    }
+
+    SUBCASE("Shrink and Clear")
+    {
+        HugePageArray u;
+        u.Resize(1000000);
+        u.Resize(10);
+        u.ShrinkToFit();
+
+        CHECK_EQ(u.GetSize(), 10);
+        CHECK_EQ(u.GetCapacity(), PlatformMemory::GetHugePageSize() / sizeof(int64));
+
+        u.Clear(true);
+
+        CHECK_EQ(u.GetCapacity(), 0);
+        CHECK_EQ(u.GetData(), nullptr);
+    }
+
+    SUBCASE("Move")
+    {
+        HugePageArray u = {1, 2, 3};
+        HugePageArray v(std::move(u));
+
+        CHECK(u.IsEmpty());
+        CHECK_EQ(v.GetSize(), 3);
+        CHECK_EQ(v[2], 3);
+    }
+}
+
+TEST_CASE("[MemoryUtils] Construct elements")
+{
+    std::string* items = static_cast<std::string*>(MemoryUtils::AllocateAligned(3 * sizeof(std::string), alignof(std::string)));
+
+    MemoryUtils::ConstructElements(items, 3, std::string("Lorem ipsum dolor sit amet"));
+    for (int32 i = 0; i < 3; i++) {
+        CHECK_EQ(items[i], "Lorem ipsum dolor sit amet");
+    }
+    MemoryUtils::DestroyItems(items, 3);
+
+    std::string text("consectetur adipiscing elit");
+    MemoryUtils::ConstructElement(items, std::move(text));
+    CHECK_EQ(items[0], "consectetur adipiscing elit");
+    MemoryUtils::DestroyItems(items, 1);
+
+    MemoryUtils::FreeAligned(items);
+}
+
+#if AE_MEMORY_TRACKING
+
+TEST_CASE("[MemoryTracker]")
+{
+    const uint16 tag = MemoryTracker::RegisterTag("TestMemoryTracker");
+
+    CHECK_NE(tag, MemoryTracker::UntaggedTag);
+    CHECK_EQ(MemoryTracker::RegisterTag("TestMemoryTracker"), tag);
+    CHECK_EQ(strcmp(MemoryTracker::GetTagName(tag), "TestMemoryTracker"), 0);
+    CHECK_EQ(MemoryTracker::GetCurrentTag(), MemoryTracker::UntaggedTag);
+
+    SUBCASE("Scope")
+    {
+        {
+            MemoryTagScope scope(tag);
+            CHECK_EQ(MemoryTracker::GetCurrentTag(), tag);
+        }
+        CHECK_EQ(MemoryTracker::GetCurrentTag(), MemoryTracker::UntaggedTag);
+
+        {
+            AE_MEMORY_TAG_SCOPE("TestMemoryTracker");
+            CHECK_EQ(MemoryTracker::GetCurrentTag(), tag);
+        }
+        CHECK_EQ(MemoryTracker::GetCurrentTag(), MemoryTracker::UntaggedTag);
+    }
+
+    SUBCASE("Live and peak bytes")
+    {
+        const MemoryTagStats before = MemoryTracker::GetTagStats(tag);
+
+        void* a;
+        void* b;
+        {
+            MemoryTagScope scope(tag);
+            a = MemoryUtils::AllocateAligned(1000);
+            b = MemoryUtils::AllocateAligned(3000, 64);
+        }
+        CHECK_EQ(reinterpret_cast<uint64>(b) % 64, 0);
+
+        MemoryTagStats stats = MemoryTracker::GetTagStats(tag);
+        CHECK_EQ(stats.LiveBytes - before.LiveBytes, 4000);
+        CHECK_EQ(stats.LiveAllocations - before.LiveAllocations, 2);
+        CHECK_EQ(stats.TotalAllocations - before.TotalAllocations, 2);
+        CHECK_GE(stats.PeakBytes, before.LiveBytes + 4000);
+
+        // Reallocations and frees are attributed to the allocation's tag, whatever the current one.
+        a = MemoryUtils::ReallocateAligned(a, 1000, 5000);
+        stats = MemoryTracker::GetTagStats(tag);
+        CHECK_EQ(stats.LiveBytes - before.LiveBytes, 8000);
+        CHECK_EQ(stats.Reallocations - before.Reallocations, 1);
+
+        MemoryUtils::FreeAligned(a);
+        MemoryUtils::FreeAligned(b);
+
+        stats = MemoryTracker::GetTagStats(tag);
+        CHECK_EQ(stats.LiveBytes, before.LiveBytes);
+        CHECK_EQ(stats.LiveAllocations, before.LiveAllocations);
+        CHECK_GE(stats.PeakBytes, before.LiveBytes + 8000);
+    }
+
+    SUBCASE("Threads")
+    {
+        const MemoryTagStats before = MemoryTracker::GetTagStats(tag);
+
+        constexpr int32 ThreadCount = 4;
+        void*           blocks[ThreadCount][100];
+
+        std::thread threads[ThreadCount];
+        for (int32 i = 0; i < ThreadCount; i++) {
+            threads[i] = std::thread([&, i]() {
+                AE_MEMORY_TAG_SCOPE("TestMemoryTracker");
+                for (void*& block : blocks[i]) {
+                    block = MemoryUtils::AllocateAligned(1024);
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        MemoryTagStats stats = MemoryTracker::GetTagStats(tag);
+        CHECK_EQ(stats.LiveBytes - before.LiveBytes, ThreadCount * 100 * 1024);
+        CHECK_EQ(stats.LiveAllocations - before.LiveAllocations, ThreadCount * 100);
+        CHECK_GE(stats.PeakBytes, before.LiveBytes + ThreadCount * 100 * 1024);
+
+        // Blocks are freed by another thread than the one that allocated them.
+        for (auto& threadBlocks : blocks) {
+            for (void* block : threadBlocks) {
+                MemoryUtils::FreeAligned(block);
+            }
+        }
+
+        stats = MemoryTracker::GetTagStats(tag);
+        CHECK_EQ(stats.LiveBytes, before.LiveBytes);
+        CHECK_EQ(stats.LiveAllocations, before.LiveAllocations);
+    }
+
+    SUBCASE("Size histogram")
+    {
+        const uint64 before = MemoryTracker::GetSizeHistogram(20);
+
+        void* memory = MemoryUtils::AllocateAligned(1 << 20);
+        MemoryUtils::FreeAligned(memory);
+
+        CHECK_EQ(MemoryTracker::GetSizeHistogram(20) - before, 1);
+    }
+
+    SUBCASE("Container growth")
+    {
+        const MemoryTagStats before = MemoryTracker::GetTagStats(tag);
+
+        MemoryTagScope scope(tag);
+
+        TArray<int32> u;
+        for (int32 i = 0; i < 1000; i++) {
+            u.Add(i);
+        }
+
+        const MemoryTagStats stats  = MemoryTracker::GetTagStats(tag);
+        const uint64         growth = stats.ContainerGrowths - before.ContainerGrowths;
+        CHECK_GT(growth, 1);
+        CHECK_LT(growth, 1000);
+        CHECK_EQ(stats.TotalAllocations - before.TotalAllocations + stats.Reallocations - before.Reallocations, growth);
+    }
+
+    SUBCASE("Dump")
+    {
+        const char* path = "TestMemoryTracker.txt";
+        CHECK(MemoryTracker::Dump(path));
+
+        FILE* file = fopen(path, "r");
+        REQUIRE(file);
+
+        char contents[4096] = {};
+        fread(contents, 1, sizeof(contents) - 1, file);
+        fclose(file);
+        remove(path);
+
+        CHECK(strstr(contents, "TestMemoryTracker"));
+        CHECK(strstr(contents, "Total"));
+    }
+}
+
+TEST_CASE("[MemoryTrace]")
+{
+    const char* path = "TestMemoryTrace.aetrace";
+
+    REQUIRE(MemoryTrace::BeginCapture(path));
+    CHECK(MemoryTrace::IsCapturing());
+
+    void* a = MemoryUtils::AllocateAligned(100);
+    void* b = MemoryUtils::AllocateAligned(5000, 256);
+    void* c = MemoryUtils::ReallocateAligned(a, 100, 200000);
+
+    void* d = nullptr;
+    std::thread([&d]() { d = MemoryUtils::AllocateAligned(48); }).join();
+
+    MemoryUtils::FreeAligned(b);
+    MemoryUtils::FreeAligned(c);
+    MemoryUtils::FreeAligned(d);
+
+    MemoryTrace::EndCapture();
+    CHECK_FALSE(MemoryTrace::IsCapturing());
+
+    void* untraced = MemoryUtils::AllocateAligned(100);
+    MemoryUtils::FreeAligned(untraced);
+
+    MemoryTraceReader reader;
+    REQUIRE(reader.Open(path));
+
+    MemoryTraceEvent events[8];
+    int32            count = 0;
+    while (count < 8 && reader.Read(events[count])) {
+        count++;
+    }
+    remove(path);
+
+    REQUIRE_EQ(count, 7);
+
+    CHECK_EQ(events[0].Type, EMemoryTraceEvent::Allocate);
+    CHECK_EQ(events[0].Address, reinterpret_cast<uint64>(a));
+    CHECK_EQ(events[0].Size, 100);
+    CHECK_EQ(events[0].Align, 16);
+
+    CHECK_EQ(events[1].Type, EMemoryTraceEvent::Allocate);
+    CHECK_EQ(events[1].Address, reinterpret_cast<uint64>(b));
+    CHECK_EQ(events[1].Size, 5000);
+    CHECK_EQ(events[1].Align, 256);
+    CHECK_EQ(events[1].ThreadId, events[0].ThreadId);
+
+    CHECK_EQ(events[2].Type, EMemoryTraceEvent::Reallocate);
+    CHECK_EQ(events[2].OldAddress, reinterpret_cast<uint64>(a));
+    CHECK_EQ(events[2].Address, reinterpret_cast<uint64>(c));
+    CHECK_EQ(events[2].Size, 200000);
+
+    CHECK_EQ(events[3].Type, EMemoryTraceEvent::Allocate);
+    CHECK_EQ(events[3].Address, reinterpret_cast<uint64>(d));
+    CHECK_NE(events[3].ThreadId, events[0].ThreadId);
+
+    CHECK_EQ(events[4].Type, EMemoryTraceEvent::Free);
+    CHECK_EQ(events[4].Address, reinterpret_cast<uint64>(b));
+    CHECK_EQ(events[5].Address, reinterpret_cast<uint64>(c));
+    CHECK_EQ(events[6].Address, reinterpret_cast<uint64>(d));
+}
+
+TEST_CASE("[MemoryTrace] Threads")
+{
+    constexpr int32 ThreadCount = 4;
+
+    const char* path = "TestMemoryTraceThreads.aetrace";
+    REQUIRE(MemoryTrace::BeginCapture(path));
+
+    // Reallocations release blocks that the other threads immediately get back.
+    std::thread threads[ThreadCount];
+    for (int32 t = 0; t < ThreadCount; t++) {
+        threads[t] = std::thread([t]() {
+            void* blocks[8] = {};
+            for (int32 i = 0; i < 4000; i++) {
+                void*& block = blocks[(i * 7 + t) % 8];
+                if (!block) {
+                    block = MemoryUtils::AllocateAligned(64 + i % 512);
+                } else if (i % 3) {
+                    block = MemoryUtils::ReallocateAligned(block, 0, 64 + (i * 13) % 4096);
+                } else {
+                    MemoryUtils::FreeAligned(block);
+                    block = nullptr;
+                }
+            }
+            for (void* block : blocks) {
+                if (block) {
+                    MemoryUtils::FreeAligned(block);
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    MemoryTrace::EndCapture();
+
+    MemoryTraceReader reader;
+    REQUIRE(reader.Open(path));
+
+    // In trace order, every block is freed or reallocated while it is live and allocated while it is not.
+    std::unordered_map<uint64, uint32> live;
+    MemoryTraceEvent                   event;
+    bool                               ordered = true;
+    while (reader.Read(event)) {
+        if (event.Type != EMemoryTraceEvent::Allocate) {
+            const uint64 address = event.Type == EMemoryTraceEvent::Free ? event.Address : event.OldAddress;
+            auto         block   = live.find(address);
+            ordered              = ordered && block != live.end() && block->second == event.ThreadId;
+            if (block != live.end()) {
+                live.erase(block);
+            }
+        }
+        if (event.Type != EMemoryTraceEvent::Free) {
+            ordered = ordered && live.emplace(event.Address, event.ThreadId).second;
+        }
+    }
+    remove(path);
+
+    CHECK(ordered);
+    CHECK(live.empty());
+}
+
+#endif // AE_MEMORY_TRACKING
+
+TEST_SUITE_END();
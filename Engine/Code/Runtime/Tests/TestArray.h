@@ -4,6 +4,8 @@
 #include "Serialization/MemoryReader.h"
 #include "Serialization/MemoryWriter.h"
 #include <doctest/doctest.h>
+#include <string>
+#include <vector>
 
 struct MyStruct
 {
@@ -30,6 +32,75 @@ struct MyStruct
     }
 };
 
+/** Points to itself, so it must be move constructed to change address.*/
+struct SelfReferencing
+{
+    static inline int32 LiveCount = 0;
+
+    int32            Value;
+    SelfReferencing* Self;
+
+    SelfReferencing(int32 value = 0)
+      : Value(value)
+      , Self(this)
+    {
+        LiveCount++;
+    }
+
+    SelfReferencing(const SelfReferencing& other)
+      : Value(other.Value)
+      , Self(this)
+    {
+        LiveCount++;
+    }
+
+    SelfReferencing(SelfReferencing&& other)
+      : Value(other.Value)
+      , Self(this)
+    {
+        other.Value = -1;
+        LiveCount++;
+    }
+
+    ~SelfReferencing() { LiveCount--; }
+
+    bool IsValid() const { return Self == this; }
+};
+
+/** Owns a heap allocation, opted in to be moved with memcpy.*/
+struct RelocatableHandle
+{
+    static inline int32 MoveCount = 0;
+
+    int32* Value;
+
+    RelocatableHandle(int32 value = 0)
+      : Value(new int32(value))
+    {}
+
+    RelocatableHandle(const RelocatableHandle& other)
+      : Value(new int32(*other.Value))
+    {}
+
+    RelocatableHandle(RelocatableHandle&& other)
+      : Value(other.Value)
+    {
+        other.Value = nullptr;
+        MoveCount++;
+    }
+
+    ~RelocatableHandle() { delete Value; }
+};
+
+template<>
+struct TIsTriviallyRelocatable<RelocatableHandle>
+{
+    enum
+    {
+        Value = true
+    };
+};
+
 TEST_SUITE_BEGIN("Containers");
 
 TEST_CASE("[TArray]")
@@ -311,4 +382,575 @@ TEST_CASE("[TArray]")
     }
 }
 
+TEST_CASE("[TArray] Relocation")
+{
+    static_assert(TIsTriviallyRelocatable<int32>::Value);
+    static_assert(TIsTriviallyRelocatable<TArray<SelfReferencing>>::Value);
+    static_assert(!TIsTriviallyRelocatable<SelfReferencing>::Value);
+
+    auto isValid = [](const auto& u) {
+        for (int32 i = 0; i < int32(u.GetSize()); i++) {
+            if (!u[i].IsValid()) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    SUBCASE("Growth")
+    {
+        {
+            TArray<SelfReferencing> u;
+            for (int32 i = 0; i < 100; i++) {
+                u.Emplace(i);
+            }
+
+            CHECK(isValid(u));
+            CHECK_EQ(u[99].Value, 99);
+            CHECK_EQ(SelfReferencing::LiveCount, 100);
+
+            u.Reserve(1000);
+            CHECK(isValid(u));
+            CHECK_EQ(SelfReferencing::LiveCount, 100);
+        }
+        CHECK_EQ(SelfReferencing::LiveCount, 0);
+    }
+
+    SUBCASE("Insert and RemoveAt")
+    {
+        {
+            TArray<SelfReferencing> u;
+            for (int32 i = 0; i < 10; i++) {
+                u.Emplace(i);
+            }
+
+            u.Insert(3, SelfReferencing(42));
+            u.Insert(0, {SelfReferencing(7), SelfReferencing(8)});
+
+            CHECK_EQ(u.GetSize(), 13);
+            CHECK(isValid(u));
+            CHECK_EQ(u[0].Value, 7);
+            CHECK_EQ(u[2].Value, 0);
+            CHECK_EQ(u[5].Value, 42);
+            CHECK_EQ(u[12].Value, 9);
+
+            u.RemoveAt(1, 4);
+
+            CHECK_EQ(u.GetSize(), 9);
+            CHECK(isValid(u));
+            CHECK_EQ(u[1].Value, 42);
+            CHECK_EQ(u[8].Value, 9);
+            CHECK_EQ(SelfReferencing::LiveCount, 9);
+        }
+        CHECK_EQ(SelfReferencing::LiveCount, 0);
+    }
+
+    SUBCASE("Resize")
+    {
+        {
+            TArray<SelfReferencing> u;
+            for (int32 i = 0; i < 3; i++) {
+                u.Emplace(i);
+            }
+
+            u.Resize(100);
+            CHECK_EQ(u.GetSize(), 100);
+            CHECK(isValid(u));
+            CHECK_EQ(u[2].Value, 2);
+            CHECK_EQ(u[99].Value, 0);
+            CHECK_EQ(SelfReferencing::LiveCount, 100);
+
+            u.Resize(10);
+            CHECK(isValid(u));
+            CHECK_EQ(SelfReferencing::LiveCount, 10);
+
+            // Grows within the capacity.
+            u.Resize(50);
+            CHECK(isValid(u));
+            CHECK_EQ(SelfReferencing::LiveCount, 50);
+        }
+        CHECK_EQ(SelfReferencing::LiveCount, 0);
+    }
+
+    SUBCASE("Inline allocator")
+    {
+        {
+            TArray<SelfReferencing, TInlineAllocator<4>> u;
+            for (int32 i = 0; i < 10; i++) {
+                u.Emplace(i);
+            }
+            CHECK(isValid(u));
+
+            u.RemoveAt(2, 7, false);
+            u.ShrinkToFit();
+
+            CHECK_EQ(u.GetSize(), 3);
+            CHECK_EQ(u.GetCapacity(), 4);
+            CHECK(isValid(u));
+            CHECK_EQ(u[2].Value, 9);
+            CHECK_EQ(SelfReferencing::LiveCount, 3);
+        }
+        CHECK_EQ(SelfReferencing::LiveCount, 0);
+    }
+
+    SUBCASE("Move inline items")
+    {
+        {
+            TArray<SelfReferencing, TInlineAllocator<4>> u;
+            TArray<SelfReferencing, TFixedAllocator<4>>  v;
+            for (int32 i = 0; i < 3; i++) {
+                u.Emplace(i);
+                v.Emplace(i);
+            }
+
+            TArray<SelfReferencing, TInlineAllocator<4>> w(std::move(u));
+            TArray<SelfReferencing, TFixedAllocator<4>>  x(std::move(v));
+            CHECK(u.IsEmpty());
+            CHECK(v.IsEmpty());
+            CHECK(isValid(w));
+            CHECK(isValid(x));
+            CHECK_EQ(w[2].Value, 2);
+            CHECK_EQ(x[2].Value, 2);
+            CHECK_EQ(SelfReferencing::LiveCount, 6);
+
+            u.Emplace(7);
+            v.Emplace(7);
+            u = std::move(w);
+            v = std::move(x);
+            CHECK(isValid(u));
+            CHECK(isValid(v));
+            CHECK_EQ(u[1].Value, 1);
+            CHECK_EQ(v[1].Value, 1);
+            CHECK_EQ(SelfReferencing::LiveCount, 6);
+
+            // Items in the secondary allocator keep their addresses.
+            for (int32 i = 3; i < 10; i++) {
+                u.Emplace(i);
+            }
+            const SelfReferencing* data = u.GetData();
+            w                           = std::move(u);
+            CHECK_EQ(w.GetData(), data);
+            CHECK(isValid(w));
+            CHECK_EQ(SelfReferencing::LiveCount, 13);
+        }
+        CHECK_EQ(SelfReferencing::LiveCount, 0);
+    }
+
+    SUBCASE("Opt-in relocatable type")
+    {
+        RelocatableHandle::MoveCount = 0;
+
+        TArray<RelocatableHandle> u;
+        for (int32 i = 0; i < 100; i++) {
+            u.Emplace(i);
+        }
+        u.Insert(0, RelocatableHandle(-1));
+        u.RemoveAt(50);
+
+        CHECK_EQ(RelocatableHandle::MoveCount, 1);
+        CHECK_EQ(*u[0].Value, -1);
+        CHECK_EQ(*u[50].Value, 50);
+        CHECK_EQ(*u[99].Value, 99);
+    }
+}
+
+struct alignas(32) SimdVector
+{
+    float Lanes[8];
+};
+
+TEST_CASE("[TArray] Aligned heap allocator")
+{
+    SUBCASE("Natural alignment")
+    {
+        TArray<SimdVector> vectors;
+        for (uint32 i = 0; i < 100; i++) {
+            vectors.Add(SimdVector { { float(i) } });
+            CHECK_EQ(reinterpret_cast<uint64>(vectors.GetData()) % alignof(SimdVector), 0);
+        }
+
+        for (uint32 i = 0; i < 100; i++) {
+            CHECK_EQ(vectors[i].Lanes[0], float(i));
+        }
+
+        TArray<SimdVector, TInlineAllocator<2>> inlineVectors;
+        for (uint32 i = 0; i < 8; i++) {
+            inlineVectors.Add(SimdVector { { float(i) } });
+            CHECK_EQ(reinterpret_cast<uint64>(inlineVectors.GetData()) % alignof(SimdVector), 0);
+        }
+    }
+
+    SUBCASE("Cache line alignment")
+    {
+        TArray<uint8, THeapAllocator<uint64, MemoryUtils::CacheLineAlignment>> bytes;
+        for (uint32 i = 0; i < 1000; i++) {
+            bytes.Add(uint8(i));
+            CHECK_EQ(reinterpret_cast<uint64>(bytes.GetData()) % MemoryUtils::CacheLineAlignment, 0);
+        }
+
+        for (uint32 i = 0; i < 1000; i++) {
+            CHECK_EQ(bytes[i], uint8(i));
+        }
+    }
+
+    SUBCASE("Page alignment")
+    {
+        TArray<uint32, THeapAllocator<uint32, MemoryUtils::PageAlignment>> items(10);
+        CHECK_EQ(reinterpret_cast<uint64>(items.GetData()) % MemoryUtils::PageAlignment, 0);
+
+        items.Resize(5000);
+        CHECK_EQ(reinterpret_cast<uint64>(items.GetData()) % MemoryUtils::PageAlignment, 0);
+
+        TArray<uint32, THeapAllocator<uint32, MemoryUtils::PageAlignment>> copy = items;
+        CHECK_EQ(reinterpret_cast<uint64>(copy.GetData()) % MemoryUtils::PageAlignment, 0);
+        CHECK_EQ(copy.GetSize(), 5000);
+    }
+}
+
+TEST_CASE("[TArray] Inline allocator")
+{
+    using InlineArray = TArray<int32, TInlineAllocator<4>>;
+
+    SUBCASE("Default constructor")
+    {
+        InlineArray u;
+
+        CHECK_EQ(u.GetSize(), 0);
+        CHECK_EQ(u.GetCapacity(), 0);
+        CHECK(u.IsEmpty());
+    }
+
+    SUBCASE("Items stay inline")
+    {
+        InlineArray u;
+        u.Add(1);
+        u.Add(2);
+        u.Add(3);
+        u.Add(4);
+
+        CHECK_EQ(u.GetSize(), 4);
+        CHECK_EQ(u.GetCapacity(), 4);
+
+        const uint8* arrayBegin = reinterpret_cast<const uint8*>(&u);
+        const uint8* arrayEnd   = arrayBegin + sizeof(u);
+        const uint8* data       = reinterpret_cast<const uint8*>(u.GetData());
+        CHECK((data >= arrayBegin && data < arrayEnd));
+
+        for (int32 i = 0; i < 4; i++) {
+            CHECK_EQ(u[i], i + 1);
+        }
+    }
+
+    SUBCASE("Spill to secondary allocator")
+    {
+        InlineArray u = {1, 2, 3};
+        for (int32 i = 4; i <= 10; i++) {
+            u.Add(i);
+        }
+
+        CHECK_EQ(u.GetSize(), 10);
+        CHECK_GE(u.GetCapacity(), 10);
+
+        const uint8* arrayBegin = reinterpret_cast<const uint8*>(&u);
+        const uint8* arrayEnd   = arrayBegin + sizeof(u);
+        const uint8* data       = reinterpret_cast<const uint8*>(u.GetData());
+        CHECK_FALSE((data >= arrayBegin && data < arrayEnd));
+
+        for (int32 i = 0; i < 10; i++) {
+            CHECK_EQ(u[i], i + 1);
+        }
+
+        u.RemoveAt(2, 7);
+
+        CHECK_EQ(u.GetSize(), 3);
+        CHECK_EQ(u.GetCapacity(), 4);
+        CHECK_EQ(u[0], 1);
+        CHECK_EQ(u[1], 2);
+        CHECK_EQ(u[2], 10);
+    }
+
+    SUBCASE("Copy and move")
+    {
+        InlineArray u = {1, 2, 3};
+        InlineArray v(u);
+        InlineArray w(std::move(u));
+
+        CHECK_EQ(u.GetSize(), 0);
+        CHECK_EQ(v.GetSize(), 3);
+        CHECK_EQ(w.GetSize(), 3);
+
+        for (int32 i = 0; i < 3; i++) {
+            CHECK_EQ(v[i], i + 1);
+            CHECK_EQ(w[i], i + 1);
+        }
+
+        InlineArray x = {1, 2, 3, 4, 5, 6};
+        v             = std::move(x);
+        w             = v;
+
+        CHECK_EQ(v.GetSize(), 6);
+        CHECK_EQ(w.GetSize(), 6);
+
+        for (int32 i = 0; i < 6; i++) {
+            CHECK_EQ(v[i], i + 1);
+            CHECK_EQ(w[i], i + 1);
+        }
+    }
+
+    SUBCASE("Structs")
+    {
+        TArray<MyStruct, TInlineAllocator<2>> u;
+
+        MyStruct sa;
+        sa.a = 1;
+
+        MyStruct sb;
+        sb.a = 10;
+
+        MyStruct sc;
+        sc.a = 100;
+
+        u.Add(sa);
+        u.Add(sb);
+        u.Insert(1, sc);
+
+        CHECK_EQ(u.GetSize(), 3);
+        CHECK_EQ(u[0].a, 1);
+        CHECK_EQ(u[1].a, 100);
+        CHECK_EQ(u[2].a, 10);
+
+        u.Clear(true);
+
+        CHECK(u.IsEmpty());
+        CHECK_EQ(u.GetCapacity(), 0);
+    }
+}
+
+TEST_CASE("[TArray] Fixed allocator")
+{
+    using FixedArray = TArray<int32, TFixedAllocator<8>>;
+
+    SUBCASE("Default constructor")
+    {
+        FixedArray u;
+
+        CHECK_EQ(u.GetSize(), 0);
+        CHECK_EQ(u.GetCapacity(), 0);
+        CHECK(u.IsEmpty());
+    }
+
+    SUBCASE("Add, Insert and Remove")
+    {
+        FixedArray u;
+        for (int32 i = 0; i < 6; i++) {
+            u.Add(i);
+        }
+
+        CHECK_EQ(u.GetSize(), 6);
+        CHECK_EQ(u.GetCapacity(), 8);
+
+        u.Insert(0, {10, 11});
+
+        CHECK_EQ(u.GetSize(), 8);
+        CHECK_EQ(u.GetCapacity(), 8);
+        CHECK_EQ(u[0], 10);
+        CHECK_EQ(u[1], 11);
+        CHECK_EQ(u[7], 5);
+
+        const uint8* arrayBegin = reinterpret_cast<const uint8*>(&u);
+        const uint8* arrayEnd   = arrayBegin + sizeof(u);
+        const uint8* data       = reinterpret_cast<const uint8*>(u.GetData());
+        CHECK((data >= arrayBegin && data < arrayEnd));
+
+        u.RemoveAt(0, 2);
+
+        CHECK_EQ(u.GetSize(), 6);
+        CHECK_EQ(u.GetCapacity(), 8);
+
+        for (int32 i = 0; i < 6; i++) {
+            CHECK_EQ(u[i], i);
+        }
+    }
+
+    SUBCASE("Copy and move")
+    {
+        FixedArray u = {1, 2, 3};
+        FixedArray v(u);
+        FixedArray w(std::move(u));
+
+        CHECK_EQ(u.GetSize(), 0);
+        CHECK_EQ(v.GetSize(), 3);
+        CHECK_EQ(w.GetSize(), 3);
+
+        for (int32 i = 0; i < 3; i++) {
+            CHECK_EQ(v[i], i + 1);
+            CHECK_EQ(w[i], i + 1);
+        }
+    }
+}
+
+/** Deterministic pseudo random values, the same on every run.*/
+struct SortRandom
+{
+    uint64 State = 1;
+
+    uint64 Next()
+    {
+        State = State * 6364136223846793005ull + 1442695040888963407ull;
+        return State >> 17;
+    }
+};
+
+/** Item sorted by key, the order records where it started.*/
+struct SortKeyed
+{
+    uint64 Key;
+    uint32 Order;
+};
+
+TEST_CASE("[TArray] Sorting")
+{
+    SUBCASE("Sort")
+    {
+        for (uint32 count : { 0u, 1u, 2u, 15u, 17u, 1000u, 100000u }) {
+            SortRandom         random;
+            TArray<int32>      array;
+            std::vector<int32> expected;
+            for (uint32 i = 0; i < count; i++) {
+                const int32 value = static_cast<int32>(random.Next() % 1000) - 500;
+                array.Add(value);
+                expected.push_back(value);
+            }
+
+            array.Sort();
+            std::sort(expected.begin(), expected.end());
+            CHECK(std::equal(array.begin(), array.end(), expected.begin(), expected.end()));
+        }
+    }
+
+    SUBCASE("Sort with a predicate")
+    {
+        // Already sorted, reversed and equal items are the classic quicksort worst cases.
+        TArray<uint32> ascending;
+        TArray<uint32> descending;
+        TArray<uint32> equal;
+        for (uint32 i = 0; i < 50000; i++) {
+            ascending.Add(i);
+            descending.Add(50000 - i);
+            equal.Add(7);
+        }
+
+        const auto greater = [](uint32 a, uint32 b) { return a > b; };
+        ascending.Sort(greater);
+        descending.Sort(greater);
+        equal.Sort(greater);
+        CHECK(std::is_sorted(ascending.begin(), ascending.end(), greater));
+        CHECK(std::is_sorted(descending.begin(), descending.end(), greater));
+        CHECK_EQ(ascending[0], 49999);
+        CHECK_EQ(equal[49999], 7);
+    }
+
+    SUBCASE("Stable sort")
+    {
+        for (uint32 count : { 10u, 1000u, 100000u }) {
+            SortRandom        random;
+            TArray<SortKeyed> array;
+            for (uint32 i = 0; i < count; i++) {
+                array.Add(SortKeyed{ random.Next() % 64, i });
+            }
+
+            array.StableSort([](const SortKeyed& a, const SortKeyed& b) { return a.Key < b.Key; });
+            for (uint32 i = 1; i < count; i++) {
+                CHECK((array[i - 1].Key < array[i].Key || (array[i - 1].Key == array[i].Key && array[i - 1].Order < array[i].Order)));
+            }
+        }
+    }
+
+    SUBCASE("Stable sort of non trivial items with arena scratch")
+    {
+        MemoryArena::GetFrameArena().Reset();
+
+        const auto shorter = [](const std::string& a, const std::string& b) { return a.size() < b.size(); };
+
+        TArray<std::string>      array;
+        std::vector<std::string> expected;
+        for (int32 i = 0; i < 500; i++) {
+            array.Add(std::to_string((i * 7919) % 500));
+            expected.push_back(array[i]);
+        }
+
+        array.StableSort<DefaultArenaAllocator>(shorter);
+        std::stable_sort(expected.begin(), expected.end(), shorter);
+        CHECK(std::equal(array.begin(), array.end(), expected.begin(), expected.end()));
+
+        MemoryArena::GetFrameArena().Reset();
+    }
+
+    SUBCASE("Radix sort of integers")
+    {
+        SortRandom     random;
+        TArray<uint64> unsignedKeys;
+        TArray<int32>  signedKeys;
+        TArray<uint8>  byteKeys;
+        for (uint32 i = 0; i < 20000; i++) {
+            const uint64 value = random.Next();
+            unsignedKeys.Add(value << 17 | value);
+            signedKeys.Add(static_cast<int32>(value));
+            byteKeys.Add(static_cast<uint8>(value));
+        }
+        signedKeys.Add(INT32_MIN);
+        signedKeys.Add(INT32_MAX);
+
+        unsignedKeys.RadixSort();
+        signedKeys.RadixSort();
+        byteKeys.RadixSort();
+        CHECK(std::is_sorted(unsignedKeys.begin(), unsignedKeys.end()));
+        CHECK(std::is_sorted(signedKeys.begin(), signedKeys.end()));
+        CHECK(std::is_sorted(byteKeys.begin(), byteKeys.end()));
+        CHECK_EQ(signedKeys[0], INT32_MIN);
+        CHECK_EQ(signedKeys[signedKeys.GetSize() - 1], INT32_MAX);
+    }
+
+    SUBCASE("Radix sort of floats")
+    {
+        const float    specials[] = { -0.0f, 0.0f, -1.0f, 1.0f, -1e30f, 1e30f, 1e-40f, -1e-40f, -INFINITY, INFINITY };
+        SortRandom     random;
+        TArray<float>  floats;
+        TArray<double> doubles;
+        for (float value : specials) {
+            floats.Add(value);
+            doubles.Add(value);
+        }
+        for (uint32 i = 0; i < 1000; i++) {
+            const float value = static_cast<float>(static_cast<int64>(random.Next() % 2000000) - 1000000) / 1000.0f;
+            floats.Add(value);
+            doubles.Add(value);
+        }
+
+        floats.RadixSort();
+        doubles.RadixSort();
+        CHECK(std::is_sorted(floats.begin(), floats.end()));
+        CHECK(std::is_sorted(doubles.begin(), doubles.end()));
+        CHECK_EQ(floats[0], -INFINITY);
+        CHECK_EQ(doubles[doubles.GetSize() - 1], INFINITY);
+    }
+
+    SUBCASE("Radix sort with a key")
+    {
+        for (uint32 count : { 50u, 100000u }) {
+            SortRandom        random;
+            TArray<SortKeyed> array;
+            for (uint32 i = 0; i < count; i++) {
+                // Only a few bytes differ, the other passes are skipped.
+                array.Add(SortKeyed{ (random.Next() % 300) << 40 | 0xAB, i });
+            }
+
+            array.RadixSort([](const SortKeyed& item) { return item.Key; });
+            for (uint32 i = 1; i < count; i++) {
+                CHECK((array[i - 1].Key < array[i].Key || (array[i - 1].Key == array[i].Key && array[i - 1].Order < array[i].Order)));
+            }
+        }
+    }
+}
+
 TEST_SUITE_END();
@@ -23,269 +23,213 @@ TEST_CASE("[TArray<bool>]")
         TArray<bool> u(v, v + 3);
 
         CHECK_EQ(u.GetSize(), 3);
-        CHECK_EQ(u.GetCapacity(), 3);
+        CHECK_EQ(u.GetCapacity(), 64);
         CHECK_FALSE(u.IsEmpty());
 
-       // CHECK_EQ(u[0], true);
-       // CHECK_EQ(u[1], true);
-       // CHECK_EQ(u[2], false);
+        CHECK_EQ(u[0], true);
+        CHECK_EQ(u[1], true);
+        CHECK_EQ(u[2], false);
 
         SafeDeleteArray(v);
     }
 
     SUBCASE("Copy and List constructor")
     {
-        TArray<int32> u = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
-        TArray<int32> v(u);
+        TArray<bool> u = {true, false, true, true, false, false, true, false, true, true};
+        TArray<bool> v(u);
 
         CHECK_EQ(u.GetSize(), 10);
-        CHECK_EQ(u.GetCapacity(), 10);
-        CHECK_FALSE(u.IsEmpty());
-
         CHECK_EQ(v.GetSize(), 10);
-        CHECK_EQ(v.GetCapacity(), 10);
         CHECK_FALSE(v.IsEmpty());
+        CHECK(u == v);
 
         for (uint32 i = 0; i < 10; i++) {
-            CHECK_EQ(u[i], i + 1);
             CHECK_EQ(v[i], u[i]);
         }
     }
 
     SUBCASE("Move constructor")
     {
-        TArray<int32> u = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
-        TArray<int32> v(std::move(u));
+        TArray<bool> u = {true, false, true};
+        TArray<bool> v(std::move(u));
 
         CHECK_EQ(u.GetSize(), 0);
         CHECK_EQ(u.GetCapacity(), 0);
         CHECK(u.IsEmpty());
 
-        CHECK_EQ(v.GetSize(), 10);
-        CHECK_EQ(v.GetCapacity(), 10);
-        CHECK_FALSE(v.IsEmpty());
-
-        for (uint32 i = 0; i < 10; i++) {
-            CHECK_EQ(v[i], i + 1);
-        }
+        CHECK_EQ(v.GetSize(), 3);
+        CHECK(v[0]);
+        CHECK_FALSE(v[1]);
+        CHECK(v[2]);
     }
 
-    SUBCASE("Copy assignment constructor")
+    SUBCASE("Copy and move assignment")
     {
-        TArray<int32> u = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
-        TArray<int32> v = {11, 12, 13};
+        TArray<bool> u(200, true);
+        TArray<bool> v = {false, true};
 
         v = u;
+        CHECK_EQ(v.GetSize(), 200);
+        CHECK(v == u);
 
-        CHECK_EQ(u.GetSize(), 10);
-        CHECK_EQ(u.GetCapacity(), 10);
-        CHECK_FALSE(u.IsEmpty());
-
-        CHECK_EQ(v.GetSize(), 10);
-        CHECK_EQ(v.GetCapacity(), 10);
-        CHECK_FALSE(v.IsEmpty());
-
-        for (uint32 i = 0; i < 10; i++) {
-            CHECK_EQ(u[i], i + 1);
-            CHECK_EQ(v[i], u[i]);
-        }
-    }
-
-    SUBCASE("Move assignment constructor")
-    {
-        TArray<int32> u = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
-        TArray<int32> v = {11, 12, 13};
-
-        v = std::move(u);
-
-        CHECK_EQ(u.GetSize(), 0);
-        CHECK_EQ(u.GetCapacity(), 0);
-        CHECK(u.IsEmpty());
-
-        CHECK_EQ(v.GetSize(), 10);
-        CHECK_EQ(v.GetCapacity(), 10);
-        CHECK_FALSE(v.IsEmpty());
-
-        for (uint32 i = 0; i < 10; i++) {
-            CHECK_EQ(v[i], i + 1);
-        }
+        TArray<bool> w;
+        w = std::move(v);
+        CHECK(v.IsEmpty());
+        CHECK_EQ(w.CountSetBits(), 200);
     }
 
     SUBCASE("Initial sized constructor")
     {
-        TArray<MyStruct> u(5);
-
-        CHECK_EQ(u.GetSize(), 5);
-        CHECK_EQ(u.GetCapacity(), 5);
-        CHECK_FALSE(u.IsEmpty());
+        TArray<bool> u(100);
+        TArray<bool> v(100, true);
+
+        CHECK_EQ(u.GetSize(), 100);
+        CHECK_EQ(u.GetCapacity(), 128);
+        CHECK_EQ(u.CountSetBits(), 0);
+        CHECK_EQ(v.CountSetBits(), 100);
+        CHECK_EQ(v.GetWordCount(), 2);
+        CHECK_EQ(v.GetData()[1], (uint64(1) << 36) - 1);
     }
 
-    SUBCASE("Emplace")
+    SUBCASE("Add, Set and Pop")
     {
-        TArray<MyStruct> u;
-
-        MyStruct sa;
-        sa.a = 1;
-        sa.b = 2.0f;
-
-        MyStruct sb;
-        sb.a = 10;
-        sb.b = 20.0f;
-
-        MyStruct sc;
-        sc.a = 100;
-        sc.b = 200.0f;
-
-        MyStruct sd;
-        sd.a = 29;
-        sd.b = 19.93f;
-
-        u.Emplace(sa);
-        u.Emplace(sb);
-        u.Emplace(sc);
-        u.Emplace(sd);
-
-        CHECK_EQ(u[0].a, 1);
-        CHECK_EQ(u[1].a, 10);
-        CHECK_EQ(u[2].a, 100);
-        CHECK_EQ(u[3].a, 29);
-
-        u.Add(sa);
-        u.Add(sb);
-        u.Add(std::move(sc));
-        u.Add(sd);
-
-        CHECK_EQ(u[4].a, 1);
-        CHECK_EQ(u[5].a, 10);
-        CHECK_EQ(u[6].a, 100);
-        CHECK_EQ(u[7].a, 29);
-
-        CHECK_EQ(u.GetSize(), 8);
-        CHECK_EQ(u.GetCapacity(), 22);
+        TArray<bool> u;
+        for (uint32 i = 0; i < 150; i++) {
+            CHECK_EQ(u.Add(i % 3 == 0), i);
+        }
+
+        CHECK_EQ(u.GetSize(), 150);
+        CHECK_EQ(u.CountSetBits(), 50);
+
+        u[1] = true;
+        u.Set(3, false);
+        u[2] = u[1];
+        CHECK(u[1]);
+        CHECK(u[2]);
+        CHECK_FALSE(u[3]);
+
+        CHECK_FALSE(u.Pop());
+        CHECK_FALSE(u.Pop());
+        CHECK(u.Pop());
+        CHECK_EQ(u.GetSize(), 147);
+
+        // Popped bits do not come back.
+        u.Add(false);
+        CHECK_FALSE(u[147]);
+        CHECK_EQ(u.CountSetBits(), 50);
     }
 
-    SUBCASE("Insert")
+    SUBCASE("Resize")
     {
-        SUBCASE("Items")
-        {
-            TArray<MyStruct> u;
-
-            MyStruct sa;
-            sa.a = 1;
-            sa.b = 2.0f;
-
-            MyStruct sb;
-            sb.a = 10;
-            sb.b = 20.0f;
-
-            MyStruct sc;
-            sc.a = 100;
-            sc.b = 200.0f;
-
-            MyStruct sd;
-            sd.a = 29;
-            sd.b = 19.93f;
-
-            u.Insert(0, sa);
-            u.Insert(1, sb);
-            u.Insert(2, sc);
-            u.Insert(1, std::move(sd));
+        TArray<bool> u(70, true);
+        u.Resize(10);
+        CHECK_EQ(u.GetSize(), 10);
+        CHECK_EQ(u.CountSetBits(), 10);
 
-            CHECK_EQ(u[0].a, 1);
-            CHECK_EQ(u[1].a, 29);
-            CHECK_EQ(u[2].a, 10);
-            CHECK_EQ(u[3].a, 100);
+        u.Resize(300);
+        CHECK_EQ(u.GetSize(), 300);
+        CHECK_EQ(u.CountSetBits(), 10);
 
-            TArray<uint8> memory;
+        u.Resize(400, true);
+        CHECK_EQ(u.CountSetBits(), 110);
+        CHECK_EQ(u.FindFirstSet(10), 300);
 
-            MemoryWriter ar(memory);
-            Serialize(ar, u, "testArray", "Test Array");
-        }
-
-        SUBCASE("List")
-        {
-            TArray<int32> v = {1, 2, 3, 4};
-
-            v.Insert(2, {5, 6, 7, 8});
-
-            CHECK_EQ(v.GetSize(), 8);
-            CHECK_EQ(v[0], 1);
-            CHECK_EQ(v[1], 2);
-            CHECK_EQ(v[2], 5);
-            CHECK_EQ(v[3], 6);
-            CHECK_EQ(v[4], 7);
-            CHECK_EQ(v[5], 8);
-            CHECK_EQ(v[6], 3);
-            CHECK_EQ(v[7], 4);
-        }
+        u.Clear(true);
+        CHECK(u.IsEmpty());
+        CHECK_EQ(u.GetCapacity(), 0);
     }
 
-    SUBCASE("Remove At")
+    SUBCASE("SetRange and ClearRange")
     {
-        TArray<int32> u = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
-        u.RemoveAt(3);
-        u.RemoveAt(3);
-        u.RemoveAt(6);
-
-        CHECK_EQ(u.GetSize(), 7);
-        CHECK_EQ(u.GetCapacity(), 7);
-        CHECK_FALSE(u.IsEmpty());
-
-        CHECK_EQ(u[0], 1);
-        CHECK_EQ(u[1], 2);
-        CHECK_EQ(u[2], 3);
-        CHECK_EQ(u[3], 6);
-        CHECK_EQ(u[4], 7);
-        CHECK_EQ(u[5], 8);
-        CHECK_EQ(u[6], 10);
+        TArray<bool> u(300);
+        u.SetRange(5, 3);
+        CHECK_EQ(u.CountSetBits(), 3);
+        CHECK_EQ(u.GetData()[0], uint64(0xE0));
+
+        u.SetRange(60, 200);
+        CHECK_EQ(u.CountSetBits(), 203);
+        CHECK_FALSE(u[59]);
+        CHECK(u[60]);
+        CHECK(u[259]);
+        CHECK_FALSE(u[260]);
+
+        u.ClearRange(64, 128);
+        CHECK_EQ(u.CountSetBits(), 75);
+        CHECK(u[63]);
+        CHECK_FALSE(u[64]);
+        CHECK_FALSE(u[191]);
+        CHECK(u[192]);
+
+        u.SetRange(0, 300);
+        CHECK_EQ(u.CountSetBits(), 300);
+        u.ClearRange(0, 300);
+        CHECK_EQ(u.CountSetBits(), 0);
     }
 
-    SUBCASE("Remove At Ranged")
+    SUBCASE("Find first set and unset")
     {
-        TArray<int32> u = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
-        u.RemoveAt(3, 3);
-
-        CHECK_EQ(u.GetSize(), 7);
-        CHECK_EQ(u.GetCapacity(), 7);
-        CHECK_FALSE(u.IsEmpty());
-
-        CHECK_EQ(u[0], 1);
-        CHECK_EQ(u[1], 2);
-        CHECK_EQ(u[2], 3);
-        CHECK_EQ(u[3], 7);
-        CHECK_EQ(u[4], 8);
-        CHECK_EQ(u[5], 9);
-        CHECK_EQ(u[6], 10);
+        TArray<bool> u(200);
+        CHECK_EQ(u.FindFirstSet(), (TArray<bool>::SizeType)INVALID_INDEX);
+        CHECK_EQ(u.FindFirstUnset(), 0);
+
+        u.Set(130);
+        u.Set(131);
+        CHECK_EQ(u.FindFirstSet(), 130);
+        CHECK_EQ(u.FindFirstSet(131), 131);
+        CHECK_EQ(u.FindFirstSet(132), (TArray<bool>::SizeType)INVALID_INDEX);
+        CHECK_EQ(u.FindFirstSet(500), (TArray<bool>::SizeType)INVALID_INDEX);
+
+        u.SetRange(0, 200);
+        u.Set(199, false);
+        CHECK_EQ(u.FindFirstUnset(), 199);
+
+        // The bits past the end are never reported as unset.
+        u.Set(199);
+        CHECK_EQ(u.FindFirstUnset(), (TArray<bool>::SizeType)INVALID_INDEX);
     }
 
-    SUBCASE("Resize")
+    SUBCASE("For each set bit")
     {
-        TArray<int32> u = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
-        u.Resize(5);
-
-        CHECK_EQ(u.GetSize(), 5);
-        CHECK_EQ(u.GetCapacity(), 10);
-
-        u.Resize(15);
+        TArray<bool> u(1000);
+        for (uint32 i = 0; i < 1000; i += 7) {
+            u.Set(i);
+        }
 
-        CHECK_EQ(u.GetSize(), 15);
-        CHECK_EQ(u.GetCapacity(), 36);
+        uint32 count = 0;
+        bool   valid = true;
+        u.ForEachSetBit([&](TArray<bool>::SizeType index) { valid = valid && index == count++ * 7; });
+        CHECK(valid);
+        CHECK_EQ(count, 143);
     }
 
-    SUBCASE("Contains, Find and Pop")
+    SUBCASE("Bitwise operations")
     {
-        TArray<int32> u = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
-
-        CHECK(u.Contains(6));
-        CHECK_FALSE(u.Contains(29));
-
-        CHECK_EQ(u.Find(4), 3);
-        CHECK_EQ(u.Find(29), INVALID_INDEX);
-
-        int32 last = u.Pop();
-
-        CHECK_EQ(u.GetSize(), 9);
-        CHECK_EQ(last, 10);
+        TArray<bool> a(130);
+        TArray<bool> b(130);
+        a.SetRange(0, 100);
+        b.SetRange(50, 80);
+
+        CHECK_EQ((a & b).CountSetBits(), 50);
+        CHECK_EQ((a | b).CountSetBits(), 130);
+        CHECK_EQ((a ^ b).CountSetBits(), 80);
+
+        // Inverting keeps the bits past the end cleared.
+        TArray<bool> notA = ~a;
+        CHECK_EQ(notA.CountSetBits(), 30);
+        CHECK_EQ(notA.FindFirstSet(), 100);
+        CHECK_EQ(notA.GetData()[2], uint64(3));
+
+        a &= b;
+        CHECK_EQ(a.FindFirstSet(), 50);
+        a |= notA;
+        CHECK_EQ(a.CountSetBits(), 80);
+        a ^= b;
+        CHECK_EQ(a.CountSetBits(), 0);
+        CHECK(a != b);
+
+        TArray<bool, TInlineAllocator<4>> inlined(130, true);
+        b &= inlined;
+        CHECK_EQ(b.CountSetBits(), 80);
     }
 }
 
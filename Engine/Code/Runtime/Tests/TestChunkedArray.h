@@ -0,0 +1,140 @@
+#pragma once
+
+#include "Containers/ChunkedArray.h"
+#include "TestUtils.h"
+#include <doctest/doctest.h>
+#include <string>
+
+TEST_SUITE_BEGIN("Containers");
+TEST_CASE("[TChunkedArray]")
+{
+    SUBCASE("Default constructor")
+    {
+        TChunkedArray<int32> array;
+        CHECK(array.IsEmpty());
+        CHECK_EQ(array.GetSize(), 0);
+        CHECK_EQ(array.GetCapacity(), 0);
+        CHECK_EQ(array.GetChunkCount(), 0);
+        CHECK(array.begin() == array.end());
+    }
+
+    SUBCASE("Add and index")
+    {
+        TChunkedArray<int32, 16> array;
+        for (int32 i = 0; i < 1000; i++) {
+            CHECK_EQ(array.Emplace(i), i);
+        }
+
+        CHECK_EQ(array.GetSize(), 1000);
+        CHECK_EQ(array.GetChunkCount(), 63);
+        CHECK_EQ(array.GetCapacity(), 1008);
+        for (int32 i = 0; i < 1000; i++) {
+            CHECK_EQ(array[i], i);
+        }
+
+        CHECK_EQ(array.Pop(), 999);
+        CHECK_EQ(array.GetLast(), 998);
+    }
+
+    SUBCASE("References are stable")
+    {
+        TChunkedArray<int32, 16> array;
+        int32&                   first = array.Add(7);
+        int32*                   items[100];
+        for (int32 i = 0; i < 100; i++) {
+            items[i] = &array.Add(i);
+        }
+        for (int32 i = 0; i < 10000; i++) {
+            array.Add(i);
+        }
+
+        CHECK_EQ(first, 7);
+        CHECK_EQ(&array[0], &first);
+        for (int32 i = 0; i < 100; i++) {
+            CHECK_EQ(items[i], &array[i + 1]);
+            CHECK_EQ(*items[i], i);
+        }
+    }
+
+    SUBCASE("Iteration")
+    {
+        TChunkedArray<int32, 8> array;
+        for (int32 i = 0; i < 32; i++) {
+            array.Add(i);
+        }
+
+        // Full last chunk, then a partial one.
+        for (int32 size : { 32, 29 }) {
+            while (array.GetSize() > size) {
+                array.Pop();
+            }
+
+            int32 expected = 0;
+            for (int32 value : array) {
+                CHECK_EQ(value, expected++);
+            }
+            CHECK_EQ(expected, size);
+
+            expected = 0;
+            array.ForEachChunk([&](const int32* items, uint64 count) {
+                CHECK_EQ(count, expected + 8 <= size ? 8 : size - expected);
+                for (uint64 i = 0; i < count; i++) {
+                    CHECK_EQ(items[i], expected++);
+                }
+            });
+            CHECK_EQ(expected, size);
+        }
+
+        CHECK_EQ(array.GetChunk(3).GetSize(), 5);
+        CHECK_EQ(array.GetChunk(3)[4], 28);
+    }
+
+    SUBCASE("Reserve, clear and shrink")
+    {
+        TChunkedArray<int32, 16> array;
+        array.Reserve(40);
+        CHECK_EQ(array.GetCapacity(), 48);
+        CHECK(array.IsEmpty());
+
+        int32* first = &array.Add(1);
+        array.Clear();
+        CHECK(array.IsEmpty());
+        CHECK_EQ(array.GetCapacity(), 48);
+        CHECK_EQ(&array.Add(2), first);
+
+        array.ShrinkToFit();
+        CHECK_EQ(array.GetCapacity(), 16);
+        array.Clear(true);
+        CHECK_EQ(array.GetCapacity(), 0);
+    }
+
+    SUBCASE("Non trivial items")
+    {
+        {
+            TChunkedArray<LiveTracked, 4> array;
+            for (int32 i = 0; i < 30; i++) {
+                array.Emplace(i);
+            }
+            array.Pop();
+            CHECK_EQ(LiveTracked::LiveCount, 29);
+
+            TChunkedArray<LiveTracked, 4> copy(array);
+            CHECK_EQ(LiveTracked::LiveCount, 58);
+            CHECK_EQ(copy[17].Name, "17");
+            CHECK_EQ(copy.GetLast().Name, "28");
+
+            const LiveTracked*            item = &array[10];
+            TChunkedArray<LiveTracked, 4> moved(std::move(array));
+            CHECK(array.IsEmpty());
+            CHECK_EQ(&moved[10], item);
+            CHECK_EQ(LiveTracked::LiveCount, 58);
+
+            copy = moved;
+            CHECK_EQ(LiveTracked::LiveCount, 58);
+            copy.Clear();
+            CHECK_EQ(LiveTracked::LiveCount, 29);
+        }
+        CHECK_EQ(LiveTracked::LiveCount, 0);
+    }
+}
+TEST_SUITE_END();
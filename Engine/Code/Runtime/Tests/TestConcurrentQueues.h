@@ -0,0 +1,245 @@
+#pragma once
+
+#include "Containers/MpmcQueue.h"
+#include "Containers/SpscQueue.h"
+#include "TestUtils.h"
+#include <atomic>
+#include <doctest/doctest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Producers add (producer << 32 | sequence) values, alternating single and batch adds, and
+ * consumers remove them until they receive a stop value. Every consumer checks that the values
+ * of each producer arrive in order, and the sum of every value removed is returned.
+ */
+template<class QueueType>
+uint64
+RunQueueStress(QueueType& queue, uint32 producerCount, uint32 consumerCount, uint64 itemCount, bool& inOrder)
+{
+    constexpr uint64 StopValue = ~0ull;
+
+    std::atomic<uint64>      sum { 0 };
+    std::atomic<uint32>      outOfOrder { 0 };
+    std::vector<std::thread> consumers;
+    for (uint32 c = 0; c < consumerCount; c++) {
+        consumers.emplace_back([&, c] {
+            std::vector<uint64> next(producerCount, 0);
+            uint64              values[16];
+            uint64              localSum = 0;
+            for (uint64 round = 0;; round++) {
+                const uint64 count = (round + c) % 2 ? queue.PopBatch(values, 16) : (queue.Pop(values[0]), 1);
+                for (uint64 i = 0; i < count; i++) {
+                    if (values[i] == StopValue) {
+                        sum.fetch_add(localSum);
+                        // The rest of the batch belongs to the other consumers.
+                        for (uint64 j = i + 1; j < count; j++) {
+                            queue.Push(values[j]);
+                        }
+                        return;
+                    }
+
+                    const uint32 producer = static_cast<uint32>(values[i] >> 32);
+                    const uint64 sequence = values[i] & 0xFFFFFFFF;
+                    if (sequence < next[producer]) {
+                        outOfOrder.fetch_add(1);
+                    }
+                    next[producer] = sequence + 1;
+                    localSum += values[i];
+                }
+            }
+        });
+    }
+
+    std::vector<std::thread> producers;
+    for (uint32 p = 0; p < producerCount; p++) {
+        producers.emplace_back([&, p] {
+            uint64 values[7];
+            for (uint64 i = 0; i < itemCount;) {
+                if (i % 3 == 0 && i + 7 <= itemCount) {
+                    for (uint64 j = 0; j < 7; j++) {
+                        values[j] = (static_cast<uint64>(p) << 32) | (i + j);
+                    }
+                    queue.PushBatch(values, 7);
+                    i += 7;
+                } else {
+                    queue.Push((static_cast<uint64>(p) << 32) | i);
+                    i++;
+                }
+            }
+        });
+    }
+
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    for (uint32 c = 0; c < consumerCount; c++) {
+        queue.Push(StopValue);
+    }
+    for (std::thread& consumer : consumers) {
+        consumer.join();
+    }
+
+    inOrder = outOfOrder.load() == 0;
+    return sum.load();
+}
+
+uint64
+ExpectedQueueStressSum(uint32 producerCount, uint64 itemCount)
+{
+    uint64 sum = 0;
+    for (uint64 p = 0; p < producerCount; p++) {
+        sum += (p << 32) * itemCount + itemCount * (itemCount - 1) / 2;
+    }
+    return sum;
+}
+
+TEST_SUITE_BEGIN("Containers");
+TEST_CASE("[TSpscQueue]")
+{
+    SUBCASE("Push and pop")
+    {
+        TSpscQueue<int32> queue(5);
+        CHECK_EQ(queue.GetCapacity(), 8);
+        CHECK(queue.IsEmpty());
+
+        int32 item = -1;
+        CHECK_FALSE(queue.TryPop(item));
+
+        for (int32 i = 0; i < 8; i++) {
+            CHECK(queue.TryPush(i));
+        }
+        CHECK_FALSE(queue.TryPush(8));
+        CHECK_EQ(queue.GetSize(), 8);
+
+        // Wraps around the end of the ring.
+        for (int32 round = 0; round < 3; round++) {
+            for (int32 i = 0; i < 5; i++) {
+                CHECK(queue.TryPop(item));
+                CHECK_EQ(item, round * 5 + i);
+            }
+            for (int32 i = 0; i < 5; i++) {
+                CHECK(queue.TryPush(8 + round * 5 + i));
+            }
+        }
+    }
+
+    SUBCASE("Batches")
+    {
+        TSpscQueue<int32> queue(8);
+        const int32       items[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+        CHECK_EQ(queue.TryPushBatch(items, 3), 3);
+        CHECK_EQ(queue.TryPushBatch(items + 3, 7), 5);
+        CHECK_EQ(queue.TryPushBatch(items, 1), 0);
+
+        int32 popped[10] = {};
+        CHECK_EQ(queue.TryPopBatch(popped, 6), 6);
+        CHECK_EQ(queue.TryPushBatch(items + 8, 2), 2);
+        CHECK_EQ(queue.TryPopBatch(popped + 6, 10), 4);
+        CHECK_EQ(queue.TryPopBatch(popped, 1), 0);
+
+        for (int32 i = 0; i < 10; i++) {
+            CHECK_EQ(popped[i], i);
+        }
+    }
+
+    SUBCASE("Non trivial items")
+    {
+        {
+            TSpscQueue<LiveTracked> queue(16);
+            for (int32 i = 0; i < 10; i++) {
+                queue.TryEmplace(i);
+            }
+
+            LiveTracked item;
+            CHECK(queue.TryPop(item));
+            CHECK_EQ(item.Name, "0");
+            CHECK_EQ(LiveTracked::LiveCount, 10);
+        }
+        CHECK_EQ(LiveTracked::LiveCount, 0);
+    }
+
+    SUBCASE("Stress")
+    {
+        constexpr uint64 itemCount = 200000;
+
+        TSpscQueue<uint64> queue(64);
+        bool               inOrder = false;
+        CHECK_EQ(RunQueueStress(queue, 1, 1, itemCount, inOrder), ExpectedQueueStressSum(1, itemCount));
+        CHECK(inOrder);
+        CHECK(queue.IsEmpty());
+    }
+}
+
+TEST_CASE("[TMpmcQueue]")
+{
+    SUBCASE("Push and pop")
+    {
+        TMpmcQueue<int32> queue(1);
+        CHECK_EQ(queue.GetCapacity(), 2);
+
+        int32 item = -1;
+        CHECK_FALSE(queue.TryPop(item));
+        CHECK(queue.TryPush(0));
+        CHECK(queue.TryPush(1));
+        CHECK_FALSE(queue.TryPush(2));
+
+        for (int32 i = 0; i < 100; i++) {
+            CHECK(queue.TryPop(item));
+            CHECK_EQ(item, i);
+            CHECK(queue.TryPush(i + 2));
+        }
+        CHECK_EQ(queue.GetSize(), 2);
+    }
+
+    SUBCASE("Batches")
+    {
+        TMpmcQueue<int32> queue(8);
+        const int32       items[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+        CHECK_EQ(queue.TryPushBatch(items, 3), 3);
+        CHECK_EQ(queue.TryPushBatch(items + 3, 7), 5);
+        CHECK_EQ(queue.TryPushBatch(items, 1), 0);
+
+        int32 popped[10] = {};
+        CHECK_EQ(queue.TryPopBatch(popped, 6), 6);
+        CHECK_EQ(queue.TryPushBatch(items + 8, 2), 2);
+        CHECK_EQ(queue.TryPopBatch(popped + 6, 10), 4);
+        CHECK_EQ(queue.TryPopBatch(popped, 1), 0);
+
+        for (int32 i = 0; i < 10; i++) {
+            CHECK_EQ(popped[i], i);
+        }
+    }
+
+    SUBCASE("Non trivial items")
+    {
+        {
+            TMpmcQueue<LiveTracked> queue(16);
+            for (int32 i = 0; i < 10; i++) {
+                queue.TryEmplace(i);
+            }
+
+            LiveTracked items[4];
+            CHECK_EQ(queue.TryPopBatch(items, 4), 4);
+            CHECK_EQ(items[3].Name, "3");
+            CHECK_EQ(LiveTracked::LiveCount, 10);
+        }
+        CHECK_EQ(LiveTracked::LiveCount, 0);
+    }
+
+    SUBCASE("Stress")
+    {
+        constexpr uint64 itemCount = 20000;
+
+        const uint32 threadCounts[][2] = { { 1, 1 }, { 4, 4 }, { 8, 2 }, { 2, 8 }, { 16, 16 } };
+        for (const uint32* counts : threadCounts) {
+            TMpmcQueue<uint64> queue(64);
+            bool               inOrder = false;
+            CHECK_EQ(RunQueueStress(queue, counts[0], counts[1], itemCount, inOrder), ExpectedQueueStressSum(counts[0], itemCount));
+            CHECK(inOrder);
+            CHECK(queue.IsEmpty());
+        }
+    }
+}
+TEST_SUITE_END();
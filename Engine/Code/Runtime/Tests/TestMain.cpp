@@ -2,8 +2,15 @@
 
 #include "Containers/ContainersFwd.h"
 
+#include "TestAllocators.h"
 #include "TestArray.h"
-// #include "TestArrayBool.h"
-// #include "TestString.h"
-// #include "TestSet.h"
-// #include "TestMap.h"
\ No newline at end of file
+#include "TestArrayBool.h"
+#include "TestConcurrentQueues.h"
+#include "TestSlotMap.h"
+#include "TestRingBuffer.h"
+#include "TestChunkedArray.h"
+#include "TestSoAArray.h"
+#include "TestString.h"
+#include "TestSet.h"
+#include "TestMap.h"
+#include "TestName.h"
\ No newline at end of file
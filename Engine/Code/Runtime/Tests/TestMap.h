@@ -1,8 +1,13 @@
 #pragma once
 
 #include "Containers/AnvilString.h"
+#include "Containers/ContainersFwd.h"
 #include "Containers/Map.h"
+#include "Memory/MemoryTracker.h"
+#include "TestUtils.h"
 #include <doctest/doctest.h>
+#include <string>
+#include <string_view>
 
 struct MyMapStruct
 {
@@ -34,6 +39,151 @@ TEST_CASE("[Map] Inserting and Removing")
         brian.Weight = 72.55f;
 
         map.Add(ATEXT("Brian"), brian);
+        CHECK_EQ(map.Find(ATEXT("Brian"))->Age, 27);
+        CHECK_EQ(map.Find(ATEXT("Bryan")), nullptr);
     }
 }
+TEST_CASE("[Map] Integer keys")
+{
+    SUBCASE("Add, Find and Remove")
+    {
+        TMap<int32, int32> map;
+        for (int32 i = 0; i < 1000; i++) {
+            map.Add(i, i * 10);
+        }
+
+        CHECK_EQ(map.GetCount(), 1000);
+        CHECK_EQ(*map.Find(500), 5000);
+        CHECK_EQ(map.Find(1000), nullptr);
+
+        // Adding an existing key replaces its value.
+        CHECK_EQ(map.Add(500, 1), 1);
+        CHECK_EQ(map.GetCount(), 1000);
+
+        for (int32 i = 0; i < 1000; i += 2) {
+            CHECK(map.Remove(i));
+        }
+        CHECK_FALSE(map.Remove(0));
+        CHECK_EQ(map.GetCount(), 500);
+
+        bool found = true;
+        for (int32 i = 0; i < 1000; i++) {
+            const int32* value = map.Find(i);
+            found              = found && (i % 2 ? value && (i == 500 ? *value == 1 : *value == i * 10) : !value);
+        }
+        CHECK(found);
+    }
+
+    SUBCASE("FindOrAdd and Emplace")
+    {
+        TMap<int32, TArray<int32>> map;
+        map.FindOrAdd(1).Add(10);
+        map.FindOrAdd(1).Add(11);
+        map.Emplace(2, 3);
+        map.Emplace(2, 100);
+
+        CHECK_EQ(map.GetCount(), 2);
+        CHECK_EQ(map.Find(1)->GetSize(), 2);
+        CHECK_EQ(map.Find(2)->GetSize(), 3);
+    }
+
+    SUBCASE("Dense iteration")
+    {
+        TMap<int32, int32> map;
+        for (int32 i = 0; i < 10; i++) {
+            map.Add(i, i);
+        }
+
+        // Entries are iterated in insertion order, the last entry fills the removed one's place.
+        map.Remove(3);
+
+        const int32 expected[] = {0, 1, 2, 9, 4, 5, 6, 7, 8};
+        int32       position   = 0;
+        for (const TMapEntry<int32, int32>& entry : map) {
+            CHECK_EQ(entry.Key, expected[position++]);
+            CHECK_EQ(entry.Value, entry.Key);
+        }
+        CHECK_EQ(position, 9);
+        CHECK_EQ(*map.Find(9), 9);
+    }
+
+    SUBCASE("Reserve, copy and move")
+    {
+        TMap<uint64, uint64> map;
+        map.Reserve(1000);
+        for (uint64 i = 0; i < 1000; i++) {
+            map.Add(i << 32, i);
+        }
+
+        TMap<uint64, uint64> copy = map;
+        copy.Remove(uint64(5) << 32);
+        CHECK_EQ(map.GetCount(), 1000);
+        CHECK_EQ(copy.GetCount(), 999);
+        CHECK_EQ(*copy.Find(uint64(999) << 32), 999);
+
+        TMap<uint64, uint64> moved = std::move(copy);
+        CHECK(copy.IsEmpty());
+        CHECK_EQ(moved.Find(uint64(5) << 32), nullptr);
+
+        moved.Clear();
+        CHECK(moved.IsEmpty());
+        CHECK_FALSE(moved.Contains(uint64(1) << 32));
+    }
+
+    SUBCASE("Churn")
+    {
+        TMap<int32, int32> map;
+        for (int32 i = 0; i < 100000; i++) {
+            map.Add(i, i);
+            if (i >= 90) {
+                map.Remove(i - 90);
+            }
+        }
+
+        CHECK_EQ(map.GetCount(), 90);
+        CHECK_EQ(*map.Find(99999), 99999);
+        CHECK_FALSE(map.Contains(99909));
+    }
+}
+
+TEST_CASE("[Map] String views")
+{
+    const tchar* key = ATEXT("a key longer than the inline capacity of String");
+
+    TMap<String, int32> map;
+    map.Add(String(key), 1);
+
+    // Looking up by text or view constructs no String.
+#if AE_MEMORY_TRACKING
+    const uint64 allocations = MemoryTracker::GetTotalStats().TotalAllocations;
+#endif
+    CHECK_EQ(*map.Find(key), 1);
+    CHECK(map.Contains(StringView(key)));
+    CHECK_FALSE(map.Contains(StringView(key, 5)));
+    CHECK_EQ(map.FindOrAdd(key), 1);
+    map.Add(key, 2);
+#if AE_MEMORY_TRACKING
+    CHECK_EQ(MemoryTracker::GetTotalStats().TotalAllocations, allocations);
+#endif
+
+    CHECK_EQ(*map.Find(String(key)), 2);
+    CHECK(map.Remove(StringView(key)));
+    CHECK(map.IsEmpty());
+}
+
+TEST_CASE("[Map] String keys")
+{
+    TMap<std::string, int32, StringViewHasher> map;
+    map.Add(std::string("honeydew"), 1);
+    map.Emplace("grapefruit", 2);
+
+    // Looking up by view constructs no key.
+    const std::string_view key = "grapefruit";
+    CHECK_EQ(*map.Find(key), 2);
+    CHECK_EQ(map.FindOrAdd(std::string_view("honeydew")), 1);
+    CHECK_EQ(map.FindOrAdd(std::string_view("kiwi")), 0);
+    CHECK_EQ(map.GetCount(), 3);
+    CHECK(map.Remove(std::string_view("honeydew")));
+    CHECK_FALSE(map.Contains(std::string_view("honeydew")));
+}
 TEST_SUITE_END();
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "Containers/Map.h"
+#include "Misc/Name.h"
+#include <doctest/doctest.h>
+#include <thread>
+#include <vector>
+
+TEST_SUITE_BEGIN("Misc");
+TEST_CASE("[Name] Interning")
+{
+    SUBCASE("Empty name")
+    {
+        Name empty;
+        CHECK(empty.IsEmpty());
+        CHECK_EQ(empty.GetId(), 0);
+        CHECK_EQ(empty.GetSize(), 0);
+        CHECK_EQ(String(empty.GetText()), ATEXT(""));
+        CHECK_EQ(Name(ATEXT("")), empty);
+        CHECK_EQ(Name(static_cast<const tchar*>(nullptr)), empty);
+    }
+
+    SUBCASE("Same text, same id")
+    {
+        const Name first(ATEXT("PlayerController"));
+        const Name second(ATEXT("PlayerController"));
+        const Name other(ATEXT("PlayerControllers"));
+
+        CHECK_FALSE(first.IsEmpty());
+        CHECK_EQ(first, second);
+        CHECK_EQ(first.GetId(), second.GetId());
+        CHECK_NE(first, other);
+        CHECK_EQ(first.GetText(), second.GetText());
+        CHECK_EQ(String(first.GetText()), ATEXT("PlayerController"));
+        CHECK_EQ(first.GetSize(), 16);
+
+        // Names are case sensitive and sized by code units.
+        CHECK_NE(Name(ATEXT("playercontroller")), first);
+        CHECK_EQ(Name(ATEXT("PlayerControllerX"), 16), first);
+        CHECK_EQ(Name(String(ATEXT("Maçã"))), Name(ATEXT("Maçã")));
+        CHECK_EQ(Name(ATEXT("Maçã")).GetSize(), 6);
+    }
+
+    SUBCASE("Find does not add")
+    {
+        const uint32 count = Name::GetCount();
+        CHECK(Name::Find(ATEXT("NeverInterned_7f3a"), 18).IsEmpty());
+        CHECK_EQ(Name::GetCount(), count);
+
+        const Name added(ATEXT("NeverInterned_7f3a"));
+        CHECK_EQ(Name::GetCount(), count + 1);
+        CHECK_EQ(Name::Find(ATEXT("NeverInterned_7f3a"), 18), added);
+    }
+
+    SUBCASE("Many names")
+    {
+        // Enough names to grow the lookup table several times and fill more than one id chunk.
+        std::vector<Name> names;
+        for (uint32 i = 0; i < 20000; i++) {
+            const std::string text = "Actor_" + std::to_string(i);
+            names.push_back(Name(reinterpret_cast<const tchar*>(text.c_str())));
+        }
+
+        for (uint32 i = 0; i < 20000; i++) {
+            const std::string text = "Actor_" + std::to_string(i);
+            CHECK_EQ(Name(reinterpret_cast<const tchar*>(text.c_str())), names[i]);
+            CHECK_EQ(std::string(reinterpret_cast<const char*>(names[i].GetText())), text);
+        }
+    }
+
+    SUBCASE("Hashed containers")
+    {
+        TMap<Name, int32> map;
+        map.Add(Name(ATEXT("Health")), 100);
+        map.Add(Name(ATEXT("Mana")), 50);
+
+        CHECK_EQ(*map.Find(Name(ATEXT("Health"))), 100);
+        CHECK_EQ(*map.Find(Name(ATEXT("Mana"))), 50);
+        CHECK_EQ(map.Find(Name(ATEXT("Stamina"))), nullptr);
+    }
+
+    SUBCASE("Concurrent interning")
+    {
+        constexpr uint32 threadCount = 8;
+        constexpr uint32 nameCount   = 5000;
+
+        std::vector<std::vector<uint32>> ids(threadCount, std::vector<uint32>(nameCount));
+        std::vector<std::thread>         threads;
+        for (uint32 t = 0; t < threadCount; t++) {
+            threads.emplace_back([t, &ids] {
+                // Every thread interns the same names in a different order, plus names of its own.
+                for (uint32 i = 0; i < nameCount; i++) {
+                    const uint32      index = (i * 7919 + t * 1237) % nameCount;
+                    const std::string text  = "Shared_" + std::to_string(index);
+                    const std::string own   = "Thread_" + std::to_string(t) + "_" + std::to_string(i);
+                    ids[t][index]           = Name(reinterpret_cast<const tchar*>(text.c_str())).GetId();
+                    Name(reinterpret_cast<const tchar*>(own.c_str()));
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        for (uint32 i = 0; i < nameCount; i++) {
+            const std::string text = "Shared_" + std::to_string(i);
+            const Name        name = Name::Find(reinterpret_cast<const tchar*>(text.c_str()), static_cast<uint32>(text.size()));
+            CHECK_FALSE(name.IsEmpty());
+            for (uint32 t = 0; t < threadCount; t++) {
+                CHECK_EQ(ids[t][i], name.GetId());
+            }
+        }
+    }
+}
+TEST_SUITE_END();
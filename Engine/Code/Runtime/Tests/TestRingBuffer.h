@@ -0,0 +1,302 @@
+#pragma once
+
+#include "Containers/Deque.h"
+#include "TestUtils.h"
+#include <doctest/doctest.h>
+#include <string>
+
+TEST_SUITE_BEGIN("Containers");
+TEST_CASE("[TRingBuffer]")
+{
+    SUBCASE("Default constructor")
+    {
+        TRingBuffer<int32> ring;
+        CHECK(ring.IsEmpty());
+        CHECK(ring.IsFull());
+        CHECK_EQ(ring.GetSize(), 0);
+        CHECK_EQ(ring.GetCapacity(), 0);
+    }
+
+    SUBCASE("Queue order")
+    {
+        TRingBuffer<int32> ring;
+        for (int32 i = 0; i < 100; i++) {
+            ring.PushBack(i);
+        }
+
+        CHECK_EQ(ring.GetSize(), 100);
+        CHECK_EQ(ring.GetCapacity(), 128);
+        CHECK_EQ(ring.GetFront(), 0);
+        CHECK_EQ(ring.GetBack(), 99);
+
+        for (int32 i = 0; i < 100; i++) {
+            CHECK_EQ(ring.PopFront(), i);
+        }
+        CHECK(ring.IsEmpty());
+    }
+
+    SUBCASE("Growing keeps the order of wrapped items")
+    {
+        TRingBuffer<int32> ring;
+        ring.Reserve(8);
+        CHECK_EQ(ring.GetCapacity(), 8);
+
+        // Moves the head to the middle, so the next items wrap around.
+        for (int32 i = 0; i < 5; i++) {
+            ring.PushBack(-1);
+        }
+        ring.RemoveFront(5);
+
+        for (int32 i = 0; i < 8; i++) {
+            ring.PushBack(i);
+        }
+        CHECK(ring.IsFull());
+        CHECK_EQ(ring.GetCapacity(), 8);
+
+        ring.PushBack(8);
+        CHECK_EQ(ring.GetCapacity(), 16);
+        for (int32 i = 0; i < 9; i++) {
+            CHECK_EQ(ring[i], i);
+        }
+    }
+
+    SUBCASE("Both ends")
+    {
+        TRingBuffer<int32> ring;
+        for (int32 i = 0; i < 10; i++) {
+            ring.PushBack(i);
+            ring.PushFront(-i - 1);
+        }
+
+        CHECK_EQ(ring.GetSize(), 20);
+        for (int32 i = 0; i < 20; i++) {
+            CHECK_EQ(ring[i], i - 10);
+        }
+
+        CHECK_EQ(ring.PopBack(), 9);
+        CHECK_EQ(ring.PopFront(), -10);
+        CHECK_EQ(ring.GetFront(), -9);
+        CHECK_EQ(ring.GetBack(), 8);
+
+        int32 expected = -9;
+        for (int32 value : ring) {
+            CHECK_EQ(value, expected++);
+        }
+        CHECK_EQ(expected, 9);
+    }
+
+    SUBCASE("Non trivial items")
+    {
+        {
+            TRingBuffer<LiveTracked> ring;
+            for (int32 i = 0; i < 50; i++) {
+                ring.EmplaceBack(i);
+                if (i % 3 == 0) {
+                    ring.PopFront();
+                }
+            }
+            CHECK_EQ(LiveTracked::LiveCount, 33);
+
+            TRingBuffer<LiveTracked> copy(ring);
+            CHECK_EQ(LiveTracked::LiveCount, 66);
+            CHECK_EQ(copy.GetFront().Name, ring.GetFront().Name);
+            CHECK_EQ(copy.GetBack().Name, "49");
+
+            TRingBuffer<LiveTracked> moved(std::move(copy));
+            CHECK(copy.IsEmpty());
+            CHECK_EQ(moved.GetSize(), 33);
+
+            ring.RemoveFront(10);
+            CHECK_EQ(LiveTracked::LiveCount, 56);
+
+            ring.Clear(true);
+            CHECK_EQ(ring.GetCapacity(), 0);
+            CHECK_EQ(LiveTracked::LiveCount, 33);
+
+            ring = moved;
+            CHECK_EQ(LiveTracked::LiveCount, 66);
+        }
+        CHECK_EQ(LiveTracked::LiveCount, 0);
+    }
+
+    SUBCASE("Shrink to fit")
+    {
+        TRingBuffer<int32> ring;
+        for (int32 i = 0; i < 1000; i++) {
+            ring.PushBack(i);
+        }
+        ring.RemoveFront(990);
+        ring.ShrinkToFit();
+        CHECK_EQ(ring.GetCapacity(), 16);
+        CHECK_EQ(ring.GetFront(), 990);
+        CHECK_EQ(ring.GetBack(), 999);
+    }
+
+    SUBCASE("Fixed allocator")
+    {
+        TRingBuffer<int32, TFixedAllocator<16>> ring;
+        for (int32 round = 0; round < 10; round++) {
+            for (int32 i = 0; i < 16; i++) {
+                ring.PushBack(round * 16 + i);
+            }
+            CHECK(ring.IsFull());
+            CHECK_EQ(ring.GetCapacity(), 16);
+
+            for (int32 i = 0; i < 16; i++) {
+                CHECK_EQ(ring.PopFront(), round * 16 + i);
+            }
+        }
+    }
+
+    SUBCASE("Inline allocator")
+    {
+        TRingBuffer<LiveTracked, TInlineAllocator<8, DefaultHeapAllocator64>> ring;
+        for (int32 i = 0; i < 8; i++) {
+            ring.EmplaceFront(i);
+        }
+        CHECK_EQ(ring.GetCapacity(), 8);
+
+        ring.EmplaceFront(8);
+        CHECK_GE(ring.GetCapacity(), 16);
+        for (int32 i = 0; i < 9; i++) {
+            CHECK_EQ(ring[i].Name, std::to_string(8 - i));
+        }
+
+        ring.Clear();
+        CHECK_EQ(LiveTracked::LiveCount, 0);
+    }
+
+    SUBCASE("Shrink to inline storage")
+    {
+        using InlineRing = TRingBuffer<std::string, TInlineAllocator<4, DefaultHeapAllocator64>>;
+
+        InlineRing ring;
+        for (int32 i = 0; i < 6; i++) {
+            ring.EmplaceBack(std::to_string(i));
+        }
+        for (int32 i = 0; i < 4; i++) {
+            ring.PopFront();
+        }
+        ring.ShrinkToFit();
+        CHECK_EQ(ring.GetCapacity(), 4);
+        CHECK_EQ(ring[0], "4");
+        CHECK_EQ(ring[1], "5");
+
+        // Wrapped items are put back in order.
+        InlineRing wrapped;
+        for (int32 i = 0; i < 6; i++) {
+            wrapped.EmplaceBack(std::to_string(i));
+        }
+        for (int32 i = 0; i < 5; i++) {
+            wrapped.PopFront();
+        }
+        wrapped.EmplaceBack("6");
+        wrapped.EmplaceBack("7");
+        wrapped.EmplaceBack(std::string(32, 'x'));
+        wrapped.ShrinkToFit();
+        CHECK_EQ(wrapped.GetCapacity(), 4);
+        CHECK_EQ(wrapped[0], "5");
+        CHECK_EQ(wrapped[3], std::string(32, 'x'));
+
+        // Moving keeps the inline items.
+        InlineRing moved(std::move(wrapped));
+        CHECK(wrapped.IsEmpty());
+        CHECK_EQ(moved[1], "6");
+        ring = std::move(moved);
+        CHECK_EQ(ring.GetSize(), 4);
+        CHECK_EQ(ring[2], "7");
+        CHECK_EQ(ring.PopBack(), std::string(32, 'x'));
+    }
+}
+
+TEST_CASE("[TDeque]")
+{
+    SUBCASE("Queue order")
+    {
+        TDeque<int32> deque;
+        for (int32 i = 0; i < 5000; i++) {
+            deque.PushBack(i);
+        }
+
+        CHECK_EQ(deque.GetSize(), 5000);
+        for (int32 i = 0; i < 5000; i++) {
+            CHECK_EQ(deque.PopFront(), i);
+        }
+        CHECK(deque.IsEmpty());
+    }
+
+    SUBCASE("Both ends")
+    {
+        TDeque<int32> deque;
+        for (int32 i = 0; i < 3000; i++) {
+            deque.PushBack(i);
+            deque.PushFront(-i - 1);
+        }
+
+        CHECK_EQ(deque.GetSize(), 6000);
+        CHECK_EQ(deque.GetFront(), -3000);
+        CHECK_EQ(deque.GetBack(), 2999);
+
+        int32 expected = -3000;
+        for (int32 value : deque) {
+            CHECK_EQ(value, expected++);
+        }
+
+        for (int32 i = 0; i < 3000; i++) {
+            CHECK_EQ(deque.PopBack(), 2999 - i);
+            CHECK_EQ(deque.PopFront(), i - 3000);
+        }
+        CHECK(deque.IsEmpty());
+
+        // Items are added again into the blocks that were kept.
+        deque.PushFront(1);
+        deque.PushBack(2);
+        CHECK_EQ(deque[0], 1);
+        CHECK_EQ(deque[1], 2);
+    }
+
+    SUBCASE("References are stable")
+    {
+        TDeque<int32> deque;
+        int32&        first = deque.PushBack(7);
+        int32&        last  = deque.PushFront(3);
+        for (int32 i = 0; i < 10000; i++) {
+            deque.PushBack(i);
+            deque.PushFront(i);
+        }
+
+        CHECK_EQ(first, 7);
+        CHECK_EQ(last, 3);
+        CHECK_EQ(&deque[10000], &last);
+        CHECK_EQ(&deque[10001], &first);
+    }
+
+    SUBCASE("Non trivial items")
+    {
+        {
+            TDeque<LiveTracked> deque;
+            for (int32 i = 0; i < 1000; i++) {
+                deque.EmplaceBack(i);
+                deque.EmplaceFront(-i);
+            }
+            for (int32 i = 0; i < 500; i++) {
+                deque.PopFront();
+            }
+            CHECK_EQ(LiveTracked::LiveCount, 1500);
+
+            TDeque<LiveTracked> copy(deque);
+            CHECK_EQ(LiveTracked::LiveCount, 3000);
+            CHECK_EQ(copy.GetFront().Name, "-499");
+            CHECK_EQ(copy.GetBack().Name, "999");
+
+            TDeque<LiveTracked> moved(std::move(deque));
+            CHECK(deque.IsEmpty());
+            CHECK_EQ(LiveTracked::LiveCount, 3000);
+
+            copy.Clear();
+            CHECK_EQ(LiveTracked::LiveCount, 1500);
+        }
+        CHECK_EQ(LiveTracked::LiveCount, 0);
+    }
+}
+TEST_SUITE_END();
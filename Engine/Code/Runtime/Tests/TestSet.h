@@ -2,15 +2,11 @@
 
 #include "Containers/AnvilString.h"
 #include "Containers/Set.h"
+#include "Memory/MemoryTracker.h"
+#include "TestUtils.h"
 #include <doctest/doctest.h>
-
-namespace std {
-template<>
-struct hash<String>
-{
-    std::size_t operator()(const String& k) const { return std::hash<std::string>()(*k); }
-};
-} // namespace std
+#include <string>
+#include <string_view>
 
 TEST_SUITE_BEGIN("Containers");
 TEST_CASE("[Set] Constructors and Assignments")
@@ -62,4 +58,183 @@ TEST_CASE("[Set] Inserting and Removing")
         set.Add(ATEXT("banana"));
     }
 }
+/** Counts its live instances and collides on purpose.*/
+struct SetTracked
+{
+    static inline int32 LiveCount = 0;
+
+    int32 Value;
+
+    SetTracked(int32 value)
+      : Value(value)
+    {
+        LiveCount++;
+    }
+
+    SetTracked(const SetTracked& other)
+      : Value(other.Value)
+    {
+        LiveCount++;
+    }
+
+    ~SetTracked() { LiveCount--; }
+
+    bool operator==(const SetTracked& other) const { return Value == other.Value; }
+};
+
+struct SetTrackedHasher
+{
+    using ResultType = size_t;
+    ResultType operator()(const SetTracked& value) const { return size_t(value.Value % 7); }
+};
+
+TEST_CASE("[Set] Integers")
+{
+    SUBCASE("Add, Contains and Remove")
+    {
+        TSet<int32> set;
+        for (int32 i = 0; i < 1000; i++) {
+            CHECK(set.Add(i * 3));
+        }
+
+        CHECK_FALSE(set.Add(0));
+        CHECK_EQ(set.GetCount(), 1000);
+        CHECK_FALSE(set.IsEmpty());
+
+        bool found = true;
+        for (int32 i = 0; i < 3000; i++) {
+            found = found && set.Contains(i) == (i % 3 == 0);
+        }
+        CHECK(found);
+
+        for (int32 i = 0; i < 1000; i += 2) {
+            CHECK(set.Remove(i * 3));
+        }
+        CHECK_FALSE(set.Remove(3000));
+        CHECK_EQ(set.GetCount(), 500);
+
+        found = true;
+        for (int32 i = 0; i < 1000; i++) {
+            found = found && set.Contains(i * 3) == (i % 2 == 1);
+        }
+        CHECK(found);
+    }
+
+    SUBCASE("Reserve")
+    {
+        TSet<uint64> set;
+        set.Reserve(1000);
+
+        const uint64 capacity = set.GetCapacity();
+        CHECK_GE(capacity, 1000);
+
+        for (uint64 i = 0; i < 1000; i++) {
+            set.Add(i << 32);
+        }
+        CHECK_EQ(set.GetCapacity(), capacity);
+    }
+
+    SUBCASE("Removing and adding keeps the capacity")
+    {
+        TSet<int32> set;
+        for (int32 i = 0; i < 90; i++) {
+            set.Add(i);
+        }
+
+        const uint64 capacity = set.GetCapacity();
+        for (int32 i = 90; i < 100000; i++) {
+            set.Remove(i - 90);
+            set.Add(i);
+        }
+
+        CHECK_EQ(set.GetCount(), 90);
+        CHECK_EQ(set.GetCapacity(), capacity);
+        CHECK(set.Contains(99999));
+        CHECK_FALSE(set.Contains(99909));
+    }
+
+    SUBCASE("Iteration, copy and move")
+    {
+        TSet<int32> set = {1, 2, 3, 2, 1};
+        CHECK_EQ(set.GetCount(), 3);
+
+        int32 sum = 0;
+        for (int32 item : set) {
+            sum += item;
+        }
+        CHECK_EQ(sum, 6);
+
+        TSet<int32> copy = set;
+        copy.Add(4);
+        CHECK_EQ(set.GetCount(), 3);
+        CHECK_EQ(copy.GetCount(), 4);
+
+        TSet<int32> moved = std::move(copy);
+        CHECK(copy.IsEmpty());
+        CHECK(moved.Contains(4));
+
+        moved.Clear();
+        CHECK(moved.IsEmpty());
+        CHECK_FALSE(moved.Contains(1));
+    }
+}
+
+TEST_CASE("[Set] Items")
+{
+    SetTracked::LiveCount = 0;
+
+    SUBCASE("Collisions and lifetime")
+    {
+        {
+            TSet<SetTracked, SetTrackedHasher> set;
+            for (int32 i = 0; i < 200; i++) {
+                set.Add(SetTracked(i));
+            }
+
+            CHECK_EQ(SetTracked::LiveCount, 200);
+            CHECK_EQ(set.Find(SetTracked(150))->Value, 150);
+            CHECK_EQ(set.Find(SetTracked(250)), nullptr);
+
+            set.Remove(SetTracked(150));
+            CHECK_EQ(SetTracked::LiveCount, 199);
+            CHECK_EQ(set.Emplace(10).Value, 10);
+            CHECK_EQ(set.GetCount(), 199);
+        }
+
+        CHECK_EQ(SetTracked::LiveCount, 0);
+    }
+
+    SUBCASE("Heterogeneous lookup")
+    {
+        TSet<std::string, StringViewHasher> set;
+        set.Add("honeydew");
+        set.Add("grapefruit");
+        set.Add(std::string(100, 'x'));
+
+        const std::string_view key = "grapefruit";
+        CHECK(set.Contains(key));
+        CHECK_EQ(*set.Find(key), "grapefruit");
+        CHECK_FALSE(set.Contains(std::string_view("grape")));
+        CHECK(set.Remove(std::string_view("honeydew")));
+        CHECK_EQ(set.GetCount(), 2);
+    }
+
+    SUBCASE("Emplace by key")
+    {
+        const tchar* text = ATEXT("a text longer than the inline capacity of String");
+
+        TSet<String> set;
+        CHECK(set.Emplace(text) == text);
+
+        // The text is looked up as is, no String is constructed for an item already in the set.
+#if AE_MEMORY_TRACKING
+        const uint64 allocations = MemoryTracker::GetTotalStats().TotalAllocations;
+#endif
+        CHECK(set.Emplace(text) == text);
+#if AE_MEMORY_TRACKING
+        CHECK_EQ(MemoryTracker::GetTotalStats().TotalAllocations, allocations);
+#endif
+        CHECK_EQ(set.GetCount(), 1);
+    }
+}
 TEST_SUITE_END();
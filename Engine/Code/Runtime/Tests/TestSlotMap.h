@@ -0,0 +1,162 @@
+#pragma once
+
+#include "Containers/SlotMap.h"
+#include "TestUtils.h"
+#include <doctest/doctest.h>
+#include <string>
+
+TEST_SUITE_BEGIN("Containers");
+TEST_CASE("[TSlotMap]")
+{
+    using SlotMap = TSlotMap<int32>;
+
+    SUBCASE("Default constructor")
+    {
+        SlotMap map;
+        CHECK_EQ(map.GetSize(), 0);
+        CHECK(map.IsEmpty());
+        CHECK_FALSE(map.IsValid(SlotMap::Handle{}));
+        CHECK_EQ(map.Get(SlotMap::Handle{}), nullptr);
+        CHECK_EQ(sizeof(SlotMap::Handle), 4);
+    }
+
+    SUBCASE("Add and Get")
+    {
+        SlotMap               map;
+        const SlotMap::Handle a = map.Add(1);
+        const SlotMap::Handle b = map.Emplace(2);
+
+        CHECK_NE(a, b);
+        CHECK_EQ(map.GetSize(), 2);
+        CHECK_EQ(*map.Get(a), 1);
+        CHECK_EQ(*map.Get(b), 2);
+        CHECK_EQ(map.GetHandle(1), b);
+    }
+
+    SUBCASE("Remove swaps with the last item")
+    {
+        SlotMap         map;
+        SlotMap::Handle handles[5];
+        for (int32 i = 0; i < 5; i++) {
+            handles[i] = map.Add(i);
+        }
+
+        CHECK(map.Remove(handles[1]));
+        CHECK_FALSE(map.Remove(handles[1]));
+        CHECK_EQ(map.GetSize(), 4);
+        CHECK_EQ(map[1], 4);
+        CHECK_EQ(map.GetHandle(1), handles[4]);
+        CHECK_EQ(*map.Get(handles[4]), 4);
+
+        // Removing the last item moves nothing.
+        CHECK(map.Remove(handles[3]));
+        CHECK_EQ(map.GetSize(), 3);
+        CHECK_EQ(*map.Get(handles[0]), 0);
+        CHECK_EQ(*map.Get(handles[2]), 2);
+        CHECK_EQ(*map.Get(handles[4]), 4);
+
+        int32 sum = 0;
+        for (int32 item : map) {
+            sum += item;
+        }
+        CHECK_EQ(sum, 6);
+    }
+
+    SUBCASE("Stale handles")
+    {
+        SlotMap               map;
+        const SlotMap::Handle removed = map.Add(1);
+        map.Remove(removed);
+
+        // The slot is reused, the old handle stays stale.
+        const SlotMap::Handle reused = map.Add(2);
+        CHECK_EQ(reused.GetIndex(), removed.GetIndex());
+        CHECK_FALSE(map.IsValid(removed));
+        CHECK_EQ(map.Get(removed), nullptr);
+        CHECK_EQ(*map.Get(reused), 2);
+
+        map.Clear();
+        CHECK(map.IsEmpty());
+        CHECK_FALSE(map.IsValid(reused));
+
+        const SlotMap::Handle added = map.Add(3);
+        CHECK_FALSE(map.IsValid(reused));
+        CHECK_EQ(*map.Get(added), 3);
+    }
+
+    SUBCASE("Generation wraparound")
+    {
+        SlotMap               map;
+        const SlotMap::Handle first = map.Add(0);
+        map.Remove(first);
+
+        // Every reuse bumps the generation twice, the slot keeps being reused once it wraps around.
+        SlotMap::Handle handle;
+        for (uint32 i = 1; i < (SlotMap::MaxGeneration + 1) / 2; i++) {
+            handle = map.Add(static_cast<int32>(i));
+            CHECK_EQ(handle.GetIndex(), first.GetIndex());
+            CHECK_NE(handle.GetGeneration() % 2, 0);
+            map.Remove(handle);
+        }
+        CHECK_EQ(handle.GetGeneration(), SlotMap::MaxGeneration);
+        CHECK_FALSE(map.IsValid(handle));
+
+        const SlotMap::Handle added = map.Add(1);
+        CHECK_EQ(added.GetIndex(), first.GetIndex());
+        CHECK_EQ(*map.Get(added), 1);
+        CHECK_FALSE(map.IsValid(SlotMap::Handle{}));
+
+        // Handles as old as the whole generation range are the accepted exception.
+        CHECK_EQ(added, first);
+    }
+
+    SUBCASE("Churn")
+    {
+        SlotMap         map;
+        SlotMap::Handle handles[1000];
+        map.Reserve(1000);
+        for (int32 i = 0; i < 1000; i++) {
+            handles[i] = map.Add(i);
+        }
+
+        for (int32 i = 0; i < 1000; i += 3) {
+            CHECK(map.Remove(handles[i]));
+        }
+        for (int32 i = 0; i < 1000; i += 3) {
+            handles[i] = map.Add(-i);
+        }
+
+        bool valid = map.GetSize() == 1000;
+        for (int32 i = 0; i < 1000; i++) {
+            valid = valid && *map.Get(handles[i]) == (i % 3 ? i : -i);
+        }
+        for (SlotMap::SizeType position = 0; position < map.GetSize(); position++) {
+            valid = valid && map.Get(map.GetHandle(position)) == &map[position];
+        }
+        CHECK(valid);
+    }
+
+    SUBCASE("Items lifetime")
+    {
+        {
+            TSlotMap<LiveTracked> map;
+            const auto               first = map.Emplace("first");
+            map.Emplace("second");
+            map.Add(LiveTracked("third"));
+            CHECK_EQ(LiveTracked::LiveCount, 3);
+
+            map.Remove(first);
+            CHECK_EQ(LiveTracked::LiveCount, 2);
+            CHECK_EQ(map[0].Name, "third");
+
+            TSlotMap<LiveTracked> copy = map;
+            CHECK_EQ(LiveTracked::LiveCount, 4);
+            CHECK_EQ(copy.Get(copy.GetHandle(1))->Name, "second");
+
+            copy.Clear(true);
+            CHECK_EQ(LiveTracked::LiveCount, 2);
+        }
+        CHECK_EQ(LiveTracked::LiveCount, 0);
+    }
+}
+TEST_SUITE_END();
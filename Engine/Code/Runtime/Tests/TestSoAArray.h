@@ -0,0 +1,140 @@
+#pragma once
+
+#include "Containers/SoAArray.h"
+#include <doctest/doctest.h>
+#include <string>
+
+struct SoAVector
+{
+    float X, Y, Z;
+};
+
+struct alignas(128) SoAWideField
+{
+    float Values[32];
+};
+
+TEST_SUITE_BEGIN("Containers");
+TEST_CASE("[TSoAArray]")
+{
+    using Particles = TSoAArray<SoAVector, SoAVector, float, uint8>;
+
+    SUBCASE("Default constructor")
+    {
+        Particles u;
+        CHECK_EQ(u.GetSize(), 0);
+        CHECK_EQ(u.GetCapacity(), 0);
+        CHECK(u.IsEmpty());
+        CHECK(u.GetColumn<2>().IsEmpty());
+    }
+
+    SUBCASE("Add and columns")
+    {
+        Particles u;
+        for (uint32 i = 0; i < 100; i++) {
+            CHECK_EQ(u.Add(SoAVector{ float(i), 0, 0 }, SoAVector{ 0, float(i), 0 }, float(i) * 0.5f, uint8(i)), i);
+        }
+
+        CHECK_EQ(u.GetSize(), 100);
+        CHECK_GE(u.GetCapacity(), 100);
+
+        // Every column is contiguous and starts on a cache line.
+        TSpan<SoAVector> positions = u.GetColumn<0>();
+        TSpan<float>     lifetimes = u.GetColumn<float>();
+        TSpan<uint8>     flags     = u.GetColumn<uint8>();
+        CHECK_EQ(positions.GetSize(), 100);
+        CHECK_EQ(reinterpret_cast<uint64>(positions.GetData()) % Particles::ColumnAlignment, 0);
+        CHECK_EQ(reinterpret_cast<uint64>(u.GetColumn<1>().GetData()) % Particles::ColumnAlignment, 0);
+        CHECK_EQ(reinterpret_cast<uint64>(lifetimes.GetData()) % Particles::ColumnAlignment, 0);
+        CHECK_EQ(reinterpret_cast<uint64>(flags.GetData()) % Particles::ColumnAlignment, 0);
+
+        float sum = 0;
+        for (float lifetime : lifetimes) {
+            sum += lifetime;
+        }
+        CHECK_EQ(sum, 2475.0f);
+        CHECK_EQ(positions[42].X, 42.0f);
+        CHECK_EQ(u.Get<1>(42).Y, 42.0f);
+        CHECK_EQ(flags[99], 99);
+    }
+
+    SUBCASE("RemoveAtSwap")
+    {
+        Particles u;
+        for (uint32 i = 0; i < 10; i++) {
+            u.Add(SoAVector{ float(i), 0, 0 }, SoAVector{}, float(i), uint8(i));
+        }
+
+        u.RemoveAtSwap(2);
+        CHECK_EQ(u.GetSize(), 9);
+        CHECK_EQ(u.Get<0>(2).X, 9.0f);
+        CHECK_EQ(u.Get<2>(2), 9.0f);
+        CHECK_EQ(u.Get<3>(2), 9);
+
+        u.RemoveAtSwap(8, true);
+        CHECK_EQ(u.GetSize(), 8);
+        CHECK_EQ(u.GetCapacity(), 8);
+        CHECK_EQ(u.Get<3>(7), 7);
+    }
+
+    SUBCASE("Reserve, Resize and Clear")
+    {
+        Particles u;
+        u.Reserve(1000);
+        CHECK_EQ(u.GetCapacity(), 1000);
+        u.Reserve(10);
+        CHECK_EQ(u.GetCapacity(), 1000);
+
+        u.Add(SoAVector{ 1, 2, 3 }, SoAVector{}, 1.0f, uint8(1));
+        u.Resize(500);
+        CHECK_EQ(u.GetSize(), 500);
+        CHECK_EQ(u.Get<0>(0).Z, 3.0f);
+        CHECK_EQ(u.Get<2>(499), 0.0f);
+
+        u.Resize(2);
+        CHECK_EQ(u.GetSize(), 2);
+
+        u.Clear(true);
+        CHECK(u.IsEmpty());
+        CHECK_EQ(u.GetCapacity(), 0);
+    }
+
+    SUBCASE("Field alignment above a cache line")
+    {
+        TSoAArray<uint8, SoAWideField> u;
+        for (uint32 i = 0; i < 5; i++) {
+            u.Add(uint8(i), SoAWideField{ { float(i) } });
+        }
+
+        CHECK_EQ(reinterpret_cast<uint64>(u.GetColumn<1>().GetData()) % 128, 0);
+        CHECK_EQ(u.Get<1>(4).Values[0], 4.0f);
+    }
+
+    SUBCASE("Non trivial fields")
+    {
+        TSoAArray<std::string, int32> u;
+        u.Add(std::string("first"), 1);
+        u.Add("second", 2);
+        u.Add("third", 3);
+        for (int32 i = 0; i < 100; i++) {
+            u.Add("filler", i);
+        }
+        u.RemoveAtSwap(0);
+        CHECK_EQ(u.Get<0>(0), "filler");
+        CHECK_EQ(u.Get<1>(0), 99);
+
+        TSoAArray<std::string, int32> copy = u;
+        u.Clear();
+        CHECK_EQ(copy.GetSize(), 102);
+        CHECK_EQ(copy.Get<0>(1), "second");
+
+        TSoAArray<std::string, int32> moved = std::move(copy);
+        CHECK(copy.IsEmpty());
+        CHECK_EQ(moved.GetColumn<std::string>()[2], "third");
+
+        u = moved;
+        CHECK_EQ(u.GetSize(), 102);
+        CHECK_EQ(u.GetColumn<int32>()[101], 98);
+    }
+}
+TEST_SUITE_END();
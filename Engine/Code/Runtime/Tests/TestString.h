@@ -2,7 +2,10 @@
 
 #include "Containers/AnvilString.h"
 #include "Containers/StringUtils.h"
+#include <cmath>
+#include <cstdio>
 #include <doctest/doctest.h>
+#include <limits>
 
 TEST_SUITE_BEGIN("Containers");
 TEST_CASE("[String] Constructors and Assignments")
@@ -22,15 +25,120 @@ TEST_CASE("[String] Constructors and Assignments")
         String text = ATEXT("Olá, meu nome é Brian, eu sou de Uberlândia e gosto de maçãs.");
 
         CHECK_EQ(text.GetSize(), 67);
-        CHECK_EQ(text.GetLength(), 66);
+        CHECK_EQ(text.GetLength(), 61);
         CHECK_EQ(text.GetSizeInBytes(), 67 * sizeof(tchar));
         CHECK_FALSE(text.IsEmpty());
     }
+
+    SUBCASE("Copy and move")
+    {
+        String inlined = ATEXT("Anvil");
+        String heap    = ATEXT("Uberlândia, Minas Gerais, Brasil");
+
+        String inlinedCopy = inlined;
+        String heapCopy    = heap;
+        CHECK_EQ(inlinedCopy, inlined);
+        CHECK_EQ(heapCopy, heap);
+        CHECK_NE(heapCopy.GetData(), heap.GetData());
+
+        const tchar* heapData  = heap.GetData();
+        String       heapMoved = std::move(heap);
+        CHECK_EQ(heapMoved.GetData(), heapData);
+        CHECK_EQ(heapMoved.GetLength(), 32);
+        CHECK(heap.IsEmpty());
+        CHECK_EQ(heap, ATEXT(""));
+
+        String inlinedMoved;
+        inlinedMoved = std::move(inlined);
+        CHECK_EQ(inlinedMoved, ATEXT("Anvil"));
+        CHECK(inlined.IsEmpty());
+
+        heapCopy = inlinedCopy;
+        CHECK_EQ(heapCopy, ATEXT("Anvil"));
+        CHECK_EQ(heapCopy.GetLength(), 5);
+    }
+}
+
+TEST_CASE("[String] Inline storage")
+{
+    String text;
+    CHECK_EQ(text.GetCapacity(), String::InlineCapacity);
+
+    // Up to InlineCapacity code units are kept inside the string.
+    for (uint32 i = 0; i < String::InlineCapacity; i++) {
+        text += ATEXT("a");
+    }
+    CHECK_EQ(text.GetCapacity(), String::InlineCapacity);
+    CHECK_EQ(text.GetLength(), String::InlineCapacity);
+
+    text += ATEXT("ç");
+    CHECK_GT(text.GetCapacity(), String::InlineCapacity);
+    CHECK_EQ(text.GetSize(), String::InlineCapacity + 3);
+    CHECK_EQ(text.GetLength(), String::InlineCapacity + 1);
+    CHECK_EQ(text[String::InlineCapacity - 1], 'a');
+
+    text.Clear();
+    CHECK(text.IsEmpty());
+    CHECK_EQ(text.GetLength(), 0);
+    CHECK_EQ(text, ATEXT(""));
+}
+
+TEST_CASE("[String] Append and compare")
+{
+    String text = ATEXT("maçã");
+    text.Append(text);
+    text += ATEXT(" e pêra");
+    CHECK_EQ(text, ATEXT("maçãmaçã e pêra"));
+    CHECK_EQ(text.GetLength(), 15);
+
+    // Appending itself past the capacity reads the old text before it is released.
+    String repeated = ATEXT("0123456789abcdef");
+    repeated.Append(repeated.GetData() + 8, 8);
+    repeated.Append(repeated);
+    CHECK_EQ(repeated, ATEXT("0123456789abcdef89abcdef0123456789abcdef89abcdef"));
+
+    const String joined = String(ATEXT("Anvil")) + String(ATEXT(" Engine"));
+    CHECK_EQ(joined, ATEXT("Anvil Engine"));
+    CHECK_NE(joined, ATEXT("Anvil"));
+    CHECK(String(ATEXT("abc")) < String(ATEXT("abd")));
+    CHECK(String(ATEXT("ab")) < String(ATEXT("abc")));
+    CHECK_FALSE(String(ATEXT("é")) < String(ATEXT("z")));
+}
+
+TEST_CASE("[String] UTF-8")
+{
+    const char* valid[] = { "", "ASCII only, long enough to take the vectorized path.", "Olá", "日本語のテキスト", "🔨⚒ mixed 𝄞 text",
+                            "\xF4\x8F\xBF\xBF" };
+    for (const char* text : valid) {
+        CHECK(Utf8::IsValid(reinterpret_cast<const tchar*>(text), strlen(text)));
+    }
+
+    const char* invalid[] = {
+        "\x80",             // Lone continuation byte.
+        "abc\xC3",          // Truncated sequence.
+        "\xC0\xAF",         // Overlong encoding.
+        "\xE0\x80\xAF",     // Overlong encoding.
+        "\xED\xA0\x80",     // Surrogate.
+        "\xF4\x90\x80\x80", // Past U+10FFFF.
+        "\xFF",             // Never used.
+        "0123456789abcdef0123456789\xE6\x97", // Truncated past a vectorized block.
+    };
+    for (const char* text : invalid) {
+        CHECK_FALSE(Utf8::IsValid(reinterpret_cast<const tchar*>(text), strlen(text)));
+    }
+
+    const String japanese = ATEXT("日本語のテキストは一文字が三バイトです。");
+    CHECK_EQ(japanese.GetLength(), 20);
+    CHECK_EQ(japanese.GetSize(), 61);
+
+    const String emojis = ATEXT("🔨⚒🔨⚒🔨⚒🔨⚒ anvil");
+    CHECK_EQ(emojis.GetLength(), 14);
+    CHECK_EQ(Utf8::CountCodePoints(emojis.GetData(), emojis.GetSize() - 1), 14);
 }
 
 TEST_CASE("[String] Formatter")
 {
-    String formatted = StringUtils::Format(ATEXT("Olá, meu nome é {}, eu sou de {}, vulgo {1:s4} e gosto de {}. Eu tenho {} anos e peso {:3.5f} kg."),
+    String formatted = StringUtils::Format(ATEXT("Olá, meu nome é {}, eu sou de {}, vulgo {2:s4} e gosto de {3}. Eu tenho {4} anos e peso {5:3.5f} kg."),
                                            ATEXT("Brian"),
                                            ATEXT("Uberlândia"),
                                            ATEXT("Udia"),
@@ -38,6 +146,147 @@ TEST_CASE("[String] Formatter")
                                            29,
                                            71.3542f);
 
-    CHECK_EQ(formatted, ATEXT("Olá, meu nome é Brian, eu sou de Uberlândia, vulgo Udia e gosto de maçã. Eu tenho 29 anos e peso 72.35"));
+    CHECK_EQ(formatted, ATEXT("Olá, meu nome é Brian, eu sou de Uberlândia, vulgo Udia e gosto de maçã. Eu tenho 29 anos e peso 71.35420 kg."));
+
+    // Placeholders naming an argument do not move to the next one.
+    CHECK_EQ(StringUtils::Format(ATEXT("{} {0} {} {1:s4}"), ATEXT("Brian"), ATEXT("Udia")), ATEXT("Brian Brian Udia Udia"));
+}
+
+TEST_CASE("[StringUtils] Format")
+{
+    SUBCASE("Integers")
+    {
+        CHECK_EQ(StringUtils::Format(ATEXT("{} {} {} {}"), 0, -42, 1234567890u, uint8(255)), ATEXT("0 -42 1234567890 255"));
+        CHECK_EQ(StringUtils::Format(ATEXT("{}"), int64(-9223372036854775807ll - 1)), ATEXT("-9223372036854775808"));
+        CHECK_EQ(StringUtils::Format(ATEXT("{}"), uint64(18446744073709551615ull)), ATEXT("18446744073709551615"));
+        CHECK_EQ(StringUtils::Format(ATEXT("{:x} {:x} {:x}"), 255, 0u, -16), ATEXT("ff 0 -10"));
+        CHECK_EQ(StringUtils::Format(ATEXT("[{:5}] [{:d3}] [{:2}]"), 42, -7, 12345), ATEXT("[   42] [ -7] [12345]"));
+    }
+
+    SUBCASE("Text")
+    {
+        const String name = ATEXT("maçã");
+        CHECK_EQ(StringUtils::Format(ATEXT("{} {} {} {}"), name, ATEXT("é"), true, tchar('x')), ATEXT("maçã é true x"));
+        CHECK_EQ(StringUtils::Format(ATEXT("[{:6}] [{:s.2}] [{:3.1}]"), name, name, name), ATEXT("[maçã  ] [ma] [m  ]"));
+        CHECK_EQ(StringUtils::Format(ATEXT("{1}{0}{1}"), ATEXT("b"), ATEXT("a")), ATEXT("aba"));
+        CHECK_EQ(StringUtils::Format(ATEXT("{{{}}} }}{{"), 7), ATEXT("{7} }{"));
+        CHECK_EQ(StringUtils::Format(ATEXT("no placeholders")), ATEXT("no placeholders"));
+    }
+
+    SUBCASE("Shortest floats")
+    {
+        CHECK_EQ(StringUtils::Format(ATEXT("{} {} {} {}"), 0.1, 0.0, -0.0, 1.5f), ATEXT("0.1 0 -0 1.5"));
+        CHECK_EQ(StringUtils::Format(ATEXT("{} {}"), 0.1f, 0.3), ATEXT("0.1 0.3"));
+        CHECK_EQ(StringUtils::Format(ATEXT("{} {}"), 0.1 + 0.2, 1.0 / 3.0), ATEXT("0.30000000000000004 0.3333333333333333"));
+        CHECK_EQ(StringUtils::Format(ATEXT("{} {} {}"), 1e15, 1e16, 123456.789), ATEXT("1000000000000000 1e+16 123456.789"));
+        CHECK_EQ(StringUtils::Format(ATEXT("{} {}"), 0.0001, 0.00001), ATEXT("0.0001 1e-05"));
+        CHECK_EQ(StringUtils::Format(ATEXT("{} {}"), 5e-324, 1.7976931348623157e308), ATEXT("5e-324 1.7976931348623157e+308"));
+        CHECK_EQ(StringUtils::Format(ATEXT("{} {}"), 3.4028235e38f, 1e-45f), ATEXT("3.4028235e+38 1e-45"));
+
+        const double inf = std::numeric_limits<double>::infinity();
+        CHECK_EQ(StringUtils::Format(ATEXT("{} {} {:5}"), inf, -inf, std::numeric_limits<double>::quiet_NaN()), ATEXT("inf -inf   nan"));
+
+        // Every written float reads back to the same value.
+        uint64 state = 0x9E3779B97F4A7C15ull;
+        for (uint32 i = 0; i < 10000; i++) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+
+            double value;
+            memcpy(&value, &state, sizeof(value));
+            if (std::isnan(value) || std::isinf(value)) {
+                continue;
+            }
+
+            tchar        text[StringUtils::MaxFloatChars + 1];
+            const uint32 size = StringUtils::FloatToChars(text, value);
+            text[size]        = 0;
+            CHECK_EQ(strtod(reinterpret_cast<const char*>(text), nullptr), value);
+
+            const float  single     = static_cast<float>(value);
+            const uint32 singleSize = StringUtils::FloatToChars(text, single);
+            text[singleSize]        = 0;
+            if (!std::isinf(single)) {
+                CHECK_EQ(strtof(reinterpret_cast<const char*>(text), nullptr), single);
+            }
+        }
+    }
+
+    SUBCASE("Float precision")
+    {
+        CHECK_EQ(StringUtils::Format(ATEXT("{:.2f} {:.0f} {:.3f}"), 3.14159, 2.5, -0.0004), ATEXT("3.14 2 -0.000"));
+        CHECK_EQ(StringUtils::Format(ATEXT("{:.2f} {:.1f} {:f}"), 9.999, 0.05, 1e20), ATEXT("10.00 0.1 100000000000000000000"));
+        CHECK_EQ(StringUtils::Format(ATEXT("[{:8.3f}] [{:f}]"), -1.5, 0.25), ATEXT("[  -1.500] [0.25]"));
+        CHECK_EQ(StringUtils::Format(ATEXT("{:.2e} {:e} {:.0e}"), 12345.678, 0.00012, 9.6), ATEXT("1.23e+04 1.2e-04 1e+01"));
+        CHECK_EQ(StringUtils::Format(ATEXT("{:.3g} {:.3g} {:.1g}"), 3.14159, 1234567.0, 0.96), ATEXT("3.14 1.23e+06 1"));
+
+        // Rounded from the exact binary value, ties to even.
+        CHECK_EQ(StringUtils::Format(ATEXT("{:.2f} {:.1f} {:.0f} {:.0f}"), 2.675, 0.15, 0.5, 1.5), ATEXT("2.67 0.1 0 2"));
+        CHECK_EQ(StringUtils::Format(ATEXT("{:.20f} {:.3e}"), 0.1, 5e-324), ATEXT("0.10000000000000000555 4.941e-324"));
+
+        uint64 state = 0x9E3779B97F4A7C15ull;
+        for (uint32 i = 0; i < 3000; i++) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+
+            double value;
+            memcpy(&value, &state, sizeof(value));
+            if (std::isnan(value) || std::isinf(value)) {
+                continue;
+            }
+
+            // Short decimals sit on the ties, random bits anywhere.
+            value = i % 2 ? static_cast<double>(state % 100000) / 1000 : value;
+
+            char expected[2048];
+            snprintf(expected, sizeof(expected), "%.0f %.2f %.17f %.0e %.3e %.16e %.4g", value, value, value, value, value, value, value);
+            CHECK_EQ(StringUtils::Format(ATEXT("{:.0f} {:.2f} {:.17f} {:.0e} {:.3e} {:.16e} {:.4g}"), value, value, value, value, value, value, value),
+                     reinterpret_cast<const tchar*>(expected));
+        }
+    }
+
+    SUBCASE("Caller buffers")
+    {
+        tchar buffer[8];
+        CHECK_EQ(StringUtils::FormatTo(buffer, sizeof(buffer), ATEXT("{}-{}"), 12, 34), 5);
+        CHECK_EQ(String(buffer), ATEXT("12-34"));
+
+        // Truncated text is null terminated and the full size is returned.
+        CHECK_EQ(StringUtils::FormatTo(buffer, sizeof(buffer), ATEXT("value {}"), 123456), 12);
+        CHECK_EQ(String(buffer), ATEXT("value 1"));
+        CHECK_EQ(StringUtils::FormatTo(nullptr, 0, ATEXT("{:.3f}"), 1.0), 5);
+
+        MemoryArena  arena;
+        const tchar* text = StringUtils::FormatTo(arena, ATEXT("{} and {}"), ATEXT("arena"), 1.25f);
+        CHECK_EQ(String(text), ATEXT("arena and 1.25"));
+
+        // Results longer than the stack buffer go through scratch memory.
+        String name;
+        for (uint32 i = 0; i < 40; i++) {
+            name += ATEXT("Uberlândia");
+        }
+        const String longText = StringUtils::Format(ATEXT("{}/{}"), name, name);
+        CHECK_EQ(longText.GetLength(), 801);
+        CHECK_EQ(longText, name + String(ATEXT("/")) + name);
+        CHECK_EQ(String(StringUtils::FormatTo(arena, ATEXT("{}"), name)), name);
+    }
+
+    SUBCASE("Format checks")
+    {
+        CHECK((StringUtils::CheckFormat<int32, float>(ATEXT("{} {:.2f}"))));
+        CHECK(StringUtils::CheckFormat<const tchar*>(ATEXT("{0:s10} {0}")));
+        CHECK_FALSE(StringUtils::CheckFormat<int32>(ATEXT("{} {}")));
+        CHECK_FALSE(StringUtils::CheckFormat<int32>(ATEXT("{:s}")));
+        CHECK_FALSE(StringUtils::CheckFormat<float>(ATEXT("{:x}")));
+        CHECK_FALSE(StringUtils::CheckFormat<int32>(ATEXT("{")));
+        CHECK_FALSE(StringUtils::CheckFormat<int32>(ATEXT("{} }")));
+        CHECK_FALSE(StringUtils::CheckFormat<int32>(ATEXT("{:.f}")));
+        CHECK_FALSE(StringUtils::CheckFormat<int32>(ATEXT("{2}")));
+        CHECK((StringUtils::CheckFormat<int32, int32>(ATEXT("{1} {0} {0}"))));
+        CHECK_FALSE((StringUtils::CheckFormat<int32, int32>(ATEXT("{}"))));
+        CHECK_FALSE((StringUtils::CheckFormat<int32, int32>(ATEXT("{0} {0}"))));
+    }
 }
 TEST_SUITE_END();
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <string_view>
+
+/** Hashes std::string and std::string_view alike, so sets and maps of strings can be searched with views.*/
+struct StringViewHasher
+{
+    using ResultType = size_t;
+    ResultType operator()(std::string_view value) const { return std::hash<std::string_view>()(value); }
+};
+
+/** Counts its live instances, so leaked or doubly destroyed items are detected.*/
+struct LiveTracked
+{
+    static inline std::atomic<int32> LiveCount = 0;
+
+    std::string Name;
+
+    LiveTracked()
+      : Name()
+    {
+        LiveCount++;
+    }
+
+    explicit LiveTracked(int32 value)
+      : Name(std::to_string(value))
+    {
+        LiveCount++;
+    }
+
+    explicit LiveTracked(const char* name)
+      : Name(name)
+    {
+        LiveCount++;
+    }
+
+    LiveTracked(const LiveTracked& other)
+      : Name(other.Name)
+    {
+        LiveCount++;
+    }
+
+    LiveTracked(LiveTracked&& other) noexcept
+      : Name(std::move(other.Name))
+    {
+        LiveCount++;
+    }
+
+    LiveTracked& operator=(const LiveTracked&) = default;
+    LiveTracked& operator=(LiveTracked&&)      = default;
+
+    ~LiveTracked() { LiveCount--; }
+};